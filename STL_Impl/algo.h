@@ -391,6 +391,23 @@ InputIter find(InputIter first, InputIter last, const T& value) {
     return first;
 }
 
+// deque 迭代器的分段版本，在每个连续的缓冲区内用指针查找
+template <class T, class Ref, class Ptr, size_t BufSiz, class U>
+deque_iterator<T, Ref, Ptr, BufSiz>
+find(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, const U& value) {
+    while (first.node != last.node) {
+        T* p = MySTL::find(first.cur, first.last, value);
+        if (p != first.last) {
+            first.cur = p;
+            return first;
+        }
+        first.set_node(first.node + 1);
+        first.cur = first.first;
+    }
+    first.cur = MySTL::find(first.cur, last.cur, value);
+    return first;
+}
+
 /*****************************************************************************************/
 // find_if
 // 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
@@ -677,6 +694,16 @@ Function for_each(InputIter first, InputIter last, Function func) {
     return func;
 }
 
+// deque 迭代器的分段版本，在每个连续的缓冲区内用指针遍历
+template <class T, class Ref, class Ptr, size_t BufSiz, class Function>
+Function for_each(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, Function func) {
+    MySTL::deque_segments(first, last, [&func](T* b, T* e) {
+        for (; b != e; ++b)
+            func(static_cast<Ref>(*b));
+    });
+    return func;
+}
+
 /*****************************************************************************************/
 // adjacent_find
 // 找出第一对匹配的相邻元素，缺省使用 operator== 比较，如果找到返回一个迭代器，指向这对元素的第一个元素
@@ -871,7 +898,7 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last, const T& value,
         half = len >> 1;
         middle = first;
         MySTL::advance(middle, half);
-        if (comp(*middle, value)) {
+        if (comp(value, *middle)) {
             len = half;
         } else {
             first = middle;
@@ -893,7 +920,7 @@ RandomIter ubound_dispatch(RandomIter first, RandomIter last, const T& value, ra
     while (len > 0) {
         half = len >> 1;
         middle = first + half;
-        if (comp(*middle, value)) {
+        if (comp(value, *middle)) {
             len = half;
         } else {
             first = middle + 1;
@@ -2175,7 +2202,7 @@ template <class Size>
 Size slg2(Size n) {
     // 找出 lgk <= n 的 k 的最大值
     Size k = 0;
-    for (; n > 1; n >> 1) ++k;
+    for (; n > 1; n >>= 1) ++k;
     return k;
 }
 
@@ -2229,7 +2256,8 @@ void unchecked_linear_insert(RandomIter last, const T& value) {
 template <class RandomIter>
 void unchecked_insertion_sort(RandomIter first, RandomIter last) {
     for (auto i = first; i != last; ++i) {
-        MySTL::unchecked_linear_insert(i, *i);
+        auto value = *i;  // *i 会在后移时被覆盖，须先取出
+        MySTL::unchecked_linear_insert(i, value);
     }
 }
 
@@ -2321,7 +2349,8 @@ template <class RandomIter, class Compare>
 void unchecked_insertion_sort(RandomIter first, RandomIter last,
                               Compare comp) {
     for (auto i = first; i != last; ++i) {
-        MySTL::unchecked_linear_insert(i, *i, comp);
+        auto value = *i;  // *i 会在后移时被覆盖，须先取出
+        MySTL::unchecked_linear_insert(i, value, comp);
     }
 }
 
@@ -2361,6 +2390,76 @@ void sort(RandomIter first, RandomIter last, Compare comp) {
     }
 }
 
+/*****************************************************************************************/
+// stable_sort
+// 对序列进行排序，相等的元素保持原有的相对次序
+/*****************************************************************************************/
+constexpr static size_t kStableChunkSize = 16;  // 不超过这个大小的区间直接采用插入排序
+
+// 有缓冲区的情况下进行归并排序，缓冲区至少能容纳前半段
+template <class RandomIter, class Pointer, class Compare>
+void merge_sort_with_buffer(RandomIter first, RandomIter last, Pointer buffer, Compare comp) {
+    if (static_cast<size_t>(last - first) <= kStableChunkSize) {
+        MySTL::insertion_sort(first, last, comp);
+        return;
+    }
+    auto middle = first + (last - first) / 2;
+    MySTL::merge_sort_with_buffer(first, middle, buffer, comp);
+    MySTL::merge_sort_with_buffer(middle, last, buffer, comp);
+    if (!comp(*middle, *(middle - 1)))  // 两段已经整体有序
+        return;
+    // 前半段移入缓冲区，再与后半段合并回原区间，相等时先取前半段的元素
+    auto buffer_end = MySTL::move(first, middle, buffer);
+    while (buffer != buffer_end && middle != last) {
+        if (comp(*middle, *buffer)) {
+            *first = MySTL::move(*middle);
+            ++middle;
+        } else {
+            *first = MySTL::move(*buffer);
+            ++buffer;
+        }
+        ++first;
+    }
+    MySTL::move(buffer, buffer_end, first);
+}
+
+// 没有缓冲区的情况下进行归并排序
+template <class RandomIter, class Compare>
+void inplace_stable_sort(RandomIter first, RandomIter last, Compare comp) {
+    if (static_cast<size_t>(last - first) <= kStableChunkSize) {
+        MySTL::insertion_sort(first, last, comp);
+        return;
+    }
+    auto middle = first + (last - first) / 2;
+    MySTL::inplace_stable_sort(first, middle, comp);
+    MySTL::inplace_stable_sort(middle, last, comp);
+    MySTL::merge_without_buffer(first, middle, last, middle - first, last - middle, comp);
+}
+
+template <class RandomIter, class T, class Compare>
+void stable_sort_aux(RandomIter first, RandomIter last, T*, Compare comp) {
+    auto half = (last - first) / 2;
+    temporary_buffer<RandomIter, T> buf(first, first + half);
+    if (buf.begin() && buf.size() == half) {
+        MySTL::merge_sort_with_buffer(first, last, buf.begin(), comp);
+    } else {
+        MySTL::inplace_stable_sort(first, last, comp);
+    }
+}
+
+template <class RandomIter, class Compare>
+void stable_sort(RandomIter first, RandomIter last, Compare comp) {
+    if (last - first < 2)
+        return;
+    MySTL::stable_sort_aux(first, last, value_type(first), comp);
+}
+
+template <class RandomIter>
+void stable_sort(RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    MySTL::stable_sort(first, last, MySTL::less<value_type>());
+}
+
 /*****************************************************************************************/
 // nth_element
 // 对序列重排，使得所有小于第 n 个元素的元素出现在它的前面，大于它的出现在它的后面
@@ -431,5 +431,222 @@ MySTL::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1
     }
     return MySTL::pair<InputIter1, InputIter2>(first1, first2);
 }
+
+/*****************************************************************************************/
+// deque 迭代器的分段版本
+// deque 的元素分段存放在多个连续的缓冲区中，逐个 ++ 时每一步都要检查是否越过缓冲区的边界
+// 以下重载把区间拆成若干个连续的缓冲区段，对每一段用指针调用原来的算法，
+// 可平凡复制的元素由指针版本整段 memmove，一个字节的整数由 fill_n 整段 memset
+// 源与目标重叠时的复制顺序与逐个复制相同，copy 从前往后，copy_backward 从后往前
+/*****************************************************************************************/
+template <class T, class Ref, class Ptr, size_t BufSiz>
+struct deque_iterator;
+
+// 按从前往后的顺序，对 [first, last) 中的每一个连续段调用 op(段首, 段尾)
+template <class T, class Ref, class Ptr, size_t BufSiz, class Op>
+void deque_segments(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, Op op) {
+    if (first.node == last.node) {
+        op(first.cur, last.cur);
+        return;
+    }
+    op(first.cur, first.last);
+    for (auto node = first.node + 1; node != last.node; ++node)
+        op(*node, *node + deque_iterator<T, Ref, Ptr, BufSiz>::buffer_size);
+    op(last.first, last.cur);
+}
+
+// 按从后往前的顺序，对 [first, last) 中的每一个连续段调用 op(段首, 段尾)
+template <class T, class Ref, class Ptr, size_t BufSiz, class Op>
+void deque_segments_backward(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, Op op) {
+    if (first.node == last.node) {
+        op(first.cur, last.cur);
+        return;
+    }
+    op(last.first, last.cur);
+    for (auto node = last.node - 1; node != first.node; --node)
+        op(*node, *node + deque_iterator<T, Ref, Ptr, BufSiz>::buffer_size);
+    op(first.cur, first.last);
+}
+
+// 按从前往后的顺序，对从 first 开始的 n 个位置中的每一个连续段调用 op(段首, 段尾)，返回 first + n
+template <class T, size_t BufSiz, class Op>
+deque_iterator<T, T&, T*, BufSiz> deque_segments_n(deque_iterator<T, T&, T*, BufSiz> first, ptrdiff_t n, Op op) {
+    while (n > 0) {
+        const ptrdiff_t len = MySTL::min(n, static_cast<ptrdiff_t>(first.last - first.cur));
+        op(first.cur, first.cur + len);
+        first += len;
+        n -= len;
+    }
+    return first;
+}
+
+// 按从后往前的顺序，对 last 之前的 n 个位置中的每一个连续段调用 op(段首, 段尾)，返回 last - n
+template <class T, size_t BufSiz, class Op>
+deque_iterator<T, T&, T*, BufSiz> deque_segments_n_backward(deque_iterator<T, T&, T*, BufSiz> last, ptrdiff_t n, Op op) {
+    while (n > 0) {
+        ptrdiff_t avail = last.cur - last.first;
+        T* end = last.cur;
+        if (avail == 0) {
+            avail = static_cast<ptrdiff_t>(deque_iterator<T, T&, T*, BufSiz>::buffer_size);
+            end = *(last.node - 1) + avail;
+        }
+        const ptrdiff_t len = MySTL::min(n, avail);
+        op(end - len, end);
+        last -= len;
+        n -= len;
+    }
+    return last;
+}
+
+// copy / move 的目标是 deque 的迭代器
+template <class InputIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+copy_to_segments(InputIter first, InputIter last, deque_iterator<T, T&, T*, BufSiz> result, MySTL::input_iterator_tag) {
+    return MySTL::unchecked_copy_cat(first, last, result, MySTL::input_iterator_tag());
+}
+
+template <class RandomIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+copy_to_segments(RandomIter first, RandomIter last, deque_iterator<T, T&, T*, BufSiz> result, MySTL::random_access_iterator_tag) {
+    return MySTL::deque_segments_n(result, last - first, [&first](T* b, T* e) {
+        MySTL::copy(first, first + (e - b), b);
+        first += e - b;
+    });
+}
+
+template <class InputIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz> copy(InputIter first, InputIter last, deque_iterator<T, T&, T*, BufSiz> result) {
+    return MySTL::copy_to_segments(first, last, result, iterator_category(first));
+}
+
+template <class InputIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+move_to_segments(InputIter first, InputIter last, deque_iterator<T, T&, T*, BufSiz> result, MySTL::input_iterator_tag) {
+    return MySTL::unchecked_move_cat(first, last, result, MySTL::input_iterator_tag());
+}
+
+template <class RandomIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+move_to_segments(RandomIter first, RandomIter last, deque_iterator<T, T&, T*, BufSiz> result, MySTL::random_access_iterator_tag) {
+    return MySTL::deque_segments_n(result, last - first, [&first](T* b, T* e) {
+        MySTL::move(first, first + (e - b), b);
+        first += e - b;
+    });
+}
+
+template <class InputIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz> move(InputIter first, InputIter last, deque_iterator<T, T&, T*, BufSiz> result) {
+    return MySTL::move_to_segments(first, last, result, iterator_category(first));
+}
+
+// copy_backward / move_backward 的目标是 deque 的迭代器，源必须是双向迭代器
+template <class BidirectionalIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+copy_backward_to_segments(BidirectionalIter first, BidirectionalIter last, deque_iterator<T, T&, T*, BufSiz> result,
+                          MySTL::bidirectional_iterator_tag) {
+    return MySTL::unchecked_copy_backward_cat(first, last, result, MySTL::bidirectional_iterator_tag());
+}
+
+template <class RandomIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+copy_backward_to_segments(RandomIter first, RandomIter last, deque_iterator<T, T&, T*, BufSiz> result,
+                          MySTL::random_access_iterator_tag) {
+    return MySTL::deque_segments_n_backward(result, last - first, [&last](T* b, T* e) {
+        MySTL::copy_backward(last - (e - b), last, e);
+        last -= e - b;
+    });
+}
+
+template <class BidirectionalIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+copy_backward(BidirectionalIter first, BidirectionalIter last, deque_iterator<T, T&, T*, BufSiz> result) {
+    return MySTL::copy_backward_to_segments(first, last, result, iterator_category(first));
+}
+
+template <class BidirectionalIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+move_backward_to_segments(BidirectionalIter first, BidirectionalIter last, deque_iterator<T, T&, T*, BufSiz> result,
+                          MySTL::bidirectional_iterator_tag) {
+    return MySTL::unchecked_move_backward_cat(first, last, result, MySTL::bidirectional_iterator_tag());
+}
+
+template <class RandomIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+move_backward_to_segments(RandomIter first, RandomIter last, deque_iterator<T, T&, T*, BufSiz> result,
+                          MySTL::random_access_iterator_tag) {
+    return MySTL::deque_segments_n_backward(result, last - first, [&last](T* b, T* e) {
+        MySTL::move_backward(last - (e - b), last, e);
+        last -= e - b;
+    });
+}
+
+template <class BidirectionalIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+move_backward(BidirectionalIter first, BidirectionalIter last, deque_iterator<T, T&, T*, BufSiz> result) {
+    return MySTL::move_backward_to_segments(first, last, result, iterator_category(first));
+}
+
+// copy / move / copy_backward / move_backward 的源是 deque 的迭代器，目标任意
+template <class T, class Ref, class Ptr, size_t BufSiz, class OutputIter>
+OutputIter copy(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, OutputIter result) {
+    MySTL::deque_segments(first, last, [&result](T* b, T* e) { result = MySTL::copy(b, e, result); });
+    return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class OutputIter>
+OutputIter move(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, OutputIter result) {
+    MySTL::deque_segments(first, last, [&result](T* b, T* e) { result = MySTL::move(b, e, result); });
+    return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class BidirectionalIter>
+BidirectionalIter
+copy_backward(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, BidirectionalIter result) {
+    MySTL::deque_segments_backward(first, last, [&result](T* b, T* e) { result = MySTL::copy_backward(b, e, result); });
+    return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class BidirectionalIter>
+BidirectionalIter
+move_backward(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, BidirectionalIter result) {
+    MySTL::deque_segments_backward(first, last, [&result](T* b, T* e) { result = MySTL::move_backward(b, e, result); });
+    return result;
+}
+
+// 源与目标都是 deque 的迭代器
+template <class T, class Ref, class Ptr, size_t BufSiz, class U, size_t BufSiz2>
+deque_iterator<U, U&, U*, BufSiz2>
+copy(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, deque_iterator<U, U&, U*, BufSiz2> result) {
+    MySTL::deque_segments(first, last, [&result](T* b, T* e) { result = MySTL::copy(b, e, result); });
+    return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class U, size_t BufSiz2>
+deque_iterator<U, U&, U*, BufSiz2>
+move(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, deque_iterator<U, U&, U*, BufSiz2> result) {
+    MySTL::deque_segments(first, last, [&result](T* b, T* e) { result = MySTL::move(b, e, result); });
+    return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class U, size_t BufSiz2>
+deque_iterator<U, U&, U*, BufSiz2>
+copy_backward(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, deque_iterator<U, U&, U*, BufSiz2> result) {
+    MySTL::deque_segments_backward(first, last, [&result](T* b, T* e) { result = MySTL::copy_backward(b, e, result); });
+    return result;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class U, size_t BufSiz2>
+deque_iterator<U, U&, U*, BufSiz2>
+move_backward(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, deque_iterator<U, U&, U*, BufSiz2> result) {
+    MySTL::deque_segments_backward(first, last, [&result](T* b, T* e) { result = MySTL::move_backward(b, e, result); });
+    return result;
+}
+
+// fill
+template <class T, size_t BufSiz, class U>
+void fill(deque_iterator<T, T&, T*, BufSiz> first, deque_iterator<T, T&, T*, BufSiz> last, const U& value) {
+    MySTL::deque_segments(first, last, [&value](T* b, T* e) { MySTL::fill_n(b, e - b, value); });
+}
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
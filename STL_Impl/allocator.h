@@ -2,11 +2,148 @@
 #define _MYSTL_ALLOCATOR_H_
 
 // 这个头文件包含一个模板类 allocator，用于管理内存的分配、释放，对象的构造、析构
+// 按指定边界对齐分配内存的模板类 aligned_allocator，以及容器使用分配器的接口 allocator_traits
+
+// notes:
+//
+// 不小于 MYSTL_MMAP_THRESHOLD 字节的块直接用 mmap 向系统映射内存页，释放时 munmap 归还
+// 这样的块可以通过 aligned_reallocate 扩展，Linux 下由 mremap 重新映射页表，不复制数据，
+// 扩容时不必同时持有新旧两块内存，vector 存放可平凡重定位的元素时借此原地扩容
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
 
 #include "construct.h"
 #include "util.h"
 
+// 定义 MYSTL_MMAP_THRESHOLD 为 0 时关闭 mmap 分配，所有块都交给 ::operator new
+#ifndef MYSTL_MMAP_THRESHOLD
+#define MYSTL_MMAP_THRESHOLD (4 * 1024 * 1024)
+#endif
+
+#if MYSTL_MMAP_THRESHOLD != 0 && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#define MYSTL_HAS_MMAP 1
+#else
+#define MYSTL_HAS_MMAP 0
+#endif
+
 namespace MySTL {
+
+// 缓存行与内存页的大小，aligned_vector 缺省按缓存行对齐
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef MYSTL_PAGE_SIZE
+#define MYSTL_PAGE_SIZE 4096
+#endif
+
+/*****************************************************************************************/
+// aligned_malloc / aligned_allocate
+// ::operator new 只保证 alignof(std::max_align_t) 的对齐，超过这个值的对齐要求交给平台的对齐分配函数
+// aligned_malloc 失败时返回空指针，aligned_allocate 失败时抛出 std::bad_alloc
+// 释放时必须传入与分配时相同的大小与对齐值
+/*****************************************************************************************/
+inline void* aligned_malloc(size_t bytes, size_t align) noexcept {
+    if (align <= alignof(std::max_align_t)) return std::malloc(bytes);
+#if defined(_WIN32)
+    return _aligned_malloc(bytes, align);
+#else
+    void* p = nullptr;
+    if (align < sizeof(void*)) align = sizeof(void*);
+    return posix_memalign(&p, align, bytes) == 0 ? p : nullptr;
+#endif
+}
+
+inline void aligned_free(void* ptr, size_t align) noexcept {
+#if defined(_WIN32)
+    if (align > alignof(std::max_align_t)) {
+        _aligned_free(ptr);
+        return;
+    }
+#else
+    (void)align;
+#endif
+    std::free(ptr);
+}
+
+// 是否直接映射内存页：块足够大，且对齐要求不超过页的大小
+constexpr bool is_page_mapped(size_t bytes, size_t align) noexcept {
+    return MYSTL_HAS_MMAP && bytes >= static_cast<size_t>(MYSTL_MMAP_THRESHOLD) && align <= MYSTL_PAGE_SIZE;
+}
+
+inline void* aligned_allocate(size_t bytes, size_t align) {
+#if MYSTL_HAS_MMAP
+    if (is_page_mapped(bytes, align)) {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        return p;
+    }
+#endif
+    if (align <= alignof(std::max_align_t)) return ::operator new(bytes);
+#if defined(__cpp_aligned_new)
+    return ::operator new(bytes, std::align_val_t(align));
+#else
+    void* p = aligned_malloc(bytes, align);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+#endif
+}
+
+// bytes 必须与分配时相同，支持 sized deallocation 时交给带大小的 ::operator delete，省去一次查找块大小的开销
+inline void aligned_deallocate(void* ptr, size_t bytes, size_t align) noexcept {
+#if MYSTL_HAS_MMAP
+    if (is_page_mapped(bytes, align)) {
+        ::munmap(ptr, bytes);
+        return;
+    }
+#endif
+    if (align <= alignof(std::max_align_t)) {
+#if defined(__cpp_sized_deallocation)
+        ::operator delete(ptr, bytes);
+#else
+        (void)bytes;
+        ::operator delete(ptr);
+#endif
+        return;
+    }
+#if defined(__cpp_aligned_new) && defined(__cpp_sized_deallocation)
+    ::operator delete(ptr, bytes, std::align_val_t(align));
+#elif defined(__cpp_aligned_new)
+    (void)bytes;
+    ::operator delete(ptr, std::align_val_t(align));
+#else
+    (void)bytes;
+    aligned_free(ptr, align);
+#endif
+}
+
+// 把 ptr 处 old_bytes 字节的块换成 new_bytes 字节，前 min(old_bytes, new_bytes) 字节的内容保留，返回新的地址
+// 新旧两块都是映射的内存页时，Linux 下用 mremap 原地扩展或移动页表，其余情况分配新块后 memcpy
+// 只能用于可以按字节搬运的数据，失败时抛出 std::bad_alloc，原来的块保持不变
+inline void* aligned_reallocate(void* ptr, size_t old_bytes, size_t new_bytes, size_t align) {
+    if (ptr == nullptr) return aligned_allocate(new_bytes, align);
+#if MYSTL_HAS_MMAP && defined(__linux__)
+    if (is_page_mapped(old_bytes, align) && is_page_mapped(new_bytes, align)) {
+        void* p = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        return p;
+    }
+#endif
+    void* p = aligned_allocate(new_bytes, align);
+    std::memcpy(p, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+    aligned_deallocate(ptr, old_bytes, align);
+    return p;
+}
+
+/*****************************************************************************************/
+// allocator
+// 按照 alignof(T) 分配内存，alignas 指定了扩展对齐的类型也能放进容器
+/*****************************************************************************************/
 template <class T>
 class allocator {
    public:
@@ -18,6 +155,17 @@ class allocator {
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
 
+    template <class U>
+    struct rebind {
+        typedef allocator<U> other;
+    };
+
+   public:
+    allocator() noexcept {}
+    allocator(const allocator&) noexcept {}
+    template <class U>
+    allocator(const allocator<U>&) noexcept {}
+
    public:
     static T* allocate();
     static T* allocate(size_type n);
@@ -25,6 +173,9 @@ class allocator {
     static void deallocate(T* ptr);
     static void deallocate(T* ptr, size_type n);
 
+    // 只用于可平凡重定位的 T
+    static T* reallocate(T* ptr, size_type old_n, size_type new_n);
+
     static void construct(T* ptr);
     static void construct(T* ptr, const T& value);
     static void construct(T* ptr, T&& value);
@@ -38,25 +189,34 @@ class allocator {
 
 template <class T>
 T* allocator<T>::allocate() {
-    return static_cast<T*>(::operator new(sizeof(T)));
+    return static_cast<T*>(aligned_allocate(sizeof(T), alignof(T)));
 }
 
 template <class T>
 T* allocator<T>::allocate(size_type n) {
     if (n == 0) return nullptr;
-    return static_cast<T*>(::operator new(n * sizeof(T)));
+    return static_cast<T*>(aligned_allocate(n * sizeof(T), alignof(T)));
 }
 
 template <class T>
 void allocator<T>::deallocate(T* ptr) {
     if (ptr == nullptr) return;
-    ::operator delete(ptr);
+    aligned_deallocate(ptr, sizeof(T), alignof(T));
 }
 
 template <class T>
 void allocator<T>::deallocate(T* ptr, size_type n) {
     if (ptr == nullptr) return;
-    ::operator delete(ptr);
+    aligned_deallocate(ptr, n * sizeof(T), alignof(T));
+}
+
+template <class T>
+T* allocator<T>::reallocate(T* ptr, size_type old_n, size_type new_n) {
+    if (new_n == 0) {
+        deallocate(ptr, old_n);
+        return nullptr;
+    }
+    return static_cast<T*>(aligned_reallocate(ptr, old_n * sizeof(T), new_n * sizeof(T), alignof(T)));
 }
 
 template <class T>
@@ -89,5 +249,372 @@ template <class T>
 void allocator<T>::destroy(T* first, T* last) {
     MySTL::destroy(first, last);
 }
+
+// allocator 没有状态，任意两个 allocator 都相等
+template <class T, class U>
+bool operator==(const allocator<T>&, const allocator<U>&) noexcept {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const allocator<T>&, const allocator<U>&) noexcept {
+    return false;
+}
+
+template <class T>
+struct is_trivially_relocatable<allocator<T>> : std::true_type {};
+
+/*****************************************************************************************/
+// aligned_allocator
+// 分配的内存起始于 Align 与 alignof(T) 中较大者的边界，例如缓存行或内存页
+// 用于让 vector 的 data() 对齐到缓存行以避免伪共享，或对齐到内存页
+/*****************************************************************************************/
+template <class T, size_t Align>
+class aligned_allocator {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "aligned_allocator: Align must be a power of two");
+
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef const T* const_pointer;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef aligned_allocator<U, Align> other;
+    };
+
+    // 实际使用的对齐值
+    static constexpr size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+
+   public:
+    aligned_allocator() noexcept {}
+    aligned_allocator(const aligned_allocator&) noexcept {}
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+   public:
+    static T* allocate(size_type n) {
+        if (n == 0) return nullptr;
+        return static_cast<T*>(aligned_allocate(n * sizeof(T), alignment));
+    }
+
+    static void deallocate(T* ptr, size_type n) {
+        if (ptr == nullptr) return;
+        aligned_deallocate(ptr, n * sizeof(T), alignment);
+    }
+
+    static T* reallocate(T* ptr, size_type old_n, size_type new_n) {
+        if (new_n == 0) {
+            deallocate(ptr, old_n);
+            return nullptr;
+        }
+        return static_cast<T*>(aligned_reallocate(ptr, old_n * sizeof(T), new_n * sizeof(T), alignment));
+    }
+
+    template <class... Args>
+    static void construct(T* ptr, Args&&... args) {
+        MySTL::construct(ptr, MySTL::forward<Args>(args)...);
+    }
+
+    static void destroy(T* ptr) { MySTL::destroy(ptr); }
+    static void destroy(T* first, T* last) { MySTL::destroy(first, last); }
+};
+
+template <class T, size_t Align>
+constexpr size_t aligned_allocator<T, Align>::alignment;
+
+template <class T, class U, size_t Align>
+bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) noexcept {
+    return true;
+}
+
+template <class T, class U, size_t Align>
+bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) noexcept {
+    return false;
+}
+
+template <class T, size_t Align>
+struct is_trivially_relocatable<aligned_allocator<T, Align>> : std::true_type {};
+
+/*****************************************************************************************/
+// allocator_traits
+// 容器通过 allocator_traits 使用分配器，分配器至少要提供 value_type、allocate(n) 与 deallocate(p, n)
+// construct、destroy、rebind 等成员缺省时由 allocator_traits 补齐
+// 容器内部只使用原生指针，不支持自定义的 pointer 类型
+/*****************************************************************************************/
+
+template <class... Types>
+struct alloc_void {
+    typedef void type;
+};
+
+// 以下 traits 取分配器的嵌套类型，没有时使用缺省类型
+template <class Alloc, class = void>
+struct alloc_pocca : std::false_type {};
+
+template <class Alloc>
+struct alloc_pocca<Alloc, typename alloc_void<typename Alloc::propagate_on_container_copy_assignment>::type>
+    : Alloc::propagate_on_container_copy_assignment {};
+
+template <class Alloc, class = void>
+struct alloc_pocma : std::false_type {};
+
+template <class Alloc>
+struct alloc_pocma<Alloc, typename alloc_void<typename Alloc::propagate_on_container_move_assignment>::type>
+    : Alloc::propagate_on_container_move_assignment {};
+
+template <class Alloc, class = void>
+struct alloc_pocs : std::false_type {};
+
+template <class Alloc>
+struct alloc_pocs<Alloc, typename alloc_void<typename Alloc::propagate_on_container_swap>::type>
+    : Alloc::propagate_on_container_swap {};
+
+template <class Alloc, class = void>
+struct alloc_always_equal : std::is_empty<Alloc> {};
+
+template <class Alloc>
+struct alloc_always_equal<Alloc, typename alloc_void<typename Alloc::is_always_equal>::type>
+    : Alloc::is_always_equal {};
+
+// 分配器的 rebind：优先使用 Alloc::rebind<U>::other，否则把 Alloc<T, Args...> 替换为 Alloc<U, Args...>
+template <class Alloc, class U>
+struct alloc_rebind_sub;
+
+template <template <class, class...> class Alloc, class T, class... Args, class U>
+struct alloc_rebind_sub<Alloc<T, Args...>, U> {
+    typedef Alloc<U, Args...> type;
+};
+
+template <class Alloc, class U, class = void>
+struct alloc_rebind {
+    typedef typename alloc_rebind_sub<Alloc, U>::type type;
+};
+
+template <class Alloc, class U>
+struct alloc_rebind<Alloc, U, typename alloc_void<typename Alloc::template rebind<U>::other>::type> {
+    typedef typename Alloc::template rebind<U>::other type;
+};
+
+// 检查分配器是否提供了对应的成员函数
+template <class Alloc, class T, class... Args>
+struct alloc_has_construct {
+   private:
+    template <class A, class = decltype(std::declval<A&>().construct(std::declval<T*>(), std::declval<Args>()...))>
+    static std::true_type test(int);
+    template <class A>
+    static std::false_type test(...);
+
+   public:
+    typedef decltype(test<Alloc>(0)) type;
+};
+
+template <class Alloc, class T>
+struct alloc_has_destroy {
+   private:
+    template <class A, class = decltype(std::declval<A&>().destroy(std::declval<T*>()))>
+    static std::true_type test(int);
+    template <class A>
+    static std::false_type test(...);
+
+   public:
+    typedef decltype(test<Alloc>(0)) type;
+};
+
+template <class Alloc>
+struct alloc_has_max_size {
+   private:
+    template <class A, class = decltype(std::declval<const A&>().max_size())>
+    static std::true_type test(int);
+    template <class A>
+    static std::false_type test(...);
+
+   public:
+    typedef decltype(test<Alloc>(0)) type;
+};
+
+// reallocate 不是标准分配器的成员，提供它的分配器可以把扩容交给系统原地完成
+template <class Alloc>
+struct alloc_has_reallocate {
+   private:
+    template <class A, class = decltype(std::declval<A&>().reallocate(std::declval<typename A::value_type*>(), size_t(), size_t()))>
+    static std::true_type test(int);
+    template <class A>
+    static std::false_type test(...);
+
+   public:
+    typedef decltype(test<Alloc>(0)) type;
+};
+
+template <class Alloc>
+struct alloc_has_select {
+   private:
+    template <class A, class = decltype(std::declval<const A&>().select_on_container_copy_construction())>
+    static std::true_type test(int);
+    template <class A>
+    static std::false_type test(...);
+
+   public:
+    typedef decltype(test<Alloc>(0)) type;
+};
+
+template <class Alloc>
+struct allocator_traits {
+    typedef Alloc allocator_type;
+    typedef typename Alloc::value_type value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef typename alloc_pocca<Alloc>::type propagate_on_container_copy_assignment;
+    typedef typename alloc_pocma<Alloc>::type propagate_on_container_move_assignment;
+    typedef typename alloc_pocs<Alloc>::type propagate_on_container_swap;
+    typedef typename alloc_always_equal<Alloc>::type is_always_equal;
+
+    template <class U>
+    using rebind_alloc = typename alloc_rebind<Alloc, U>::type;
+
+    template <class U>
+    using rebind_traits = allocator_traits<rebind_alloc<U>>;
+
+    static pointer allocate(Alloc& a, size_type n) { return a.allocate(n); }
+
+    static void deallocate(Alloc& a, pointer p, size_type n) { a.deallocate(p, n); }
+
+    // 把 p 处 old_n 个元素的空间换成 new_n 个，前 min(old_n, new_n) 个元素按字节搬到新的位置
+    // 只用于可平凡重定位的元素类型，分配器没有 reallocate 时分配新空间再搬运
+    static pointer reallocate(Alloc& a, pointer p, size_type old_n, size_type new_n) {
+        return reallocate_aux(typename alloc_has_reallocate<Alloc>::type{}, a, p, old_n, new_n);
+    }
+
+    template <class T, class... Args>
+    static void construct(Alloc& a, T* p, Args&&... args) {
+        construct_aux(typename alloc_has_construct<Alloc, T, Args...>::type{}, a, p, MySTL::forward<Args>(args)...);
+    }
+
+    template <class T>
+    static void destroy(Alloc& a, T* p) {
+        destroy_aux(typename alloc_has_destroy<Alloc, T>::type{}, a, p);
+    }
+
+    // 析构 [first, last) 上的对象，分配器没有 destroy 时对平凡析构的类型什么也不做
+    template <class T>
+    static void destroy(Alloc& a, T* first, T* last) {
+        destroy_range_aux(typename alloc_has_destroy<Alloc, T>::type{}, a, first, last);
+    }
+
+    static size_type max_size(const Alloc& a) noexcept {
+        return max_size_aux(typename alloc_has_max_size<Alloc>::type{}, a);
+    }
+
+    static Alloc select_on_container_copy_construction(const Alloc& a) {
+        return select_aux(typename alloc_has_select<Alloc>::type{}, a);
+    }
+
+   private:
+    template <class T, class... Args>
+    static void construct_aux(std::true_type, Alloc& a, T* p, Args&&... args) {
+        a.construct(p, MySTL::forward<Args>(args)...);
+    }
+
+    template <class T, class... Args>
+    static void construct_aux(std::false_type, Alloc&, T* p, Args&&... args) {
+        ::new ((void*)p) T(MySTL::forward<Args>(args)...);
+    }
+
+    template <class T>
+    static void destroy_aux(std::true_type, Alloc& a, T* p) { a.destroy(p); }
+
+    template <class T>
+    static void destroy_aux(std::false_type, Alloc&, T* p) { MySTL::destroy(p); }
+
+    template <class T>
+    static void destroy_range_aux(std::true_type, Alloc& a, T* first, T* last) {
+        for (; first != last; ++first)
+            a.destroy(first);
+    }
+
+    template <class T>
+    static void destroy_range_aux(std::false_type, Alloc&, T* first, T* last) { MySTL::destroy(first, last); }
+
+    static pointer reallocate_aux(std::true_type, Alloc& a, pointer p, size_type old_n, size_type new_n) {
+        return a.reallocate(p, old_n, new_n);
+    }
+
+    static pointer reallocate_aux(std::false_type, Alloc& a, pointer p, size_type old_n, size_type new_n) {
+        pointer q = new_n == 0 ? nullptr : a.allocate(new_n);
+        if (p != nullptr) {
+            const size_type n = old_n < new_n ? old_n : new_n;
+            if (n != 0) std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), n * sizeof(value_type));
+            a.deallocate(p, old_n);
+        }
+        return q;
+    }
+
+    static size_type max_size_aux(std::true_type, const Alloc& a) { return a.max_size(); }
+
+    static size_type max_size_aux(std::false_type, const Alloc&) { return static_cast<size_type>(-1) / sizeof(value_type); }
+
+    static Alloc select_aux(std::true_type, const Alloc& a) { return a.select_on_container_copy_construction(); }
+
+    static Alloc select_aux(std::false_type, const Alloc& a) { return a; }
+};
+
+// 容器赋值、交换时，按照 propagate_on_container_* 决定是否连同分配器一起传播
+template <class Alloc>
+void alloc_copy_assign(Alloc& lhs, const Alloc& rhs, std::true_type) { lhs = rhs; }
+
+template <class Alloc>
+void alloc_copy_assign(Alloc&, const Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_copy_assign(Alloc& lhs, const Alloc& rhs) {
+    alloc_copy_assign(lhs, rhs, typename allocator_traits<Alloc>::propagate_on_container_copy_assignment{});
+}
+
+template <class Alloc>
+void alloc_move_assign(Alloc& lhs, Alloc& rhs, std::true_type) { lhs = MySTL::move(rhs); }
+
+template <class Alloc>
+void alloc_move_assign(Alloc&, Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_move_assign(Alloc& lhs, Alloc& rhs) {
+    alloc_move_assign(lhs, rhs, typename allocator_traits<Alloc>::propagate_on_container_move_assignment{});
+}
+
+template <class Alloc>
+void alloc_swap(Alloc& lhs, Alloc& rhs, std::true_type) {
+    using MySTL::swap;
+    swap(lhs, rhs);
+}
+
+template <class Alloc>
+void alloc_swap(Alloc&, Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_swap(Alloc& lhs, Alloc& rhs) {
+    alloc_swap(lhs, rhs, typename allocator_traits<Alloc>::propagate_on_container_swap{});
+}
+
+/*****************************************************************************************/
+// alloc_holder
+// 容器以私有基类的形式保存分配器，分配器为空类时借助空基类优化不增加容器的大小
+/*****************************************************************************************/
+template <class Alloc>
+class alloc_holder : private Alloc {
+   public:
+    alloc_holder() : Alloc() {}
+    explicit alloc_holder(const Alloc& a) : Alloc(a) {}
+    explicit alloc_holder(Alloc&& a) : Alloc(MySTL::move(a)) {}
+
+    Alloc& get_alloc() noexcept { return *this; }
+    const Alloc& get_alloc() const noexcept { return *this; }
+};
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -12,5 +12,15 @@ using wstring = MySTL::basic_string<wchar_t>;
 using u16string = MySTL::basic_string<char16_t>;
 using u32string = MySTL::basic_string<char32_t>;
 
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+using string = MySTL::basic_string<char, MySTL::char_traits<char>, MySTL::polymorphic_allocator<char>>;
+using wstring = MySTL::basic_string<wchar_t, MySTL::char_traits<wchar_t>, MySTL::polymorphic_allocator<wchar_t>>;
+using u16string = MySTL::basic_string<char16_t, MySTL::char_traits<char16_t>, MySTL::polymorphic_allocator<char16_t>>;
+using u32string = MySTL::basic_string<char32_t, MySTL::char_traits<char32_t>, MySTL::polymorphic_allocator<char32_t>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
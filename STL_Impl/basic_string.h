@@ -222,29 +222,31 @@ struct char_traits<char32_t> {
 
 // 模板类 basic_string
 // 参数一代表字符类型，参数二代表萃取字符类型的方式，缺省使用 MySTL::char_traits
-template <class CharType, class CharTraits = MySTL::char_traits<CharType>>
-class basic_string {
+// 参数三代表空间配置器类型，缺省使用 MySTL::allocator
+template <class CharType, class CharTraits = MySTL::char_traits<CharType>, class Alloc = MySTL::allocator<CharType>>
+class basic_string : private alloc_holder<Alloc> {
    public:
     typedef CharTraits traits_type;
     typedef CharTraits char_traits;
 
-    typedef MySTL::allocator<CharType> allocator_type;
-    typedef MySTL::allocator<CharType> data_allocator;
+    typedef Alloc allocator_type;
+    typedef MySTL::allocator_traits<Alloc> alloc_traits;
+    typedef MySTL::alloc_holder<Alloc> holder_type;
 
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef CharType value_type;
+    typedef CharType* pointer;
+    typedef const CharType* const_pointer;
+    typedef CharType& reference;
+    typedef const CharType& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
 
     typedef value_type* iterator;
     typedef const value_type* const_iterator;
     typedef MySTL::reverse_iterator<iterator> reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() { return allocator_type(); }
+    allocator_type get_allocator() const { return this->get_alloc(); }
 
     static_assert(std::is_pod<CharType>::value, "Character type of basic_string must be a POD");
     static_assert(std::is_same<CharType, typename traits_type::char_type>::value,
@@ -264,43 +266,58 @@ class basic_string {
     // 构造、复制、移动、析构函数
     basic_string() noexcept { try_init(); }
 
-    basic_string(size_type n, value_type ch) : buffer_(nullptr), size_(0), cap_(0) {
+    explicit basic_string(const allocator_type& alloc) noexcept : holder_type(alloc) { try_init(); }
+
+    basic_string(size_type n, value_type ch, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc), buffer_(nullptr), size_(0), cap_(0) {
         fill_init(n, ch);
     }
 
-    basic_string(const basic_string& other, size_type pos) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const basic_string& other, size_type pos, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(other.buffer_, pos, other.size_ - pos);
     }
 
-    basic_string(const basic_string& other, size_type pos, size_type count) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const basic_string& other, size_type pos, size_type count, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(other.buffer_, pos, count);
     }
 
-    basic_string(const_pointer str) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const_pointer str, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(str, 0, char_traits::length(str));
     }
 
-    basic_string(const_pointer str, size_type count) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const_pointer str, size_type count, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(str, 0, count);
     }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    basic_string(Iter first, Iter last) {
+    basic_string(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
         copy_init(first, last, iterator_category(first));
     }
 
-    basic_string(const basic_string& rhs) : buffer_(nullptr), size_(0), cap_(0) {
+    basic_string(const basic_string& rhs)
+        : holder_type(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())), buffer_(nullptr), size_(0), cap_(0) {
+        init_from(rhs.buffer_, 0, rhs.size_);
+    }
+
+    basic_string(const basic_string& rhs, const allocator_type& alloc)
+        : holder_type(alloc), buffer_(nullptr), size_(0), cap_(0) {
         init_from(rhs.buffer_, 0, rhs.size_);
     }
 
-    basic_string(basic_string&& rhs) noexcept : buffer_(rhs.buffer_), size_(rhs.size_), cap_(rhs.cap_) {
+    basic_string(basic_string&& rhs) noexcept
+        : holder_type(MySTL::move(rhs.get_alloc())), buffer_(rhs.buffer_), size_(rhs.size_), cap_(rhs.cap_) {
         rhs.buffer_ = nullptr;
         rhs.size_ = 0;
         rhs.cap_ = 0;
     }
 
     basic_string& operator=(const basic_string& rhs);
-    basic_string& operator=(basic_string&& rhs) noexcept;
+    basic_string& operator=(basic_string&& rhs) noexcept(alloc_traits::is_always_equal::value);
 
     basic_string& operator=(const_pointer str);
     basic_string& operator=(value_type ch);
@@ -425,6 +442,11 @@ class basic_string {
     void resize(size_type count) { resize(count, value_type()); }
     void resize(size_type count, value_type ch);
 
+    // resize_default_init / append_uninitialized
+    // 新增的字符不做初始化，由调用者随后填充，例如直接作为 read() 的目标缓冲区
+    void resize_default_init(size_type count);
+    pointer append_uninitialized(size_type count);
+
     // basic_string 相关操作
     // compare
     int compare(const basic_string& other) const;
@@ -438,7 +460,7 @@ class basic_string {
     // substr
     basic_string substr(size_type index, size_type count = npos) {
         count = MySTL::min(count, size_ - index);
-        return basic_string(buffer_ + index, buffer_ + index + count);
+        return basic_string(buffer_ + index, buffer_ + index + count, get_allocator());
     }
 
     // replace
@@ -550,7 +572,7 @@ class basic_string {
     friend std::istream& operator>>(std::istream& is, basic_string& str) {
         value_type* buf = new value_type[4096];
         is >> buf;
-        basic_string tmp(buf);
+        basic_string tmp(buf, str.get_allocator());
         str = std::move(tmp);
         delete[] buf;
         return is;
@@ -606,38 +628,52 @@ class basic_string {
 
 /****************************************函数实现****************************************/
 // 复制赋值操作符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::operator=(const basic_string& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::operator=(const basic_string& rhs) {
     if (this != &rhs) {
-        basic_string tmp(rhs);
+        if (alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的空间必须由原来的分配器释放
+            destroy_buffer();
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        }
+        basic_string tmp(rhs, get_allocator());
         swap(tmp);
     }
     return *this;
 }
 
 // 移动赋值操作符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::operator=(basic_string&& rhs) noexcept {
-    destroy_buffer();
-    buffer_ = rhs.buffer_;
-    size_ = rhs.size_;
-    cap_ = rhs.cap_;
-    rhs.buffer_ = nullptr;
-    rhs.size_ = 0;
-    rhs.cap_ = 0;
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::operator=(basic_string&& rhs) noexcept(alloc_traits::is_always_equal::value) {
+    if (alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+        destroy_buffer();
+        MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+        buffer_ = rhs.buffer_;
+        size_ = rhs.size_;
+        cap_ = rhs.cap_;
+        rhs.buffer_ = nullptr;
+        rhs.size_ = 0;
+        rhs.cap_ = 0;
+    } else {
+        // 分配器不相等，不能直接接管对方的空间
+        basic_string tmp(rhs, get_allocator());
+        swap(tmp);
+        rhs.clear();
+    }
     return *this;
 }
 
 // 用一个字符串赋值
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::operator=(const_pointer str) {
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::operator=(const_pointer str) {
     const size_type len = char_traits::length(str);
     if (cap_ < len) {
-        auto new_buffer = data_allocator::allocate(len + 1);
-        data_allocator::deallocate(buffer_);
+        auto new_buffer = alloc_traits::allocate(this->get_alloc(), len + 1);
+        if (buffer_ != nullptr)
+            alloc_traits::deallocate(this->get_alloc(), buffer_, cap_);
         buffer_ = new_buffer;
         cap_ = len + 1;
     }
@@ -648,12 +684,13 @@ basic_string<CharType, CharTraits>::operator=(const_pointer str) {
 }
 
 // 用一个字符赋值
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::operator=(value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::operator=(value_type ch) {
     if (cap_ < 1) {
-        auto new_buffer = data_allocator::allocate(2);
-        data_allocator::deallocate(buffer_);
+        auto new_buffer = alloc_traits::allocate(this->get_alloc(), 2);
+        if (buffer_ != nullptr)
+            alloc_traits::deallocate(this->get_alloc(), buffer_, cap_);
         buffer_ = new_buffer;
         cap_ = 2;
     }
@@ -663,29 +700,31 @@ basic_string<CharType, CharTraits>::operator=(value_type ch) {
 }
 
 // 预留储存空间
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::reserve(size_type n) {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::reserve(size_type n) {
     if (cap_ < n) {
         THROW_LENGTH_ERROR_IF(n > max_size(),
                               "n can not larger than max_size() in basic_string<Char,Traits>::reserve(n)");
-        auto new_buffer = data_allocator::allocate(n);
+        auto new_buffer = alloc_traits::allocate(this->get_alloc(), n);
         char_traits::move(new_buffer, buffer_, size_);
+        if (buffer_ != nullptr)
+            alloc_traits::deallocate(this->get_alloc(), buffer_, cap_);
         buffer_ = new_buffer;
         cap_ = n;
     }
 }
 
 // 减少不用的空间
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::shrink_to_fit() {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::shrink_to_fit() {
     if (size_ != cap_)
         reinsert(size_);
 }
 
 // 在 pos 处插入一个元素
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::insert(const_iterator pos, value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::insert(const_iterator pos, value_type ch) {
     iterator r = const_cast<iterator>(pos);
     if (size_ == cap_)
         return reallocate_and_fill(r, 1, ch);
@@ -696,9 +735,9 @@ basic_string<CharType, CharTraits>::insert(const_iterator pos, value_type ch) {
 }
 
 // 在 pos 处插入 n 个元素
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::insert(const_iterator pos, size_type count, value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::insert(const_iterator pos, size_type count, value_type ch) {
     iterator r = const_cast<iterator>(pos);
     if (count == 0) return r;
 
@@ -717,10 +756,10 @@ basic_string<CharType, CharTraits>::insert(const_iterator pos, size_type count,
 }
 
 // 在 pos 处插入 [first, last) 内的元素
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc>
 template <class Iter>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::insert(const_iterator pos, Iter first, Iter last) {
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::insert(const_iterator pos, Iter first, Iter last) {
     iterator r = const_cast<iterator>(pos);
     const size_type len = MySTL::distance(first, last);
     if (len == 0) return r;
@@ -739,9 +778,9 @@ basic_string<CharType, CharTraits>::insert(const_iterator pos, Iter first, Iter
 }
 
 // 在末尾添加 count 个 ch
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::append(size_type count, value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::append(size_type count, value_type ch) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
                           "basic_string<Char, Tratis>'s size too big");
     if (cap_ - size_ < count)
@@ -752,9 +791,9 @@ basic_string<CharType, CharTraits>::append(size_type count, value_type ch) {
 }
 
 // 在末尾添加 [str[pos] str[pos+count]) 一段
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::append(const basic_string& str, size_type pos, size_type count) {
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::append(const basic_string& str, size_type pos, size_type count) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
                           "basic_string<Char, Tratis>'s size too big");
     if (count == 0) return *this;
@@ -766,9 +805,9 @@ basic_string<CharType, CharTraits>::append(const basic_string& str, size_type po
 }
 
 // 在末尾添加 [s, s+count) 一段
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::append(const_pointer s, size_type count) {
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::append(const_pointer s, size_type count) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
                           "basic_string<Char, Tratis>'s size too big");
     if (cap_ - size_ < count)
@@ -779,9 +818,9 @@ basic_string<CharType, CharTraits>::append(const_pointer s, size_type count) {
 }
 
 // 删除 pos 处的元素
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::erase(const_iterator pos) {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::erase(const_iterator pos) {
     MYSTL_DEBUG(pos != end());
     iterator r = const_cast<iterator>(pos);
     char_traits::move(r, pos + 1, end() - pos - 1);
@@ -790,9 +829,9 @@ basic_string<CharType, CharTraits>::erase(const_iterator pos) {
 }
 
 // 删除 [first, last) 的元素
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::erase(const_iterator first, const_iterator last) {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::erase(const_iterator first, const_iterator last) {
     if (first == begin() && last == end()) {
         clear();
         return end();
@@ -806,8 +845,8 @@ basic_string<CharType, CharTraits>::erase(const_iterator first, const_iterator l
 }
 
 // 重置容器大小
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::resize(size_type count, value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::resize(size_type count, value_type ch) {
     if (count < size_) {
         erase(buffer_ + count, buffer_ + size_);
     } else {
@@ -815,22 +854,44 @@ void basic_string<CharType, CharTraits>::resize(size_type count, value_type ch)
     }
 }
 
+// 重置容器大小，新增的字符不做初始化
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::resize_default_init(size_type count) {
+    if (count < size_) {
+        erase(buffer_ + count, buffer_ + size_);
+    } else {
+        append_uninitialized(count - size_);
+    }
+}
+
+// 在末尾追加 count 个未初始化的字符，返回指向第一个新字符的指针
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::pointer
+basic_string<CharType, CharTraits, Alloc>::append_uninitialized(size_type count) {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
+                          "basic_string<Char, Tratis>'s size too big");
+    if (cap_ - size_ < count)
+        reallocate(count);
+    size_ += count;
+    return buffer_ + size_ - count;
+}
+
 // 比较两个 basic_string，小于返回 -1，大于返回 1，等于返回 0
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::compare(const basic_string& other) const {
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::compare(const basic_string& other) const {
     return compare_cstr(buffer_, size_, other.buffer_, other.size_);
 }
 
 // 从 pos 下标开始的 count 个字符跟另一个 basic_string 比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::compare(size_type pos, size_type count, const basic_string& other) const {
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::compare(size_type pos, size_type count, const basic_string& other) const {
     auto n = MySTL::min(count, size_ - pos);
     return compare_cstr(buffer_ + pos, n, other.buffer_, other.size_);
 }
 
 // 从 pos1 下标开始的 count1 个字符跟另一个 basic_string 下标 pos2 开始的 count2 个字符比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::compare(size_type pos1, size_type count1, const basic_string& other,
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::compare(size_type pos1, size_type count1, const basic_string& other,
                                                 size_type pos2, size_type count2) const {
     auto n1 = MySTL::min(count1, size_ - pos1);
     auto n2 = MySTL::min(count2, other.size_ - pos2);
@@ -838,39 +899,40 @@ int basic_string<CharType, CharTraits>::compare(size_type pos1, size_type count1
 }
 
 // 跟一个字符串比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::compare(const_pointer s) const {
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::compare(const_pointer s) const {
     auto n = char_traits::length(s);
     return compare_cstr(buffer_, size_, s, n);
 }
 
 // 从下标 pos 开始的 count 个字符跟另一个字符串比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::compare(size_type pos, size_type count, const_pointer s) const {
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::compare(size_type pos, size_type count, const_pointer s) const {
     auto n1 = MySTL::min(count, size_ - pos);
     auto n2 = char_traits::length(s);
     return compare_cstr(buffer_ + pos, n1, s, n2);
 }
 
 // 从下标 pos1 开始的 count1 个字符跟另一个字符串的前 count2 个字符比较
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::compare(size_type pos1, size_type count1, const_pointer s, size_type count2) const {
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::compare(size_type pos1, size_type count1, const_pointer s, size_type count2) const {
     auto n1 = MySTL::min(count1, size_ - pos1);
     return compare_cstr(buffer_ + pos1, n1, s, count2);
 }
 
 // 反转 basic_string
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::reverse() noexcept {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::reverse() noexcept {
     for (auto i = begin(), j = end(); i < j;)
         MySTL::iter_swap(i++, --j);
 }
 
 // 交换两个 basic_string
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::
     swap(basic_string& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
         MySTL::swap(buffer_, rhs.buffer_);
         MySTL::swap(size_, rhs.size_);
         MySTL::swap(cap_, rhs.cap_);
@@ -878,9 +940,9 @@ void basic_string<CharType, CharTraits>::
 }
 
 // 从下标 pos 开始查找字符为 ch 的元素，若找到返回其下标，否则返回 npos
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find(value_type ch, size_type pos) const noexcept {
     for (auto i = pos; i < size_; ++i)
         if (*(buffer_ + i) == ch)
             return i;
@@ -888,9 +950,9 @@ basic_string<CharType, CharTraits>::find(value_type ch, size_type pos) const noe
 }
 
 // 从下标 pos 开始查找字符串 str，若找到返回起始位置的下标，否则返回 npos
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find(const_pointer str, size_type pos) const noexcept {
     const auto len = char_traits::length(str);
     if (len == 0) return pos;
     if (size_ - pos < len) return npos;
@@ -910,9 +972,9 @@ basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos) const
 }
 
 // 从下标 pos 开始查找字符串 str 的前 count 个字符，若找到返回起始位置的下标，否则返回 npos
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos, size_type count) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find(const_pointer str, size_type pos, size_type count) const noexcept {
     if (count == 0) return pos;
     if (size_ - pos < count) return npos;
 
@@ -931,9 +993,9 @@ basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos, size_
 }
 
 // 从下标 pos 开始查找字符串 str，若找到返回起始位置的下标，否则返回 npos
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find(const basic_string& str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find(const basic_string& str, size_type pos) const noexcept {
     const size_type count = str.size_;
     if (count == 0) return pos;
     if (size_ - pos < count) return npos;
@@ -953,9 +1015,9 @@ basic_string<CharType, CharTraits>::find(const basic_string& str, size_type pos)
 }
 
 // 从下标 pos 开始反向查找值为 ch 的元素，与 find 类似
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::rfind(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::rfind(value_type ch, size_type pos) const noexcept {
     if (pos >= size_) pos = size_ - 1;
     for (auto i = pos; i != 0; --i)
         if (*(buffer_ + i) == ch) return i;
@@ -963,9 +1025,9 @@ basic_string<CharType, CharTraits>::rfind(value_type ch, size_type pos) const no
 }
 
 // 从下标 pos 开始反向查找字符串 str，与 find 类似
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::rfind(const_pointer str, size_type pos) const noexcept {
     if (pos >= size_) pos = size_ - 1;
     const size_type len = char_traits::length(str);
     switch (len) {
@@ -996,9 +1058,9 @@ basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos) cons
 }
 
 // 从下标 pos 开始反向查找字符串 str 前 count 个字符，与 find 类似
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos, size_type count) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::rfind(const_pointer str, size_type pos, size_type count) const noexcept {
     if (count == 0) return pos;
     if (pos >= size_) pos = size_ - 1;
     if (pos < count - 1) return npos;
@@ -1017,9 +1079,9 @@ basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos, size
 }
 
 // 从下标 pos 开始反向查找字符串 str，与 find 类似
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::rfind(const basic_string& str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::rfind(const basic_string& str, size_type pos) const noexcept {
     const size_type count = str.size_;
     if (count == 0) return pos;
     if (pos >= size_) pos = size_ - 1;
@@ -1040,18 +1102,18 @@ basic_string<CharType, CharTraits>::rfind(const basic_string& str, size_type pos
 
 // find_first_of
 // 从下标 pos 开始查找 ch 出现的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_of(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_of(value_type ch, size_type pos) const noexcept {
     for (auto i = pos; i < size_; ++i)
         if (*(buffer_ + i) == ch) return i;
     return npos;
 }
 
 // 从下标 pos 开始查找字符串 s 其中的一个字符出现的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_of(const_pointer str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     for (auto i = pos; i < size_; ++i) {
         value_type ch = *(buffer_ + i);
@@ -1063,9 +1125,9 @@ basic_string<CharType, CharTraits>::find_first_of(const_pointer str, size_type p
 }
 
 // 从下标 pos 开始查找字符串 s
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_of(const_pointer str, size_type pos, size_type count) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = pos; i < size_; ++i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < count; ++j) {
@@ -1076,9 +1138,9 @@ basic_string<CharType, CharTraits>::find_first_of(const_pointer str, size_type p
 }
 
 // 从下标 pos 开始查找字符串 str 其中一个字符出现的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_of(const basic_string& str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = pos; i < size_; ++i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < str.size_; ++j) {
@@ -1090,9 +1152,9 @@ basic_string<CharType, CharTraits>::find_first_of(const basic_string& str, size_
 
 // find_first_not_of
 // 从下标 pos 开始查找与 ch 不相等的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_not_of(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_not_of(value_type ch, size_type pos) const noexcept {
     for (auto i = pos; i < size_; ++i) {
         if (*(buffer_ + i) != ch) return i;
     }
@@ -1100,9 +1162,9 @@ basic_string<CharType, CharTraits>::find_first_not_of(value_type ch, size_type p
 }
 
 // 从下标 pos 开始查找与字符串 s 其中一个字符不相等的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_not_of(const_pointer str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_not_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     for (auto i = pos; i < size_; ++i) {
         value_type ch = *(buffer_ + i);
@@ -1114,9 +1176,9 @@ basic_string<CharType, CharTraits>::find_first_not_of(const_pointer str, size_ty
 }
 
 // 从下标 pos 开始查找与字符串 s 前 count 个字符中不相等的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_not_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = pos; i < size_; ++i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < count; ++j) {
@@ -1127,9 +1189,9 @@ basic_string<CharType, CharTraits>::find_first_not_of(const_pointer str, size_ty
 }
 
 // 从下标 pos 开始查找与字符串 str 的字符中不相等的第一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_first_not_of(const basic_string& str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_first_not_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = pos; i < size_; ++i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < str.size_; ++j) {
@@ -1141,9 +1203,9 @@ basic_string<CharType, CharTraits>::find_first_not_of(const basic_string& str, s
 
 // find_last_of
 // 从下标 pos 开始查找与 ch 相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_of(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_of(value_type ch, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         if (*(buffer_ + i) == ch) return i;
     }
@@ -1151,9 +1213,9 @@ basic_string<CharType, CharTraits>::find_last_of(value_type ch, size_type pos) c
 }
 
 // 从下标 pos 开始查找与字符串 s 其中一个字符相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_of(const_pointer str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
@@ -1165,9 +1227,9 @@ basic_string<CharType, CharTraits>::find_last_of(const_pointer str, size_type po
 }
 
 // 从下标 pos 开始查找与字符串 s 前 count 个字符中相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_of(const_pointer str, size_type pos, size_type count) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < count; ++j) {
@@ -1178,9 +1240,9 @@ basic_string<CharType, CharTraits>::find_last_of(const_pointer str, size_type po
 }
 
 // 从下标 pos 开始查找与字符串 str 字符中相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_of(const basic_string& str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < str.size_; ++j) {
@@ -1192,9 +1254,9 @@ basic_string<CharType, CharTraits>::find_last_of(const basic_string& str, size_t
 
 // find_last_not_of
 // 从下标 pos 开始查找与 ch 字符不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_not_of(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_not_of(value_type ch, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         if (*(buffer_ + i) != ch) return i;
     }
@@ -1202,9 +1264,9 @@ basic_string<CharType, CharTraits>::find_last_not_of(value_type ch, size_type po
 }
 
 // 从下标 pos 开始查找与字符串 s 的字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_not_of(const_pointer str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_not_of(const_pointer str, size_type pos) const noexcept {
     const size_type len = char_traits::length(str);
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
@@ -1216,9 +1278,9 @@ basic_string<CharType, CharTraits>::find_last_not_of(const_pointer str, size_typ
 }
 
 // 从下标 pos 开始查找与字符串 s 前 count 个字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_not_of(const_pointer str, size_type pos, size_type count) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < count; ++j) {
@@ -1229,9 +1291,9 @@ basic_string<CharType, CharTraits>::find_last_not_of(const_pointer str, size_typ
 }
 
 // 从下标 pos 开始查找与字符串 str 字符中不相等的最后一个位置
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::find_last_not_of(const basic_string& str, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::find_last_not_of(const basic_string& str, size_type pos) const noexcept {
     for (auto i = size_ - 1; i >= pos; --i) {
         value_type ch = *(buffer_ + i);
         for (size_type j = 0; j < str.size_; ++j) {
@@ -1242,9 +1304,9 @@ basic_string<CharType, CharTraits>::find_last_not_of(const basic_string& str, si
 }
 
 // 返回从下标 pos 开始字符为 ch 的元素出现的次数
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::size_type
-basic_string<CharType, CharTraits>::count(value_type ch, size_type pos) const noexcept {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::size_type
+basic_string<CharType, CharTraits, Alloc>::count(value_type ch, size_type pos) const noexcept {
     size_type n = 0;
     for (auto i = pos; i < size_; ++i) {
         if (*(buffer_ + i) == ch) ++n;
@@ -1256,12 +1318,12 @@ basic_string<CharType, CharTraits>::count(value_type ch, size_type pos) const no
 // helper function
 
 // 尝试初始化一段 buffer，若分配失败则忽略，不会抛出异常
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::try_init() noexcept {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::try_init() noexcept {
     try {
-        buffer_ = data_allocator::allocate(static_cast<size_type>(STRING_INIT_SIZE));
+        buffer_ = alloc_traits::allocate(this->get_alloc(), static_cast<size_type>(STRING_INIT_SIZE));
         size_ = 0;
-        cap_ = 0;
+        cap_ = static_cast<size_type>(STRING_INIT_SIZE);
     } catch (...) {
         buffer_ = nullptr;
         size_ = 0;
@@ -1270,24 +1332,24 @@ void basic_string<CharType, CharTraits>::try_init() noexcept {
 }
 
 // fill_init 函数
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::fill_init(size_type n, value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::fill_init(size_type n, value_type ch) {
     const auto init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-    buffer_ = data_allocator::allocate(init_size);
+    buffer_ = alloc_traits::allocate(this->get_alloc(), init_size);
     char_traits::fill(buffer_, ch, n);
     size_ = n;
     cap_ = init_size;
 }
 
 // copy_init 函数
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc>
 template <class Iter>
-void basic_string<CharType, CharTraits>::copy_init(Iter first, Iter last, MySTL::input_iterator_tag) {
+void basic_string<CharType, CharTraits, Alloc>::copy_init(Iter first, Iter last, MySTL::input_iterator_tag) {
     size_type n = MySTL::distance(first, last);
     const auto init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
 
     try {
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = alloc_traits::allocate(this->get_alloc(), init_size);
         size_ = n;
         cap_ = init_size;
     } catch (...) {
@@ -1300,14 +1362,14 @@ void basic_string<CharType, CharTraits>::copy_init(Iter first, Iter last, MySTL:
         append(*first);
 }
 
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc>
 template <class Iter>
-void basic_string<CharType, CharTraits>::copy_init(Iter first, Iter last, MySTL::forward_iterator_tag) {
+void basic_string<CharType, CharTraits, Alloc>::copy_init(Iter first, Iter last, MySTL::forward_iterator_tag) {
     const size_type n = MySTL::distance(first, last);
     const auto init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
 
     try {
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = alloc_traits::allocate(this->get_alloc(), init_size);
         size_ = n;
         cap_ = init_size;
         MySTL::uninitialized_copy(first, last, buffer_);
@@ -1320,20 +1382,21 @@ void basic_string<CharType, CharTraits>::copy_init(Iter first, Iter last, MySTL:
 }
 
 // init_from 函数
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::init_from(const_pointer src, size_type pos, size_type n) {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::init_from(const_pointer src, size_type pos, size_type n) {
     const size_type init_size = MySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-    buffer_ = data_allocator::allocate(init_size);
-    char_traits::copy(buffer_, src + pos, n);
+    buffer_ = alloc_traits::allocate(this->get_alloc(), init_size);
+    if (n != 0)  // 被移动过的字符串 buffer_ 为空
+        char_traits::copy(buffer_, src + pos, n);
     size_ = n;
     cap_ = init_size;
 }
 
 // destroy_buffer 函数
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::destroy_buffer() {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::destroy_buffer() {
     if (buffer_ != nullptr) {
-        data_allocator::deallocate(buffer_, cap_);
+        alloc_traits::deallocate(this->get_alloc(), buffer_, cap_);
         buffer_ = nullptr;
         size_ = 0;
         cap_ = 0;
@@ -1341,32 +1404,35 @@ void basic_string<CharType, CharTraits>::destroy_buffer() {
 }
 
 // to_raw_pointer 函数
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::const_pointer
-basic_string<CharType, CharTraits>::to_raw_pointer() const {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::const_pointer
+basic_string<CharType, CharTraits, Alloc>::to_raw_pointer() const {
     *(buffer_ + size_) = value_type();
     return buffer_;
 }
 
 // reinsert 函数
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::reinsert(size_type size) {
-    auto new_buffer = data_allocator::allocate(size);
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::reinsert(size_type size) {
+    auto new_buffer = alloc_traits::allocate(this->get_alloc(), size);
     try {
         char_traits::move(new_buffer, buffer_, size);
     } catch (...) {
-        data_allocator::deallocate(new_buffer);
+        alloc_traits::deallocate(this->get_alloc(), new_buffer, size);
+        throw;
     }
+    if (buffer_ != nullptr)
+        alloc_traits::deallocate(this->get_alloc(), buffer_, cap_);
     buffer_ = new_buffer;
     size_ = size;
     cap_ = size;
 }
 
 // append_range，末尾追加一段 [first, last) 内的字符
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc>
 template <class Iter>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::append_range(Iter first, Iter last) {
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::append_range(Iter first, Iter last) {
     const size_type len = MySTL::distance(first, last);
     THROW_LENGTH_ERROR_IF(size_ > max_size() - len,
                           "basic_string<Char, Tratis>'s size too big");
@@ -1378,8 +1444,8 @@ basic_string<CharType, CharTraits>::append_range(Iter first, Iter last) {
 }
 
 // compare_cstr函数
-template <class CharType, class CharTraits>
-int basic_string<CharType, CharTraits>::
+template <class CharType, class CharTraits, class Alloc>
+int basic_string<CharType, CharTraits, Alloc>::
     compare_cstr(const_pointer s1, size_type n1, const_pointer s2, size_type n2) const {
     auto rlen = MySTL::min(n1, n2);
     auto res = char_traits::compare(s1, s2, rlen);
@@ -1391,9 +1457,9 @@ int basic_string<CharType, CharTraits>::
 
 // replace相关
 // 把 first 开始的 count1 个字符替换成 str 开始的 count2 个字符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::replace_cstr(const_iterator first, size_type count1,
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::replace_cstr(const_iterator first, size_type count1,
                                                  const_pointer str, size_type count2) {
     if (static_cast<size_type>(cend() - first) < count1) {
         count1 = cend() - first;
@@ -1419,9 +1485,9 @@ basic_string<CharType, CharTraits>::replace_cstr(const_iterator first, size_type
 }
 
 // 把 first 开始的 count1 个字符替换成 count2 个 ch 字符
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::replace_fill(const_iterator first, size_type count1,
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::replace_fill(const_iterator first, size_type count1,
                                                  size_type count2, value_type ch) {
     if (static_cast<size_type>(cend() - first) < count1) {
         count1 = cend() - first;
@@ -1446,10 +1512,10 @@ basic_string<CharType, CharTraits>::replace_fill(const_iterator first, size_type
 }
 
 // 把 [first, last) 的字符替换成 [first2, last2)
-template <class CharType, class CharTraits>
+template <class CharType, class CharTraits, class Alloc>
 template <class Iter>
-basic_string<CharType, CharTraits>&
-basic_string<CharType, CharTraits>::replace_copy(const_iterator first1, const_iterator last1,
+basic_string<CharType, CharTraits, Alloc>&
+basic_string<CharType, CharTraits, Alloc>::replace_copy(const_iterator first1, const_iterator last1,
                                                  Iter first2, Iter last2) {
     size_type len1 = last1 - first1;
     size_type len2 = last2 - first2;
@@ -1473,30 +1539,31 @@ basic_string<CharType, CharTraits>::replace_copy(const_iterator first1, const_it
 }
 
 // reallocate 函数
-template <class CharType, class CharTraits>
-void basic_string<CharType, CharTraits>::reallocate(size_type need_size) {
+template <class CharType, class CharTraits, class Alloc>
+void basic_string<CharType, CharTraits, Alloc>::reallocate(size_type need_size) {
     const auto new_cap = MySTL::max(cap_ + need_size, cap_ + (cap_ >> 1));
-    auto new_buffer = data_allocator::allocate(new_cap);
+    auto new_buffer = alloc_traits::allocate(this->get_alloc(), new_cap);
     char_traits::move(new_buffer, buffer_, size_);
-    data_allocator::deallocate(buffer_);
+    if (buffer_ != nullptr)
+        alloc_traits::deallocate(this->get_alloc(), buffer_, cap_);
     buffer_ = new_buffer;
     cap_ = new_cap;
 }
 
 // reallocate_and_fill 函数
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::reallocate_and_fill(iterator pos, size_type n, value_type ch) {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::reallocate_and_fill(iterator pos, size_type n, value_type ch) {
     const auto r = pos - buffer_;
     const auto old_cap = cap_;
     const auto new_cap = MySTL::max(old_cap + n, old_cap + (old_cap >> 1));
 
-    auto new_buffer = data_allocator::allocate(new_cap);
+    auto new_buffer = alloc_traits::allocate(this->get_alloc(), new_cap);
     auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
     auto e2 = char_traits::fill(e1, ch, n) + n;
 
     char_traits::move(e2, buffer_ + r, size_ - r);
-    data_allocator::deallocate(buffer_, old_cap);
+    alloc_traits::deallocate(this->get_alloc(), buffer_, old_cap);
     buffer_ = new_buffer;
     size_ += n;
     cap_ = new_cap;
@@ -1504,20 +1571,20 @@ basic_string<CharType, CharTraits>::reallocate_and_fill(iterator pos, size_type
 }
 
 // reallocate_and_copy 函数
-template <class CharType, class CharTraits>
-typename basic_string<CharType, CharTraits>::iterator
-basic_string<CharType, CharTraits>::reallocate_and_copy(iterator pos, const_iterator first, const_iterator last) {
+template <class CharType, class CharTraits, class Alloc>
+typename basic_string<CharType, CharTraits, Alloc>::iterator
+basic_string<CharType, CharTraits, Alloc>::reallocate_and_copy(iterator pos, const_iterator first, const_iterator last) {
     const auto r = pos - buffer_;
     const auto old_cap = cap_;
     const size_type n = MySTL::distance(first, last);
     const auto new_cap = MySTL::max(old_cap + n, old_cap + (old_cap >> 1));
 
-    auto new_buffer = data_allocator::allocate(new_cap);
+    auto new_buffer = alloc_traits::allocate(this->get_alloc(), new_cap);
     auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
     auto e2 = MySTL::uninitialized_copy_n(first, n, e1) + n;
 
     char_traits::move(e2, buffer_ + r, size_ - r);
-    data_allocator::deallocate(buffer_, old_cap);
+    alloc_traits::deallocate(this->get_alloc(), buffer_, old_cap);
     buffer_ = new_buffer;
     size_ += n;
     cap_ = new_cap;
@@ -1527,159 +1594,163 @@ basic_string<CharType, CharTraits>::reallocate_and_copy(iterator pos, const_iter
 /*****************************************************************************************/
 // 重载全局操作符
 // 重载 operator+
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(const basic_string<CharType, CharTraits, Alloc>& lhs,
+          const basic_string<CharType, CharTraits, Alloc>& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(lhs);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
 operator+(const CharType* lhs,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+          const basic_string<CharType, CharTraits, Alloc>& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(lhs);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(CharType ch, const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(1, ch);
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(CharType ch, const basic_string<CharType, CharTraits, Alloc>& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(1, ch);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs, const CharType* rhs) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(const basic_string<CharType, CharTraits, Alloc>& lhs, const CharType* rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(lhs);
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs, CharType ch) {
-    basic_string<CharType, CharTraits> tmp(lhs);
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(const basic_string<CharType, CharTraits, Alloc>& lhs, CharType ch) {
+    basic_string<CharType, CharTraits, Alloc> tmp(lhs);
     tmp.append(1, ch);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs,
-          const basic_string<CharType, CharTraits>& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(basic_string<CharType, CharTraits, Alloc>&& lhs,
+          const basic_string<CharType, CharTraits, Alloc>& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(lhs));
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const basic_string<CharType, CharTraits>& lhs,
-          basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(rhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(const basic_string<CharType, CharTraits, Alloc>& lhs,
+          basic_string<CharType, CharTraits, Alloc>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(rhs));
     tmp.insert(tmp.begin(), lhs.begin(), lhs.end());
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs,
-          basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(basic_string<CharType, CharTraits, Alloc>&& lhs,
+          basic_string<CharType, CharTraits, Alloc>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(lhs));
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(const CharType* lhs, basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(rhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(const CharType* lhs, basic_string<CharType, CharTraits, Alloc>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(rhs));
     tmp.insert(tmp.begin(), lhs, lhs + char_traits<CharType>::length(lhs));
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(CharType ch, basic_string<CharType, CharTraits>&& rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(rhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(CharType ch, basic_string<CharType, CharTraits, Alloc>&& rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(rhs));
     tmp.insert(tmp.begin(), ch);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs, const CharType* rhs) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(basic_string<CharType, CharTraits, Alloc>&& lhs, const CharType* rhs) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(lhs));
     tmp.append(rhs);
     return tmp;
 }
 
-template <class CharType, class CharTraits>
-basic_string<CharType, CharTraits>
-operator+(basic_string<CharType, CharTraits>&& lhs, CharType ch) {
-    basic_string<CharType, CharTraits> tmp(MySTL::move(lhs));
+template <class CharType, class CharTraits, class Alloc>
+basic_string<CharType, CharTraits, Alloc>
+operator+(basic_string<CharType, CharTraits, Alloc>&& lhs, CharType ch) {
+    basic_string<CharType, CharTraits, Alloc> tmp(MySTL::move(lhs));
     tmp.append(1, ch);
     return tmp;
 }
 
 // 重载比较操作符
-template <class CharType, class CharTraits>
-bool operator==(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+bool operator==(const basic_string<CharType, CharTraits, Alloc>& lhs,
+                const basic_string<CharType, CharTraits, Alloc>& rhs) {
     return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator!=(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+bool operator!=(const basic_string<CharType, CharTraits, Alloc>& lhs,
+                const basic_string<CharType, CharTraits, Alloc>& rhs) {
     return lhs.size() != rhs.size() || lhs.compare(rhs) != 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator<(const basic_string<CharType, CharTraits>& lhs,
-               const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+bool operator<(const basic_string<CharType, CharTraits, Alloc>& lhs,
+               const basic_string<CharType, CharTraits, Alloc>& rhs) {
     return lhs.compare(rhs) < 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator<=(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+bool operator<=(const basic_string<CharType, CharTraits, Alloc>& lhs,
+                const basic_string<CharType, CharTraits, Alloc>& rhs) {
     return lhs.compare(rhs) <= 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator>(const basic_string<CharType, CharTraits>& lhs,
-               const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+bool operator>(const basic_string<CharType, CharTraits, Alloc>& lhs,
+               const basic_string<CharType, CharTraits, Alloc>& rhs) {
     return lhs.compare(rhs) > 0;
 }
 
-template <class CharType, class CharTraits>
-bool operator>=(const basic_string<CharType, CharTraits>& lhs,
-                const basic_string<CharType, CharTraits>& rhs) {
+template <class CharType, class CharTraits, class Alloc>
+bool operator>=(const basic_string<CharType, CharTraits, Alloc>& lhs,
+                const basic_string<CharType, CharTraits, Alloc>& rhs) {
     return lhs.compare(rhs) >= 0;
 }
 
 // 重载 MySTL 的 swap
-template <class CharType, class CharTraits>
-void swap(basic_string<CharType, CharTraits>& lhs,
-          basic_string<CharType, CharTraits>& rhs) noexcept {
+template <class CharType, class CharTraits, class Alloc>
+void swap(basic_string<CharType, CharTraits, Alloc>& lhs,
+          basic_string<CharType, CharTraits, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 // 特化 MySTL::hash
-template <class CharType, class CharTraits>
-struct hash<basic_string<CharType, CharTraits>> {
-    size_t operator()(const basic_string<CharType, CharTraits>& str) {
+template <class CharType, class CharTraits, class Alloc>
+struct hash<basic_string<CharType, CharTraits, Alloc>> {
+    size_t operator()(const basic_string<CharType, CharTraits, Alloc>& str) {
         return bitwise_hash((const unsigned char*)str.c_str(),
                             str.size() * sizeof(CharType));
     }
 };
 
+// basic_string 只保存指向缓冲区的指针、大小与容量
+template <class CharType, class CharTraits, class Alloc>
+struct is_trivially_relocatable<basic_string<CharType, CharTraits, Alloc>> : is_trivially_relocatable<Alloc> {};
+
 }  // namespace MySTL
 #endif
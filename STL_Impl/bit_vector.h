@@ -0,0 +1,793 @@
+#ifndef _MYSTL_BIT_VECTOR_H_
+#define _MYSTL_BIT_VECTOR_H_
+
+// 这个头文件包含一个按位存储布尔值的容器 bit_vector，以及它的迭代器与代理引用
+
+// notes:
+//
+// MySTL::vector<bool> 被禁用，需要按位压缩的布尔数组时使用 bit_vector，每个元素只占一个比特
+// 元素保存在 64 位的字中，第 i 个元素是第 i / 64 个字的第 i % 64 位
+// operator[] 与迭代器解引用返回代理对象 bit_reference，不能取得元素的地址
+// count、find、fill 对 bit_vector 的迭代器有按字处理的重载，一次处理 64 个元素；
+// 成员函数 count、find_first、find_next、fill、flip 同样按字处理
+// 最后一个字中超出 size() 的位没有意义，所有按字处理的操作都会把它们屏蔽掉
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace MySTL {
+
+typedef uint64_t bit_word;
+
+enum { bit_word_bits = 64 };
+
+/*****************************************************************************************/
+// 按字处理的辅助函数
+/*****************************************************************************************/
+
+// 低 n 位为 1 的掩码，n 不超过 64
+inline bit_word bit_low_mask(size_t n) noexcept {
+    return n >= bit_word_bits ? ~static_cast<bit_word>(0) : (static_cast<bit_word>(1) << n) - 1;
+}
+
+inline size_t bit_popcount(bit_word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(w));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<size_t>(__popcnt64(w));
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<size_t>((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// 最低的 1 所在的位置，w 不能为 0
+inline size_t bit_ctz(bit_word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(w));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, w);
+    return static_cast<size_t>(index);
+#else
+    size_t n = 0;
+    while ((w & 1) == 0) {
+        w >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// 统计从 p 的第 off 位开始的 n 个位中值为 1 的个数
+inline size_t bit_count_range(const bit_word* p, size_t off, size_t n) noexcept {
+    size_t result = 0;
+    if (off != 0 && n != 0) {
+        const size_t take = MySTL::min(static_cast<size_t>(bit_word_bits) - off, n);
+        result += bit_popcount((*p >> off) & bit_low_mask(take));
+        n -= take;
+        ++p;
+    }
+    for (; n >= bit_word_bits; n -= bit_word_bits)
+        result += bit_popcount(*p++);
+    if (n != 0)
+        result += bit_popcount(*p & bit_low_mask(n));
+    return result;
+}
+
+// 在从 p 的第 off 位开始的 n 个位中找到第一个等于 value 的位，返回它相对于起点的位置，找不到时返回 n
+inline size_t bit_find_range(const bit_word* p, size_t off, size_t n, bool value) noexcept {
+    const bit_word flip = value ? 0 : ~static_cast<bit_word>(0);
+    size_t index = 0;
+    if (off != 0 && n != 0) {
+        const size_t take = MySTL::min(static_cast<size_t>(bit_word_bits) - off, n);
+        const bit_word w = ((*p ^ flip) >> off) & bit_low_mask(take);
+        if (w != 0) return bit_ctz(w);
+        index = take;
+        ++p;
+    }
+    for (; index + bit_word_bits <= n; index += bit_word_bits, ++p) {
+        const bit_word w = *p ^ flip;
+        if (w != 0) return index + bit_ctz(w);
+    }
+    if (index < n) {
+        const bit_word w = (*p ^ flip) & bit_low_mask(n - index);
+        if (w != 0) return index + bit_ctz(w);
+    }
+    return n;
+}
+
+// 把从 p 的第 off 位开始的 n 个位设为 value，整字部分交给 memset
+inline void bit_fill_range(bit_word* p, size_t off, size_t n, bool value) noexcept {
+    if (off != 0 && n != 0) {
+        const size_t take = MySTL::min(static_cast<size_t>(bit_word_bits) - off, n);
+        const bit_word mask = bit_low_mask(take) << off;
+        *p = value ? (*p | mask) : (*p & ~mask);
+        n -= take;
+        ++p;
+    }
+    const size_t words = n / bit_word_bits;
+    if (words != 0) {
+        std::memset(static_cast<void*>(p), value ? 0xff : 0, words * sizeof(bit_word));
+        p += words;
+    }
+    n %= bit_word_bits;
+    if (n != 0) {
+        const bit_word mask = bit_low_mask(n);
+        *p = value ? (*p | mask) : (*p & ~mask);
+    }
+}
+
+/*****************************************************************************************/
+// bit_reference
+// 代理引用，指向某个字中的一位
+/*****************************************************************************************/
+struct bit_reference {
+    bit_word* p_;
+    bit_word mask_;
+
+    bit_reference(bit_word* p, bit_word mask) noexcept : p_(p), mask_(mask) {}
+
+    operator bool() const noexcept { return (*p_ & mask_) != 0; }
+
+    bit_reference& operator=(bool value) noexcept {
+        if (value)
+            *p_ |= mask_;
+        else
+            *p_ &= ~mask_;
+        return *this;
+    }
+
+    bit_reference& operator=(const bit_reference& rhs) noexcept { return *this = static_cast<bool>(rhs); }
+
+    bool operator==(const bit_reference& rhs) const noexcept { return static_cast<bool>(*this) == static_cast<bool>(rhs); }
+    bool operator<(const bit_reference& rhs) const noexcept { return !static_cast<bool>(*this) && static_cast<bool>(rhs); }
+
+    void flip() noexcept { *p_ ^= mask_; }
+};
+
+inline void swap(bit_reference lhs, bit_reference rhs) noexcept {
+    const bool tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+}
+
+/*****************************************************************************************/
+// bit_iterator / bit_const_iterator
+// 随机访问迭代器，由字指针与字内的位偏移组成
+/*****************************************************************************************/
+struct bit_iterator_base : public MySTL::iterator<MySTL::random_access_iterator_tag, bool> {
+    bit_word* p_;
+    unsigned offset_;
+
+    bit_iterator_base(bit_word* p, unsigned offset) noexcept : p_(p), offset_(offset) {}
+
+    void bump_up() noexcept {
+        if (offset_++ == bit_word_bits - 1) {
+            offset_ = 0;
+            ++p_;
+        }
+    }
+
+    void bump_down() noexcept {
+        if (offset_-- == 0) {
+            offset_ = bit_word_bits - 1;
+            --p_;
+        }
+    }
+
+    void incr(ptrdiff_t i) noexcept {
+        ptrdiff_t n = i + static_cast<ptrdiff_t>(offset_);
+        p_ += n / bit_word_bits;
+        n = n % bit_word_bits;
+        if (n < 0) {
+            n += bit_word_bits;
+            --p_;
+        }
+        offset_ = static_cast<unsigned>(n);
+    }
+
+    bool operator==(const bit_iterator_base& rhs) const noexcept { return p_ == rhs.p_ && offset_ == rhs.offset_; }
+    bool operator!=(const bit_iterator_base& rhs) const noexcept { return !(*this == rhs); }
+    bool operator<(const bit_iterator_base& rhs) const noexcept {
+        return p_ < rhs.p_ || (p_ == rhs.p_ && offset_ < rhs.offset_);
+    }
+    bool operator>(const bit_iterator_base& rhs) const noexcept { return rhs < *this; }
+    bool operator<=(const bit_iterator_base& rhs) const noexcept { return !(rhs < *this); }
+    bool operator>=(const bit_iterator_base& rhs) const noexcept { return !(*this < rhs); }
+};
+
+inline ptrdiff_t operator-(const bit_iterator_base& lhs, const bit_iterator_base& rhs) noexcept {
+    return bit_word_bits * (lhs.p_ - rhs.p_) + static_cast<ptrdiff_t>(lhs.offset_) - static_cast<ptrdiff_t>(rhs.offset_);
+}
+
+struct bit_iterator : public bit_iterator_base {
+    typedef bit_reference reference;
+    typedef bit_reference* pointer;
+    typedef bit_iterator self;
+
+    bit_iterator() noexcept : bit_iterator_base(nullptr, 0) {}
+    bit_iterator(bit_word* p, unsigned offset) noexcept : bit_iterator_base(p, offset) {}
+
+    reference operator*() const noexcept { return reference(p_, static_cast<bit_word>(1) << offset_); }
+    reference operator[](ptrdiff_t i) const noexcept { return *(*this + i); }
+
+    self& operator++() noexcept {
+        bump_up();
+        return *this;
+    }
+    self operator++(int) noexcept {
+        self tmp = *this;
+        bump_up();
+        return tmp;
+    }
+    self& operator--() noexcept {
+        bump_down();
+        return *this;
+    }
+    self operator--(int) noexcept {
+        self tmp = *this;
+        bump_down();
+        return tmp;
+    }
+
+    self& operator+=(ptrdiff_t i) noexcept {
+        incr(i);
+        return *this;
+    }
+    self& operator-=(ptrdiff_t i) noexcept {
+        incr(-i);
+        return *this;
+    }
+    self operator+(ptrdiff_t i) const noexcept {
+        self tmp = *this;
+        return tmp += i;
+    }
+    self operator-(ptrdiff_t i) const noexcept {
+        self tmp = *this;
+        return tmp -= i;
+    }
+};
+
+inline bit_iterator operator+(ptrdiff_t n, const bit_iterator& x) noexcept { return x + n; }
+
+struct bit_const_iterator : public bit_iterator_base {
+    typedef bool reference;
+    typedef bool const_reference;
+    typedef const bool* pointer;
+    typedef bit_const_iterator self;
+
+    bit_const_iterator() noexcept : bit_iterator_base(nullptr, 0) {}
+    bit_const_iterator(bit_word* p, unsigned offset) noexcept : bit_iterator_base(p, offset) {}
+    bit_const_iterator(const bit_iterator& x) noexcept : bit_iterator_base(x.p_, x.offset_) {}
+
+    const_reference operator*() const noexcept { return (*p_ & (static_cast<bit_word>(1) << offset_)) != 0; }
+    const_reference operator[](ptrdiff_t i) const noexcept { return *(*this + i); }
+
+    self& operator++() noexcept {
+        bump_up();
+        return *this;
+    }
+    self operator++(int) noexcept {
+        self tmp = *this;
+        bump_up();
+        return tmp;
+    }
+    self& operator--() noexcept {
+        bump_down();
+        return *this;
+    }
+    self operator--(int) noexcept {
+        self tmp = *this;
+        bump_down();
+        return tmp;
+    }
+
+    self& operator+=(ptrdiff_t i) noexcept {
+        incr(i);
+        return *this;
+    }
+    self& operator-=(ptrdiff_t i) noexcept {
+        incr(-i);
+        return *this;
+    }
+    self operator+(ptrdiff_t i) const noexcept {
+        self tmp = *this;
+        return tmp += i;
+    }
+    self operator-(ptrdiff_t i) const noexcept {
+        self tmp = *this;
+        return tmp -= i;
+    }
+};
+
+inline bit_const_iterator operator+(ptrdiff_t n, const bit_const_iterator& x) noexcept { return x + n; }
+
+/*****************************************************************************************/
+// count / find / fill 对 bit_vector 迭代器的重载，按字处理
+/*****************************************************************************************/
+template <class T>
+size_t count(bit_const_iterator first, bit_const_iterator last, const T& value) {
+    const size_t n = static_cast<size_t>(last - first);
+    const size_t ones = MySTL::bit_count_range(first.p_, first.offset_, n);
+    return static_cast<bool>(value) ? ones : n - ones;
+}
+
+template <class T>
+size_t count(bit_iterator first, bit_iterator last, const T& value) {
+    return MySTL::count(bit_const_iterator(first), bit_const_iterator(last), value);
+}
+
+template <class T>
+bit_const_iterator find(bit_const_iterator first, bit_const_iterator last, const T& value) {
+    return first + static_cast<ptrdiff_t>(MySTL::bit_find_range(first.p_, first.offset_, static_cast<size_t>(last - first),
+                                                                static_cast<bool>(value)));
+}
+
+template <class T>
+bit_iterator find(bit_iterator first, bit_iterator last, const T& value) {
+    return first + static_cast<ptrdiff_t>(MySTL::bit_find_range(first.p_, first.offset_, static_cast<size_t>(last - first),
+                                                                static_cast<bool>(value)));
+}
+
+template <class T>
+void fill(bit_iterator first, bit_iterator last, const T& value) {
+    MySTL::bit_fill_range(first.p_, first.offset_, static_cast<size_t>(last - first), static_cast<bool>(value));
+}
+
+/*****************************************************************************************/
+// bit_vector
+// 接口与 vector 相同，元素按位存储
+// 模板参数 Alloc 代表分配器类型，缺省使用 MySTL::allocator，实际按 bit_word 分配空间
+/*****************************************************************************************/
+template <class Alloc = MySTL::allocator<bool>>
+class bit_vector : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<bit_word>> {
+   public:
+    // bit_vector 的嵌套型别定义
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<bit_word> data_allocator;
+    typedef MySTL::allocator_traits<data_allocator> data_alloc_traits;
+    typedef MySTL::alloc_holder<data_allocator> holder_type;
+
+    typedef bool value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef bit_reference reference;
+    typedef bool const_reference;
+
+    typedef bit_iterator iterator;
+    typedef bit_const_iterator const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    allocator_type get_allocator() const { return allocator_type(this->get_alloc()); }
+
+   private:
+    bit_word* words_;  // 储存空间的起始位置
+    size_type size_;   // 元素个数
+    size_type cap_;    // 容量，总是 bit_word_bits 的倍数
+
+   public:
+    // 构造、复制、移动、析构函数
+    bit_vector() noexcept : words_(nullptr), size_(0), cap_(0) {}
+
+    explicit bit_vector(const allocator_type& alloc) noexcept
+        : holder_type(data_allocator(alloc)), words_(nullptr), size_(0), cap_(0) {}
+
+    explicit bit_vector(size_type n, bool value = false, const allocator_type& alloc = allocator_type())
+        : holder_type(data_allocator(alloc)), words_(nullptr), size_(0), cap_(0) {
+        init_space(n);
+        bit_fill_range(words_, 0, n, value);
+        size_ = n;
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    bit_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(data_allocator(alloc)), words_(nullptr), size_(0), cap_(0) {
+        MYSTL_DEBUG(!(last < first));
+        insert(end(), first, last);
+    }
+
+    bit_vector(std::initializer_list<bool> list, const allocator_type& alloc = allocator_type())
+        : holder_type(data_allocator(alloc)), words_(nullptr), size_(0), cap_(0) {
+        insert(end(), list.begin(), list.end());
+    }
+
+    bit_vector(const bit_vector& rhs)
+        : holder_type(data_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())),
+          words_(nullptr), size_(0), cap_(0) { copy_words(rhs); }
+
+    bit_vector(const bit_vector& rhs, const allocator_type& alloc)
+        : holder_type(data_allocator(alloc)), words_(nullptr), size_(0), cap_(0) { copy_words(rhs); }
+
+    bit_vector(bit_vector&& rhs) noexcept
+        : holder_type(MySTL::move(rhs.get_alloc())), words_(nullptr), size_(0), cap_(0) { take(rhs); }
+
+    bit_vector& operator=(const bit_vector& rhs);
+    bit_vector& operator=(bit_vector&& rhs) noexcept(data_alloc_traits::is_always_equal::value);
+
+    bit_vector& operator=(std::initializer_list<bool> list) {
+        assign(list.begin(), list.end());
+        return *this;
+    }
+
+    ~bit_vector() { release(); }
+
+   public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(words_, 0); }
+    const_iterator begin() const noexcept { return const_iterator(words_, 0); }
+
+    iterator end() noexcept { return begin() + static_cast<difference_type>(size_); }
+    const_iterator end() const noexcept { return begin() + static_cast<difference_type>(size_); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / 2; }
+    size_type capacity() const noexcept { return cap_; }
+
+    void reserve(size_type n);
+    void shrink_to_fit();
+
+    // 访问元素操作
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size_);
+        return reference(words_ + n / bit_word_bits, static_cast<bit_word>(1) << (n % bit_word_bits));
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return (words_[n / bit_word_bits] >> (n % bit_word_bits)) & 1;
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size_), "bit_vector::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size_), "bit_vector::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    // 底层的字，最后一个字中超出 size() 的位没有意义
+    bit_word* data() noexcept { return words_; }
+    const bit_word* data() const noexcept { return words_; }
+
+    // 修改容器相关操作
+    // assign
+    void assign(size_type n, bool value) {
+        clear();
+        insert(end(), n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void assign(std::initializer_list<bool> list) { assign(list.begin(), list.end()); }
+
+    // push_back / pop_back
+    void push_back(bool value) {
+        if (size_ == cap_) reserve(get_new_cap(1));
+        bit_reference(words_ + size_ / bit_word_bits, static_cast<bit_word>(1) << (size_ % bit_word_bits)) = value;
+        ++size_;
+    }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+    }
+
+    // insert
+    iterator insert(const_iterator pos, bool value) { return insert(pos, 1, value); }
+    iterator insert(const_iterator pos, size_type n, bool value);
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return range_insert(static_cast<size_type>(pos - begin()), first, last, iterator_category(first));
+    }
+
+    // erase / clear
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear() noexcept { size_ = 0; }
+
+    // resize
+    void resize(size_type new_size, bool value = false) {
+        if (new_size < size_)
+            size_ = new_size;
+        else
+            insert(end(), new_size - size_, value);
+    }
+
+    // 按字处理的操作
+    // 值为 true 的元素个数
+    size_type count() const noexcept { return bit_count_range(words_, 0, size_); }
+
+    // 第一个值为 true 的元素的下标，不存在时返回 size()
+    size_type find_first() const noexcept { return bit_find_range(words_, 0, size_, true); }
+
+    // pos 之后第一个值为 true 的元素的下标，不存在时返回 size()
+    size_type find_next(size_type pos) const noexcept {
+        if (pos + 1 >= size_) return size_;
+        const size_type start = pos + 1;
+        return start + bit_find_range(words_ + start / bit_word_bits, start % bit_word_bits, size_ - start, true);
+    }
+
+    // 把所有元素设为 value
+    void fill(bool value) noexcept { bit_fill_range(words_, 0, size_, value); }
+
+    // 翻转所有元素或第 n 个元素
+    void flip() noexcept {
+        const size_type words = words_for(size_);
+        for (size_type i = 0; i < words; ++i)
+            words_[i] = ~words_[i];
+    }
+
+    void flip(size_type n) noexcept { (*this)[n].flip(); }
+
+    // swap
+    void swap(bit_vector& rhs) noexcept {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
+        MySTL::swap(words_, rhs.words_);
+        MySTL::swap(size_, rhs.size_);
+        MySTL::swap(cap_, rhs.cap_);
+    }
+
+   private:
+    // helper functions
+    static size_type words_for(size_type n) noexcept { return (n + bit_word_bits - 1) / bit_word_bits; }
+
+    void init_space(size_type n) {
+        const size_type words = words_for(n);
+        words_ = words == 0 ? nullptr : data_alloc_traits::allocate(this->get_alloc(), words);
+        cap_ = words * bit_word_bits;
+    }
+
+    // 复制 rhs 的元素，调用前容器必须为空
+    void copy_words(const bit_vector& rhs) {
+        if (cap_ < rhs.size_)
+            reserve(rhs.size_);
+        if (rhs.size_ != 0)
+            std::memcpy(words_, rhs.words_, words_for(rhs.size_) * sizeof(bit_word));
+        size_ = rhs.size_;
+    }
+
+    // 接管 rhs 的空间，调用前容器必须没有空间
+    void take(bit_vector& rhs) noexcept {
+        words_ = rhs.words_;
+        size_ = rhs.size_;
+        cap_ = rhs.cap_;
+        rhs.words_ = nullptr;
+        rhs.size_ = 0;
+        rhs.cap_ = 0;
+    }
+
+    // 释放空间
+    void release() noexcept {
+        if (words_ != nullptr)
+            data_alloc_traits::deallocate(this->get_alloc(), words_, cap_ / bit_word_bits);
+        words_ = nullptr;
+        size_ = 0;
+        cap_ = 0;
+    }
+
+    size_type get_new_cap(size_type add_size) const {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - add_size, "bit_vector's size is too big!");
+        return MySTL::max(cap_ + cap_ / 2, size_ + add_size);
+    }
+
+    template <class Iter>
+    iterator range_insert(size_type index, Iter first, Iter last, input_iterator_tag) {
+        for (size_type i = index; first != last; ++first, ++i)
+            insert(begin() + static_cast<difference_type>(i), static_cast<bool>(*first));
+        return begin() + static_cast<difference_type>(index);
+    }
+
+    template <class Iter>
+    iterator range_insert(size_type index, Iter first, Iter last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(MySTL::distance(first, last));
+        make_gap(index, n);
+        auto cur = begin() + static_cast<difference_type>(index);
+        for (; first != last; ++first, ++cur)
+            *cur = static_cast<bool>(*first);
+        return begin() + static_cast<difference_type>(index);
+    }
+
+    // 在 index 处腾出 n 个位置，其后的元素整体后移
+    void make_gap(size_type index, size_type n) {
+        if (n == 0) return;
+        if (cap_ - size_ < n) reserve(get_new_cap(n));
+        MySTL::copy_backward(begin() + static_cast<difference_type>(index), end(), end() + static_cast<difference_type>(n));
+        size_ += n;
+    }
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <class Alloc>
+bit_vector<Alloc>& bit_vector<Alloc>::operator=(const bit_vector& rhs) {
+    if (this != &rhs) {
+        clear();
+        if (data_alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的空间必须由原来的分配器释放
+            release();
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        }
+        copy_words(rhs);
+    }
+    return *this;
+}
+
+// 移动赋值运算符
+template <class Alloc>
+bit_vector<Alloc>& bit_vector<Alloc>::operator=(bit_vector&& rhs) noexcept(data_alloc_traits::is_always_equal::value) {
+    if (this != &rhs) {
+        if (data_alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+            release();
+            MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+            take(rhs);
+        } else {
+            // 分配器不相等，不能直接接管对方的空间，只能复制
+            clear();
+            copy_words(rhs);
+            rhs.clear();
+        }
+    }
+    return *this;
+}
+
+// 预留空间，容量按整字计算
+template <class Alloc>
+void bit_vector<Alloc>::reserve(size_type n) {
+    if (cap_ < n) {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in bit_vector::reserve(n)");
+        const size_type words = words_for(n);
+        bit_word* tmp = data_alloc_traits::allocate(this->get_alloc(), words);
+        if (size_ != 0)
+            std::memcpy(tmp, words_, words_for(size_) * sizeof(bit_word));
+        if (words_ != nullptr)
+            data_alloc_traits::deallocate(this->get_alloc(), words_, cap_ / bit_word_bits);
+        words_ = tmp;
+        cap_ = words * bit_word_bits;
+    }
+}
+
+// 放弃多余的容量
+template <class Alloc>
+void bit_vector<Alloc>::shrink_to_fit() {
+    if (words_for(size_) * bit_word_bits < cap_) {
+        bit_vector tmp(*this);
+        swap(tmp);
+    }
+}
+
+// 在 pos 处插入 n 个 value
+template <class Alloc>
+typename bit_vector<Alloc>::iterator
+bit_vector<Alloc>::insert(const_iterator pos, size_type n, bool value) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    const size_type index = static_cast<size_type>(pos - begin());
+    make_gap(index, n);
+    bit_fill_range(words_ + index / bit_word_bits, index % bit_word_bits, n, value);
+    return begin() + static_cast<difference_type>(index);
+}
+
+// 删除 [first, last) 上的元素
+template <class Alloc>
+typename bit_vector<Alloc>::iterator
+bit_vector<Alloc>::erase(const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+    const difference_type index = first - begin();
+    const difference_type n = last - first;
+    MySTL::copy(begin() + (index + n), end(), begin() + index);
+    size_ -= static_cast<size_type>(n);
+    return begin() + index;
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+template <class Alloc>
+bool operator==(const bit_vector<Alloc>& lhs, const bit_vector<Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    const size_t full = lhs.size() / bit_word_bits;
+    if (full != 0 && std::memcmp(lhs.data(), rhs.data(), full * sizeof(bit_word)) != 0) return false;
+    const size_t rest = lhs.size() % bit_word_bits;
+    return rest == 0 || ((lhs.data()[full] ^ rhs.data()[full]) & bit_low_mask(rest)) == 0;
+}
+
+template <class Alloc>
+bool operator!=(const bit_vector<Alloc>& lhs, const bit_vector<Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Alloc>
+bool operator<(const bit_vector<Alloc>& lhs, const bit_vector<Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class Alloc>
+bool operator>(const bit_vector<Alloc>& lhs, const bit_vector<Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Alloc>
+bool operator<=(const bit_vector<Alloc>& lhs, const bit_vector<Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Alloc>
+bool operator>=(const bit_vector<Alloc>& lhs, const bit_vector<Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class Alloc>
+void swap(bit_vector<Alloc>& lhs, bit_vector<Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// bit_vector 只保存指向缓冲区的指针，分配器可以平凡重定位时 bit_vector 也可以
+template <class Alloc>
+struct is_trivially_relocatable<bit_vector<Alloc>> : is_trivially_relocatable<Alloc> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+using bit_vector = MySTL::bit_vector<MySTL::polymorphic_allocator<bool>>;
+
+}  // namespace pmr
+
+}  // namespace MySTL
+#endif
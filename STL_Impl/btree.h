@@ -0,0 +1,1094 @@
+#ifndef _MYSTL_BTREE_H_
+#define _MYSTL_BTREE_H_
+
+// 这个头文件包含一个模板类 btree
+// btree : B 树，btree_map / btree_set 以它作为底层机制
+
+// notes:
+//
+// 每个节点在一块连续空间里保存多个元素，节点大小由 BTREE_NODE_BYTES 决定，缺省 256 字节（4 条 cache line）
+// 查找时每下降一层只访问一个节点，在节点内连续存放的元素上二分查找；
+// rb_tree 每个元素占一个节点、带三个指针和颜色，每下降一层都是一次指针跳转，cache miss 要多得多
+// 元素保存在所有节点中，叶子节点没有子节点指针，内部节点另有 slots + 1 个子节点指针
+// 插入到满的节点时把它分裂成两个，在节点末尾插入时把元素都留在左边，顺序插入得到的叶子几乎是满的
+// 删除后元素少于 slots / 2 的节点与兄弟节点合并，或从兄弟节点借元素
+//
+// 与 rb_tree 不同，元素直接存放在节点中，插入和删除会在节点之间搬移元素：
+//   insert / emplace / erase 之后，所有迭代器、指针和引用都可能失效，erase 返回指向下一个元素的迭代器
+// 元素的搬移使用 uninitialized_relocate 的做法，可平凡重定位的类型直接 memmove
+//
+// 异常保证：
+// 插入时先分配需要的节点、构造新元素，再搬移元素，只要 value_type 的移动构造不抛出异常，
+// emplace / insert 满足强异常安全保证
+
+#include <cstring>
+#include <initializer_list>
+
+#include "rb_tree.h"
+
+namespace MySTL {
+
+// 每个节点占用的字节数
+#ifndef BTREE_NODE_BYTES
+#define BTREE_NODE_BYTES 256
+#endif
+
+template <class T>
+struct btree_node;
+template <class T>
+struct btree_internal_node;
+
+// btree 的节点设计，同时也是叶子节点
+template <class T>
+struct btree_node {
+    typedef btree_node<T>* node_ptr;
+    typedef btree_internal_node<T>* internal_ptr;
+
+    // 节点头部之后能放下的元素个数，至少为 3，至多为 255
+    static constexpr size_t header_size = sizeof(void*) + 2 * sizeof(unsigned short) + sizeof(bool);
+    static constexpr size_t fit = BTREE_NODE_BYTES > header_size ? (BTREE_NODE_BYTES - header_size) / sizeof(T) : 0;
+    static constexpr size_t slots = fit < 3 ? 3 : (fit > 255 ? 255 : fit);
+
+    node_ptr parent;          // 父节点，根节点的父节点为 nullptr
+    unsigned short position;  // 在父节点中的下标
+    unsigned short count;     // 元素个数
+    bool leaf;                // 是否为叶子节点
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type values[slots];
+
+    T* slot(size_t i) { return reinterpret_cast<T*>(&values[i]); }
+    const T* slot(size_t i) const { return reinterpret_cast<const T*>(&values[i]); }
+    T& value(size_t i) { return *slot(i); }
+
+    node_ptr& child(size_t i);
+    void set_child(size_t i, node_ptr c) {
+        child(i) = c;
+        c->parent = this;
+        c->position = static_cast<unsigned short>(i);
+    }
+};
+
+template <class T>
+struct btree_internal_node : public btree_node<T> {
+    typedef btree_node<T>* node_ptr;
+
+    node_ptr children[btree_node<T>::slots + 1];  // 子节点，第 i 个子节点中的元素都在第 i 个元素之前
+};
+
+template <class T>
+typename btree_node<T>::node_ptr& btree_node<T>::child(size_t i) {
+    MYSTL_DEBUG(!leaf);
+    return static_cast<internal_ptr>(this)->children[i];
+}
+
+// btree 的迭代器设计，由节点与节点内的下标表示一个位置，end() 为最右叶子的末尾
+template <class T, class Ref, class Ptr>
+struct btree_iterator : public MySTL::iterator<MySTL::bidirectional_iterator_tag, T> {
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef btree_node<T>* node_ptr;
+    typedef btree_iterator<T, Ref, Ptr> self;
+
+    node_ptr node;    // 当前节点
+    size_t position;  // 在节点中的下标
+
+    btree_iterator() : node(nullptr), position(0) {}
+    btree_iterator(node_ptr n, size_t pos) : node(n), position(pos) {}
+    btree_iterator(const btree_iterator&) = default;
+    btree_iterator& operator=(const btree_iterator&) = default;
+
+    // 由 iterator 构造 const_iterator，反方向不允许
+    template <class R, class P, typename std::enable_if<std::is_convertible<P, Ptr>::value, int>::type = 0>
+    btree_iterator(const btree_iterator<T, R, P>& rhs) : node(rhs.node), position(rhs.position) {}
+
+    reference operator*() const { return node->value(position); }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node != nullptr);
+        if (node->leaf) {
+            if (++position < node->count)
+                return *this;
+            // 已经到达叶子的末尾，沿父节点向上找下一个元素，找不到时停在 end()
+            self save = *this;
+            while (position == node->count && node->parent != nullptr) {
+                position = node->position;
+                node = node->parent;
+            }
+            if (position == node->count)
+                *this = save;
+        } else {
+            // 下一个元素是右子树中最左的元素
+            node = node->child(position + 1);
+            while (!node->leaf)
+                node = node->child(0);
+            position = 0;
+        }
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        MYSTL_DEBUG(node != nullptr);
+        if (node->leaf) {
+            if (position > 0) {
+                --position;
+                return *this;
+            }
+            while (position == 0 && node->parent != nullptr) {
+                position = node->position;
+                node = node->parent;
+            }
+            MYSTL_DEBUG(position > 0);
+            --position;
+        } else {
+            // 上一个元素是左子树中最右的元素
+            node = node->child(position);
+            while (!node->leaf)
+                node = node->child(node->count);
+            position = node->count - 1;
+        }
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return node == rhs.node && position == rhs.position; }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// 模板类 btree
+// 参数一代表数据类型，参数二代表键值比较类型，参数三代表分配器类型
+template <class T, class Compare, class Alloc = typename default_node_allocator<T>::type>
+class btree : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<btree_node<T>>> {
+   public:
+    // btree 的嵌套型别定义
+    typedef rb_tree_value_traits<T> value_traits;
+
+    typedef btree_node<T> node_type;
+    typedef btree_internal_node<T> internal_type;
+    typedef node_type* node_ptr;
+    typedef typename value_traits::key_type key_type;
+    typedef typename value_traits::mapped_type mapped_type;
+    typedef typename value_traits::value_type value_type;
+    typedef Compare key_compare;
+
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<node_type> node_allocator;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<internal_type> internal_allocator;
+    typedef MySTL::allocator_traits<node_allocator> node_alloc_traits;
+    typedef MySTL::allocator_traits<internal_allocator> internal_alloc_traits;
+    typedef MySTL::alloc_holder<node_allocator> holder_type;
+    typedef typename MySTL::is_trivially_relocatable<T>::type relocate_tag;
+
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef btree_iterator<T, T&, T*> iterator;
+    typedef btree_iterator<T, const T&, const T*> const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static constexpr size_type node_slots = node_type::slots;
+    static constexpr size_type min_values = node_slots / 2;
+
+    allocator_type get_allocator() const { return allocator_type(this->get_alloc()); }
+    key_compare key_comp() const { return key_comp_; }
+
+   private:
+    // 用以下五个数据表现 btree
+    node_ptr root_;         // 根节点，空树时为 nullptr
+    node_ptr leftmost_;     // 最左的叶子
+    node_ptr rightmost_;    // 最右的叶子
+    size_type size_;        // 元素个数
+    key_compare key_comp_;  // 键值比较的准则
+
+   public:
+    // 构造、复制、析构函数
+    btree() { reset(); }
+    explicit btree(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)), key_comp_(comp) { reset(); }
+    explicit btree(const allocator_type& alloc) : holder_type(node_allocator(alloc)) { reset(); }
+    btree(const btree& rhs)
+        : holder_type(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())), key_comp_(rhs.key_comp_) {
+        reset();
+        copy_tree(rhs);
+    }
+    btree(const btree& rhs, const allocator_type& alloc)
+        : holder_type(node_allocator(alloc)), key_comp_(rhs.key_comp_) {
+        reset();
+        copy_tree(rhs);
+    }
+    btree(btree&& rhs) noexcept
+        : holder_type(MySTL::move(rhs.get_alloc())),
+          root_(rhs.root_),
+          leftmost_(rhs.leftmost_),
+          rightmost_(rhs.rightmost_),
+          size_(rhs.size_),
+          key_comp_(rhs.key_comp_) {
+        rhs.reset();
+    }
+
+    btree& operator=(const btree& rhs);
+    btree& operator=(btree&& rhs);
+
+    ~btree() { clear(); }
+
+   public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(leftmost_, 0); }
+    const_iterator begin() const noexcept { return iterator(leftmost_, 0); }
+    iterator end() noexcept { return iterator(rightmost_, rightmost_ ? rightmost_->count : 0); }
+    const_iterator end() const noexcept { return iterator(rightmost_, rightmost_ ? rightmost_->count : 0); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+    // 插入删除相关操作
+    // emplace
+    template <class... Args>
+    iterator emplace_multi(Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_multi(MySTL::move(tmp));
+    }
+
+    template <class... Args>
+    MySTL::pair<iterator, bool> emplace_unique(Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_unique(MySTL::move(tmp));
+    }
+
+    template <class... Args>
+    iterator emplace_multi_use_hint(const_iterator hint, Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_multi(hint, MySTL::move(tmp));
+    }
+
+    template <class... Args>
+    iterator emplace_unique_use_hint(const_iterator hint, Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_unique(hint, MySTL::move(tmp));
+    }
+
+    // insert
+    iterator insert_multi(const value_type& value) {
+        return insert_value_at(upper_bound_pos(value_traits::get_key(value)), value);
+    }
+    iterator insert_multi(value_type&& value) {
+        return insert_value_at(upper_bound_pos(value_traits::get_key(value)), MySTL::move(value));
+    }
+
+    iterator insert_multi(const_iterator hint, const value_type& value) { return hint_insert_multi(hint, value); }
+    iterator insert_multi(const_iterator hint, value_type&& value) { return hint_insert_multi(hint, MySTL::move(value)); }
+
+    template <class InputIterator>
+    void insert_multi(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_multi(end(), *first);
+    }
+
+    MySTL::pair<iterator, bool> insert_unique(const value_type& value) { return unique_insert(value); }
+    MySTL::pair<iterator, bool> insert_unique(value_type&& value) { return unique_insert(MySTL::move(value)); }
+
+    iterator insert_unique(const_iterator hint, const value_type& value) { return hint_insert_unique(hint, value); }
+    iterator insert_unique(const_iterator hint, value_type&& value) { return hint_insert_unique(hint, MySTL::move(value)); }
+
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_unique(end(), *first);
+    }
+
+    // erase
+    iterator erase(const_iterator pos);
+
+    size_type erase_multi(const key_type& key);
+    size_type erase_unique(const key_type& key);
+
+    iterator erase(const_iterator first, const_iterator last);
+    void clear();
+
+    // btree 相关操作
+    iterator find(const key_type& key);
+    const_iterator find(const key_type& key) const;
+
+    size_type count_multi(const key_type& key) const {
+        auto p = equal_range_multi(key);
+        return static_cast<size_type>(MySTL::distance(p.first, p.second));
+    }
+    size_type count_unique(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    iterator lower_bound(const key_type& key) { return lower_bound_pos(key, true); }
+    const_iterator lower_bound(const key_type& key) const { return lower_bound_pos(key, true); }
+    iterator upper_bound(const key_type& key) { return lower_bound_pos(key, false); }
+    const_iterator upper_bound(const key_type& key) const { return lower_bound_pos(key, false); }
+
+    MySTL::pair<iterator, iterator>
+    equal_range_multi(const key_type& key) {
+        return MySTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MySTL::pair<const_iterator, const_iterator>
+    equal_range_multi(const key_type& key) const {
+        return MySTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    MySTL::pair<iterator, iterator>
+    equal_range_unique(const key_type& key) {
+        iterator it = find(key);
+        auto next = it;
+        return it == end() ? MySTL::make_pair(it, it) : MySTL::make_pair(it, ++next);
+    }
+    MySTL::pair<const_iterator, const_iterator>
+    equal_range_unique(const key_type& key) const {
+        const_iterator it = find(key);
+        auto next = it;
+        return it == end() ? MySTL::make_pair(it, it) : MySTL::make_pair(it, ++next);
+    }
+
+    void swap(btree& rhs) noexcept;
+
+   private:
+    // node related
+    const key_type& key_at(node_ptr x, size_type i) const { return value_traits::get_key(x->value(i)); }
+    node_ptr new_leaf(node_ptr parent);
+    node_ptr new_internal(node_ptr parent);
+    void free_node(node_ptr x);
+    void destroy_subtree(node_ptr x);
+    void reset();
+    void copy_tree(const btree& rhs);
+
+    // 元素的搬移
+    static void relocate_one(T* dst, T* src);
+    static void relocate_forward(T* first, T* last, T* result);
+    static void relocate_backward(T* first, T* last, T* result_last);
+
+    // search
+    size_type node_lower_bound(node_ptr x, const key_type& key) const;
+    size_type node_upper_bound(node_ptr x, const key_type& key) const;
+    iterator lower_bound_pos(const key_type& key, bool lower) const;
+    iterator upper_bound_pos(const key_type& key) const;
+
+    // 容器内部修改元素时由 const_iterator 得到指向同一位置的 iterator
+    static iterator to_iterator(const_iterator it) noexcept { return iterator(it.node, it.position); }
+
+    // insert
+    template <class V>
+    MySTL::pair<iterator, bool> unique_insert(V&& value);
+    template <class V>
+    iterator hint_insert_unique(const_iterator hint, V&& value);
+    template <class V>
+    iterator hint_insert_multi(const_iterator hint, V&& value);
+    template <class V>
+    iterator insert_value_at(iterator pos, V&& value);
+    void split_for_insert(iterator& pos);
+    void split_node(node_ptr x, size_type insert_pos, node_ptr dest);
+
+    // erase
+    iterator rebalance_after_erase(iterator it);
+    bool merge_or_rebalance(iterator& it);
+    void merge_nodes(node_ptr left, node_ptr right);
+    void move_right_to_left(node_ptr left, node_ptr right, size_type n);
+    void move_left_to_right(node_ptr left, node_ptr right, size_type n);
+    void shrink_root();
+};
+
+/*****************************************************************************************/
+// 复制赋值操作符
+template <class T, class Compare, class Alloc>
+btree<T, Compare, Alloc>&
+btree<T, Compare, Alloc>::
+operator=(const btree& rhs) {
+    if (this != &rhs) {
+        clear();
+        MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        key_comp_ = rhs.key_comp_;
+        copy_tree(rhs);
+    }
+    return *this;
+}
+
+// 移动赋值操作符
+template <class T, class Compare, class Alloc>
+btree<T, Compare, Alloc>&
+btree<T, Compare, Alloc>::
+operator=(btree&& rhs) {
+    if (this == &rhs)
+        return *this;
+    clear();
+    key_comp_ = rhs.key_comp_;
+    if (node_alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+        MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+        root_ = rhs.root_;
+        leftmost_ = rhs.leftmost_;
+        rightmost_ = rhs.rightmost_;
+        size_ = rhs.size_;
+        rhs.reset();
+    } else {
+        // 分配器不相等，不能直接接管对方的节点
+        for (auto it = rhs.begin(); it != rhs.end(); ++it)
+            insert_value_at(end(), MySTL::move(*it));
+        rhs.clear();
+    }
+    return *this;
+}
+
+// 删除 pos 处的元素，返回指向下一个元素的迭代器
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::
+    erase(const_iterator cpos) {
+    MYSTL_DEBUG(cpos != end());
+    iterator pos = to_iterator(cpos);
+    bool internal_erase = false;
+    node_alloc_traits::destroy(this->get_alloc(), pos.node->slot(pos.position));
+    if (!pos.node->leaf) {
+        // 内部节点上的元素由它的前驱顶替，前驱一定在叶子上，随后从叶子上删去前驱原来的位置
+        iterator hole = pos;
+        --pos;
+        relocate_one(hole.node->slot(hole.position), pos.node->slot(pos.position));
+        internal_erase = true;
+    }
+    node_ptr x = pos.node;
+    relocate_forward(x->slot(pos.position + 1), x->slot(x->count), x->slot(pos.position));
+    --x->count;
+    --size_;
+    iterator res = rebalance_after_erase(pos);
+    // 前驱顶替了被删除的元素，下一个元素在它之后
+    if (internal_erase)
+        ++res;
+    return res;
+}
+
+// 删除键值等于 key 的元素，返回删除的个数
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::size_type
+btree<T, Compare, Alloc>::
+    erase_multi(const key_type& key) {
+    auto p = equal_range_multi(key);
+    size_type n = MySTL::distance(p.first, p.second);
+    iterator it = p.first;
+    for (size_type i = 0; i < n; ++i)
+        it = erase(it);
+    return n;
+}
+
+// 删除键值等于 key 的元素，返回删除的个数
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::size_type
+btree<T, Compare, Alloc>::
+    erase_unique(const key_type& key) {
+    iterator it = find(key);
+    if (it != end()) {
+        erase(it);
+        return 1;
+    }
+    return 0;
+}
+
+// 删除 [first, last) 区间内的元素，每次删除都会使迭代器失效，因此先数出个数
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::
+    erase(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end()) {
+        clear();
+        return end();
+    }
+    size_type n = MySTL::distance(first, last);
+    iterator it = to_iterator(first);
+    for (; n > 0; --n)
+        it = erase(it);
+    return it;
+}
+
+// 清空 btree
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::clear() {
+    if (root_ != nullptr) {
+        destroy_subtree(root_);
+        reset();
+    }
+}
+
+// 查找键值为 key 的元素，返回指向它的迭代器，键值允许重复时返回第一个
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::
+    find(const key_type& key) {
+    iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+}
+
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::const_iterator
+btree<T, Compare, Alloc>::
+    find(const key_type& key) const {
+    const_iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+}
+
+// 交换 btree
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::
+    swap(btree& rhs) noexcept {
+    if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
+        MySTL::swap(root_, rhs.root_);
+        MySTL::swap(leftmost_, rhs.leftmost_);
+        MySTL::swap(rightmost_, rhs.rightmost_);
+        MySTL::swap(size_, rhs.size_);
+        MySTL::swap(key_comp_, rhs.key_comp_);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 分配一个空的叶子节点
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::node_ptr
+btree<T, Compare, Alloc>::new_leaf(node_ptr parent) {
+    node_ptr x = node_alloc_traits::allocate(this->get_alloc(), 1);
+    x->parent = parent;
+    x->position = 0;
+    x->count = 0;
+    x->leaf = true;
+    return x;
+}
+
+// 分配一个空的内部节点
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::node_ptr
+btree<T, Compare, Alloc>::new_internal(node_ptr parent) {
+    internal_allocator alloc(this->get_alloc());
+    node_ptr x = internal_alloc_traits::allocate(alloc, 1);
+    x->parent = parent;
+    x->position = 0;
+    x->count = 0;
+    x->leaf = false;
+    return x;
+}
+
+// 释放节点，节点中的元素此前已经析构或搬走
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::free_node(node_ptr x) {
+    if (x->leaf) {
+        node_alloc_traits::deallocate(this->get_alloc(), x, 1);
+    } else {
+        internal_allocator alloc(this->get_alloc());
+        internal_alloc_traits::deallocate(alloc, static_cast<internal_type*>(x), 1);
+    }
+}
+
+// 析构以 x 为根的子树中的所有元素并释放节点
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::destroy_subtree(node_ptr x) {
+    if (!x->leaf) {
+        for (size_type i = 0; i <= x->count; ++i)
+            destroy_subtree(x->child(i));
+    }
+    for (size_type i = 0; i < x->count; ++i)
+        node_alloc_traits::destroy(this->get_alloc(), x->slot(i));
+    free_node(x);
+}
+
+// reset 函数
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::reset() {
+    root_ = nullptr;
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+}
+
+// copy_tree 函数
+// rhs 中的元素已经有序，逐个追加在末尾，分裂时元素都留在左边，得到的叶子几乎是满的；调用前容器必须为空
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::copy_tree(const btree& rhs) {
+    try {
+        for (auto it = rhs.begin(); it != rhs.end(); ++it)
+            insert_value_at(end(), *it);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// 搬移一个元素到未初始化的位置，源位置随后视为未初始化
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::relocate_one(T* dst, T* src) {
+    if (relocate_tag::value) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T));
+    } else {
+        MySTL::construct(dst, MySTL::move(*src));
+        MySTL::destroy(src);
+    }
+}
+
+// 把 [first, last) 搬到以 result 为起点的位置，result 在 first 之前时允许重叠
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::relocate_forward(T* first, T* last, T* result) {
+    if (relocate_tag::value) {
+        if (first != last)
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), (last - first) * sizeof(T));
+    } else {
+        for (; first != last; ++first, ++result)
+            relocate_one(result, first);
+    }
+}
+
+// 把 [first, last) 搬到以 result_last 为终点的位置，result_last 在 last 之后时允许重叠
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::relocate_backward(T* first, T* last, T* result_last) {
+    if (relocate_tag::value) {
+        if (first != last)
+            std::memmove(static_cast<void*>(result_last - (last - first)), static_cast<const void*>(first), (last - first) * sizeof(T));
+    } else {
+        while (first != last)
+            relocate_one(--result_last, --last);
+    }
+}
+
+// 节点 x 中第一个不小于 key 的元素的下标
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::size_type
+btree<T, Compare, Alloc>::node_lower_bound(node_ptr x, const key_type& key) const {
+    size_type lo = 0, hi = x->count;
+    while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (key_comp_(key_at(x, mid), key))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// 节点 x 中第一个大于 key 的元素的下标
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::size_type
+btree<T, Compare, Alloc>::node_upper_bound(node_ptr x, const key_type& key) const {
+    size_type lo = 0, hi = x->count;
+    while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (key_comp_(key, key_at(x, mid)))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
+}
+
+// lower 为 true 时返回第一个不小于 key 的元素，否则返回第一个大于 key 的元素
+// 越往下找到的候选元素越小，最后一个候选即为答案
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::lower_bound_pos(const key_type& key, bool lower) const {
+    iterator res(rightmost_, rightmost_ ? rightmost_->count : 0);
+    node_ptr x = root_;
+    while (x != nullptr) {
+        size_type i = lower ? node_lower_bound(x, key) : node_upper_bound(x, key);
+        if (i < x->count)
+            res = iterator(x, i);
+        if (x->leaf)
+            break;
+        x = x->child(i);
+    }
+    return res;
+}
+
+// 键值允许重复时的插入位置：叶子上第一个大于 key 的元素之前，相等的元素中新元素排在最后
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::upper_bound_pos(const key_type& key) const {
+    node_ptr x = root_;
+    if (x == nullptr)
+        return iterator();
+    while (true) {
+        size_type i = node_upper_bound(x, key);
+        if (x->leaf)
+            return iterator(x, i);
+        x = x->child(i);
+    }
+}
+
+// 键值不允许重复时的插入，沿途遇到相等的键值即返回
+template <class T, class Compare, class Alloc>
+template <class V>
+MySTL::pair<typename btree<T, Compare, Alloc>::iterator, bool>
+btree<T, Compare, Alloc>::unique_insert(V&& value) {
+    const key_type& key = value_traits::get_key(value);
+    node_ptr x = root_;
+    if (x == nullptr)
+        return MySTL::make_pair(insert_value_at(iterator(), MySTL::forward<V>(value)), true);
+    while (true) {
+        size_type i = node_lower_bound(x, key);
+        if (i < x->count && !key_comp_(key, key_at(x, i)))
+            return MySTL::make_pair(iterator(x, i), false);
+        if (x->leaf)
+            return MySTL::make_pair(insert_value_at(iterator(x, i), MySTL::forward<V>(value)), true);
+        x = x->child(i);
+    }
+}
+
+// 键值不允许重复时使用 hint 插入：hint 恰好是插入位置时不必从根节点查找
+template <class T, class Compare, class Alloc>
+template <class V>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::hint_insert_unique(const_iterator chint, V&& value) {
+    iterator hint = to_iterator(chint);
+    if (size_ != 0) {
+        const key_type& key = value_traits::get_key(value);
+        if (hint == end() || key_comp_(key, value_traits::get_key(*hint))) {
+            iterator prev = hint;
+            if (hint == begin() || key_comp_(value_traits::get_key(*--prev), key))
+                return insert_value_at(hint, MySTL::forward<V>(value));
+        }
+    }
+    return unique_insert(MySTL::forward<V>(value)).first;
+}
+
+// 键值允许重复时使用 hint 插入
+template <class T, class Compare, class Alloc>
+template <class V>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::hint_insert_multi(const_iterator chint, V&& value) {
+    iterator hint = to_iterator(chint);
+    if (size_ != 0) {
+        const key_type& key = value_traits::get_key(value);
+        if (hint == end() || !key_comp_(value_traits::get_key(*hint), key)) {
+            iterator prev = hint;
+            if (hint == begin() || !key_comp_(key, value_traits::get_key(*--prev)))
+                return insert_value_at(hint, MySTL::forward<V>(value));
+        }
+    }
+    return insert_multi(MySTL::forward<V>(value));
+}
+
+// 在 pos 之前插入 value
+// 先按需分裂节点，再把新元素构造在节点末尾的空位上，最后旋转到 pos 处，构造失败时只留下已完成的分裂
+template <class T, class Compare, class Alloc>
+template <class V>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::insert_value_at(iterator pos, V&& value) {
+    if (root_ == nullptr) {
+        root_ = leftmost_ = rightmost_ = new_leaf(nullptr);
+        pos = iterator(root_, 0);
+    } else if (!pos.node->leaf) {
+        // 内部节点上的位置之前是左子树中最右的元素，新元素放在它之后
+        --pos;
+        ++pos.position;
+    }
+    if (pos.node->count == node_slots)
+        split_for_insert(pos);
+    node_ptr x = pos.node;
+    try {
+        node_alloc_traits::construct(this->get_alloc(), x->slot(x->count), MySTL::forward<V>(value));
+    } catch (...) {
+        if (size_ == 0) {
+            free_node(root_);
+            reset();
+        }
+        throw;
+    }
+    if (pos.position < x->count) {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type tmp;
+        T* t = reinterpret_cast<T*>(&tmp);
+        relocate_one(t, x->slot(x->count));
+        relocate_backward(x->slot(pos.position), x->slot(x->count), x->slot(x->count + 1));
+        relocate_one(x->slot(pos.position), t);
+    }
+    ++x->count;
+    ++size_;
+    return pos;
+}
+
+// 为 pos 所在的满节点腾出空间：父节点满时先分裂父节点，根节点满时树长高一层，pos 随分裂调整
+// 每一步都在修改树之前分配节点，分配失败时树仍然完整
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::split_for_insert(iterator& pos) {
+    node_ptr x = pos.node;
+    node_ptr parent = x->parent;
+    node_ptr dest = nullptr;
+    if (parent == nullptr) {
+        parent = new_internal(nullptr);
+        try {
+            dest = x->leaf ? new_leaf(parent) : new_internal(parent);
+        } catch (...) {
+            free_node(parent);
+            throw;
+        }
+        parent->set_child(0, x);
+        root_ = parent;
+    } else {
+        if (parent->count == node_slots) {
+            iterator parent_pos(parent, x->position);
+            split_for_insert(parent_pos);
+            parent = x->parent;
+        }
+        dest = x->leaf ? new_leaf(parent) : new_internal(parent);
+    }
+    split_node(x, pos.position, dest);
+    if (rightmost_ == x)
+        rightmost_ = dest;
+    if (pos.position > x->count) {
+        pos.position -= x->count + 1;
+        pos.node = dest;
+    }
+}
+
+// 把 x 的后一部分元素移到新节点 dest，x 的最后一个元素上移到父节点作为两者的分隔
+// 在开头插入时把元素都移到右边，在末尾插入时都留在左边，其余情况对半分
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::split_node(node_ptr x, size_type insert_pos, node_ptr dest) {
+    size_type n;
+    if (insert_pos == 0)
+        n = x->count - 1;
+    else if (insert_pos == node_slots)
+        n = 0;
+    else
+        n = x->count / 2;
+    const size_type keep = x->count - n;  // 包含分隔元素
+    relocate_forward(x->slot(keep), x->slot(x->count), dest->slot(0));
+    dest->count = static_cast<unsigned short>(n);
+    if (!x->leaf) {
+        for (size_type i = 0; i <= n; ++i)
+            dest->set_child(i, x->child(keep + i));
+    }
+    x->count = static_cast<unsigned short>(keep - 1);
+
+    // 分隔元素与 dest 插入父节点
+    node_ptr p = x->parent;
+    const size_type i = x->position;
+    relocate_backward(p->slot(i), p->slot(p->count), p->slot(p->count + 1));
+    relocate_one(p->slot(i), x->slot(keep - 1));
+    for (size_type j = p->count; j > i; --j)
+        p->set_child(j + 1, p->child(j));
+    p->set_child(i + 1, dest);
+    ++p->count;
+}
+
+// 删除元素后自下而上修复元素过少的节点，it 指向被删除的位置，返回修复后该位置对应的迭代器
+template <class T, class Compare, class Alloc>
+typename btree<T, Compare, Alloc>::iterator
+btree<T, Compare, Alloc>::rebalance_after_erase(iterator it) {
+    iterator res = it;
+    bool first = true;
+    while (true) {
+        if (it.node == root_) {
+            shrink_root();
+            if (root_ == nullptr)
+                return end();
+            break;
+        }
+        if (it.node->count >= min_values)
+            break;
+        bool merged = merge_or_rebalance(it);
+        // 第一轮调整的是叶子，res 随之更新
+        if (first) {
+            res = it;
+            first = false;
+        }
+        if (!merged)
+            break;
+        it.position = it.node->position;
+        it.node = it.node->parent;
+    }
+    // res 位于节点末尾时，下一个元素在别处
+    if (res.position == res.node->count) {
+        res.position = res.node->count - 1;
+        ++res;
+    }
+    return res;
+}
+
+// 与兄弟节点合并，或从兄弟节点借元素，发生合并时返回 true，父节点可能因此需要继续调整
+// 从前端删除时不向右兄弟借、从后端删除时不向左兄弟借，以免反复搬移
+template <class T, class Compare, class Alloc>
+bool btree<T, Compare, Alloc>::merge_or_rebalance(iterator& it) {
+    node_ptr x = it.node;
+    node_ptr parent = x->parent;
+    if (x->position > 0) {
+        node_ptr left = parent->child(x->position - 1);
+        if (1 + left->count + x->count <= node_slots) {
+            it.position += 1 + left->count;
+            merge_nodes(left, x);
+            it.node = left;
+            return true;
+        }
+    }
+    if (x->position < parent->count) {
+        node_ptr right = parent->child(x->position + 1);
+        if (1 + x->count + right->count <= node_slots) {
+            merge_nodes(x, right);
+            return true;
+        }
+        if (right->count > min_values && (x->count == 0 || it.position > 0)) {
+            size_type n = MySTL::min((right->count - x->count) / 2, right->count - 1);
+            move_right_to_left(x, right, n);
+            return false;
+        }
+    }
+    if (x->position > 0) {
+        node_ptr left = parent->child(x->position - 1);
+        if (left->count > min_values && (x->count == 0 || it.position < x->count)) {
+            size_type n = MySTL::min((left->count - x->count) / 2, left->count - 1);
+            move_left_to_right(left, x, n);
+            it.position += n;
+            return false;
+        }
+    }
+    return false;
+}
+
+// 把父节点中的分隔元素与 right 的全部内容并入 left，释放 right
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::merge_nodes(node_ptr left, node_ptr right) {
+    node_ptr p = left->parent;
+    const size_type i = left->position;
+    const size_type lc = left->count;
+    relocate_one(left->slot(lc), p->slot(i));
+    relocate_forward(right->slot(0), right->slot(right->count), left->slot(lc + 1));
+    if (!left->leaf) {
+        for (size_type j = 0; j <= right->count; ++j)
+            left->set_child(lc + 1 + j, right->child(j));
+    }
+    left->count = static_cast<unsigned short>(lc + 1 + right->count);
+
+    // 父节点删去分隔元素与 right
+    relocate_forward(p->slot(i + 1), p->slot(p->count), p->slot(i));
+    for (size_type j = i + 2; j <= p->count; ++j)
+        p->set_child(j - 1, p->child(j));
+    --p->count;
+
+    if (rightmost_ == right)
+        rightmost_ = left;
+    free_node(right);
+}
+
+// 经由父节点把 right 的前 n 个元素移到 left 末尾
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::move_right_to_left(node_ptr left, node_ptr right, size_type n) {
+    node_ptr p = left->parent;
+    const size_type i = left->position;
+    const size_type lc = left->count;
+    relocate_one(left->slot(lc), p->slot(i));
+    relocate_forward(right->slot(0), right->slot(n - 1), left->slot(lc + 1));
+    relocate_one(p->slot(i), right->slot(n - 1));
+    relocate_forward(right->slot(n), right->slot(right->count), right->slot(0));
+    if (!left->leaf) {
+        for (size_type j = 0; j < n; ++j)
+            left->set_child(lc + 1 + j, right->child(j));
+        for (size_type j = n; j <= right->count; ++j)
+            right->set_child(j - n, right->child(j));
+    }
+    left->count = static_cast<unsigned short>(lc + n);
+    right->count = static_cast<unsigned short>(right->count - n);
+}
+
+// 经由父节点把 left 的后 n 个元素移到 right 开头
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::move_left_to_right(node_ptr left, node_ptr right, size_type n) {
+    node_ptr p = left->parent;
+    const size_type i = left->position;
+    const size_type lc = left->count;
+    relocate_backward(right->slot(0), right->slot(right->count), right->slot(right->count + n));
+    relocate_one(right->slot(n - 1), p->slot(i));
+    relocate_forward(left->slot(lc - n + 1), left->slot(lc), right->slot(0));
+    relocate_one(p->slot(i), left->slot(lc - n));
+    if (!left->leaf) {
+        for (size_type j = right->count + 1; j > 0; --j)
+            right->set_child(j - 1 + n, right->child(j - 1));
+        for (size_type j = 0; j < n; ++j)
+            right->set_child(j, left->child(lc - n + 1 + j));
+    }
+    left->count = static_cast<unsigned short>(lc - n);
+    right->count = static_cast<unsigned short>(right->count + n);
+}
+
+// 根节点为空时降低树的高度，树为空时释放根节点
+template <class T, class Compare, class Alloc>
+void btree<T, Compare, Alloc>::shrink_root() {
+    if (root_->count > 0)
+        return;
+    node_ptr old = root_;
+    if (old->leaf) {
+        reset();
+    } else {
+        root_ = old->child(0);
+        root_->parent = nullptr;
+        root_->position = 0;
+    }
+    free_node(old);
+}
+
+// 重载比较操作符
+template <class T, class Compare, class Alloc>
+bool operator==(const btree<T, Compare, Alloc>& lhs, const btree<T, Compare, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Compare, class Alloc>
+bool operator<(const btree<T, Compare, Alloc>& lhs, const btree<T, Compare, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Compare, class Alloc>
+bool operator!=(const btree<T, Compare, Alloc>& lhs, const btree<T, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Compare, class Alloc>
+bool operator>(const btree<T, Compare, Alloc>& lhs, const btree<T, Compare, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Compare, class Alloc>
+bool operator<=(const btree<T, Compare, Alloc>& lhs, const btree<T, Compare, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Compare, class Alloc>
+bool operator>=(const btree<T, Compare, Alloc>& lhs, const btree<T, Compare, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, class Compare, class Alloc>
+void swap(btree<T, Compare, Alloc>& lhs, btree<T, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 节点中没有指回 btree 对象的指针
+template <class T, class Compare, class Alloc>
+struct is_trivially_relocatable<btree<T, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value && is_trivially_relocatable<Alloc>::value> {};
+
+}  // namespace MySTL
+#endif  // !_MYSTL_BTREE_H_
@@ -0,0 +1,435 @@
+#ifndef _MYSTL_BTREE_SET_H_
+#define _MYSTL_BTREE_SET_H_
+
+// 这个头文件包含两个模板类 btree_set 和 btree_multiset
+// btree_set      : 集合，以 B 树为底层机制，接口与 btree_set 相同，键值不允许重复
+// btree_multiset : 集合，以 B 树为底层机制，接口与 btree_multiset 相同，键值允许重复
+
+// notes:
+//
+// 与 btree_set 不同，insert / emplace / erase 之后，所有迭代器、指针和引用都可能失效，erase 返回指向下一个元素的迭代器
+//
+// 异常保证：
+// MySTL::btree_set<Key> / MySTL::btree_multiset<Key> 满足基本异常保证，
+// value_type 的移动构造不抛出异常时，对以下等函数做强异常安全保证：
+//   * emplace
+//   * emplace_hint
+//   * insert
+
+#include "btree.h"
+
+namespace MySTL {
+
+// 模板类 btree_set，键值不允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 MySTL::less，参数三代表分配器类型
+template <class Key, class Compare = MySTL::less<Key>, class Alloc = typename default_node_allocator<Key>::type>
+class btree_set {
+   public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+   private:
+    // 以 MySTL::btree 作为底层机制
+    typedef MySTL::btree<value_type, key_compare, Alloc> base_type;
+    base_type tree_;
+
+   public:
+    // 使用 btree 定义的型别
+    typedef typename base_type::node_type node_type;
+    typedef typename base_type::const_pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::const_reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::const_iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::const_reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+    typedef typename base_type::allocator_type allocator_type;
+
+   public:
+    // 构造、复制、移动函数
+    btree_set() = default;
+    explicit btree_set(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit btree_set(const allocator_type& alloc)
+        : tree_(alloc) {}
+
+    template <class InputIterator>
+    btree_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(first, last); }
+    btree_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(ilist.begin(), ilist.end()); }
+
+    btree_set(const btree_set& rhs)
+        : tree_(rhs.tree_) {
+    }
+    btree_set(const btree_set& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {
+    }
+    btree_set(btree_set&& rhs) noexcept
+        : tree_(MySTL::move(rhs.tree_)) {
+    }
+
+    btree_set& operator=(const btree_set& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    btree_set& operator=(btree_set&& rhs) {
+        tree_ = MySTL::move(rhs.tree_);
+        return *this;
+    }
+    btree_set& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+    value_compare value_comp() const { return tree_.key_comp(); }
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+    // 迭代器相关
+
+    iterator begin() noexcept { return tree_.begin(); }
+    const_iterator begin() const noexcept { return tree_.begin(); }
+    iterator end() noexcept { return tree_.end(); }
+    const_iterator end() const noexcept { return tree_.end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关
+    bool empty() const noexcept { return tree_.empty(); }
+    size_type size() const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+
+    // 插入删除操作
+
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return tree_.emplace_unique(MySTL::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(iterator hint, Args&&... args) {
+        return tree_.emplace_unique_use_hint(hint, MySTL::forward<Args>(args)...);
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return tree_.insert_unique(value);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        return tree_.insert_unique(MySTL::move(value));
+    }
+
+    iterator insert(iterator hint, const value_type& value) {
+        return tree_.insert_unique(hint, value);
+    }
+    iterator insert(iterator hint, value_type&& value) {
+        return tree_.insert_unique(hint, MySTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_unique(first, last);
+    }
+
+    iterator erase(iterator position) { return tree_.erase(position); }
+    size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+    iterator erase(iterator first, iterator last) { return tree_.erase(first, last); }
+
+    void clear() { tree_.clear(); }
+
+    // btree_set 相关操作
+
+    iterator find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+    size_type count(const key_type& key) const { return tree_.count_unique(key); }
+
+    iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+    equal_range(const key_type& key) { return tree_.equal_range_unique(key); }
+
+    pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const { return tree_.equal_range_unique(key); }
+
+    void swap(btree_set& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+   public:
+    friend bool operator==(const btree_set& lhs, const btree_set& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const btree_set& lhs, const btree_set& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class Compare, class Alloc>
+bool operator==(const btree_set<Key, Compare, Alloc>& lhs, const btree_set<Key, Compare, Alloc>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<(const btree_set<Key, Compare, Alloc>& lhs, const btree_set<Key, Compare, Alloc>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator!=(const btree_set<Key, Compare, Alloc>& lhs, const btree_set<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator>(const btree_set<Key, Compare, Alloc>& lhs, const btree_set<Key, Compare, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<=(const btree_set<Key, Compare, Alloc>& lhs, const btree_set<Key, Compare, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator>=(const btree_set<Key, Compare, Alloc>& lhs, const btree_set<Key, Compare, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class Key, class Compare, class Alloc>
+void swap(btree_set<Key, Compare, Alloc>& lhs, btree_set<Key, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// 模板类 btree_multiset，键值允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 MySTL::less，参数三代表分配器类型
+template <class Key, class Compare = MySTL::less<Key>, class Alloc = typename default_node_allocator<Key>::type>
+class btree_multiset {
+   public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+   private:
+    // 以 MySTL::btree 作为底层机制
+    typedef MySTL::btree<value_type, key_compare, Alloc> base_type;
+    base_type tree_;  // 以 btree 表现 btree_multiset
+
+   public:
+    // 使用 btree 定义的型别
+    typedef typename base_type::node_type node_type;
+    typedef typename base_type::const_pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef typename base_type::const_reference reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::const_iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::const_reverse_iterator reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+    typedef typename base_type::allocator_type allocator_type;
+
+   public:
+    // 构造、复制、移动函数
+    btree_multiset() = default;
+    explicit btree_multiset(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit btree_multiset(const allocator_type& alloc)
+        : tree_(alloc) {}
+
+    template <class InputIterator>
+    btree_multiset(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(first, last); }
+    btree_multiset(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(ilist.begin(), ilist.end()); }
+
+    btree_multiset(const btree_multiset& rhs)
+        : tree_(rhs.tree_) {
+    }
+    btree_multiset(const btree_multiset& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {
+    }
+    btree_multiset(btree_multiset&& rhs) noexcept
+        : tree_(MySTL::move(rhs.tree_)) {
+    }
+
+    btree_multiset& operator=(const btree_multiset& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    btree_multiset& operator=(btree_multiset&& rhs) {
+        tree_ = MySTL::move(rhs.tree_);
+        return *this;
+    }
+    btree_multiset& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_multi(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+    value_compare value_comp() const { return tree_.key_comp(); }
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+    // 迭代器相关
+
+    iterator begin() noexcept { return tree_.begin(); }
+    const_iterator begin() const noexcept { return tree_.begin(); }
+    iterator end() noexcept { return tree_.end(); }
+    const_iterator end() const noexcept { return tree_.end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关
+    bool empty() const noexcept { return tree_.empty(); }
+    size_type size() const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+
+    // 插入删除操作
+
+    template <class... Args>
+    iterator emplace(Args&&... args) {
+        return tree_.emplace_multi(MySTL::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(iterator hint, Args&&... args) {
+        return tree_.emplace_multi_use_hint(hint, MySTL::forward<Args>(args)...);
+    }
+
+    iterator insert(const value_type& value) {
+        return tree_.insert_multi(value);
+    }
+    iterator insert(value_type&& value) {
+        return tree_.insert_multi(MySTL::move(value));
+    }
+
+    iterator insert(iterator hint, const value_type& value) {
+        return tree_.insert_multi(hint, value);
+    }
+    iterator insert(iterator hint, value_type&& value) {
+        return tree_.insert_multi(hint, MySTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_multi(first, last);
+    }
+
+    iterator erase(iterator position) { return tree_.erase(position); }
+    size_type erase(const key_type& key) { return tree_.erase_multi(key); }
+    iterator erase(iterator first, iterator last) { return tree_.erase(first, last); }
+
+    void clear() { tree_.clear(); }
+
+    // btree_multiset 相关操作
+
+    iterator find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+    size_type count(const key_type& key) const { return tree_.count_multi(key); }
+
+    iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+    equal_range(const key_type& key) { return tree_.equal_range_multi(key); }
+
+    pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const { return tree_.equal_range_multi(key); }
+
+    void swap(btree_multiset& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+   public:
+    friend bool operator==(const btree_multiset& lhs, const btree_multiset& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const btree_multiset& lhs, const btree_multiset& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class Compare, class Alloc>
+bool operator==(const btree_multiset<Key, Compare, Alloc>& lhs, const btree_multiset<Key, Compare, Alloc>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<(const btree_multiset<Key, Compare, Alloc>& lhs, const btree_multiset<Key, Compare, Alloc>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator!=(const btree_multiset<Key, Compare, Alloc>& lhs, const btree_multiset<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator>(const btree_multiset<Key, Compare, Alloc>& lhs, const btree_multiset<Key, Compare, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<=(const btree_multiset<Key, Compare, Alloc>& lhs, const btree_multiset<Key, Compare, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator>=(const btree_multiset<Key, Compare, Alloc>& lhs, const btree_multiset<Key, Compare, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class Key, class Compare, class Alloc>
+void swap(btree_multiset<Key, Compare, Alloc>& lhs, btree_multiset<Key, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// btree_set / btree_multiset 只包含一棵 btree
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<btree_set<Key, Compare, Alloc>> : is_trivially_relocatable<btree<Key, Compare, Alloc>> {};
+
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<btree_multiset<Key, Compare, Alloc>> : is_trivially_relocatable<btree<Key, Compare, Alloc>> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class Key, class Compare = MySTL::less<Key>>
+using btree_set = MySTL::btree_set<Key, Compare, MySTL::polymorphic_allocator<Key>>;
+
+template <class Key, class Compare = MySTL::less<Key>>
+using btree_multiset = MySTL::btree_multiset<Key, Compare, MySTL::polymorphic_allocator<Key>>;
+
+}  // namespace pmr
+
+}  // namespace MySTL
+#endif  // !_MYSTL_BTREE_SET_H_
@@ -0,0 +1,812 @@
+#ifndef _MYSTL_CIRCULAR_BUFFER_H_
+#define _MYSTL_CIRCULAR_BUFFER_H_
+
+// 这个头文件包含一个模板类 circular_buffer
+// circular_buffer : 环形缓冲区，元素保存在一块连续空间中，可以作为 queue 与 stack 的底层容器
+
+// notes:
+//
+// 容量总是 2 的幂，逻辑下标换算成物理下标只需与 capacity() - 1 做一次按位与，
+// 头尾插入删除都是常数时间，与 deque 相比没有 map 的间接寻址，元素也集中在一块连续空间里
+// 元素在环上最多分成两段连续区间，as_spans() 返回这两段，free_spans() 返回空闲的两段，可以直接交给 writev/readv：
+//   writev 写出后用 consume_front(n) 丢弃已写出的元素，readv 读入后用 commit_back(n) 把读入的元素计入容器，
+//   commit_back 只做默认初始化，因此只适用于 int、char 这类平凡类型
+// 容量策略由 circular_buffer_mode 指定：
+//   circular_grow      : 空间用完时容量翻倍，缺省的策略
+//   circular_fixed     : 容量固定，向满的缓冲区插入元素时抛出 length_error
+//   circular_overwrite : 容量固定，向满的缓冲区插入元素时覆盖另一端的元素
+//
+// 异常保证：
+// circular_grow 与 circular_fixed 下，emplace_front、emplace_back、push_front、push_back 满足强异常保证，
+// 扩容时元素的移动构造可能抛出异常就改为复制；元素不能复制且移动构造可能抛出异常时只满足基本异常保证
+// circular_overwrite 覆盖元素时只满足基本异常保证
+
+#include <initializer_list>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace MySTL {
+
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif  // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif  // min
+
+// circular_buffer 第一次分配空间时的容量
+#ifndef CIRCULAR_BUFFER_INIT_SIZE
+#define CIRCULAR_BUFFER_INIT_SIZE 16
+#endif
+
+// 容量策略
+enum circular_buffer_mode {
+    circular_grow,      // 空间用完时容量翻倍
+    circular_fixed,     // 容量固定，满时插入抛出异常
+    circular_overwrite  // 容量固定，满时插入覆盖另一端的元素
+};
+
+// 一段连续的元素，data 指向第一个元素，size 为元素个数
+template <class T>
+struct contiguous_span {
+    T* data;
+    size_t size;
+
+    T* begin() const noexcept { return data; }
+    T* end() const noexcept { return data + size; }
+    bool empty() const noexcept { return size == 0; }
+};
+
+// circular_buffer 的迭代器设计
+// pos 是未取模的物理位置，从头部位置开始递增，解引用时才与 mask 按位与，比较与相减都不用考虑回绕
+template <class T, class Ref, class Ptr>
+struct circular_buffer_iterator : public iterator<random_access_iterator_tag, T> {
+    typedef circular_buffer_iterator<T, T&, T*> iterator;
+    typedef circular_buffer_iterator<T, const T&, const T*> const_iterator;
+    typedef circular_buffer_iterator self;
+
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    // 迭代器所含成员数据
+    T* buf;          // 缓冲区的起始位置
+    size_type mask;  // 容量减一
+    size_type pos;   // 未取模的位置
+
+    // 构造、复制函数
+    circular_buffer_iterator() noexcept : buf(nullptr), mask(0), pos(0) {}
+    circular_buffer_iterator(T* b, size_type m, size_type p) noexcept : buf(b), mask(m), pos(p) {}
+    circular_buffer_iterator(const iterator& rhs) noexcept : buf(rhs.buf), mask(rhs.mask), pos(rhs.pos) {}
+
+    // 重载运算符
+    reference operator*() const { return buf[pos & mask]; }
+    pointer operator->() const { return &(operator*()); }
+    reference operator[](difference_type n) const { return buf[(pos + n) & mask]; }
+
+    difference_type operator-(const self& rhs) const {
+        return static_cast<difference_type>(pos - rhs.pos);
+    }
+
+    self& operator++() {
+        ++pos;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++pos;
+        return tmp;
+    }
+    self& operator--() {
+        --pos;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --pos;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        pos += n;
+        return *this;
+    }
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-=(difference_type n) {
+        pos -= n;
+        return *this;
+    }
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return pos == rhs.pos; }
+    bool operator<(const self& rhs) const { return pos < rhs.pos; }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+// 模板类 circular_buffer
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型，缺省使用 MySTL::allocator
+template <class T, class Alloc = MySTL::allocator<T>>
+class circular_buffer : private alloc_holder<Alloc> {
+   public:
+    // circular_buffer 的型别定义
+    typedef Alloc allocator_type;
+    typedef MySTL::allocator_traits<Alloc> alloc_traits;
+    typedef MySTL::alloc_holder<Alloc> holder_type;
+    typedef typename MySTL::is_trivially_relocatable<T>::type relocate_tag;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef circular_buffer_iterator<T, T&, T*> iterator;
+    typedef circular_buffer_iterator<T, const T&, const T*> const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    typedef contiguous_span<T> span_type;
+    typedef contiguous_span<const T> const_span_type;
+
+    allocator_type get_allocator() const { return this->get_alloc(); }
+
+   private:
+    // 用以下五个数据来表现一个 circular_buffer
+    pointer buf_;               // 缓冲区的起始位置
+    size_type cap_;             // 容量，为 0 或 2 的幂
+    size_type head_;            // 第一个元素的物理位置
+    size_type size_;            // 元素个数
+    circular_buffer_mode mode_; // 容量策略
+
+   public:
+    // 构造、复制、移动、析构函数
+    circular_buffer() noexcept { init_empty(circular_grow); }
+
+    explicit circular_buffer(const allocator_type& alloc) noexcept : holder_type(alloc) { init_empty(circular_grow); }
+
+    // 以 mode 指定的策略构造一个空的缓冲区，容量为不小于 cap 的 2 的幂
+    circular_buffer(size_type cap, circular_buffer_mode mode, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_empty(mode);
+        reserve(cap);
+    }
+
+    explicit circular_buffer(size_type n, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { fill_init(n, value_type()); }
+
+    circular_buffer(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { fill_init(n, value); }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    circular_buffer(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_empty(circular_grow);
+        try {
+            copy_assign(first, last, iterator_category(first));
+        } catch (...) {
+            clear();
+            release();
+            throw;
+        }
+    }
+
+    circular_buffer(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_empty(circular_grow);
+        try {
+            copy_assign(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag());
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    circular_buffer(const circular_buffer& rhs)
+        : holder_type(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) { copy_init(rhs); }
+
+    circular_buffer(const circular_buffer& rhs, const allocator_type& alloc)
+        : holder_type(alloc) { copy_init(rhs); }
+
+    circular_buffer(circular_buffer&& rhs) noexcept
+        : holder_type(MySTL::move(rhs.get_alloc())) { take(rhs); }
+
+    circular_buffer& operator=(const circular_buffer& rhs);
+    circular_buffer& operator=(circular_buffer&& rhs) noexcept(alloc_traits::is_always_equal::value);
+    circular_buffer& operator=(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag());
+        return *this;
+    }
+
+    ~circular_buffer() {
+        clear();
+        release();
+    }
+
+   public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(buf_, cap_ - 1, head_); }
+    const_iterator begin() const noexcept { return const_iterator(iterator(buf_, cap_ - 1, head_)); }
+    iterator end() noexcept { return iterator(buf_, cap_ - 1, head_ + size_); }
+    const_iterator end() const noexcept { return const_iterator(iterator(buf_, cap_ - 1, head_ + size_)); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == cap_; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return (static_cast<size_type>(-1) / 2 + 1) / sizeof(T); }
+    size_type capacity() const noexcept { return cap_; }
+    circular_buffer_mode mode() const noexcept { return mode_; }
+    void reserve(size_type n);
+    void shrink_to_fit();
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    // 访问元素相关操作
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size_);
+        return buf_[(head_ + n) & (cap_ - 1)];
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return buf_[(head_ + n) & (cap_ - 1)];
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return buf_[head_];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return buf_[head_];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return buf_[(head_ + size_ - 1) & (cap_ - 1)];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return buf_[(head_ + size_ - 1) & (cap_ - 1)];
+    }
+
+    // 连续区间相关操作
+    // as_spans 返回元素所在的两段区间，free_spans 返回空闲的两段区间，只用到一段时第二段为空
+    MySTL::pair<span_type, span_type> as_spans() noexcept;
+    MySTL::pair<const_span_type, const_span_type> as_spans() const noexcept;
+    MySTL::pair<span_type, span_type> free_spans() noexcept;
+    void commit_back(size_type n);
+    void consume_front(size_type n);
+
+    // 修改容器相关操作
+    // assign
+    void assign(size_type n, const value_type& value);
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) { copy_assign(first, last, iterator_category(first)); }
+    void assign(std::initializer_list<value_type> ilist) { copy_assign(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag()); }
+
+    // emplace_front / emplace_back
+    template <class... Args>
+    void emplace_front(Args&&... args);
+    template <class... Args>
+    void emplace_back(Args&&... args);
+
+    // push_front / push_back
+    void push_front(const value_type& value) { emplace_front(value); }
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_front(value_type&& value) { emplace_front(MySTL::move(value)); }
+    void push_back(value_type&& value) { emplace_back(MySTL::move(value)); }
+
+    // pop_back / pop_front
+    void pop_front();
+    void pop_back();
+
+    // clear / swap
+    void clear() noexcept;
+    void swap(circular_buffer& rhs) noexcept;
+
+   private:
+    // helper functions
+    size_type mask() const noexcept { return cap_ - 1; }
+    static size_type round_capacity(size_type n) noexcept;
+
+    // initialize / destroy
+    void init_empty(circular_buffer_mode mode) noexcept;
+    void fill_init(size_type n, const value_type& value);
+    void copy_init(const circular_buffer& rhs);
+    void release() noexcept;
+    void take(circular_buffer& rhs) noexcept;
+
+    // assign
+    template <class Iter>
+    void copy_assign(Iter first, Iter last, input_iterator_tag);
+    template <class Iter>
+    void copy_assign(Iter first, Iter last, forward_iterator_tag);
+
+    // reallocate
+    void require_space();
+    void reallocate(size_type new_cap);
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <class T, class Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(const circular_buffer& rhs) {
+    if (this != &rhs) {
+        clear();
+        if (alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的空间必须由原来的分配器释放
+            release();
+            init_empty(mode_);
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        }
+        mode_ = rhs.mode_;
+        if (cap_ < rhs.cap_)
+            reallocate(rhs.cap_);
+        auto spans = rhs.as_spans();
+        auto mid = MySTL::uninitialized_copy(spans.first.begin(), spans.first.end(), buf_);
+        try {
+            MySTL::uninitialized_copy(spans.second.begin(), spans.second.end(), mid);
+        } catch (...) {
+            MySTL::destroy(buf_, mid);
+            throw;
+        }
+        head_ = 0;
+        size_ = rhs.size_;
+    }
+    return *this;
+}
+
+// 移动赋值运算符
+template <class T, class Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(circular_buffer&& rhs) noexcept(alloc_traits::is_always_equal::value) {
+    if (this != &rhs) {
+        clear();
+        if (alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+            release();
+            MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+            take(rhs);
+        } else {
+            // 分配器不相等，不能直接接管对方的空间，只能逐个移动元素
+            mode_ = rhs.mode_;
+            if (cap_ < rhs.cap_)
+                reallocate(rhs.cap_);
+            for (size_type i = 0; i < rhs.size_; ++i)
+                emplace_back(MySTL::move(rhs[i]));
+            rhs.clear();
+        }
+    }
+    return *this;
+}
+
+// 预留空间，容量取不小于 n 的 2 的幂，元素搬到新空间后从物理位置 0 开始连续存放
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::reserve(size_type n) {
+    if (n <= cap_) return;
+    THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in circular_buffer<T>::reserve(n)");
+    reallocate(round_capacity(n));
+}
+
+// 放弃多余的容量，只在 circular_grow 下生效，其余策略的容量由使用者指定
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::shrink_to_fit() {
+    if (mode_ != circular_grow) return;
+    if (size_ == 0) {
+        release();
+        init_empty(mode_);
+        return;
+    }
+    const size_type new_cap = round_capacity(size_);
+    if (new_cap < cap_)
+        reallocate(new_cap);
+}
+
+// 重置容器大小
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::resize(size_type new_size, const value_type& value) {
+    while (size_ > new_size)
+        pop_back();
+    if (new_size > size_) {
+        if (new_size > cap_) {
+            THROW_LENGTH_ERROR_IF(mode_ != circular_grow, "circular_buffer<T>'s capacity is fixed");
+            const value_type value_copy = value;  // value 可能引用容器中的元素
+            reserve(MySTL::max(new_size, cap_ << 1));
+            while (size_ < new_size)
+                emplace_back(value_copy);
+        } else {
+            while (size_ < new_size)
+                emplace_back(value);
+        }
+    }
+}
+
+// 返回元素所在的两段区间
+template <class T, class Alloc>
+MySTL::pair<typename circular_buffer<T, Alloc>::span_type, typename circular_buffer<T, Alloc>::span_type>
+circular_buffer<T, Alloc>::as_spans() noexcept {
+    const size_type len = MySTL::min(size_, cap_ - head_);
+    return MySTL::pair<span_type, span_type>(span_type{buf_ + head_, len}, span_type{buf_, size_ - len});
+}
+
+template <class T, class Alloc>
+MySTL::pair<typename circular_buffer<T, Alloc>::const_span_type, typename circular_buffer<T, Alloc>::const_span_type>
+circular_buffer<T, Alloc>::as_spans() const noexcept {
+    const size_type len = MySTL::min(size_, cap_ - head_);
+    return MySTL::pair<const_span_type, const_span_type>(const_span_type{buf_ + head_, len},
+                                                         const_span_type{buf_, size_ - len});
+}
+
+// 返回尾部之后空闲的两段区间，依次填满这两段再调用 commit_back，元素就按顺序接在尾部
+template <class T, class Alloc>
+MySTL::pair<typename circular_buffer<T, Alloc>::span_type, typename circular_buffer<T, Alloc>::span_type>
+circular_buffer<T, Alloc>::free_spans() noexcept {
+    if (cap_ == 0)
+        return MySTL::pair<span_type, span_type>(span_type{buf_, 0}, span_type{buf_, 0});
+    const size_type tail = (head_ + size_) & mask();
+    const size_type room = cap_ - size_;
+    const size_type len = MySTL::min(room, cap_ - tail);
+    return MySTL::pair<span_type, span_type>(span_type{buf_ + tail, len}, span_type{buf_, room - len});
+}
+
+// 把 free_spans 中已经写入的前 n 个位置计入容器，这些位置只做默认初始化
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::commit_back(size_type n) {
+    MYSTL_DEBUG(n <= cap_ - size_);
+    auto spans = free_spans();
+    const size_type len = MySTL::min(n, spans.first.size);
+    MySTL::uninitialized_default_construct_n(spans.first.data, len);
+    try {
+        MySTL::uninitialized_default_construct_n(spans.second.data, n - len);
+    } catch (...) {
+        MySTL::destroy(spans.first.data, spans.first.data + len);
+        throw;
+    }
+    size_ += n;
+}
+
+// 从头部丢弃 n 个元素
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::consume_front(size_type n) {
+    MYSTL_DEBUG(n <= size_);
+    if (std::is_trivially_destructible<T>::value) {
+        head_ = (head_ + n) & mask();
+        size_ -= n;
+        return;
+    }
+    for (; n > 0; --n)
+        pop_front();
+}
+
+// assign 函数
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::assign(size_type n, const value_type& value) {
+    const value_type value_copy = value;  // value 可能引用容器中的元素
+    clear();
+    if (n > cap_) {
+        THROW_LENGTH_ERROR_IF(mode_ == circular_fixed, "circular_buffer<T>'s capacity is fixed");
+        if (mode_ == circular_grow)
+            reserve(n);
+        else
+            n = cap_;
+    }
+    MySTL::uninitialized_fill_n(buf_, n, value_copy);
+    head_ = 0;
+    size_ = n;
+}
+
+// 在头部就地构建元素
+template <class T, class Alloc>
+template <class... Args>
+void circular_buffer<T, Alloc>::emplace_front(Args&&... args) {
+    if (size_ == cap_) {
+        if (mode_ == circular_overwrite) {
+            // 满的缓冲区中尾部元素就在头部之前，覆盖它并把头部前移
+            THROW_LENGTH_ERROR_IF(cap_ == 0, "circular_buffer<T> has no capacity");
+            const size_type slot = (head_ - 1) & mask();
+            buf_[slot] = value_type(MySTL::forward<Args>(args)...);
+            head_ = slot;
+            return;
+        }
+        // 参数可能引用容器中的元素，先构造出新元素再扩容
+        value_type tmp(MySTL::forward<Args>(args)...);
+        require_space();
+        const size_type slot = (head_ - 1) & mask();
+        alloc_traits::construct(this->get_alloc(), buf_ + slot, MySTL::move(tmp));
+        head_ = slot;
+        ++size_;
+        return;
+    }
+    const size_type slot = (head_ - 1) & mask();
+    alloc_traits::construct(this->get_alloc(), buf_ + slot, MySTL::forward<Args>(args)...);
+    head_ = slot;
+    ++size_;
+}
+
+// 在尾部就地构建元素
+template <class T, class Alloc>
+template <class... Args>
+void circular_buffer<T, Alloc>::emplace_back(Args&&... args) {
+    if (size_ == cap_) {
+        if (mode_ == circular_overwrite) {
+            // 满的缓冲区中尾部之后就是头部元素，覆盖它并把头部后移
+            THROW_LENGTH_ERROR_IF(cap_ == 0, "circular_buffer<T> has no capacity");
+            buf_[head_] = value_type(MySTL::forward<Args>(args)...);
+            head_ = (head_ + 1) & mask();
+            return;
+        }
+        value_type tmp(MySTL::forward<Args>(args)...);
+        require_space();
+        alloc_traits::construct(this->get_alloc(), buf_ + ((head_ + size_) & mask()), MySTL::move(tmp));
+        ++size_;
+        return;
+    }
+    alloc_traits::construct(this->get_alloc(), buf_ + ((head_ + size_) & mask()), MySTL::forward<Args>(args)...);
+    ++size_;
+}
+
+// 弹出头部元素
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::pop_front() {
+    MYSTL_DEBUG(!empty());
+    alloc_traits::destroy(this->get_alloc(), buf_ + head_);
+    head_ = (head_ + 1) & mask();
+    --size_;
+}
+
+// 弹出尾部元素
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    --size_;
+    alloc_traits::destroy(this->get_alloc(), buf_ + ((head_ + size_) & mask()));
+}
+
+// 清空 circular_buffer，保留容量
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::clear() noexcept {
+    auto spans = as_spans();
+    MySTL::destroy(spans.first.begin(), spans.first.end());
+    MySTL::destroy(spans.second.begin(), spans.second.end());
+    head_ = 0;
+    size_ = 0;
+}
+
+// 交换两个 circular_buffer
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::swap(circular_buffer& rhs) noexcept {
+    if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
+        MySTL::swap(buf_, rhs.buf_);
+        MySTL::swap(cap_, rhs.cap_);
+        MySTL::swap(head_, rhs.head_);
+        MySTL::swap(size_, rhs.size_);
+        MySTL::swap(mode_, rhs.mode_);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// round_capacity 函数，返回不小于 n 的 2 的幂
+template <class T, class Alloc>
+typename circular_buffer<T, Alloc>::size_type circular_buffer<T, Alloc>::round_capacity(size_type n) noexcept {
+    size_type cap = 1;
+    while (cap < n)
+        cap <<= 1;
+    return cap;
+}
+
+// init_empty 函数
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::init_empty(circular_buffer_mode mode) noexcept {
+    buf_ = nullptr;
+    cap_ = 0;
+    head_ = 0;
+    size_ = 0;
+    mode_ = mode;
+}
+
+// fill_init 函数
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::fill_init(size_type n, const value_type& value) {
+    init_empty(circular_grow);
+    if (n == 0) return;
+    reserve(n);
+    try {
+        MySTL::uninitialized_fill_n(buf_, n, value);
+    } catch (...) {
+        release();
+        throw;
+    }
+    size_ = n;
+}
+
+// copy_init 函数，复制元素、容量与容量策略
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::copy_init(const circular_buffer& rhs) {
+    init_empty(rhs.mode_);
+    if (rhs.cap_ == 0) return;
+    reallocate(rhs.cap_);
+    auto spans = rhs.as_spans();
+    try {
+        auto mid = MySTL::uninitialized_copy(spans.first.begin(), spans.first.end(), buf_);
+        MySTL::uninitialized_copy(spans.second.begin(), spans.second.end(), mid);
+    } catch (...) {
+        release();
+        throw;
+    }
+    size_ = rhs.size_;
+}
+
+// release 函数，元素已经析构，只释放空间
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::release() noexcept {
+    if (buf_ != nullptr)
+        alloc_traits::deallocate(this->get_alloc(), buf_, cap_);
+    buf_ = nullptr;
+    cap_ = 0;
+}
+
+// take 函数，当前容器没有空间或空间已经释放，接管 rhs 的空间与元素，rhs 随后为空
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::take(circular_buffer& rhs) noexcept {
+    buf_ = rhs.buf_;
+    cap_ = rhs.cap_;
+    head_ = rhs.head_;
+    size_ = rhs.size_;
+    mode_ = rhs.mode_;
+    rhs.init_empty(rhs.mode_);
+}
+
+// copy_assign 函数
+// 元素多于容量时，circular_grow 扩容，circular_fixed 抛出异常，circular_overwrite 只保留最后 capacity() 个元素
+template <class T, class Alloc>
+template <class Iter>
+void circular_buffer<T, Alloc>::copy_assign(Iter first, Iter last, input_iterator_tag) {
+    clear();
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+template <class T, class Alloc>
+template <class Iter>
+void circular_buffer<T, Alloc>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
+    size_type n = MySTL::distance(first, last);
+    clear();
+    if (n > cap_) {
+        THROW_LENGTH_ERROR_IF(mode_ == circular_fixed, "circular_buffer<T>'s capacity is fixed");
+        if (mode_ == circular_grow) {
+            reserve(n);
+        } else {
+            MySTL::advance(first, n - cap_);
+            n = cap_;
+        }
+    }
+    MySTL::uninitialized_copy(first, last, buf_);
+    size_ = n;
+}
+
+// require_space 函数，缓冲区已满时按容量策略扩容
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::require_space() {
+    THROW_LENGTH_ERROR_IF(mode_ == circular_fixed, "circular_buffer<T>'s capacity is fixed");
+    THROW_LENGTH_ERROR_IF(cap_ > max_size() / 2, "circular_buffer<T>'s size is too big");
+    reallocate(cap_ == 0 ? static_cast<size_type>(CIRCULAR_BUFFER_INIT_SIZE) : cap_ << 1);
+}
+
+// reallocate 函数
+// 申请容量为 new_cap 的空间，把两段元素依次搬到物理位置 0 开始的位置，失败时容器保持不变
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::reallocate(size_type new_cap) {
+    MYSTL_DEBUG(new_cap >= size_);
+    pointer new_buf = alloc_traits::allocate(this->get_alloc(), new_cap);
+    auto spans = as_spans();
+    if (relocate_tag::value) {
+        auto mid = MySTL::uninitialized_relocate(spans.first.begin(), spans.first.end(), new_buf);
+        MySTL::uninitialized_relocate(spans.second.begin(), spans.second.end(), mid);
+    } else {
+        pointer mid = new_buf;
+        try {
+            // 移动构造可能抛出异常时复制元素，失败时原有元素保持不变
+            mid = MySTL::uninitialized_move_if_noexcept(spans.first.begin(), spans.first.end(), new_buf);
+            MySTL::uninitialized_move_if_noexcept(spans.second.begin(), spans.second.end(), mid);
+        } catch (...) {
+            MySTL::destroy(new_buf, mid);
+            alloc_traits::deallocate(this->get_alloc(), new_buf, new_cap);
+            throw;
+        }
+        MySTL::destroy(spans.first.begin(), spans.first.end());
+        MySTL::destroy(spans.second.begin(), spans.second.end());
+    }
+    release();
+    buf_ = new_buf;
+    cap_ = new_cap;
+    head_ = 0;
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+template <class T, class Alloc>
+bool operator==(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator<(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator!=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator>(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, class Alloc>
+void swap(circular_buffer<T, Alloc>& lhs, circular_buffer<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// circular_buffer 的空间在堆上，不指向对象自身
+template <class T, class Alloc>
+struct is_trivially_relocatable<circular_buffer<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+}  // namespace MySTL
+#endif
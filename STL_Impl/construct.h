@@ -9,6 +9,7 @@
 
 #include "iterator.h"
 #include "type_traits.h"
+#include "util.h"
 
 namespace MySTL {
 // construct 构造对象
@@ -37,18 +38,18 @@ void destroy_one(T* ptr, std::false_type) {
         ptr->~T();
 }
 
+template <class T>
+void destroy(T* ptr) {
+    destroy_one(ptr, std::is_trivially_destructible<T>{});
+}
+
 template <class ForwardIter>
 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
 
 template <class ForwardIter>
 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
     for (; first != last; ++first)
-        destroy(&*first);
-}
-
-template <class T>
-void destroy(T* ptr) {
-    destroy_one(ptr, std::is_trivially_destructible<T>{});
+        MySTL::destroy(&*first);
 }
 
 template <class ForwardIter>
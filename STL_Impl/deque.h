@@ -14,6 +14,15 @@
 //   * push_front
 //   * push_back
 //   * insert
+//
+// 元素类型满足 is_trivially_relocatable 时，insert 与 erase 在缓冲区之间逐段 memmove 元素，不再逐个复制
+//
+// 模板参数 BufSiz 指定每个缓冲区的元素个数：大元素可以用更大的缓冲区减少 map 的开销，
+// 队列负载下的小元素也可以用更大的缓冲区减少缓冲区的分配与释放，缺省时与原来的大小相同
+//
+// 释放的缓冲区先放进容量为 DEQUE_SPARE_BUFFER 的缓存，之后需要缓冲区时优先从缓存取出；
+// map 一端用完而整体仍很空时就地把已用部分移到中央，不重新分配 map。
+// 因此稳定状态下的 push_back/pop_front 不再申请或释放内存，shrink_to_fit 与 clear 会释放缓存
 
 #include <initializer_list>
 
@@ -39,16 +48,27 @@ namespace MySTL {
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
-template <class T>
+// deque 缓存的空闲缓冲区个数上限
+#ifndef DEQUE_SPARE_BUFFER
+#define DEQUE_SPARE_BUFFER 2
+#endif
+
+// 每个缓冲区容纳的元素个数，BufSiz 不为 0 时就是 BufSiz，
+// 否则缺省为 4096 字节能放下的元素个数，元素不小于 256 字节时为 16 个
+template <class T, size_t BufSiz = 0>
 struct deque_buf_size {
-    static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+    static constexpr size_t value = BufSiz != 0 ? BufSiz : (sizeof(T) < 256 ? 4096 / sizeof(T) : 16);
 };
 
+template <class T, size_t BufSiz>
+constexpr size_t deque_buf_size<T, BufSiz>::value;
+
 // deque 的迭代器设计
-template <class T, class Ref, class Ptr>
+// 模板参数 BufSiz 与所属 deque 的相同，决定缓冲区的大小
+template <class T, class Ref, class Ptr, size_t BufSiz = 0>
 struct deque_iterator : public iterator<random_access_iterator_tag, T> {
-    typedef deque_iterator<T, T&, T*> iterator;
-    typedef deque_iterator<T, const T&, const T*> const_iterator;
+    typedef deque_iterator<T, T&, T*, BufSiz> iterator;
+    typedef deque_iterator<T, const T&, const T*, BufSiz> const_iterator;
     typedef deque_iterator self;
 
     typedef T value_type;
@@ -59,7 +79,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
     typedef T* value_pointer;
     typedef T** map_pointer;
 
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    static const size_type buffer_size = deque_buf_size<T, BufSiz>::value;
 
     // 迭代器所含成员数据
     value_pointer cur;    // 指向所在缓冲区的当前元素
@@ -143,7 +163,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
 
     self& operator+=(difference_type n) {
         const auto offset = n + (cur - first);
-        if (offset > 0 && offset < static_cast<difference_type>(buffer_size)) {
+        if (offset >= 0 && offset < static_cast<difference_type>(buffer_size)) {
             // 当前仍在缓冲区
             cur += n;
         } else {
@@ -182,78 +202,92 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
 };
 
 // 模板类 deque
-// 模板参数代表数据类型
-template <class T>
-class deque {
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型，缺省使用 MySTL::allocator，map 的分配器由它 rebind 得到
+// BufSiz 代表每个缓冲区容纳的元素个数，缺省为 0，由 deque_buf_size 按元素大小决定
+template <class T, class Alloc = MySTL::allocator<T>, size_t BufSiz = 0>
+class deque : private alloc_holder<Alloc> {
    public:
     // deque的类型定义
-    typedef MySTL::allocator<T> allocator_type;
-    typedef MySTL::allocator<T> data_allocator;
-    typedef MySTL::allocator<T*> map_allocator;
-
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<T*> map_allocator;
+    typedef MySTL::allocator_traits<Alloc> alloc_traits;
+    typedef MySTL::allocator_traits<map_allocator> map_alloc_traits;
+    typedef MySTL::alloc_holder<Alloc> holder_type;
+    typedef typename MySTL::is_trivially_relocatable<T>::type relocate_tag;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
 
     typedef pointer* map_pointer;
     typedef const_pointer* const_map_pointer;
 
-    typedef deque_iterator<T, T&, T*> iterator;
-    typedef deque_iterator<T, const T&, const T*> const_iterator;
+    typedef deque_iterator<T, T&, T*, BufSiz> iterator;
+    typedef deque_iterator<T, const T&, const T*, BufSiz> const_iterator;
     typedef MySTL::reverse_iterator<iterator> reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() { return allocator_type(); }
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    allocator_type get_allocator() const { return this->get_alloc(); }
+    static const size_type buffer_size = deque_buf_size<T, BufSiz>::value;
 
    private:
+    static const size_type spare_capacity = DEQUE_SPARE_BUFFER > 0 ? DEQUE_SPARE_BUFFER : 1;
+
     // 用以下四个数据来表现一个 deque
     iterator begin_;      // 指向第一个节点
     iterator end_;        // 指向最后一个结点
     map_pointer map_;     // 指向一块 map，map 中的每个元素都是一个指针，指向一个缓冲区
     size_type map_size_;  // map 内指针的数目
+    pointer spare_[spare_capacity];  // 缓存的空闲缓冲区
+    size_type spare_size_ = 0;       // 缓存的空闲缓冲区个数
 
    public:
     // 构造、复制、移动、析构函数
     deque() { fill_init(0, value_type()); }
 
-    explicit deque(size_type n) { fill_init(n, value_type()); }
+    explicit deque(const allocator_type& alloc) : holder_type(alloc) { fill_init(0, value_type()); }
+
+    explicit deque(size_type n, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { fill_init(n, value_type()); }
 
-    deque(size_type n, const value_type& value) { fill_init(0, value); }
+    deque(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { fill_init(n, value); }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    deque(Iter first, Iter last) { copy_init(first, last, iterator_category(first)); }
+    deque(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { copy_init(first, last, iterator_category(first)); }
 
-    deque(std::initializer_list<value_type> ilist) { copy_init(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag()); }
+    deque(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { copy_init(ilist.begin(), ilist.end(), MySTL::forward_iterator_tag()); }
+
+    deque(const deque& rhs)
+        : holder_type(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        copy_init(rhs.begin(), rhs.end(), MySTL::forward_iterator_tag());
+    }
 
-    deque(const deque& rhs) { copy_init(rhs.begin(), rhs.end(), MySTL::forward_iterator_tag()); }
+    deque(const deque& rhs, const allocator_type& alloc)
+        : holder_type(alloc) { copy_init(rhs.begin(), rhs.end(), MySTL::forward_iterator_tag()); }
 
-    deque(deque&& rhs) noexcept : begin_(MySTL::move(rhs.begin_)), end_(MySTL::move(rhs.end_)), map_(rhs.map_), map_size_(rhs.map_size_) {
+    deque(deque&& rhs) noexcept
+        : holder_type(MySTL::move(rhs.get_alloc())), begin_(MySTL::move(rhs.begin_)), end_(MySTL::move(rhs.end_)), map_(rhs.map_), map_size_(rhs.map_size_) {
         rhs.map_ = nullptr;
         rhs.map_size_ = 0;
+        take_spare(rhs);
     }
 
     deque& operator=(const deque& rhs);
-    deque& operator=(deque&& rhs);
+    deque& operator=(deque&& rhs) noexcept(alloc_traits::is_always_equal::value);
     deque& operator=(std::initializer_list<value_type> ilist) {
-        deque tmp(ilist);
+        deque tmp(ilist, get_allocator());
         swap(tmp);
         return *this;
     }
 
-    ~deque() {
-        if (map_ != nullptr) {
-            clear();
-            data_allocator::deallocate(*begin_.node, buffer_size);
-            *begin_.node = nullptr;
-            map_allocator::deallocate(map_, map_size_);
-            map_ = nullptr;
-        }
-    }
+    ~deque() { tidy(); }
 
    public:
     // 迭代器相关操作
@@ -367,8 +401,20 @@ class deque {
     // helper functions
     // create node / destroy node
     map_pointer create_map(size_type size);
+    void destroy_map(map_pointer mp, size_type size) noexcept;
     void create_buffer(map_pointer nstart, map_pointer nfinish);
     void destroy_buffer(map_pointer nstart, map_pointer nfinish);
+    pointer allocate_buffer();
+    void deallocate_buffer(pointer buf) noexcept;
+    void release_spare() noexcept;
+    void take_spare(deque& rhs) noexcept;
+    void tidy() noexcept;
+    void drop_front(size_type n);
+    void drop_back(size_type n);
+
+    // relocate
+    static void relocate_down(iterator first, iterator last, iterator result) noexcept;
+    static void relocate_up(iterator first, iterator last, iterator result) noexcept;
 
     // initialize
     void map_init(size_type nelem);
@@ -400,13 +446,20 @@ class deque {
     void require_capacity(size_type n, bool front);
     void reallocate_map_at_front(size_type need);
     void reallocate_map_at_back(size_type need);
+    void recenter_map(map_pointer nstart) noexcept;
 };
 
 /****************************************函数实现****************************************/
 // 复制赋值运算符
-template <class T>
-deque<T>& deque<T>::operator=(const deque& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+deque<T, Alloc, BufSiz>& deque<T, Alloc, BufSiz>::operator=(const deque& rhs) {
     if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的缓冲区与 map 必须由原来的分配器释放
+            tidy();
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+            map_init(0);
+        }
         const auto len = size();
         if (len > rhs.size())
             erase(MySTL::copy(rhs.begin_, rhs.end_, begin_), end_);
@@ -420,21 +473,31 @@ deque<T>& deque<T>::operator=(const deque& rhs) {
 }
 
 // 移动赋值运算符
-template <class T>
-deque<T>& deque<T>::operator=(deque&& rhs) {
-    clear();
-    begin_ = MySTL::move(rhs.begin_);
-    end_ = MySTL::move(rhs.end_);
-    map_ = rhs.map_;
-    map_size_ = rhs.map_size_;
-    rhs.map_ = nullptr;
-    rhs.map_size_ = 0;
+template <class T, class Alloc, size_t BufSiz>
+deque<T, Alloc, BufSiz>& deque<T, Alloc, BufSiz>::operator=(deque&& rhs) noexcept(alloc_traits::is_always_equal::value) {
+    if (alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+        tidy();
+        MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+        begin_ = MySTL::move(rhs.begin_);
+        end_ = MySTL::move(rhs.end_);
+        map_ = rhs.map_;
+        map_size_ = rhs.map_size_;
+        rhs.map_ = nullptr;
+        rhs.map_size_ = 0;
+        take_spare(rhs);
+    } else {
+        // 分配器不相等，不能直接接管对方的缓冲区，只能逐个移动元素
+        clear();
+        for (auto it = rhs.begin(); it != rhs.end(); ++it)
+            emplace_back(MySTL::move(*it));
+        rhs.clear();
+    }
     return *this;
 }
 
 // 重置容器大小
-template <class T>
-void deque<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::resize(size_type new_size, const value_type& value) {
     const auto len = size();
     if (new_size < len) {
         erase(begin_ + new_size, end_);
@@ -444,31 +507,34 @@ void deque<T>::resize(size_type new_size, const value_type& value) {
 }
 
 // 减小容器容量
-template <class T>
-void deque<T>::shrink_to_fit() noexcept {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::shrink_to_fit() noexcept {
     // 至少会留下头部缓冲区
     for (auto cur = map_; cur < begin_.node; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
+        if (*cur != nullptr)
+            alloc_traits::deallocate(this->get_alloc(), *cur, buffer_size);
         *cur = nullptr;
     }
     for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
+        if (*cur != nullptr)
+            alloc_traits::deallocate(this->get_alloc(), *cur, buffer_size);
         *cur = nullptr;
     }
+    release_spare();
 }
 
 // 在头部就地构建元素
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class... Args>
-void deque<T>::emplace_front(Args&&... args) {
+void deque<T, Alloc, BufSiz>::emplace_front(Args&&... args) {
     if (begin_.cur != begin_.first) {
-        data_allocator::construct(begin_.cur - 1, MySTL::forward<Args>(args)...);
+        alloc_traits::construct(this->get_alloc(), begin_.cur - 1, MySTL::forward<Args>(args)...);
         --begin_.cur;
     } else {
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator::construct(begin_.cur, MySTL::forward<Args>(args)...);
+            alloc_traits::construct(this->get_alloc(), begin_.cur, MySTL::forward<Args>(args)...);
         } catch (...) {
             ++begin_;
             throw;
@@ -477,23 +543,23 @@ void deque<T>::emplace_front(Args&&... args) {
 }
 
 // 在尾部就地构建元素
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class... Args>
-void deque<T>::emplace_back(Args&&... args) {
+void deque<T, Alloc, BufSiz>::emplace_back(Args&&... args) {
     if (end_.cur != end_.last - 1) {
-        data_allocator::construct(end_.cur, MySTL::forward<Args>(args)...);
+        alloc_traits::construct(this->get_alloc(), end_.cur, MySTL::forward<Args>(args)...);
         ++end_.cur;
     } else {
         require_capacity(1, false);
-        data_allocator::construct(end_.cur, MySTL::forward<Args>(args)...);
+        alloc_traits::construct(this->get_alloc(), end_.cur, MySTL::forward<Args>(args)...);
         ++end_;
     }
 }
 
 // 在 pos 位置就地构建元素
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class... Args>
-typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&&... args) {
+typename deque<T, Alloc, BufSiz>::iterator deque<T, Alloc, BufSiz>::emplace(iterator pos, Args&&... args) {
     if (pos.cur == begin_.cur) {
         emplace_front(MySTL::forward<Args>(args)...);
         return begin_;
@@ -505,16 +571,16 @@ typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&&... args) {
 }
 
 // 在头部插入元素
-template <class T>
-void deque<T>::push_front(const value_type& value) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::push_front(const value_type& value) {
     if (begin_.cur != begin_.first) {
-        data_allocator::construct(begin_.cur - 1, value);
+        alloc_traits::construct(this->get_alloc(), begin_.cur - 1, value);
         --begin_.cur;
     } else {
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator::construct(begin_.cur, value);
+            alloc_traits::construct(this->get_alloc(), begin_.cur, value);
         } catch (...) {
             ++begin_;
             throw;
@@ -523,50 +589,50 @@ void deque<T>::push_front(const value_type& value) {
 }
 
 // 在尾部插入元素
-template <class T>
-void deque<T>::push_back(const value_type& value) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::push_back(const value_type& value) {
     if (end_.cur != end_.last - 1) {
-        data_allocator::construct(end_.cur, value);
+        alloc_traits::construct(this->get_alloc(), end_.cur, value);
         ++end_.cur;
     } else {
         require_capacity(1, false);
-        data_allocator::construct(end_.cur, value);
+        alloc_traits::construct(this->get_alloc(), end_.cur, value);
         ++end_;
     }
 }
 
 // 弹出头部元素
-template <class T>
-void deque<T>::pop_front() {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::pop_front() {
     MYSTL_DEBUG(!empty());
     if (begin_.cur != begin_.last - 1) {
-        data_allocator::destroy(begin_.cur);
+        alloc_traits::destroy(this->get_alloc(), begin_.cur);
         ++begin_.cur;
     } else {
-        data_allocator::destroy(begin_.cur);
+        alloc_traits::destroy(this->get_alloc(), begin_.cur);
         ++begin_;
         destroy_buffer(begin_.node - 1, begin_.node - 1);
     }
 }
 
 // 弹出尾部元素
-template <class T>
-void deque<T>::pop_back() {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::pop_back() {
     MYSTL_DEBUG(!empty());
     if (end_.cur != end_.first) {
         --end_.cur;
-        data_allocator::destroy(end_.cur);
+        alloc_traits::destroy(this->get_alloc(), end_.cur);
     } else {
         --end_;
-        data_allocator::destroy(end_.cur);
+        alloc_traits::destroy(this->get_alloc(), end_.cur);
         destroy_buffer(end_.node + 1, end_.node + 1);
     }
 }
 
 // 在 position 处插入元素
-template <class T>
-typename deque<T>::iterator
-deque<T>::insert(iterator position, const value_type& value) {
+template <class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::insert(iterator position, const value_type& value) {
     if (position.cur == begin_.cur) {
         push_front(value);
         return begin_;
@@ -580,9 +646,9 @@ deque<T>::insert(iterator position, const value_type& value) {
     }
 }
 
-template <class T>
-typename deque<T>::iterator
-deque<T>::insert(iterator position, value_type&& value) {
+template <class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::insert(iterator position, value_type&& value) {
     if (position.cur == begin_.cur) {
         emplace_front(MySTL::move(value));
         return begin_;
@@ -597,8 +663,8 @@ deque<T>::insert(iterator position, value_type&& value) {
 }
 
 // 在 position 位置插入 n 个元素
-template <class T>
-void deque<T>::insert(iterator position, size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::insert(iterator position, size_type n, const value_type& value) {
     if (position.cur == begin_.cur) {
         require_capacity(n, true);
         auto new_begin = begin_ - n;
@@ -615,13 +681,22 @@ void deque<T>::insert(iterator position, size_type n, const value_type& value) {
 }
 
 // 删除 position 处的元素
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator position) {
+template <class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::erase(iterator position) {
     auto next = position;
     ++next;
     const size_type elems_before = position - begin_;
-    if (elems_before < (size() / 2)) {
+    if (relocate_tag::value) {
+        alloc_traits::destroy(this->get_alloc(), position.cur);
+        if (elems_before < (size() / 2)) {
+            relocate_up(begin_, position, next);
+            drop_front(1);
+        } else {
+            relocate_down(next, end_, position);
+            drop_back(1);
+        }
+    } else if (elems_before < (size() / 2)) {
         MySTL::copy_backward(begin_, position, next);
         pop_front();
     } else {
@@ -632,36 +707,43 @@ deque<T>::erase(iterator position) {
 }
 
 // 删除[first, last)上的元素
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator first, iterator last) {
+template <class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::erase(iterator first, iterator last) {
     if (first == begin_ && last == end_) {
         clear();
         return end_;
     } else {
         const size_type len = last - first;
         const size_type elems_before = first - begin_;
-        if (elems_before < ((size() - len) / 2)) {
+        if (relocate_tag::value) {
+            MySTL::destroy(first, last);
+            if (elems_before < ((size() - len) / 2)) {
+                relocate_up(begin_, first, last);
+                drop_front(len);
+            } else {
+                relocate_down(last, end_, first);
+                drop_back(len);
+            }
+        } else if (elems_before < ((size() - len) / 2)) {
             MySTL::copy_backward(begin_, first, last);
-            auto new_begin = begin_ + len;
-            data_allocator::destroy(begin_.cur, new_begin.cur);
-            begin_ = new_begin;
+            MySTL::destroy(begin_, begin_ + len);
+            drop_front(len);
         } else {
             MySTL::copy(last, end_, first);
-            auto new_end = end_ - len;
-            data_allocator::destroy(new_end.cur, end_.cur);
-            end_ = new_end;
+            MySTL::destroy(end_ - len, end_);
+            drop_back(len);
         }
         return begin_ + elems_before;
     }
 }
 
 // 清空 deque
-template <class T>
-void deque<T>::clear() {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::clear() {
     // clear 会保留头部的缓冲区
     for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur) {
-        data_allocator::destroy(*cur, *cur + buffer_size);
+        alloc_traits::destroy(this->get_alloc(), *cur, *cur + buffer_size);
     }
     if (begin_.node != end_.node) {  // 有两个以上的缓冲区
         MySTL::destroy(begin_.cur, begin_.last);
@@ -669,47 +751,59 @@ void deque<T>::clear() {
     } else {
         MySTL::destroy(begin_.cur, end_.cur);
     }
-    shrink_to_fit();
+    // 先收拢 end_，shrink_to_fit 才会释放头部以外的所有缓冲区
     end_ = begin_;
+    shrink_to_fit();
 }
 
 // 交换两个 deque
-template <class T>
-void deque<T>::swap(deque& rhs) noexcept {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::swap(deque& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
         MySTL::swap(begin_, rhs.begin_);
         MySTL::swap(end_, rhs.end_);
         MySTL::swap(map_, rhs.map_);
         MySTL::swap(map_size_, rhs.map_size_);
+        for (size_type i = 0; i < spare_capacity; ++i)
+            MySTL::swap(spare_[i], rhs.spare_[i]);
+        MySTL::swap(spare_size_, rhs.spare_size_);
     }
 }
 
 /*****************************************************************************************/
 // helper function
 
-template <class T>
-typename deque<T>::map_pointer
-deque<T>::create_map(size_type size) {
-    map_pointer mp = nullptr;
-    mp = map_allocator::allocate(size);
+template <class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::map_pointer
+deque<T, Alloc, BufSiz>::create_map(size_type size) {
+    map_allocator map_alloc(this->get_alloc());
+    map_pointer mp = map_alloc_traits::allocate(map_alloc, size);
     for (size_type i = 0; i < size; ++i)
         *(mp + i) = nullptr;
     return mp;
 }
 
+// destroy_map 函数
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::destroy_map(map_pointer mp, size_type size) noexcept {
+    map_allocator map_alloc(this->get_alloc());
+    map_alloc_traits::deallocate(map_alloc, mp, size);
+}
+
 // create_buffer 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::
     create_buffer(map_pointer nstart, map_pointer nfinish) {
     map_pointer cur;
     try {
         for (cur = nstart; cur <= nfinish; ++cur) {
-            *cur = data_allocator::allocate(buffer_size);
+            *cur = allocate_buffer();
         }
     } catch (...) {
         while (cur != nstart) {
             --cur;
-            data_allocator::deallocate(*cur, buffer_size);
+            deallocate_buffer(*cur);
             *cur = nullptr;
         }
         throw;
@@ -717,18 +811,125 @@ void deque<T>::
 }
 
 // destroy_buffer 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::
     destroy_buffer(map_pointer nstart, map_pointer nfinish) {
     for (map_pointer n = nstart; n <= nfinish; ++n) {
-        data_allocator::deallocate(*n, buffer_size);
+        deallocate_buffer(*n);
         *n = nullptr;
     }
 }
 
+// allocate_buffer 函数，优先取出缓存的空闲缓冲区
+template <class T, class Alloc, size_t BufSiz>
+typename deque<T, Alloc, BufSiz>::pointer
+deque<T, Alloc, BufSiz>::allocate_buffer() {
+    if (spare_size_ != 0)
+        return spare_[--spare_size_];
+    return alloc_traits::allocate(this->get_alloc(), buffer_size);
+}
+
+// deallocate_buffer 函数，缓存未满时留下缓冲区，否则交还分配器
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::deallocate_buffer(pointer buf) noexcept {
+    if (spare_size_ < spare_capacity)
+        spare_[spare_size_++] = buf;
+    else
+        alloc_traits::deallocate(this->get_alloc(), buf, buffer_size);
+}
+
+// release_spare 函数，把缓存的空闲缓冲区全部交还分配器
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::release_spare() noexcept {
+    while (spare_size_ != 0)
+        alloc_traits::deallocate(this->get_alloc(), spare_[--spare_size_], buffer_size);
+}
+
+// take_spare 函数，接管 rhs 缓存的空闲缓冲区，调用前自身的缓存必须为空
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::take_spare(deque& rhs) noexcept {
+    for (size_type i = 0; i < rhs.spare_size_; ++i)
+        spare_[i] = rhs.spare_[i];
+    spare_size_ = rhs.spare_size_;
+    rhs.spare_size_ = 0;
+}
+
+// tidy 函数，析构所有元素并释放全部缓冲区与 map
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::tidy() noexcept {
+    if (map_ != nullptr) {
+        clear();
+        alloc_traits::deallocate(this->get_alloc(), *begin_.node, buffer_size);
+        *begin_.node = nullptr;
+        destroy_map(map_, map_size_);
+        map_ = nullptr;
+        map_size_ = 0;
+    }
+}
+
+// drop_front / drop_back 函数
+// 从头部或尾部去掉 n 个已经析构或已经搬走的位置，释放空出来的缓冲区，否则之后 create_buffer 会把它们覆盖掉
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::drop_front(size_type n) {
+    auto new_begin = begin_ + n;
+    if (new_begin.node != begin_.node)
+        destroy_buffer(begin_.node, new_begin.node - 1);
+    begin_ = new_begin;
+}
+
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::drop_back(size_type n) {
+    auto new_end = end_ - n;
+    if (new_end.node != end_.node)
+        destroy_buffer(new_end.node + 1, end_.node);
+    end_ = new_end;
+}
+
+// relocate_down 函数
+// 把 [first, last) 按字节搬到以 result 为起始处的位置，result 在 first 之前，按缓冲区逐段从前往后搬运
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::relocate_down(iterator first, iterator last, iterator result) noexcept {
+    difference_type n = last - first;
+    while (n > 0) {
+        const difference_type len = MySTL::min(n, MySTL::min(first.last - first.cur, result.last - result.cur));
+        MySTL::uninitialized_relocate(first.cur, first.cur + len, result.cur);
+        n -= len;
+        if (n == 0) break;
+        first += len;
+        result += len;
+    }
+}
+
+// relocate_up 函数
+// 把 [first, last) 按字节搬到以 result 为结束处的位置，result 在 last 之后，按缓冲区逐段从后往前搬运
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::relocate_up(iterator first, iterator last, iterator result) noexcept {
+    difference_type n = last - first;
+    while (n > 0) {
+        difference_type llen = last.cur - last.first;
+        T* lend = last.cur;
+        if (llen == 0) {
+            llen = buffer_size;
+            lend = *(last.node - 1) + buffer_size;
+        }
+        difference_type rlen = result.cur - result.first;
+        T* rend = result.cur;
+        if (rlen == 0) {
+            rlen = buffer_size;
+            rend = *(result.node - 1) + buffer_size;
+        }
+        const difference_type len = MySTL::min(n, MySTL::min(llen, rlen));
+        MySTL::uninitialized_relocate(lend - len, lend, rend - len);
+        n -= len;
+        if (n == 0) break;
+        last -= len;
+        result -= len;
+    }
+}
+
 // map_init 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::
     map_init(size_type nElem) {
     const size_type nNode = nElem / buffer_size + 1;  // 需要分配的缓冲区个数
     map_size_ = MySTL::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE), nNode + 2);
@@ -746,7 +947,7 @@ void deque<T>::
     try {
         create_buffer(nstart, nfinish);
     } catch (...) {
-        map_allocator::deallocate(map_, map_size_);
+        destroy_map(map_, map_size_);
         map_ = nullptr;
         map_size_ = 0;
         throw;
@@ -758,8 +959,8 @@ void deque<T>::
 }
 
 // fill_init 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::
     fill_init(size_type n, const value_type& value) {
     map_init(n);
     if (n != 0) {
@@ -771,9 +972,9 @@ void deque<T>::
 }
 
 // copy_init 函数
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class IIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     copy_init(IIter first, IIter last, input_iterator_tag) {
     const size_type n = MySTL::distance(first, last);
     map_init(n);
@@ -781,9 +982,9 @@ void deque<T>::
         emplace_back(*first);
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     copy_init(FIter first, FIter last, forward_iterator_tag) {
     const size_type n = MySTL::distance(first, last);
     map_init(n);
@@ -797,8 +998,8 @@ void deque<T>::
 }
 
 // fill_assign 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::
     fill_assign(size_type n, const value_type& value) {
     if (n > size()) {
         MySTL::fill(begin(), end(), value);
@@ -810,9 +1011,9 @@ void deque<T>::
 }
 
 // copy_assign 函数
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class IIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     copy_assign(IIter first, IIter last, input_iterator_tag) {
     auto first1 = begin();
     auto last1 = end();
@@ -826,9 +1027,9 @@ void deque<T>::
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     copy_assign(FIter first, FIter last, forward_iterator_tag) {
     const size_type len1 = size();
     const size_type len2 = MySTL::distance(first, last);
@@ -843,12 +1044,31 @@ void deque<T>::
 }
 
 // insert_aux 函数
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class... Args>
-typename deque<T>::iterator
-deque<T>::
+typename deque<T, Alloc, BufSiz>::iterator
+deque<T, Alloc, BufSiz>::
     insert_aux(iterator position, Args&&... args) {
     const size_type elems_before = position - begin_;
+    if (relocate_tag::value) {
+        // 先预留空间并在临时空间构造新元素，之后的搬运不会失败
+        const bool front_half = elems_before < (size() / 2);
+        require_capacity(1, front_half);
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T* tmp = reinterpret_cast<T*>(&buf);
+        alloc_traits::construct(this->get_alloc(), tmp, MySTL::forward<Args>(args)...);
+        if (front_half) {
+            auto new_begin = begin_ - 1;
+            relocate_down(begin_, begin_ + elems_before, new_begin);
+            begin_ = new_begin;
+        } else {
+            relocate_up(begin_ + elems_before, end_, end_ + 1);
+            ++end_;
+        }
+        position = begin_ + elems_before;
+        MySTL::uninitialized_relocate(tmp, tmp + 1, position.cur);
+        return position;
+    }
     value_type value_copy = value_type(MySTL::forward<Args>(args)...);
     if (elems_before < (size() / 2)) {  // 在前半段插入
         emplace_front(front());
@@ -874,8 +1094,8 @@ deque<T>::
 }
 
 // fill_insert 函数
-template <class T>
-void deque<T>::
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::
     fill_insert(iterator position, size_type n, const value_type& value) {
     const size_type elems_before = position - begin_;
     const size_type len = size();
@@ -933,9 +1153,9 @@ void deque<T>::
 }
 
 // copy_insert
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     copy_insert(iterator position, FIter first, FIter last, size_type n) {
     const size_type elems_before = position - begin_;
     auto len = size();
@@ -996,9 +1216,9 @@ void deque<T>::
 }
 
 // insert_dispatch 函数
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class IIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag) {
     if (last <= first) return;
     const size_type n = MySTL::distance(first, last);
@@ -1015,9 +1235,9 @@ void deque<T>::
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSiz>
 template <class FIter>
-void deque<T>::
+void deque<T, Alloc, BufSiz>::
     insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag) {
     if (last <= first) return;
     const size_type n = MySTL::distance(first, last);
@@ -1049,17 +1269,18 @@ void deque<T>::
 }
 
 // require_capacity 函数
-template <class T>
-void deque<T>::require_capacity(size_type n, bool front) {
+// 只分配恰好容纳 n 个新元素的缓冲区，多分配的缓冲区不在 [begin_.node, end_.node] 之内，重新分配 map 时会丢失
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::require_capacity(size_type n, bool front) {
     if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n)) {
-        const size_type need_buffer = (n - (begin_.cur - begin_.first)) / buffer_size + 1;
+        const size_type need_buffer = (n - (begin_.cur - begin_.first) + buffer_size - 1) / buffer_size;
         if (need_buffer > static_cast<size_type>(begin_.node - map_)) {
             reallocate_map_at_front(need_buffer);
             return;
         }
         create_buffer(begin_.node - need_buffer, begin_.node - 1);
     } else if (!front && (static_cast<size_type>(end_.last - end_.cur - 1) < n)) {
-        const size_type need_buffer = (n - (end_.last - end_.cur - 1)) / buffer_size + 1;
+        const size_type need_buffer = (n - (end_.last - end_.cur - 1) + buffer_size - 1) / buffer_size;
         if (need_buffer > static_cast<size_type>((map_ + map_size_) - end_.node - 1)) {
             reallocate_map_at_back(need_buffer);
             return;
@@ -1069,12 +1290,20 @@ void deque<T>::require_capacity(size_type n, bool front) {
 }
 
 // reallocate_map_at_front 函数
-template <class T>
-void deque<T>::reallocate_map_at_front(size_type need_buffer) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::reallocate_map_at_front(size_type need_buffer) {
+    const size_type old_buffer = end_.node - begin_.node + 1;
+    if (map_size_ > 2 * (old_buffer + need_buffer)) {
+        // map 仍有一半以上空着，只是已用部分偏向了头部，就地移到中央
+        auto begin = map_ + (map_size_ - old_buffer - need_buffer) / 2;
+        auto mid = begin + need_buffer;
+        recenter_map(mid);
+        create_buffer(begin, mid - 1);
+        return;
+    }
     const size_type new_map_size = MySTL::max(map_size_ << 1,
                                               map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
     map_pointer new_map = create_map(new_map_size);
-    const size_type old_buffer = end_.node - begin_.node + 1;
     const size_type new_buffer = old_buffer + need_buffer;
 
     // 另新的 map 中的指针指向原来的 buffer，并开辟新的 buffer
@@ -1082,11 +1311,10 @@ void deque<T>::reallocate_map_at_front(size_type need_buffer) {
     auto mid = begin + need_buffer;
     auto end = mid + old_buffer;
     create_buffer(begin, mid - 1);
-    for (auto begin1 = mid, begin2 = begin_.node; begin1 != end; ++begin1, ++begin2)
-        *begin1 = *begin2;
+    MySTL::uninitialized_relocate(begin_.node, end_.node + 1, mid);
 
     // 更新数据
-    map_allocator::deallocate(map_, map_size_);
+    destroy_map(map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*mid + (begin_.cur - begin_.first), mid);
@@ -1094,68 +1322,104 @@ void deque<T>::reallocate_map_at_front(size_type need_buffer) {
 }
 
 // reallocate_map_at_back 函数
-template <class T>
-void deque<T>::reallocate_map_at_back(size_type need_buffer) {
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::reallocate_map_at_back(size_type need_buffer) {
+    const size_type old_buffer = end_.node - begin_.node + 1;
+    if (map_size_ > 2 * (old_buffer + need_buffer)) {
+        // map 仍有一半以上空着，只是已用部分偏向了尾部，就地移到中央
+        auto begin = map_ + (map_size_ - old_buffer - need_buffer) / 2;
+        recenter_map(begin);
+        create_buffer(begin + old_buffer, begin + old_buffer + need_buffer - 1);
+        return;
+    }
     const size_type new_map_size = MySTL::max(map_size_ << 1,
                                               map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
     map_pointer new_map = create_map(new_map_size);
-    const size_type old_buffer = end_.node - begin_.node + 1;
     const size_type new_buffer = old_buffer + need_buffer;
 
     // 另新的 map 中的指针指向原来的 buffer，并开辟新的 buffer
     auto begin = new_map + ((new_map_size - new_buffer) / 2);
     auto mid = begin + old_buffer;
     auto end = mid + need_buffer;
-    for (auto begin1 = begin, begin2 = begin_.node; begin1 != mid; ++begin1, ++begin2)
-        *begin1 = *begin2;
+    MySTL::uninitialized_relocate(begin_.node, end_.node + 1, begin);
     create_buffer(mid, end - 1);
 
     // 更新数据
-    map_allocator::deallocate(map_, map_size_);
+    destroy_map(map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
     end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
 }
 
+// recenter_map 函数
+// 把 [begin_.node, end_.node] 内的指针移到以 nstart 为起始处的位置，空出来的位置置空，缓冲区本身不动
+template <class T, class Alloc, size_t BufSiz>
+void deque<T, Alloc, BufSiz>::recenter_map(map_pointer nstart) noexcept {
+    const size_type old_buffer = end_.node - begin_.node + 1;
+    if (nstart == begin_.node)
+        return;
+    if (nstart < begin_.node) {
+        MySTL::copy(begin_.node, end_.node + 1, nstart);
+        MySTL::fill(MySTL::max(nstart + old_buffer, begin_.node), end_.node + 1, nullptr);
+    } else {
+        MySTL::copy_backward(begin_.node, end_.node + 1, nstart + old_buffer);
+        MySTL::fill(begin_.node, MySTL::min(nstart, end_.node + 1), nullptr);
+    }
+    begin_.node = nstart;
+    end_.node = nstart + old_buffer - 1;
+}
+
 // 重载比较操作符
-template <class T>
-bool operator==(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+bool operator==(const deque<T, Alloc, BufSiz>& lhs, const deque<T, Alloc, BufSiz>& rhs) {
     return lhs.size() == rhs.size() &&
            MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+bool operator<(const deque<T, Alloc, BufSiz>& lhs, const deque<T, Alloc, BufSiz>& rhs) {
     return MySTL::lexicographical_compare(
         lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator!=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+bool operator!=(const deque<T, Alloc, BufSiz>& lhs, const deque<T, Alloc, BufSiz>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+bool operator>(const deque<T, Alloc, BufSiz>& lhs, const deque<T, Alloc, BufSiz>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+bool operator<=(const deque<T, Alloc, BufSiz>& lhs, const deque<T, Alloc, BufSiz>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+bool operator>=(const deque<T, Alloc, BufSiz>& lhs, const deque<T, Alloc, BufSiz>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class T>
-void swap(deque<T>& lhs, deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSiz>
+void swap(deque<T, Alloc, BufSiz>& lhs, deque<T, Alloc, BufSiz>& rhs) {
     lhs.swap(rhs);
 }
 
+// deque 的迭代器与 map 都指向堆上的空间，不指向 deque 对象自身
+template <class T, class Alloc, size_t BufSiz>
+struct is_trivially_relocatable<deque<T, Alloc, BufSiz>> : is_trivially_relocatable<Alloc> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class T>
+using deque = MySTL::deque<T, MySTL::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
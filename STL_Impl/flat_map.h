@@ -0,0 +1,973 @@
+#ifndef _MYSTL_FLAT_MAP_H_
+#define _MYSTL_FLAT_MAP_H_
+
+// 这个头文件包含了三个模板类 flat_map、flat_multimap 和 flat_split_map
+// flat_map       : 映射，元素按键值有序存放在一个 vector 中，接口与 map 相同，键值不允许重复
+// flat_multimap  : 映射，元素按键值有序存放在一个 vector 中，接口与 multimap 相同，键值允许重复
+// flat_split_map : 映射，键值与实值分别有序存放在两个 vector 中，键值不允许重复
+
+// notes:
+//
+// 适合一次建好、之后大量查找与遍历的查找表，建表时请使用成批的 insert(first, last)，单个元素的插入与删除是 O(n) 的
+// value_type 为 pair<Key, T> 而不是 pair<const Key, T>，元素需要在 vector 中移动；
+// 解引用 flat_map / flat_multimap 的迭代器得到 pair<const Key&, T&>，不能通过迭代器修改键值，
+// 遍历请使用 for (auto x : m) 或 for (auto&& x : m)
+// insert / emplace / erase 会使插入或删除位置之后的迭代器失效，发生扩容时全部失效
+//
+// flat_split_map 的键值连续存放，二分查找时访问的内存更少，它的迭代器同样解引用得到 pair<const Key&, T&>
+
+#include "flat_tree.h"
+
+namespace MySTL {
+
+// flat_map 与 flat_multimap 的迭代器设计，包装底层容器的迭代器
+// 解引用得到 pair<const Key&, T&>，operator-> 返回一个持有该 pair 的代理对象，键值只能读取
+template <class Iter>
+struct flat_map_iterator {
+    typedef typename iterator_traits<Iter>::value_type value_type;
+    typedef typename value_type::first_type key_type;
+    typedef typename value_type::second_type mapped_type;
+    typedef typename std::conditional<
+        std::is_const<typename std::remove_reference<typename iterator_traits<Iter>::reference>::type>::value,
+        const mapped_type&, mapped_type&>::type mapped_reference;
+
+    typedef MySTL::random_access_iterator_tag iterator_category;
+    typedef MySTL::pair<const key_type&, mapped_reference> reference;
+    typedef ptrdiff_t difference_type;
+    typedef flat_map_iterator<Iter> self;
+
+    struct pointer {
+        reference ref;
+        reference* operator->() { return &ref; }
+    };
+
+    Iter cur;  // 在底层容器中的位置
+
+    flat_map_iterator() : cur() {}
+    flat_map_iterator(Iter it) : cur(it) {}
+    // iterator 可以转换为 const_iterator
+    template <class OtherIter, typename std::enable_if<std::is_convertible<OtherIter, Iter>::value, int>::type = 0>
+    flat_map_iterator(const flat_map_iterator<OtherIter>& rhs) : cur(rhs.cur) {}
+
+    reference operator*() const { return reference(cur->first, cur->second); }
+    pointer operator->() const { return pointer{operator*()}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    self& operator++() {
+        ++cur;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++cur;
+        return tmp;
+    }
+    self& operator--() {
+        --cur;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --cur;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        cur += n;
+        return *this;
+    }
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-=(difference_type n) { return *this += -n; }
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+    difference_type operator-(const self& rhs) const { return cur - rhs.cur; }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return cur == rhs.cur; }
+    bool operator!=(const self& rhs) const { return cur != rhs.cur; }
+    bool operator<(const self& rhs) const { return cur < rhs.cur; }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+/*****************************************************************************************/
+// 模板类 flat_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less，参数四代表存放元素的容器
+template <class Key, class T, class Compare = MySTL::less<Key>, class Container = MySTL::vector<MySTL::pair<Key, T>>>
+class flat_map {
+   public:
+    // flat_map 的嵌套类型定义
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef MySTL::pair<Key, T> value_type;
+    typedef Compare key_compare;
+
+    // 定义一个 functor，用来进行元素比较
+    class value_compare : public binary_function<value_type, value_type, bool> {
+        friend class flat_map<Key, T, Compare, Container>;
+
+       private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+       public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    };
+
+   private:
+    // 以 MySTL::flat_tree 作为底层机制
+    typedef MySTL::flat_tree<value_type, key_compare, Container> base_type;
+    base_type tree_;
+
+   public:
+    // 使用 flat_tree 的型别
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef flat_map_iterator<typename base_type::iterator> iterator;
+    typedef flat_map_iterator<typename base_type::const_iterator> const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename iterator::reference reference;
+    typedef typename const_iterator::reference const_reference;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+    typedef typename base_type::allocator_type allocator_type;
+    typedef typename base_type::container_type container_type;
+
+   public:
+    // 构造、复制、移动、赋值函数
+    flat_map() = default;
+    explicit flat_map(const key_compare& comp, const allocator_type& alloc = allocator_type()) : tree_(comp, alloc) {}
+    explicit flat_map(const allocator_type& alloc) : tree_(alloc) {}
+    template <class InputIter>
+    flat_map(InputIter first, InputIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(first, last); }
+    flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(ilist.begin(), ilist.end()); }
+    flat_map(const flat_map& rhs) : tree_(rhs.tree_) {}
+    flat_map(const flat_map& rhs, const allocator_type& alloc) : tree_(rhs.tree_, alloc) {}
+    flat_map(flat_map&& rhs) noexcept : tree_(MySTL::move(rhs.tree_)) {}
+
+    flat_map& operator=(const flat_map& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+
+    flat_map& operator=(flat_map&& rhs) {
+        tree_ = MySTL::move(rhs.tree_);
+        return *this;
+    }
+
+    flat_map& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+    key_compare key_comp() const { return tree_.key_comp(); }
+    value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+    // 迭代器相关
+    iterator begin() noexcept { return tree_.begin(); }
+    const_iterator begin() const noexcept { return tree_.begin(); }
+    iterator end() noexcept { return tree_.end(); }
+    const_iterator end() const noexcept { return tree_.end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关
+    bool empty() const noexcept { return tree_.empty(); }
+    size_type size() const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+    size_type capacity() const noexcept { return tree_.capacity(); }
+    void reserve(size_type n) { tree_.reserve(n); }
+    void shrink_to_fit() { tree_.shrink_to_fit(); }
+
+    // 访问元素相关
+    // 若键值不存在，at 会抛出一个异常
+    mapped_type& at(const key_type& key) {
+        iterator it = lower_bound(key);
+        // it->first >= key
+        THROW_OUT_OF_RANGE_IF(it == end() || key_comp()(it->first, key), "flat_map<Key, T> no such element exists");
+
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        const_iterator it = lower_bound(key);
+        // it->first >= key
+        THROW_OUT_OF_RANGE_IF(it == end() || key_comp()(it->first, key), "flat_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        iterator it = lower_bound(key);
+        // it->first >= key
+        if (it == end() || key_comp()(key, it->first))
+            it = emplace_hint(it, key, T{});
+        return it->second;
+    }
+    mapped_type& operator[](key_type&& key) {
+        iterator it = lower_bound(key);
+        // it->first >= key
+        if (it == end() || key_comp()(key, it->first))
+            it = emplace_hint(it, MySTL::move(key), T{});
+        return it->second;
+    }
+
+    // 插入删除相关
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return tree_.emplace_unique(MySTL::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return tree_.emplace_unique_use_hint(hint.cur, MySTL::forward<Args>(args)...);
+    }
+
+    pair<iterator, bool> insert(const value_type& value) { return tree_.insert_unique(value); }
+    pair<iterator, bool> insert(value_type&& value) { return tree_.insert_unique(MySTL::move(value)); }
+    iterator insert(const_iterator hint, const value_type& value) { return tree_.insert_unique(hint.cur, value); }
+    iterator insert(const_iterator hint, value_type&& value) { return tree_.insert_unique(hint.cur, MySTL::move(value)); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { tree_.insert_unique(first, last); }
+
+    iterator erase(const_iterator pos) { return tree_.erase(pos.cur); }
+    size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+    iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first.cur, last.cur); }
+    void clear() { tree_.clear(); }
+
+    // flat_map 相关操作
+    iterator find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+    size_type count(const key_type& key) const { return tree_.count_multi(key); }
+
+    iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    pair<iterator, iterator>
+    equal_range(const key_type& key) { return tree_.equal_range_unique(key); }
+
+    pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const { return tree_.equal_range_unique(key); }
+
+    void swap(flat_map& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+   public:
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const flat_map& lhs, const flat_map& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class T, class Compare, class Container>
+bool operator==(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator<(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator!=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator>(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator<=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator>=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class Key, class T, class Compare, class Container>
+void swap(flat_map<Key, T, Compare, Container>& lhs, flat_map<Key, T, Compare, Container>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// 模板类 flat_multimap，键值允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less，参数四代表存放元素的容器
+template <class Key, class T, class Compare = MySTL::less<Key>, class Container = MySTL::vector<MySTL::pair<Key, T>>>
+class flat_multimap {
+   public:
+    // flat_multimap 的型别定义
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef MySTL::pair<Key, T> value_type;
+    typedef Compare key_compare;
+
+    // 定义一个 functor，用来进行元素比较
+    class value_compare : public binary_function<value_type, value_type, bool> {
+        friend class flat_multimap<Key, T, Compare, Container>;
+
+       private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+       public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    };
+
+   private:
+    // 用 MySTL::flat_tree 作为底层机制
+    typedef MySTL::flat_tree<value_type, key_compare, Container> base_type;
+    base_type tree_;
+
+   public:
+    // 使用 flat_tree 的型别
+    typedef typename base_type::pointer pointer;
+    typedef typename base_type::const_pointer const_pointer;
+    typedef flat_map_iterator<typename base_type::iterator> iterator;
+    typedef flat_map_iterator<typename base_type::const_iterator> const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename iterator::reference reference;
+    typedef typename const_iterator::reference const_reference;
+    typedef typename base_type::size_type size_type;
+    typedef typename base_type::difference_type difference_type;
+    typedef typename base_type::allocator_type allocator_type;
+    typedef typename base_type::container_type container_type;
+
+   public:
+    // 构造、复制、移动函数
+
+    flat_multimap() = default;
+    explicit flat_multimap(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit flat_multimap(const allocator_type& alloc)
+        : tree_(alloc) {}
+
+    template <class InputIterator>
+    flat_multimap(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(first, last); }
+    flat_multimap(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(ilist.begin(), ilist.end()); }
+
+    flat_multimap(const flat_multimap& rhs)
+        : tree_(rhs.tree_) {
+    }
+    flat_multimap(const flat_multimap& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {
+    }
+    flat_multimap(flat_multimap&& rhs) noexcept
+        : tree_(MySTL::move(rhs.tree_)) {
+    }
+
+    flat_multimap& operator=(const flat_multimap& rhs) {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+    flat_multimap& operator=(flat_multimap&& rhs) {
+        tree_ = MySTL::move(rhs.tree_);
+        return *this;
+    }
+
+    flat_multimap& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_multi(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+    value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+    // 迭代器相关
+
+    iterator begin() noexcept { return tree_.begin(); }
+    const_iterator begin() const noexcept { return tree_.begin(); }
+    iterator end() noexcept { return tree_.end(); }
+    const_iterator end() const noexcept { return tree_.end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关
+    bool empty() const noexcept { return tree_.empty(); }
+    size_type size() const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+    size_type capacity() const noexcept { return tree_.capacity(); }
+    void reserve(size_type n) { tree_.reserve(n); }
+    void shrink_to_fit() { tree_.shrink_to_fit(); }
+
+    // 插入删除操作
+
+    template <class... Args>
+    iterator emplace(Args&&... args) {
+        return tree_.emplace_multi(MySTL::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return tree_.emplace_multi_use_hint(hint.cur, MySTL::forward<Args>(args)...);
+    }
+
+    iterator insert(const value_type& value) {
+        return tree_.insert_multi(value);
+    }
+    iterator insert(value_type&& value) {
+        return tree_.insert_multi(MySTL::move(value));
+    }
+
+    iterator insert(const_iterator hint, const value_type& value) {
+        return tree_.insert_multi(hint.cur, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return tree_.insert_multi(hint.cur, MySTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree_.insert_multi(first, last);
+    }
+
+    iterator erase(const_iterator position) { return tree_.erase(position.cur); }
+    size_type erase(const key_type& key) { return tree_.erase_multi(key); }
+    iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first.cur, last.cur); }
+
+    void clear() { tree_.clear(); }
+
+    // flat_multimap 相关操作
+
+    iterator find(const key_type& key) { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+    size_type count(const key_type& key) const { return tree_.count_multi(key); }
+
+    iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+
+    iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    pair<iterator, iterator>
+    equal_range(const key_type& key) { return tree_.equal_range_multi(key); }
+
+    pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const { return tree_.equal_range_multi(key); }
+
+    void swap(flat_multimap& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+   public:
+    friend bool operator==(const flat_multimap& lhs, const flat_multimap& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const flat_multimap& lhs, const flat_multimap& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class T, class Compare, class Container>
+bool operator==(const flat_multimap<Key, T, Compare, Container>& lhs, const flat_multimap<Key, T, Compare, Container>& rhs) {
+    return lhs == rhs;
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator<(const flat_multimap<Key, T, Compare, Container>& lhs, const flat_multimap<Key, T, Compare, Container>& rhs) {
+    return lhs < rhs;
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator!=(const flat_multimap<Key, T, Compare, Container>& lhs, const flat_multimap<Key, T, Compare, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator>(const flat_multimap<Key, T, Compare, Container>& lhs, const flat_multimap<Key, T, Compare, Container>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator<=(const flat_multimap<Key, T, Compare, Container>& lhs, const flat_multimap<Key, T, Compare, Container>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator>=(const flat_multimap<Key, T, Compare, Container>& lhs, const flat_multimap<Key, T, Compare, Container>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class Key, class T, class Compare, class Container>
+void swap(flat_multimap<Key, T, Compare, Container>& lhs, flat_multimap<Key, T, Compare, Container>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// flat_split_map 的迭代器设计，同时持有键值容器与实值容器中相同下标的位置
+// 解引用得到 pair<const Key&, T&>，operator-> 返回一个持有该 pair 的代理对象
+template <class KeyIter, class MappedIter>
+struct flat_split_map_iterator {
+    typedef typename iterator_traits<KeyIter>::value_type key_type;
+    typedef typename iterator_traits<MappedIter>::value_type mapped_type;
+    typedef typename iterator_traits<MappedIter>::reference mapped_reference;
+
+    typedef MySTL::random_access_iterator_tag iterator_category;
+    typedef MySTL::pair<key_type, mapped_type> value_type;
+    typedef MySTL::pair<const key_type&, mapped_reference> reference;
+    typedef ptrdiff_t difference_type;
+    typedef flat_split_map_iterator<KeyIter, MappedIter> self;
+
+    struct pointer {
+        reference ref;
+        reference* operator->() { return &ref; }
+    };
+
+    KeyIter key;        // 在键值容器中的位置
+    MappedIter mapped;  // 在实值容器中的位置
+
+    flat_split_map_iterator() : key(), mapped() {}
+    flat_split_map_iterator(KeyIter k, MappedIter m) : key(k), mapped(m) {}
+    // iterator 可以转换为 const_iterator
+    template <class OtherIter, typename std::enable_if<std::is_convertible<OtherIter, MappedIter>::value, int>::type = 0>
+    flat_split_map_iterator(const flat_split_map_iterator<KeyIter, OtherIter>& rhs) : key(rhs.key), mapped(rhs.mapped) {}
+
+    reference operator*() const { return reference(*key, *mapped); }
+    pointer operator->() const { return pointer{operator*()}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    self& operator++() {
+        ++key;
+        ++mapped;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        --key;
+        --mapped;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        key += n;
+        mapped += n;
+        return *this;
+    }
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-=(difference_type n) { return *this += -n; }
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+    difference_type operator-(const self& rhs) const { return key - rhs.key; }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return key == rhs.key; }
+    bool operator!=(const self& rhs) const { return key != rhs.key; }
+    bool operator<(const self& rhs) const { return key < rhs.key; }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+/*****************************************************************************************/
+// 模板类 flat_split_map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less，
+// 参数四、五分别代表存放键值与实值的容器
+template <class Key, class T, class Compare = MySTL::less<Key>, class KeyContainer = MySTL::vector<Key>, class MappedContainer = MySTL::vector<T>>
+class flat_split_map {
+   public:
+    // flat_split_map 的嵌套类型定义
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef MySTL::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef KeyContainer key_container_type;
+    typedef MappedContainer mapped_container_type;
+
+    // 定义一个 functor，用来进行元素比较
+    class value_compare : public binary_function<value_type, value_type, bool> {
+        friend class flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>;
+
+       private:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+       public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    };
+
+    typedef flat_split_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::iterator> iterator;
+    typedef flat_split_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::const_iterator> const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename iterator::reference reference;
+    typedef typename const_iterator::reference const_reference;
+    typedef typename KeyContainer::size_type size_type;
+    typedef typename KeyContainer::difference_type difference_type;
+
+   private:
+    // 用以下三个数据表现 flat_split_map，两个容器中相同下标的键值与实值组成一个元素
+    key_container_type keys_;        // 有序的键值
+    mapped_container_type values_;   // 与键值一一对应的实值
+    key_compare key_comp_;           // 键值比较的准则
+
+   public:
+    // 构造、复制、移动、赋值函数
+    flat_split_map() = default;
+    explicit flat_split_map(const key_compare& comp) : key_comp_(comp) {}
+    template <class InputIter>
+    flat_split_map(InputIter first, InputIter last, const key_compare& comp = key_compare())
+        : key_comp_(comp) { insert(first, last); }
+    flat_split_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : key_comp_(comp) { insert(ilist.begin(), ilist.end()); }
+
+    flat_split_map& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+    key_compare key_comp() const { return key_comp_; }
+    value_compare value_comp() const { return value_compare(key_comp_); }
+    const key_container_type& keys() const noexcept { return keys_; }
+    const mapped_container_type& values() const noexcept { return values_; }
+
+    // 迭代器相关
+    iterator begin() noexcept { return iterator(keys_.cbegin(), values_.begin()); }
+    const_iterator begin() const noexcept { return const_iterator(keys_.cbegin(), values_.cbegin()); }
+    iterator end() noexcept { return iterator(keys_.cend(), values_.end()); }
+    const_iterator end() const noexcept { return const_iterator(keys_.cend(), values_.cend()); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关
+    bool empty() const noexcept { return keys_.empty(); }
+    size_type size() const noexcept { return keys_.size(); }
+    size_type max_size() const noexcept { return keys_.max_size(); }
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    // 访问元素相关
+    // 若键值不存在，at 会抛出一个异常
+    mapped_type& at(const key_type& key) {
+        size_type i = lower_index(key);
+        THROW_OUT_OF_RANGE_IF(i == size() || key_comp_(key, keys_[i]), "flat_split_map<Key, T> no such element exists");
+        return values_[i];
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        size_type i = lower_index(key);
+        THROW_OUT_OF_RANGE_IF(i == size() || key_comp_(key, keys_[i]), "flat_split_map<Key, T> no such element exists");
+        return values_[i];
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        size_type i = lower_index(key);
+        if (i == size() || key_comp_(key, keys_[i]))
+            insert_at(i, key, T{});
+        return values_[i];
+    }
+    mapped_type& operator[](key_type&& key) {
+        size_type i = lower_index(key);
+        if (i == size() || key_comp_(key, keys_[i]))
+            insert_at(i, MySTL::move(key), T{});
+        return values_[i];
+    }
+
+    // 插入删除相关
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert(MySTL::move(tmp));
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        size_type i = lower_index(value.first);
+        if (i != size() && !key_comp_(value.first, keys_[i]))
+            return pair<iterator, bool>(begin() + i, false);
+        insert_at(i, value.first, value.second);
+        return pair<iterator, bool>(begin() + i, true);
+    }
+    pair<iterator, bool> insert(value_type&& value) {
+        size_type i = lower_index(value.first);
+        if (i != size() && !key_comp_(value.first, keys_[i]))
+            return pair<iterator, bool>(begin() + i, false);
+        insert_at(i, MySTL::move(value.first), MySTL::move(value.second));
+        return pair<iterator, bool>(begin() + i, true);
+    }
+
+    // 成批插入：新元素先排序、去重，再与原有元素归并，原有元素优先
+    template <class InputIter>
+    void insert(InputIter first, InputIter last);
+
+    iterator erase(const_iterator pos) {
+        size_type i = static_cast<size_type>(pos - cbegin());
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return begin() + i;
+    }
+    size_type erase(const key_type& key) {
+        const_iterator it = find(key);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type i = static_cast<size_type>(first - cbegin());
+        size_type j = static_cast<size_type>(last - cbegin());
+        keys_.erase(keys_.begin() + i, keys_.begin() + j);
+        values_.erase(values_.begin() + i, values_.begin() + j);
+        return begin() + i;
+    }
+    void clear() {
+        keys_.clear();
+        values_.clear();
+    }
+
+    // flat_split_map 相关操作
+    iterator find(const key_type& key) {
+        size_type i = lower_index(key);
+        return (i == size() || key_comp_(key, keys_[i])) ? end() : begin() + i;
+    }
+    const_iterator find(const key_type& key) const {
+        size_type i = lower_index(key);
+        return (i == size() || key_comp_(key, keys_[i])) ? end() : begin() + i;
+    }
+
+    size_type count(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+
+    iterator lower_bound(const key_type& key) { return begin() + lower_index(key); }
+    const_iterator lower_bound(const key_type& key) const { return begin() + lower_index(key); }
+    iterator upper_bound(const key_type& key) { return begin() + upper_index(key); }
+    const_iterator upper_bound(const key_type& key) const { return begin() + upper_index(key); }
+
+    pair<iterator, iterator>
+    equal_range(const key_type& key) {
+        iterator it = find(key);
+        return pair<iterator, iterator>(it, it == end() ? it : it + 1);
+    }
+    pair<const_iterator, const_iterator>
+    equal_range(const key_type& key) const {
+        const_iterator it = find(key);
+        return pair<const_iterator, const_iterator>(it, it == end() ? it : it + 1);
+    }
+
+    void swap(flat_split_map& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        values_.swap(rhs.values_);
+        MySTL::swap(key_comp_, rhs.key_comp_);
+    }
+
+   public:
+    friend bool operator==(const flat_split_map& lhs, const flat_split_map& rhs) {
+        return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+    }
+    friend bool operator<(const flat_split_map& lhs, const flat_split_map& rhs) {
+        return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+   private:
+    size_type lower_index(const key_type& key) const {
+        return static_cast<size_type>(MySTL::lower_bound(keys_.begin(), keys_.end(), key, key_comp_) - keys_.begin());
+    }
+    size_type upper_index(const key_type& key) const {
+        return static_cast<size_type>(MySTL::upper_bound(keys_.begin(), keys_.end(), key, key_comp_) - keys_.begin());
+    }
+
+    // 在下标 i 处插入一个元素，实值插入失败时撤销键值的插入
+    template <class K, class V>
+    void insert_at(size_type i, K&& key, V&& value) {
+        keys_.insert(keys_.begin() + i, MySTL::forward<K>(key));
+        try {
+            values_.insert(values_.begin() + i, MySTL::forward<V>(value));
+        } catch (...) {
+            keys_.erase(keys_.begin() + i);
+            throw;
+        }
+    }
+};
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+template <class InputIter>
+void flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>::
+    insert(InputIter first, InputIter last) {
+    MySTL::vector<value_type> tmp;
+    for (; first != last; ++first)
+        tmp.emplace_back(*first);
+    if (tmp.empty())
+        return;
+    MySTL::stable_sort(tmp.begin(), tmp.end(), value_comp());
+    // 键值相同的新元素只保留第一个
+    auto result = tmp.begin();
+    for (auto it = tmp.begin() + 1; it != tmp.end(); ++it) {
+        if (key_comp_(result->first, it->first) && ++result != it)
+            *result = MySTL::move(*it);
+    }
+    tmp.erase(++result, tmp.end());
+
+    if (empty() || key_comp_(keys_.back(), tmp.front().first)) {
+        // 新元素都在原有元素之后，直接追加
+        reserve(size() + tmp.size());
+        for (auto& v : tmp) {
+            keys_.push_back(MySTL::move(v.first));
+            values_.push_back(MySTL::move(v.second));
+        }
+        return;
+    }
+    // 归并到新的容器中，完成后再交换，失败时原有元素保持不变
+    key_container_type new_keys;
+    mapped_container_type new_values;
+    new_keys.reserve(size() + tmp.size());
+    new_values.reserve(size() + tmp.size());
+    size_type i = 0;
+    auto it = tmp.begin();
+    while (i < size() && it != tmp.end()) {
+        if (key_comp_(it->first, keys_[i])) {
+            new_keys.push_back(MySTL::move(it->first));
+            new_values.push_back(MySTL::move(it->second));
+            ++it;
+        } else {
+            if (!key_comp_(keys_[i], it->first))
+                ++it;
+            new_keys.push_back(keys_[i]);
+            new_values.push_back(values_[i]);
+            ++i;
+        }
+    }
+    for (; i < size(); ++i) {
+        new_keys.push_back(keys_[i]);
+        new_values.push_back(values_[i]);
+    }
+    for (; it != tmp.end(); ++it) {
+        new_keys.push_back(MySTL::move(it->first));
+        new_values.push_back(MySTL::move(it->second));
+    }
+    keys_.swap(new_keys);
+    values_.swap(new_values);
+}
+
+// 重载比较操作符
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator!=(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+                const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator>(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+               const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator<=(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+                const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator>=(const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+                const flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void swap(flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+          flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// flat_map / flat_multimap 只包含一个 flat_tree，flat_split_map 只包含两个容器
+template <class Key, class T, class Compare, class Container>
+struct is_trivially_relocatable<flat_map<Key, T, Compare, Container>>
+    : is_trivially_relocatable<flat_tree<MySTL::pair<Key, T>, Compare, Container>> {};
+
+template <class Key, class T, class Compare, class Container>
+struct is_trivially_relocatable<flat_multimap<Key, T, Compare, Container>>
+    : is_trivially_relocatable<flat_tree<MySTL::pair<Key, T>, Compare, Container>> {};
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+struct is_trivially_relocatable<flat_split_map<Key, T, Compare, KeyContainer, MappedContainer>>
+    : std::integral_constant<bool, is_trivially_relocatable<KeyContainer>::value &&
+                                       is_trivially_relocatable<MappedContainer>::value &&
+                                       is_trivially_relocatable<Compare>::value> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class Key, class T, class Compare = MySTL::less<Key>>
+using flat_map = MySTL::flat_map<Key, T, Compare, MySTL::vector<MySTL::pair<Key, T>, MySTL::polymorphic_allocator<MySTL::pair<Key, T>>>>;
+
+template <class Key, class T, class Compare = MySTL::less<Key>>
+using flat_multimap = MySTL::flat_multimap<Key, T, Compare, MySTL::vector<MySTL::pair<Key, T>, MySTL::polymorphic_allocator<MySTL::pair<Key, T>>>>;
+
+template <class Key, class T, class Compare = MySTL::less<Key>>
+using flat_split_map = MySTL::flat_split_map<Key, T, Compare, MySTL::vector<Key, MySTL::polymorphic_allocator<Key>>,
+                                             MySTL::vector<T, MySTL::polymorphic_allocator<T>>>;
+
+}  // namespace pmr
+
+}  // namespace MySTL
+#endif  // !_MYSTL_FLAT_MAP_H_
@@ -0,0 +1,370 @@
+#ifndef _MYSTL_FLAT_TREE_H_
+#define _MYSTL_FLAT_TREE_H_
+
+// 这个头文件包含一个模板类 flat_tree
+// flat_tree : 有序向量，flat_map / flat_set 以它作为底层机制
+
+// notes:
+//
+// 元素按键值有序地连续存放在一个 vector 中，查找用 MySTL::lower_bound 二分，遍历就是顺序扫描一段内存
+// 没有节点，每个元素只占 sizeof(value_type)，适合一次建好、之后大量查找与遍历的查找表
+// 单个元素的插入与删除需要搬移其后的所有元素，是 O(n) 的；成批插入请使用 insert(first, last)：
+//   新元素先追加到末尾，排序、去重一次后再与原有元素合并，总共 O(n + m log m)
+// 成批插入与逐个插入的结果相同：键值不允许重复时，原有元素优先，同一批新元素中键值相同的只保留第一个；
+// 键值允许重复时，新元素排在键值相同的原有元素之后，同一批新元素之间保持原有的相对顺序
+//
+// 与 rb_tree 不同，insert / emplace / erase 之后，插入或删除位置及其之后的迭代器、指针和引用都会失效，
+// 发生扩容时全部失效
+//
+// 异常保证：
+// 单个元素的 emplace / insert 满足 vector::insert 的异常保证，成批 insert 只满足基本异常保证
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "rb_tree.h"
+#include "vector.h"
+
+namespace MySTL {
+
+// 模板类 flat_tree
+// 参数一代表数据类型，参数二代表键值比较类型，参数三代表存放元素的容器，必须支持随机访问
+template <class T, class Compare, class Container = MySTL::vector<T>>
+class flat_tree {
+   public:
+    // flat_tree 的嵌套型别定义
+    typedef rb_tree_value_traits<T> value_traits;
+
+    typedef typename value_traits::key_type key_type;
+    typedef typename value_traits::mapped_type mapped_type;
+    typedef typename value_traits::value_type value_type;
+    typedef Compare key_compare;
+    typedef Container container_type;
+    typedef typename Container::allocator_type allocator_type;
+
+    typedef typename Container::pointer pointer;
+    typedef typename Container::const_pointer const_pointer;
+    typedef typename Container::reference reference;
+    typedef typename Container::const_reference const_reference;
+    typedef typename Container::size_type size_type;
+    typedef typename Container::difference_type difference_type;
+
+    typedef typename Container::iterator iterator;
+    typedef typename Container::const_iterator const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    allocator_type get_allocator() const { return c_.get_allocator(); }
+    key_compare key_comp() const { return key_comp_; }
+
+   private:
+    // 元素之间、元素与键值之间的比较，MySTL::lower_bound 以 comp(*it, key) 调用，upper_bound 以 comp(key, *it) 调用
+    struct value_less {
+        Compare comp;
+        bool operator()(const T& lhs, const T& rhs) const {
+            return comp(value_traits::get_key(lhs), value_traits::get_key(rhs));
+        }
+    };
+
+    struct value_key_less {
+        Compare comp;
+        bool operator()(const T& lhs, const key_type& rhs) const { return comp(value_traits::get_key(lhs), rhs); }
+    };
+
+    struct key_value_less {
+        Compare comp;
+        bool operator()(const key_type& lhs, const T& rhs) const { return comp(lhs, value_traits::get_key(rhs)); }
+    };
+
+   private:
+    // 用以下两个数据表现 flat_tree
+    container_type c_;      // 按键值有序存放的元素
+    key_compare key_comp_;  // 键值比较的准则
+
+   public:
+    // 构造、复制、析构函数
+    flat_tree() = default;
+    explicit flat_tree(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : c_(alloc), key_comp_(comp) {}
+    explicit flat_tree(const allocator_type& alloc) : c_(alloc) {}
+    flat_tree(const flat_tree& rhs) = default;
+    flat_tree(const flat_tree& rhs, const allocator_type& alloc) : c_(rhs.c_, alloc), key_comp_(rhs.key_comp_) {}
+    flat_tree(flat_tree&& rhs) noexcept : c_(MySTL::move(rhs.c_)), key_comp_(rhs.key_comp_) {}
+
+    flat_tree& operator=(const flat_tree& rhs) = default;
+    flat_tree& operator=(flat_tree&& rhs) {
+        c_ = MySTL::move(rhs.c_);
+        key_comp_ = rhs.key_comp_;
+        return *this;
+    }
+
+   public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return c_.begin(); }
+    const_iterator begin() const noexcept { return c_.begin(); }
+    iterator end() noexcept { return c_.end(); }
+    const_iterator end() const noexcept { return c_.end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return c_.empty(); }
+    size_type size() const noexcept { return c_.size(); }
+    size_type max_size() const noexcept { return c_.max_size(); }
+    size_type capacity() const noexcept { return c_.capacity(); }
+    void reserve(size_type n) { c_.reserve(n); }
+    void shrink_to_fit() { c_.shrink_to_fit(); }
+
+    // 插入删除相关操作
+    // emplace
+    template <class... Args>
+    iterator emplace_multi(Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_multi(MySTL::move(tmp));
+    }
+
+    template <class... Args>
+    MySTL::pair<iterator, bool> emplace_unique(Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_unique(MySTL::move(tmp));
+    }
+
+    template <class... Args>
+    iterator emplace_multi_use_hint(const_iterator hint, Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_multi(hint, MySTL::move(tmp));
+    }
+
+    template <class... Args>
+    iterator emplace_unique_use_hint(const_iterator hint, Args&&... args) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        return insert_unique(hint, MySTL::move(tmp));
+    }
+
+    // insert
+    iterator insert_multi(const value_type& value) {
+        return c_.insert(upper_bound(value_traits::get_key(value)), value);
+    }
+    iterator insert_multi(value_type&& value) {
+        return c_.insert(upper_bound(value_traits::get_key(value)), MySTL::move(value));
+    }
+
+    iterator insert_multi(const_iterator hint, const value_type& value) {
+        return c_.insert(multi_position(hint, value_traits::get_key(value)), value);
+    }
+    iterator insert_multi(const_iterator hint, value_type&& value) {
+        return c_.insert(multi_position(hint, value_traits::get_key(value)), MySTL::move(value));
+    }
+
+    template <class InputIterator>
+    void insert_multi(InputIterator first, InputIterator last) {
+        const size_type old_size = c_.size();
+        c_.insert(c_.end(), first, last);
+        sort_and_merge(old_size, false);
+    }
+
+    MySTL::pair<iterator, bool> insert_unique(const value_type& value) { return unique_insert(value); }
+    MySTL::pair<iterator, bool> insert_unique(value_type&& value) { return unique_insert(MySTL::move(value)); }
+
+    iterator insert_unique(const_iterator hint, const value_type& value) { return hint_insert_unique(hint, value); }
+    iterator insert_unique(const_iterator hint, value_type&& value) { return hint_insert_unique(hint, MySTL::move(value)); }
+
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) {
+        const size_type old_size = c_.size();
+        c_.insert(c_.end(), first, last);
+        sort_and_merge(old_size, true);
+    }
+
+    // erase
+    iterator erase(const_iterator pos) { return c_.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return c_.erase(first, last); }
+
+    size_type erase_multi(const key_type& key) {
+        auto p = equal_range_multi(key);
+        const size_type n = static_cast<size_type>(p.second - p.first);
+        c_.erase(p.first, p.second);
+        return n;
+    }
+    size_type erase_unique(const key_type& key) {
+        iterator it = find(key);
+        if (it == end())
+            return 0;
+        c_.erase(it);
+        return 1;
+    }
+
+    void clear() { c_.clear(); }
+
+    // flat_tree 相关操作
+    iterator find(const key_type& key) {
+        iterator it = lower_bound(key);
+        return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+    }
+    const_iterator find(const key_type& key) const {
+        const_iterator it = lower_bound(key);
+        return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+    }
+
+    size_type count_multi(const key_type& key) const {
+        auto p = equal_range_multi(key);
+        return static_cast<size_type>(p.second - p.first);
+    }
+    size_type count_unique(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    iterator lower_bound(const key_type& key) {
+        return MySTL::lower_bound(begin(), end(), key, value_key_less{key_comp_});
+    }
+    const_iterator lower_bound(const key_type& key) const {
+        return MySTL::lower_bound(begin(), end(), key, value_key_less{key_comp_});
+    }
+    iterator upper_bound(const key_type& key) {
+        return MySTL::upper_bound(begin(), end(), key, key_value_less{key_comp_});
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        return MySTL::upper_bound(begin(), end(), key, key_value_less{key_comp_});
+    }
+
+    MySTL::pair<iterator, iterator>
+    equal_range_multi(const key_type& key) {
+        iterator first = lower_bound(key);
+        return MySTL::pair<iterator, iterator>(first, MySTL::upper_bound(first, end(), key, key_value_less{key_comp_}));
+    }
+    MySTL::pair<const_iterator, const_iterator>
+    equal_range_multi(const key_type& key) const {
+        const_iterator first = lower_bound(key);
+        return MySTL::pair<const_iterator, const_iterator>(first, MySTL::upper_bound(first, end(), key, key_value_less{key_comp_}));
+    }
+
+    MySTL::pair<iterator, iterator>
+    equal_range_unique(const key_type& key) {
+        iterator it = find(key);
+        return MySTL::pair<iterator, iterator>(it, it == end() ? it : it + 1);
+    }
+    MySTL::pair<const_iterator, const_iterator>
+    equal_range_unique(const key_type& key) const {
+        const_iterator it = find(key);
+        return MySTL::pair<const_iterator, const_iterator>(it, it == end() ? it : it + 1);
+    }
+
+    void swap(flat_tree& rhs) noexcept {
+        c_.swap(rhs.c_);
+        MySTL::swap(key_comp_, rhs.key_comp_);
+    }
+
+   private:
+    // 键值不允许重复时的插入
+    template <class V>
+    MySTL::pair<iterator, bool> unique_insert(V&& value) {
+        iterator it = lower_bound(value_traits::get_key(value));
+        if (it != end() && !key_comp_(value_traits::get_key(value), value_traits::get_key(*it)))
+            return MySTL::pair<iterator, bool>(it, false);
+        return MySTL::pair<iterator, bool>(c_.insert(it, MySTL::forward<V>(value)), true);
+    }
+
+    // 键值不允许重复时使用 hint 插入：hint 恰好是插入位置时不必二分查找
+    template <class V>
+    iterator hint_insert_unique(const_iterator hint, V&& value) {
+        const key_type& key = value_traits::get_key(value);
+        if ((hint == end() || key_comp_(key, value_traits::get_key(*hint))) &&
+            (hint == begin() || key_comp_(value_traits::get_key(*(hint - 1)), key)))
+            return c_.insert(hint, MySTL::forward<V>(value));
+        return unique_insert(MySTL::forward<V>(value)).first;
+    }
+
+    // 键值允许重复时的插入位置，hint 不合适时放在键值相同的元素之后
+    const_iterator multi_position(const_iterator hint, const key_type& key) {
+        if ((hint == end() || !key_comp_(value_traits::get_key(*hint), key)) &&
+            (hint == begin() || !key_comp_(key, value_traits::get_key(*(hint - 1)))))
+            return hint;
+        return upper_bound(key);
+    }
+
+    // 对 [old_size, size()) 上新追加的元素稳定排序，unique 为 true 时去掉键值重复的元素，再与前面的原有元素合并
+    // 键值相同的元素保持插入的先后次序，与逐个插入的结果一致
+    void sort_and_merge(size_type old_size, bool unique) {
+        const value_less comp{key_comp_};
+        iterator mid = begin() + old_size;
+        MySTL::stable_sort(mid, end(), comp);
+        if (unique)
+            c_.erase(unique_keys(mid, end()), end());
+        if (mid == begin() || mid == end())
+            return;
+        // 新元素都在原有元素之后（包括按顺序追加的情况）时不需要合并
+        if (unique ? comp(*(mid - 1), *mid) : !comp(*mid, *(mid - 1)))
+            return;
+        // inplace_merge 是稳定的，键值相同时原有元素在前
+        MySTL::inplace_merge(begin(), mid, end(), comp);
+        if (unique)
+            c_.erase(unique_keys(begin(), end()), end());
+    }
+
+    // 有序区间中键值相同的元素只保留第一个，返回新的结尾
+    iterator unique_keys(iterator first, iterator last) {
+        if (first == last)
+            return last;
+        iterator result = first;
+        while (++first != last) {
+            if (key_comp_(value_traits::get_key(*result), value_traits::get_key(*first))) {
+                if (++result != first)
+                    *result = MySTL::move(*first);
+            }
+        }
+        return ++result;
+    }
+};
+
+/*****************************************************************************************/
+// 重载比较操作符
+template <class T, class Compare, class Container>
+bool operator==(const flat_tree<T, Compare, Container>& lhs, const flat_tree<T, Compare, Container>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Compare, class Container>
+bool operator<(const flat_tree<T, Compare, Container>& lhs, const flat_tree<T, Compare, Container>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Compare, class Container>
+bool operator!=(const flat_tree<T, Compare, Container>& lhs, const flat_tree<T, Compare, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Compare, class Container>
+bool operator>(const flat_tree<T, Compare, Container>& lhs, const flat_tree<T, Compare, Container>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Compare, class Container>
+bool operator<=(const flat_tree<T, Compare, Container>& lhs, const flat_tree<T, Compare, Container>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Compare, class Container>
+bool operator>=(const flat_tree<T, Compare, Container>& lhs, const flat_tree<T, Compare, Container>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, class Compare, class Container>
+void swap(flat_tree<T, Compare, Container>& lhs, flat_tree<T, Compare, Container>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class T, class Compare, class Container>
+struct is_trivially_relocatable<flat_tree<T, Compare, Container>>
+    : std::integral_constant<bool, is_trivially_relocatable<Container>::value && is_trivially_relocatable<Compare>::value> {};
+
+}  // namespace MySTL
+#endif  // !_MYSTL_FLAT_TREE_H_
@@ -0,0 +1,762 @@
+#ifndef _MYSTL_FORWARD_LIST_H_
+#define _MYSTL_FORWARD_LIST_H_
+
+// 这个头文件包含了一个模板类 forward_list
+// forward_list : 单向链表
+
+// notes:
+//
+// 节点只有 next 指针，比 list 的节点少一个指针；缺省的 pool_allocator 按 8 字节对齐分级，
+// forward_list<int> 的节点占 16 字节，list<int> 的节点占 24 字节
+// 头结点嵌在容器对象中，空容器不申请任何内存，最后一个节点的 next 为 nullptr，end() 即为空迭代器
+// 与标准库一致，forward_list 不保存大小，插入、删除、接合都在给定位置之后进行：
+//   insert_after / emplace_after / erase_after / splice_after
+// sort 是与 list 相同的自底向上归并排序，节点在 64 个桶之间接合，不申请内存，是稳定排序
+//
+// 异常保证：
+// MySTL::forward_list<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_after
+//   * push_front
+//   * insert_after
+
+#include <initializer_list>
+
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace MySTL {
+
+template <class T>
+struct forward_list_node_base;
+template <class T>
+struct forward_list_node;
+
+// forward_list 的节点结构
+template <class T>
+struct forward_list_node_base {
+    typedef forward_list_node_base<T>* base_ptr;
+    typedef forward_list_node<T>* node_ptr;
+
+    base_ptr next;  // 下一节点
+
+    forward_list_node_base() = default;
+
+    node_ptr as_node() { return static_cast<node_ptr>(this); }
+};
+
+template <class T>
+struct forward_list_node : public forward_list_node_base<T> {
+    T value;  // 数据域
+};
+
+// forward_list 的迭代器设计
+template <class T>
+struct forward_list_iterator : public MySTL::iterator<MySTL::forward_iterator_tag, T> {
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef forward_list_node_base<T>* base_ptr;
+    typedef forward_list_iterator<T> self;
+
+    base_ptr node_;  // 指向当前节点
+
+    forward_list_iterator() = default;
+    forward_list_iterator(base_ptr x) : node_(x) {}
+
+    reference operator*() const { return node_->as_node()->value; }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+template <class T>
+struct forward_list_const_iterator : public MySTL::iterator<MySTL::forward_iterator_tag, T> {
+    typedef T value_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+    typedef forward_list_node_base<T>* base_ptr;
+    typedef forward_list_const_iterator<T> self;
+
+    base_ptr node_;
+
+    forward_list_const_iterator() = default;
+    forward_list_const_iterator(base_ptr x) : node_(x) {}
+    forward_list_const_iterator(const forward_list_iterator<T>& rhs) : node_(rhs.node_) {}
+
+    reference operator*() const { return node_->as_node()->value; }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类: forward_list
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型，节点的分配器由它 rebind 得到
+template <class T, class Alloc = typename default_node_allocator<T>::type>
+class forward_list : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<forward_list_node<T>>> {
+   public:
+    // forward_list 的嵌套类型定义
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<forward_list_node<T>> node_allocator;
+    typedef MySTL::allocator_traits<node_allocator> node_alloc_traits;
+    typedef MySTL::alloc_holder<node_allocator> holder_type;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef forward_list_iterator<T> iterator;
+    typedef forward_list_const_iterator<T> const_iterator;
+
+    typedef typename forward_list_node_base<T>::base_ptr base_ptr;
+    typedef typename forward_list_node_base<T>::node_ptr node_ptr;
+
+    allocator_type get_allocator() const { return allocator_type(this->get_alloc()); }
+
+   private:
+    forward_list_node_base<T> head_;  // 头结点，head_.next 指向第一个节点
+
+   public:
+    // 构造、复制、移动、析构函数
+    forward_list() { head_.next = nullptr; }
+    explicit forward_list(const allocator_type& alloc) : holder_type(node_allocator(alloc)) { head_.next = nullptr; }
+    explicit forward_list(size_type n, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) {
+        head_.next = nullptr;
+        fill_insert_after(before_begin(), n, value_type());
+    }
+    forward_list(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) {
+        head_.next = nullptr;
+        fill_insert_after(before_begin(), n, value);
+    }
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    forward_list(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), first, last);
+    }
+    forward_list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), ilist.begin(), ilist.end());
+    }
+    forward_list(const forward_list& rhs)
+        : holder_type(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), rhs.begin(), rhs.end());
+    }
+    forward_list(const forward_list& rhs, const allocator_type& alloc)
+        : holder_type(node_allocator(alloc)) {
+        head_.next = nullptr;
+        copy_insert_after(before_begin(), rhs.begin(), rhs.end());
+    }
+    forward_list(forward_list&& rhs) noexcept : holder_type(MySTL::move(rhs.get_alloc())) {
+        head_.next = rhs.head_.next;
+        rhs.head_.next = nullptr;
+    }
+
+    forward_list& operator=(const forward_list& rhs) {
+        if (this != &rhs) {
+            if (node_alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+                // 原有的节点必须由原来的分配器释放
+                clear();
+                MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+            }
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    forward_list& operator=(forward_list&& rhs) noexcept(node_alloc_traits::is_always_equal::value) {
+        clear();
+        MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+        if (this->get_alloc() == rhs.get_alloc()) {
+            head_.next = rhs.head_.next;
+            rhs.head_.next = nullptr;
+        } else {
+            // 分配器不相等，不能直接接管对方的节点
+            base_ptr tail = &head_;
+            for (auto& value : rhs) {
+                tail->next = create_node(MySTL::move(value));
+                tail = tail->next;
+            }
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    forward_list& operator=(std::initializer_list<T> ilist) {
+        copy_assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~forward_list() { clear(); }
+
+   public:
+    // 迭代器相关操作
+    iterator before_begin() noexcept { return &head_; }
+    const_iterator before_begin() const noexcept { return const_cast<base_ptr>(&head_); }
+    iterator begin() noexcept { return head_.next; }
+    const_iterator begin() const noexcept { return head_.next; }
+    iterator end() noexcept { return nullptr; }
+    const_iterator end() const noexcept { return nullptr; }
+    const_iterator cbefore_begin() const noexcept { return before_begin(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return head_.next == nullptr; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+    // 访问元素相关操作
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    // 调整容器相关操作
+    // assign
+    void assign(size_type n, const value_type& value) { fill_assign(n, value); }
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) { copy_assign(first, last); }
+    void assign(std::initializer_list<T> ilist) { copy_assign(ilist.begin(), ilist.end()); }
+
+    // emplace_front / emplace_after
+    template <class... Args>
+    void emplace_front(Args&&... args) {
+        emplace_after(cbefore_begin(), MySTL::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_after(const_iterator pos, Args&&... args) {
+        MYSTL_DEBUG(pos != cend());
+        base_ptr n = create_node(MySTL::forward<Args>(args)...);
+        n->next = pos.node_->next;
+        pos.node_->next = n;
+        return n;
+    }
+
+    // insert_after，返回指向最后一个插入元素的迭代器，没有插入元素时返回 pos
+    iterator insert_after(const_iterator pos, const value_type& value) { return emplace_after(pos, value); }
+    iterator insert_after(const_iterator pos, value_type&& value) { return emplace_after(pos, MySTL::move(value)); }
+    iterator insert_after(const_iterator pos, size_type n, const value_type& value) {
+        return fill_insert_after(pos, n, value);
+    }
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert_after(const_iterator pos, Iter first, Iter last) {
+        return copy_insert_after(pos, first, last);
+    }
+    iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
+        return copy_insert_after(pos, ilist.begin(), ilist.end());
+    }
+
+    // push_front / pop_front
+    void push_front(const value_type& value) { emplace_after(cbefore_begin(), value); }
+    void push_front(value_type&& value) { emplace_after(cbefore_begin(), MySTL::move(value)); }
+
+    void pop_front() {
+        MYSTL_DEBUG(!empty());
+        erase_after(cbefore_begin());
+    }
+
+    // erase_after / clear
+    iterator erase_after(const_iterator pos);
+    iterator erase_after(const_iterator first, const_iterator last);
+    void clear() { erase_after(cbefore_begin(), cend()); }
+
+    // resize
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    void swap(forward_list& rhs) noexcept {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
+        MySTL::swap(head_.next, rhs.head_.next);
+    }
+
+    // forward_list 相关操作
+    void splice_after(const_iterator pos, forward_list& other);
+    void splice_after(const_iterator pos, forward_list& other, const_iterator it);
+    void splice_after(const_iterator pos, forward_list& other, const_iterator first, const_iterator last);
+
+    void remove(const value_type& value) {
+        remove_if([&](const value_type& v) { return v == value; });
+    }
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred);
+
+    void unique() { unique(MySTL::equal_to<T>()); }
+    template <class BinaryPredicate>
+    void unique(BinaryPredicate pred);
+
+    void merge(forward_list& x) { merge(x, MySTL::less<T>()); }
+    template <class Compare>
+    void merge(forward_list& x, Compare comp);
+
+    void sort() { list_sort(MySTL::less<T>()); }
+    template <class Compared>
+    void sort(Compared comp) { list_sort(comp); }
+
+    void reverse() noexcept;
+
+   private:
+    // helper functions
+
+    // create / destroy node
+    template <class... Args>
+    base_ptr create_node(Args&&... args);
+    void destroy_node(base_ptr p);
+
+    // insert
+    iterator fill_insert_after(const_iterator pos, size_type n, const value_type& value);
+    template <class Iter>
+    iterator copy_insert_after(const_iterator pos, Iter first, Iter last);
+    iterator link_chain_after(const_iterator pos, base_ptr first, base_ptr last) noexcept;
+
+    // assign
+    void fill_assign(size_type n, const value_type& value);
+    template <class Iter>
+    void copy_assign(Iter first, Iter last);
+
+    // sort
+    template <class Compared>
+    static void merge_chains(base_ptr& a, base_ptr b, Compared& comp);
+    template <class Compared>
+    void list_sort(Compared comp);
+};
+
+/*****************************************************************************************/
+
+// 删除 pos 之后的一个元素
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::erase_after(const_iterator pos) {
+    MYSTL_DEBUG(pos != cend() && pos.node_->next != nullptr);
+    base_ptr n = pos.node_->next;
+    pos.node_->next = n->next;
+    destroy_node(n);
+    return pos.node_->next;
+}
+
+// 删除 (first, last) 内的元素
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::erase_after(const_iterator first, const_iterator last) {
+    base_ptr cur = first.node_->next;
+    while (cur != last.node_) {
+        base_ptr next = cur->next;
+        destroy_node(cur);
+        cur = next;
+    }
+    first.node_->next = last.node_;
+    return last.node_;
+}
+
+// 重置容器大小
+template <class T, class Alloc>
+void forward_list<T, Alloc>::resize(size_type new_size, const value_type& value) {
+    base_ptr prev = &head_;
+    size_type len = 0;
+    while (prev->next != nullptr && len < new_size) {
+        prev = prev->next;
+        ++len;
+    }
+    if (len == new_size) {
+        erase_after(prev, nullptr);
+    } else {
+        fill_insert_after(prev, new_size - len, value);
+    }
+}
+
+// 将 other 的全部节点接合于 pos 之后
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list& other) {
+    MYSTL_DEBUG(this != &other);
+    if (!other.empty()) {
+        base_ptr f = other.head_.next;
+        base_ptr l = f;
+        while (l->next != nullptr)
+            l = l->next;
+        other.head_.next = nullptr;
+        link_chain_after(pos, f, l);
+    }
+}
+
+// 将 it 之后的一个节点接合于 pos 之后
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list&, const_iterator it) {
+    base_ptr n = it.node_->next;
+    if (pos.node_ != it.node_ && pos.node_ != n) {
+        it.node_->next = n->next;
+        link_chain_after(pos, n, n);
+    }
+}
+
+// 将 other 的 (first, last) 内的节点接合于 pos 之后
+template <class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list&, const_iterator first, const_iterator last) {
+    base_ptr f = first.node_->next;
+    if (f != last.node_) {
+        base_ptr l = f;
+        while (l->next != last.node_)
+            l = l->next;
+        first.node_->next = last.node_;
+        link_chain_after(pos, f, l);
+    }
+}
+
+// 将另一元操作 pred 为 true 的所有元素移除
+template <class T, class Alloc>
+template <class UnaryPredicate>
+void forward_list<T, Alloc>::remove_if(UnaryPredicate pred) {
+    base_ptr prev = &head_;
+    while (prev->next != nullptr) {
+        if (pred(prev->next->as_node()->value)) {
+            erase_after(prev);
+        } else {
+            prev = prev->next;
+        }
+    }
+}
+
+// 移除 forward_list 中满足 pred 为 true 重复元素
+template <class T, class Alloc>
+template <class BinaryPredicate>
+void forward_list<T, Alloc>::unique(BinaryPredicate pred) {
+    base_ptr i = head_.next;
+    if (i == nullptr)
+        return;
+    while (i->next != nullptr) {
+        if (pred(i->as_node()->value, i->next->as_node()->value)) {
+            erase_after(i);
+        } else {
+            i = i->next;
+        }
+    }
+}
+
+// 与另一个 forward_list 合并，按照 comp 为 true 的顺序
+template <class T, class Alloc>
+template <class Compare>
+void forward_list<T, Alloc>::merge(forward_list& x, Compare comp) {
+    if (this != &x) {
+        base_ptr b = x.head_.next;
+        x.head_.next = nullptr;
+        merge_chains(head_.next, b, comp);
+    }
+}
+
+// 将 forward_list 反转
+template <class T, class Alloc>
+void forward_list<T, Alloc>::reverse() noexcept {
+    base_ptr prev = nullptr;
+    base_ptr cur = head_.next;
+    while (cur != nullptr) {
+        base_ptr next = cur->next;
+        cur->next = prev;
+        prev = cur;
+        cur = next;
+    }
+    head_.next = prev;
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 创建结点
+template <class T, class Alloc>
+template <class... Args>
+typename forward_list<T, Alloc>::base_ptr
+forward_list<T, Alloc>::create_node(Args&&... args) {
+    node_ptr p = node_alloc_traits::allocate(this->get_alloc(), 1);
+    try {
+        node_alloc_traits::construct(this->get_alloc(), MySTL::address_of(p->value), MySTL::forward<Args>(args)...);
+        p->next = nullptr;
+    } catch (...) {
+        node_alloc_traits::deallocate(this->get_alloc(), p, 1);
+        throw;
+    }
+    return p;
+}
+
+// 销毁结点
+template <class T, class Alloc>
+void forward_list<T, Alloc>::destroy_node(base_ptr p) {
+    node_ptr n = p->as_node();
+    node_alloc_traits::destroy(this->get_alloc(), MySTL::address_of(n->value));
+    node_alloc_traits::deallocate(this->get_alloc(), n, 1);
+}
+
+// 在 pos 之后插入 n 个元素，先串成一条链再整体接入，失败时容器不变
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::fill_insert_after(const_iterator pos, size_type n, const value_type& value) {
+    if (n == 0)
+        return pos.node_;
+    base_ptr first = create_node(value);
+    base_ptr last = first;
+    try {
+        for (--n; n > 0; --n) {
+            last->next = create_node(value);
+            last = last->next;
+        }
+    } catch (...) {
+        while (first != nullptr) {
+            base_ptr next = first->next;
+            destroy_node(first);
+            first = next;
+        }
+        throw;
+    }
+    return link_chain_after(pos, first, last);
+}
+
+// 在 pos 之后插入 [first, last) 的元素，先串成一条链再整体接入，失败时容器不变
+template <class T, class Alloc>
+template <class Iter>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::copy_insert_after(const_iterator pos, Iter first, Iter last) {
+    if (first == last)
+        return pos.node_;
+    base_ptr f = create_node(*first);
+    base_ptr l = f;
+    try {
+        for (++first; first != last; ++first) {
+            l->next = create_node(*first);
+            l = l->next;
+        }
+    } catch (...) {
+        while (f != nullptr) {
+            base_ptr next = f->next;
+            destroy_node(f);
+            f = next;
+        }
+        throw;
+    }
+    return link_chain_after(pos, f, l);
+}
+
+// 把 [first, last] 的节点接在 pos 之后，返回指向 last 的迭代器
+template <class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+forward_list<T, Alloc>::link_chain_after(const_iterator pos, base_ptr first, base_ptr last) noexcept {
+    last->next = pos.node_->next;
+    pos.node_->next = first;
+    return last;
+}
+
+// 用 n 个元素为容器赋值
+template <class T, class Alloc>
+void forward_list<T, Alloc>::fill_assign(size_type n, const value_type& value) {
+    base_ptr prev = &head_;
+    for (; n > 0 && prev->next != nullptr; --n, prev = prev->next) {
+        prev->next->as_node()->value = value;
+    }
+    if (n > 0) {
+        fill_insert_after(prev, n, value);
+    } else {
+        erase_after(prev, nullptr);
+    }
+}
+
+// 复制[first, last)为容器赋值
+template <class T, class Alloc>
+template <class Iter>
+void forward_list<T, Alloc>::copy_assign(Iter first, Iter last) {
+    base_ptr prev = &head_;
+    for (; first != last && prev->next != nullptr; ++first, prev = prev->next) {
+        prev->next->as_node()->value = *first;
+    }
+    if (first == last) {
+        erase_after(prev, nullptr);
+    } else {
+        copy_insert_after(prev, first, last);
+    }
+}
+
+// merge_chains 函数
+// 把两条以 nullptr 结尾的有序链 a、b 合并后放回 a，相等的元素中 a 的在前，排序因此是稳定的
+// comp 抛出异常时，已合并的部分与 a、b 剩余的节点接成一条放回 a，节点不会丢失
+template <class T, class Alloc>
+template <class Compared>
+void forward_list<T, Alloc>::merge_chains(base_ptr& a, base_ptr b, Compared& comp) {
+    if (b == nullptr)
+        return;
+    forward_list_node_base<T> head;
+    base_ptr tail = &head;
+    base_ptr x = a;
+    base_ptr y = b;
+    try {
+        while (x != nullptr && y != nullptr) {
+            if (comp(y->as_node()->value, x->as_node()->value)) {
+                tail->next = y;
+                tail = y;
+                y = y->next;
+            } else {
+                tail->next = x;
+                tail = x;
+                x = x->next;
+            }
+        }
+    } catch (...) {
+        tail->next = x;
+        while (tail->next != nullptr)
+            tail = tail->next;
+        tail->next = y;
+        a = head.next;
+        throw;
+    }
+    tail->next = x != nullptr ? x : y;
+    a = head.next;
+}
+
+// 对 forward_list 进行自底向上的归并排序，做法与 list::sort 相同
+template <class T, class Alloc>
+template <class Compared>
+void forward_list<T, Alloc>::list_sort(Compared comp) {
+    if (head_.next == nullptr || head_.next->next == nullptr)
+        return;
+    base_ptr rest = head_.next;
+    head_.next = nullptr;
+    base_ptr bins[64] = {};  // 64 个桶足以容纳 2^64 - 1 个节点
+    base_ptr carry = nullptr;
+    try {
+        while (rest != nullptr) {
+            carry = rest;
+            rest = rest->next;
+            carry->next = nullptr;
+            // 桶中的节点比 carry 更早出现，放在 merge_chains 的第一个参数
+            size_t i = 0;
+            for (; bins[i] != nullptr; ++i) {
+                base_ptr later = carry;
+                carry = nullptr;
+                merge_chains(bins[i], later, comp);
+                carry = bins[i];
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            carry = nullptr;
+        }
+        base_ptr result = nullptr;
+        for (size_t i = 0; i < 64; ++i) {
+            if (bins[i] != nullptr) {
+                merge_chains(bins[i], result, comp);
+                result = bins[i];
+                bins[i] = nullptr;
+            }
+        }
+        head_.next = result;
+    } catch (...) {
+        // 把散落在各个桶与 carry、rest 中的节点接回 forward_list，元素不变，顺序不定
+        base_ptr all = rest;
+        auto gather = [&all](base_ptr chain) {
+            if (chain == nullptr)
+                return;
+            base_ptr tail = chain;
+            while (tail->next != nullptr)
+                tail = tail->next;
+            tail->next = all;
+            all = chain;
+        };
+        gather(carry);
+        for (size_t i = 0; i < 64; ++i)
+            gather(bins[i]);
+        head_.next = all;
+        throw;
+    }
+}
+
+// 重载比较操作符
+template <class T, class Alloc>
+bool operator==(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    auto f1 = lhs.cbegin();
+    auto f2 = rhs.cbegin();
+    auto l1 = lhs.cend();
+    auto l2 = rhs.cend();
+    for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2);
+    return f1 == l1 && f2 == l2;
+}
+
+template <class T, class Alloc>
+bool operator<(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <class T, class Alloc>
+bool operator!=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator>(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, class Alloc>
+void swap(forward_list<T, Alloc>& lhs, forward_list<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 没有节点指回头结点，forward_list 对象可以按字节搬移
+template <class T, class Alloc>
+struct is_trivially_relocatable<forward_list<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class T>
+using forward_list = MySTL::forward_list<T, MySTL::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace MySTL
+#endif  // !_MYSTL_FORWARD_LIST_H_
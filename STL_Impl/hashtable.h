@@ -71,13 +71,13 @@ struct ht_value_traits {
 };
 
 // forward declaration
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc = typename default_node_allocator<T>::type>
 class hashtable;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 struct ht_iterator;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 struct ht_const_iterator;
 
 template <class T>
@@ -87,12 +87,12 @@ template <class T>
 struct ht_const_local_iterator;
 
 // ht_iterator
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 struct ht_iterator_base : public MySTL::iterator<MySTL::forward_iterator_tag, T> {
-    typedef MySTL::hashtable<T, Hash, KeyEqual> hashtable;
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
-    typedef MySTL::ht_iterator<T, Hash, KeyEqual> iterator;
-    typedef MySTL::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef MySTL::hashtable<T, Hash, KeyEqual, Alloc> hashtable;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
+    typedef MySTL::ht_iterator<T, Hash, KeyEqual, Alloc> iterator;
+    typedef MySTL::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef hashtable_node<T>* node_ptr;
     typedef hashtable* contain_ptr;
     typedef const node_ptr const_node_ptr;
@@ -110,9 +110,9 @@ struct ht_iterator_base : public MySTL::iterator<MySTL::forward_iterator_tag, T>
     bool operator!=(const base& rhs) const { return node != rhs.node; }
 };
 
-template <class T, class Hash, class KeyEqual>
-struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual> {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual, Alloc> {
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable hashtable;
     typedef typename base::iterator iterator;
     typedef typename base::const_iterator const_iterator;
@@ -181,9 +181,9 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual> {
     }
 };
 
-template <class T, class Hash, class KeyEqual>
-struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual> {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual, Alloc> {
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable hashtable;
     typedef typename base::iterator iterator;
     typedef typename base::const_iterator const_iterator;
@@ -429,11 +429,11 @@ inline size_t ht_next_prime(size_t n) {
 }
 
 // 模板类 hashtable
-// 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数
-template <class T, class Hash, class KeyEqual>
-class hashtable {
-    friend struct MySTL::ht_iterator<T, Hash, KeyEqual>;
-    friend struct MySTL::ht_const_iterator<T, Hash, KeyEqual>;
+// 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数，参数四代表分配器类型
+template <class T, class Hash, class KeyEqual, class Alloc>
+class hashtable : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<hashtable_node<T>>> {
+    friend struct MySTL::ht_iterator<T, Hash, KeyEqual, Alloc>;
+    friend struct MySTL::ht_const_iterator<T, Hash, KeyEqual, Alloc>;
 
    public:
     // hashtable 的型别定义
@@ -446,25 +446,27 @@ class hashtable {
 
     typedef hashtable_node<T> node_type;
     typedef node_type* node_ptr;
-    typedef MySTL::vector<node_ptr> bucket_type;
 
-    typedef MySTL::allocator<T> allocator_type;
-    typedef MySTL::allocator<T> data_allocator;
-    typedef MySTL::allocator<node_type> node_allocator;
-
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<node_type> node_allocator;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<node_ptr> bucket_allocator;
+    typedef MySTL::allocator_traits<node_allocator> node_alloc_traits;
+    typedef MySTL::alloc_holder<node_allocator> holder_type;
+    typedef MySTL::vector<node_ptr, bucket_allocator> bucket_type;
+
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
 
-    typedef MySTL::ht_iterator<T, Hash, KeyEqual> iterator;
-    typedef MySTL::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef MySTL::ht_iterator<T, Hash, KeyEqual, Alloc> iterator;
+    typedef MySTL::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef MySTL::ht_local_iterator<T> local_iterator;
     typedef MySTL::ht_const_local_iterator<T> const_local_iterator;
 
-    allocator_type get_allocator() const { return allocator_type(); }
+    allocator_type get_allocator() const { return allocator_type(this->get_alloc()); }
 
    private:
     // 用以下六个参数来表现 hashtable
@@ -498,35 +500,47 @@ class hashtable {
 
    public:
     // 构造、复制、移动、析构函数
-    explicit hashtable(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
-        : size_(0), mlf_(1.0f), hash_(hash), equal_(equal) {
+    explicit hashtable(size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)), buckets_(bucket_allocator(alloc)), size_(0), mlf_(1.0f), hash_(hash), equal_(equal) {
         init(bucket_count);
     }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    hashtable(Iter first, Iter last, size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
-        : size_(MySTL::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal) {
+    hashtable(Iter first, Iter last, size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+              const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)), buckets_(bucket_allocator(alloc)), size_(MySTL::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal) {
         init(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))));
     }
 
-    hashtable(const hashtable& rhs) : hash_(rhs.hash_), equal_(rhs.equal_) {
+    hashtable(const hashtable& rhs)
+        : holder_type(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())),
+          buckets_(bucket_allocator(this->get_alloc())),
+          hash_(rhs.hash_),
+          equal_(rhs.equal_) {
+        copy_init(rhs);
+    }
+
+    hashtable(const hashtable& rhs, const allocator_type& alloc)
+        : holder_type(node_allocator(alloc)), buckets_(bucket_allocator(alloc)), hash_(rhs.hash_), equal_(rhs.equal_) {
         copy_init(rhs);
     }
 
     hashtable(hashtable&& rhs) noexcept
-        : bucket_size_(rhs.bucket_size_),
+        : holder_type(MySTL::move(rhs.get_alloc())),
+          buckets_(MySTL::move(rhs.buckets_)),
+          bucket_size_(rhs.bucket_size_),
           size_(rhs.size_),
           mlf_(rhs.mlf_),
           hash_(rhs.hash_),
           equal_(rhs.equal_) {
-        buckets_ = MySTL::move(rhs.buckets_);
         rhs.bucket_size_ = 0;
         rhs.size_ = 0;
         rhs.mlf_ = 0.0f;
     }
 
     hashtable& operator=(const hashtable& rhs);
-    hashtable& operator=(hashtable&& rhs) noexcept;
+    hashtable& operator=(hashtable&& rhs) noexcept(node_alloc_traits::is_always_equal::value);
 
     ~hashtable() { clear(); }
 
@@ -700,6 +714,9 @@ class hashtable {
     void erase_bucket(size_type n, node_ptr first, node_ptr last);
     void erase_bucket(size_type n, node_ptr last);
 
+    // swap
+    void swap_data(hashtable& rhs) noexcept;
+
     // comparision
     bool equal_to_multi(const hashtable& other);
     bool equal_to_unique(const hashtable& other);
@@ -708,33 +725,47 @@ class hashtable {
 /*****************************************************************************************/
 
 // 复制赋值运算符
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>&
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>&
+hashtable<T, Hash, KeyEqual, Alloc>::
 operator=(const hashtable& rhs) {
     if (this != &rhs) {
-        hashtable tmp(rhs);
-        swap(tmp);
+        if (node_alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的节点必须由原来的分配器释放
+            clear();
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        }
+        hashtable tmp(rhs, get_allocator());
+        swap_data(tmp);
     }
     return *this;
 }
 
 // 移动赋值运算符
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>&
-hashtable<T, Hash, KeyEqual>::
-operator=(hashtable&& rhs) noexcept {
-    hashtable tmp(MySTL::move(rhs));
-    swap(tmp);
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>&
+hashtable<T, Hash, KeyEqual, Alloc>::
+operator=(hashtable&& rhs) noexcept(node_alloc_traits::is_always_equal::value) {
+    if (node_alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+        hashtable tmp(MySTL::move(rhs));
+        clear();
+        MySTL::alloc_move_assign(this->get_alloc(), tmp.get_alloc());
+        swap_data(tmp);
+    } else {
+        // 分配器不相等，不能直接接管对方的节点
+        hashtable tmp(rhs, get_allocator());
+        swap_data(tmp);
+        rhs.clear();
+    }
     return *this;
 }
 
 // 就地构造元素，键值允许重复
 // 强异常安全保证
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class... Args>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::emplace_multi(Args&&... args) {
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::emplace_multi(Args&&... args) {
     auto np = create_node(MySTL::forward<Args>(args)...);
     try {
         if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
@@ -748,10 +779,10 @@ hashtable<T, Hash, KeyEqual>::emplace_multi(Args&&... args) {
 
 // 就地构造元素，键值允许重复
 // 强异常安全保证
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class... Args>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::emplace_unique(Args&&... args) {
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::emplace_unique(Args&&... args) {
     auto np = create_node(MySTL::forward<Args>(args)...);
     try {
         if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
@@ -764,9 +795,9 @@ hashtable<T, Hash, KeyEqual>::emplace_unique(Args&&... args) {
 }
 
 // 在不需要重建表格的情况下插入新节点，键值不允许重复
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::insert_unique_noresize(const value_type& value) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::insert_unique_noresize(const value_type& value) {
     const auto n = hash(value_traits::get_key(value));
     auto first = buckets_[n];
     for (auto cur = first; cur; cur = cur->next) {
@@ -782,9 +813,9 @@ hashtable<T, Hash, KeyEqual>::insert_unique_noresize(const value_type& value) {
 }
 
 // 在不需要重建表格的情况下插入新节点，键值允许重复
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::insert_multi_noresize(const value_type& value) {
     const auto n = hash(value_traits::get_key(value));
     auto first = buckets_[n];
     auto tmp = create_node(value);
@@ -804,8 +835,8 @@ hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value) {
 }
 
 // 删除迭代器所指的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::erase(const_iterator position) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::erase(const_iterator position) {
     auto p = position.node;
     if (p) {
         const auto n = hash(value_traits::get_key(p->value));
@@ -832,8 +863,8 @@ void hashtable<T, Hash, KeyEqual>::erase(const_iterator position) {
 }
 
 // 删除[first, last)内的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::erase(const_iterator first, const_iterator last) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::erase(const_iterator first, const_iterator last) {
     if (first.node == last.node)
         return;
     auto first_bucket = first.node
@@ -857,9 +888,9 @@ void hashtable<T, Hash, KeyEqual>::erase(const_iterator first, const_iterator la
 }
 
 // 删除键值为 key 的节点
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::erase_multi(const key_type& key) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::erase_multi(const key_type& key) {
     auto p = equal_range_multi(key);
     if (p.first.node != nullptr) {
         erase(p.first, p.second);
@@ -868,9 +899,9 @@ hashtable<T, Hash, KeyEqual>::erase_multi(const key_type& key) {
     return 0;
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::erase_unique(const key_type& key) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::erase_unique(const key_type& key) {
     const auto n = hash(key);
     auto first = buckets_[n];
     if (first) {
@@ -897,8 +928,8 @@ hashtable<T, Hash, KeyEqual>::erase_unique(const key_type& key) {
 }
 
 // 清空 hashtable
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::clear() {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::clear() {
     if (size_ != 0) {
         for (size_type i = 0; i < bucket_size_; ++i) {
             node_ptr cur = buckets_[i];
@@ -914,9 +945,9 @@ void hashtable<T, Hash, KeyEqual>::clear() {
 }
 
 // 在某个 bucket 节点的个数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::bucket_size(size_type n) const noexcept {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::bucket_size(size_type n) const noexcept {
     size_type result = 0;
     for (auto cur = buckets_[n]; cur; cur = cur->next) {
         ++result;
@@ -925,8 +956,8 @@ hashtable<T, Hash, KeyEqual>::bucket_size(size_type n) const noexcept {
 }
 
 // 重新对元素进行一遍哈希，插入到新的位置
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::rehash(size_type count) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::rehash(size_type count) {
     auto n = ht_next_prime(count);
     if (n > bucket_size_) {
         replace_bucket(n);
@@ -940,9 +971,9 @@ void hashtable<T, Hash, KeyEqual>::rehash(size_type count) {
 }
 
 // 查找键值为 key 的节点，返回其迭代器
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::find(const key_type& key) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::find(const key_type& key) {
     const auto n = hash(key);
     node_ptr first = buckets_[n];
     for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {
@@ -950,9 +981,9 @@ hashtable<T, Hash, KeyEqual>::find(const key_type& key) {
     return iterator(first, this);
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::const_iterator
-hashtable<T, Hash, KeyEqual>::find(const key_type& key) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator
+hashtable<T, Hash, KeyEqual, Alloc>::find(const key_type& key) const {
     const auto n = hash(key);
     node_ptr first = buckets_[n];
     for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {
@@ -961,9 +992,9 @@ hashtable<T, Hash, KeyEqual>::find(const key_type& key) const {
 }
 
 // 查找键值为 key 出现的次数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::count(const key_type& key) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::count(const key_type& key) const {
     const auto n = hash(key);
     size_type result = 0;
     for (node_ptr cur = buckets_[n]; cur; cur = cur->next) {
@@ -974,10 +1005,10 @@ hashtable<T, Hash, KeyEqual>::count(const key_type& key) const {
 }
 
 // 查找与键值 key 相等的区间，返回一个 pair，指向相等区间的首尾
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-     typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_multi(const key_type& key) {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
         if (is_equal(value_traits::get_key(first->value), key)) {  // 如果出现相等的键值
@@ -995,10 +1026,10 @@ hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) {
     return MySTL::make_pair(end(), end());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-     typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_multi(const key_type& key) const {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
         if (is_equal(value_traits::get_key(first->value), key)) {
@@ -1016,10 +1047,10 @@ hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) const {
     return MySTL::make_pair(cend(), cend());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-     typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_unique(const key_type& key) {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
         if (is_equal(value_traits::get_key(first->value), key)) {
@@ -1035,10 +1066,10 @@ hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) {
     return MySTL::make_pair(end(), end());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-     typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_unique(const key_type& key) const {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
         if (is_equal(value_traits::get_key(first->value), key)) {
@@ -1055,8 +1086,17 @@ hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) const {
 }
 
 // 交换 hashtable
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::swap(hashtable& rhs) noexcept {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::swap(hashtable& rhs) noexcept {
+    if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
+        swap_data(rhs);
+    }
+}
+
+// 只交换数据，不交换节点分配器
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::swap_data(hashtable& rhs) noexcept {
     if (this != &rhs) {
         buckets_.swap(rhs.buckets_);
         MySTL::swap(bucket_size_, rhs.bucket_size_);
@@ -1070,8 +1110,8 @@ void hashtable<T, Hash, KeyEqual>::swap(hashtable& rhs) noexcept {
 /****************************************************************************************/
 // helper function
 // init 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::init(size_type n) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::init(size_type n) {
     const auto bucket_nums = next_size(n);
     try {
         buckets_.reserve(bucket_nums);
@@ -1085,8 +1125,8 @@ void hashtable<T, Hash, KeyEqual>::init(size_type n) {
 }
 
 // copy_init 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::copy_init(const hashtable& ht) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::copy_init(const hashtable& ht) {
     bucket_size_ = 0;
     buckets_.reserve(ht.bucket_size_);
     buckets_.assign(ht.bucket_size_, nullptr);
@@ -1112,85 +1152,85 @@ void hashtable<T, Hash, KeyEqual>::copy_init(const hashtable& ht) {
 }
 
 // create_node 函数
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class... Args>
-typename hashtable<T, Hash, KeyEqual>::node_ptr
-hashtable<T, Hash, KeyEqual>::create_node(Args&&... args) {
-    node_ptr tmp = node_allocator::allocate(1);
+typename hashtable<T, Hash, KeyEqual, Alloc>::node_ptr
+hashtable<T, Hash, KeyEqual, Alloc>::create_node(Args&&... args) {
+    node_ptr tmp = node_alloc_traits::allocate(this->get_alloc(), 1);
     try {
-        data_allocator::construct(MySTL::address_of(tmp->value), MySTL::forward<Args>(args)...);
+        node_alloc_traits::construct(this->get_alloc(), MySTL::address_of(tmp->value), MySTL::forward<Args>(args)...);
         tmp->next = nullptr;
     } catch (...) {
-        node_allocator::deallocate(tmp);
+        node_alloc_traits::deallocate(this->get_alloc(), tmp, 1);
         throw;
     }
     return tmp;
 }
 
 // destroy_node 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::destroy_node(node_ptr node) {
-    data_allocator::destroy(MySTL::address_of(node->value));
-    node_allocator::deallocate(node);
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::destroy_node(node_ptr node) {
+    node_alloc_traits::destroy(this->get_alloc(), MySTL::address_of(node->value));
+    node_alloc_traits::deallocate(this->get_alloc(), node, 1);
     node = nullptr;
 }
 
 // next_size 函数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::next_size(size_type n) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::next_size(size_type n) const {
     return ht_next_prime(n);
 }
 
 // hash 函数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::hash(const key_type& key, size_type n) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::hash(const key_type& key, size_type n) const {
     return hash_(key) % n;
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::hash(const key_type& key) const {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::hash(const key_type& key) const {
     return hash_(key) % bucket_size_;
 }
 
 // rehash_if_need 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::rehash_if_need(size_type n) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::rehash_if_need(size_type n) {
     if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
         rehash(size_ + n);
 }
 
 // copy_insert
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class InputIter>
-void hashtable<T, Hash, KeyEqual>::copy_insert_multi(InputIter first, InputIter last, MySTL::input_iterator_tag) {
+void hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_multi(InputIter first, InputIter last, MySTL::input_iterator_tag) {
     rehash_if_need(MySTL::distance(first, last));
     for (; first != last; ++first)
         insert_multi_noresize(*first);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ForwardIter>
-void hashtable<T, Hash, KeyEqual>::copy_insert_multi(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag) {
+void hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_multi(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag) {
     size_type n = MySTL::distance(first, last);
     rehash_if_need(n);
     for (; n > 0; --n, ++first)
         insert_multi_noresize(*first);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class InputIter>
-void hashtable<T, Hash, KeyEqual>::copy_insert_unique(InputIter first, InputIter last, MySTL::input_iterator_tag) {
+void hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_unique(InputIter first, InputIter last, MySTL::input_iterator_tag) {
     rehash_if_need(MySTL::distance(first, last));
     for (; first != last; ++first)
         insert_unique_noresize(*first);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ForwardIter>
-void hashtable<T, Hash, KeyEqual>::copy_insert_unique(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag) {
+void hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_unique(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag) {
     size_type n = MySTL::distance(first, last);
     rehash_if_need(n);
     for (; n > 0; --n, ++first)
@@ -1198,9 +1238,9 @@ void hashtable<T, Hash, KeyEqual>::copy_insert_unique(ForwardIter first, Forward
 }
 
 // insert_node 函数
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::insert_node_multi(node_ptr np) {
     const auto n = hash(value_traits::get_key(np->value));
     auto cur = buckets_[n];
     if (cur == nullptr) {
@@ -1223,9 +1263,9 @@ hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np) {
 }
 
 // insert_node_unique 函数
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::insert_node_unique(node_ptr np) {
     const auto n = hash(value_traits::get_key(np->value));
     auto cur = buckets_[n];
     if (cur == nullptr) {
@@ -1245,18 +1285,21 @@ hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np) {
 }
 
 // replace_bucket 函数
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::replace_bucket(size_type bucket_count) {
-    bucket_type bucket(bucket_count);
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::replace_bucket(size_type bucket_count) {
+    bucket_type bucket(bucket_count, buckets_.get_allocator());
     if (size_ != 0) {
+        // 直接把原有节点重新链接到新的桶中，不重新分配节点
         for (size_type i = 0; i < bucket_size_; ++i) {
-            for (auto first = buckets_[i]; first; first = first->next) {
-                auto tmp = create_node(first->value);
-                const auto n = hash(value_traits::get_key(first->value), bucket_count);
+            auto first = buckets_[i];
+            while (first) {
+                auto tmp = first;
+                first = first->next;
+                const auto n = hash(value_traits::get_key(tmp->value), bucket_count);
                 auto f = bucket[n];
                 bool is_inserted = false;
                 for (auto cur = f; cur; cur = cur->next) {
-                    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value))) {
+                    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(tmp->value))) {
                         tmp->next = cur->next;
                         cur->next = tmp;
                         is_inserted = true;
@@ -1268,6 +1311,7 @@ void hashtable<T, Hash, KeyEqual>::replace_bucket(size_type bucket_count) {
                     bucket[n] = tmp;
                 }
             }
+            buckets_[i] = nullptr;
         }
     }
     buckets_.swap(bucket);
@@ -1276,8 +1320,8 @@ void hashtable<T, Hash, KeyEqual>::replace_bucket(size_type bucket_count) {
 
 // erase_bucket 函数
 // 在第 n 个 bucket 内，删除 [first, last) 的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr first, node_ptr last) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::erase_bucket(size_type n, node_ptr first, node_ptr last) {
     auto cur = buckets_[n];
     if (cur == first) {
         erase_bucket(n, last);
@@ -1296,8 +1340,8 @@ void hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr first, nod
 
 // erase_bucket 函数
 // 在第 n 个 bucket 内，删除 [buckets_[n], last) 的节点
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr last) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void hashtable<T, Hash, KeyEqual, Alloc>::erase_bucket(size_type n, node_ptr last) {
     auto cur = buckets_[n];
     while (cur != last) {
         auto next = cur->next;
@@ -1309,8 +1353,8 @@ void hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr last) {
 }
 
 // equal_to 函数
-template <class T, class Hash, class KeyEqual>
-bool hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable& other) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+bool hashtable<T, Hash, KeyEqual, Alloc>::equal_to_multi(const hashtable& other) {
     if (size_ != other.size_)
         return false;
     for (auto f = begin(), l = end(); f != l;) {
@@ -1324,8 +1368,8 @@ bool hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable& other) {
     return true;
 }
 
-template <class T, class Hash, class KeyEqual>
-bool hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable& other) {
+template <class T, class Hash, class KeyEqual, class Alloc>
+bool hashtable<T, Hash, KeyEqual, Alloc>::equal_to_unique(const hashtable& other) {
     if (size_ != other.size_)
         return false;
     for (auto f = begin(), l = end(); f != l; ++f) {
@@ -1337,10 +1381,16 @@ bool hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable& other) {
 }
 
 // 重载 MySTL 的 swap
-template <class T, class Hash, class KeyEqual>
-void swap(hashtable<T, Hash, KeyEqual>& lhs,
-          hashtable<T, Hash, KeyEqual>& rhs) noexcept {
+template <class T, class Hash, class KeyEqual, class Alloc>
+void swap(hashtable<T, Hash, KeyEqual, Alloc>& lhs,
+          hashtable<T, Hash, KeyEqual, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
+// hashtable 的桶是一个 vector，哈希函数、比较函数与分配器都可以平凡重定位时 hashtable 也可以
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<hashtable<T, Hash, KeyEqual, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Hash>::value && is_trivially_relocatable<KeyEqual>::value &&
+                                       is_trivially_relocatable<Alloc>::value> {};
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -0,0 +1,388 @@
+#ifndef _MYSTL_INTRUSIVE_LIST_H_
+#define _MYSTL_INTRUSIVE_LIST_H_
+
+// 这个头文件包含一个模板类 intrusive_list
+// intrusive_list : 侵入式双向链表，链接指针（hook）嵌在元素自身之中
+
+// notes:
+//
+// 元素类型 T 需要公有继承 list_hook<Tag>，容器只保存元素的引用，不构造、不销毁、也不申请任何内存：
+//   struct conn : public MySTL::list_hook<> { ... };
+//   MySTL::intrusive_list<conn> active;
+// 同一个元素要同时挂在多条链表上时，为每条链表继承一个不同 Tag 的 hook，
+// 并以 intrusive_list<T, list_hook<Tag>> 指定容器使用哪一个
+// 与 list<T*> 相比，每个元素少一次节点分配，遍历时也少一次指针跳转；
+// 持有元素引用即可 O(1) 地 erase(x) 或用 iterator_to(x) 取得迭代器，因此很适合做 LRU：
+//   lru.splice(lru.begin(), lru, lru.iterator_to(x));
+// 结点的连接与断开复用 list_node_base 的 link_before / unlink_range
+// 未挂在链表上的 hook 两个指针都为空，is_linked() 据此判断；复制元素时 hook 不被复制
+// 容器析构或 clear 时只把元素从链表上摘下，元素的生命周期由使用者管理，
+// 元素必须在所属容器之前从链表上移除或者比容器活得更久
+
+#include "list.h"
+
+namespace MySTL {
+
+// 缺省的 hook 标签
+struct default_list_hook_tag {};
+
+// 嵌入元素中的链接指针
+template <class Tag = default_list_hook_tag>
+struct list_hook : public list_node_base<Tag> {
+    typedef list_node_base<Tag> node_base;
+
+    list_hook() noexcept { this->prev = this->next = nullptr; }
+    list_hook(const list_hook&) noexcept : list_hook() {}
+    list_hook& operator=(const list_hook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return this->next != nullptr; }
+};
+
+// intrusive_list 的迭代器设计
+template <class T, class Hook, class Ref, class Ptr>
+struct intrusive_list_iterator : public iterator<bidirectional_iterator_tag, T> {
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef typename Hook::node_base* base_ptr;
+    typedef intrusive_list_iterator<T, Hook, Ref, Ptr> self;
+
+    base_ptr node_;  // 指向当前元素的 hook
+
+    intrusive_list_iterator() = default;
+    intrusive_list_iterator(base_ptr x) : node_(x) {}
+    intrusive_list_iterator(const intrusive_list_iterator&) = default;
+    intrusive_list_iterator& operator=(const intrusive_list_iterator&) = default;
+
+    // 由 iterator 构造 const_iterator，反方向不允许
+    template <class R, class P, typename std::enable_if<std::is_convertible<P, Ptr>::value, int>::type = 0>
+    intrusive_list_iterator(const intrusive_list_iterator<T, Hook, R, P>& rhs) : node_(rhs.node_) {}
+
+    reference operator*() const { return static_cast<reference>(static_cast<Hook&>(*node_)); }
+    pointer operator->() const { return MySTL::address_of(operator*()); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->prev;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    // 重载比较操作符
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类: intrusive_list
+// 模板参数 T 代表元素类型，Hook 代表 T 所继承的、供本容器使用的 list_hook
+template <class T, class Hook = list_hook<>>
+class intrusive_list {
+   public:
+    // intrusive_list 的嵌套类型定义
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef Hook hook_type;
+    typedef typename Hook::node_base node_base;
+    typedef node_base* base_ptr;
+
+    typedef intrusive_list_iterator<T, Hook, T&, T*> iterator;
+    typedef intrusive_list_iterator<T, Hook, const T&, const T*> const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+   private:
+    node_base node_;  // 哨兵结点，嵌在容器内
+    size_type size_;  // 大小
+
+   public:
+    // 构造、移动、析构函数
+    intrusive_list() noexcept : size_(0) { node_.unlink(); }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    intrusive_list(Iter first, Iter last) : size_(0) {
+        node_.unlink();
+        insert(end(), first, last);
+    }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    intrusive_list(intrusive_list&& rhs) noexcept : size_(0) {
+        node_.unlink();
+        splice(end(), rhs);
+    }
+
+    intrusive_list& operator=(intrusive_list&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            splice(end(), rhs);
+        }
+        return *this;
+    }
+
+    ~intrusive_list() { clear(); }
+
+   public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return node_.next; }
+    const_iterator begin() const noexcept { return node_.next; }
+    iterator end() noexcept { return sentinel(); }
+    const_iterator end() const noexcept { return sentinel(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 由元素的引用得到指向它的迭代器，元素必须挂在本容器上
+    iterator iterator_to(reference x) noexcept {
+        MYSTL_DEBUG(hook_of(x)->next != nullptr);
+        return hook_of(x);
+    }
+    const_iterator iterator_to(const_reference x) const noexcept {
+        MYSTL_DEBUG(hook_of(x)->next != nullptr);
+        return hook_of(x);
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept { return node_.next == sentinel(); }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+    // 访问元素相关操作
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    // 调整容器相关操作
+    // push_front / push_back / insert，元素不能已经挂在某条链表上
+    void push_front(reference x) noexcept { insert(begin(), x); }
+    void push_back(reference x) noexcept { insert(end(), x); }
+
+    iterator insert(const_iterator pos, reference x) noexcept {
+        base_ptr n = hook_of(x);
+        MYSTL_DEBUG(n->next == nullptr);
+        node_base::link_before(pos.node_, n, n);
+        ++size_;
+        return n;
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void insert(const_iterator pos, Iter first, Iter last) {
+        for (; first != last; ++first)
+            insert(pos, *first);
+    }
+
+    // pop_front / pop_back
+    void pop_front() noexcept {
+        MYSTL_DEBUG(!empty());
+        erase(begin());
+    }
+    void pop_back() noexcept {
+        MYSTL_DEBUG(!empty());
+        erase(--end());
+    }
+
+    // erase / clear，只把元素从链表上摘下，不销毁元素
+    iterator erase(const_iterator pos) noexcept;
+    iterator erase(const_iterator first, const_iterator last) noexcept;
+    void erase(reference x) noexcept { erase(iterator_to(x)); }
+    void clear() noexcept;
+
+    // intrusive_list 相关操作
+    void splice(const_iterator pos, intrusive_list& other) noexcept;
+    void splice(const_iterator pos, intrusive_list& other, const_iterator it) noexcept;
+    void splice(const_iterator pos, intrusive_list& other, const_iterator first, const_iterator last) noexcept;
+
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred);
+
+    void reverse() noexcept;
+
+    void swap(intrusive_list& rhs) noexcept;
+
+   private:
+    // helper functions
+    base_ptr sentinel() const noexcept { return const_cast<base_ptr>(&node_); }
+
+    static base_ptr hook_of(const_reference x) noexcept {
+        return const_cast<base_ptr>(static_cast<const node_base*>(static_cast<const hook_type*>(MySTL::address_of(x))));
+    }
+
+    static void reset_hook(base_ptr n) noexcept { n->prev = n->next = nullptr; }
+};
+
+/*****************************************************************************************/
+
+// 摘下 pos 处的元素
+template <class T, class Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::erase(const_iterator pos) noexcept {
+    MYSTL_DEBUG(pos != cend());
+    base_ptr n = pos.node_;
+    base_ptr next = n->next;
+    node_base::unlink_range(n, n);
+    reset_hook(n);
+    --size_;
+    return next;
+}
+
+// 摘下 [first, last) 内的元素
+template <class T, class Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::erase(const_iterator first, const_iterator last) noexcept {
+    if (first != last) {
+        node_base::unlink_range(first.node_, last.node_->prev);
+        while (first != last) {
+            base_ptr n = first.node_;
+            ++first;
+            reset_hook(n);
+            --size_;
+        }
+    }
+    return last.node_;
+}
+
+// 清空 intrusive_list，每个元素的 hook 都恢复为未连接的状态
+template <class T, class Hook>
+void intrusive_list<T, Hook>::clear() noexcept {
+    base_ptr cur = node_.next;
+    while (cur != sentinel()) {
+        base_ptr next = cur->next;
+        reset_hook(cur);
+        cur = next;
+    }
+    node_.unlink();
+    size_ = 0;
+}
+
+// 将 other 的全部元素接合于 pos 之前
+template <class T, class Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list& other) noexcept {
+    MYSTL_DEBUG(this != &other);
+    if (!other.empty()) {
+        base_ptr f = other.node_.next;
+        base_ptr l = other.node_.prev;
+        node_base::unlink_range(f, l);
+        node_base::link_before(pos.node_, f, l);
+        size_ += other.size_;
+        other.size_ = 0;
+    }
+}
+
+// 将 it 所指的元素接合于 pos 之前，other 可以就是本容器
+template <class T, class Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list& other, const_iterator it) noexcept {
+    base_ptr n = it.node_;
+    if (pos.node_ != n && pos.node_ != n->next) {
+        node_base::unlink_range(n, n);
+        node_base::link_before(pos.node_, n, n);
+        ++size_;
+        --other.size_;
+    }
+}
+
+// 将 other 的 [first, last) 内的元素接合于 pos 之前，other 为其他容器时需要 O(n) 计数
+template <class T, class Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list& other,
+                                     const_iterator first, const_iterator last) noexcept {
+    if (first != last) {
+        if (this != &other) {
+            size_type n = MySTL::distance(first, last);
+            size_ += n;
+            other.size_ -= n;
+        }
+        base_ptr f = first.node_;
+        base_ptr l = last.node_->prev;
+        node_base::unlink_range(f, l);
+        node_base::link_before(pos.node_, f, l);
+    }
+}
+
+// 摘下所有令一元操作 pred 为 true 的元素
+template <class T, class Hook>
+template <class UnaryPredicate>
+void intrusive_list<T, Hook>::remove_if(UnaryPredicate pred) {
+    auto f = begin();
+    auto l = end();
+    while (f != l) {
+        auto next = f;
+        ++next;
+        if (pred(*f)) {
+            erase(f);
+        }
+        f = next;
+    }
+}
+
+// 将 intrusive_list 反转
+template <class T, class Hook>
+void intrusive_list<T, Hook>::reverse() noexcept {
+    if (size_ <= 1) {
+        return;
+    }
+    base_ptr e = sentinel();
+    base_ptr cur = e->next;
+    while (cur != e) {
+        MySTL::swap(cur->prev, cur->next);
+        cur = cur->prev;
+    }
+    MySTL::swap(e->prev, e->next);
+}
+
+// 交换两个 intrusive_list，哨兵嵌在容器内，因此通过接合完成
+template <class T, class Hook>
+void intrusive_list<T, Hook>::swap(intrusive_list& rhs) noexcept {
+    if (this != &rhs) {
+        intrusive_list tmp;
+        tmp.splice(tmp.end(), *this);
+        splice(end(), rhs);
+        rhs.splice(rhs.end(), tmp);
+    }
+}
+
+/*****************************************************************************************/
+// 重载 MySTL 的 swap
+template <class T, class Hook>
+void swap(intrusive_list<T, Hook>& lhs, intrusive_list<T, Hook>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace MySTL
+#endif  // !_MYSTL_INTRUSIVE_LIST_H_
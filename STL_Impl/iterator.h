@@ -106,6 +106,14 @@ struct is_bidirectional_iterator : has_iterator_cat_of<Iter, bidirectional_itera
 template <class Iter>
 struct is_random_access_iterator : has_iterator_cat_of<Iter, random_access_iterator_tag> {};
 
+// 连续迭代器：区间内的元素在内存中依次相邻，[first, last) 可以当作从 &*first 开始的一段内存处理
+// 原生指针满足这个要求，vector、basic_string 的迭代器就是原生指针；其他连续迭代器可以特化这个模板
+template <class Iter>
+struct is_contiguous_iterator : public m_false_type {};
+
+template <class T>
+struct is_contiguous_iterator<T*> : public m_true_type {};
+
 template <class Iterator>
 struct is_iterator : public m_bool_constant<
                          is_input_iterator<Iterator>::value ||
@@ -225,7 +233,7 @@ class reverse_iterator {
         return *--tmp;
     }
 
-    pointer operator->() const { return &(operator*()); }
+    pointer operator->() const { return arrow(std::is_pointer<pointer>()); }
 
     // 前进(++)变为后退(--)
     self& operator++() {
@@ -266,6 +274,14 @@ class reverse_iterator {
     self operator-(difference_type n) const { return self(current + n); }
 
     reference operator[](difference_type n) const { return *(*this + n); }
+
+   private:
+    // pointer 为指针时取元素的地址，否则 reference 是代理对象，交给正向迭代器的 operator->
+    pointer arrow(std::true_type) const { return &(operator*()); }
+    pointer arrow(std::false_type) const {
+        auto tmp = current;
+        return (--tmp).operator->();
+    }
 };
 
 // 重载 operator-
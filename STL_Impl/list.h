@@ -14,6 +14,11 @@
 //   * push_front
 //   * push_back
 //   * insert
+//
+// sort 是自底向上的归并排序：节点逐个并入 64 个桶，第 i 个桶存放 2^i 个已排序的节点，
+// 排序过程不申请内存，也不再逐层用 advance 寻找中点；合并时顺带维护 prev 指针，排序后不必再遍历一遍
+// indirect_sort 把节点指针复制到临时缓冲区，在连续的指针数组上归并排序后重新连接节点，
+// 需要 2 * size() 个指针的临时空间，申请不到时退回 sort；两者都是稳定排序
 
 #include <initializer_list>
 
@@ -52,6 +57,20 @@ struct list_node_base {
     void unlink() { prev = next = self(); }
 
     base_ptr self() { return static_cast<base_ptr>(&*this); }
+
+    // 把已经串好的 [first, last] 结点连接到 pos 之前
+    static void link_before(base_ptr pos, base_ptr first, base_ptr last) noexcept {
+        pos->prev->next = first;
+        first->prev = pos->prev;
+        pos->prev = last;
+        last->next = pos;
+    }
+
+    // 把 [first, last] 结点从所在的链表上断开，结点自身的指针保持不变
+    static void unlink_range(base_ptr first, base_ptr last) noexcept {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+    }
 };
 
 template <class T>
@@ -85,7 +104,8 @@ struct list_iterator : public MySTL::iterator<MySTL::bidirectional_iterator_tag,
     list_iterator() = default;
     list_iterator(base_ptr x) : node_(x) {}
     list_iterator(node_ptr x) : node_(x->as_base()) {}
-    list_iterator(const list_iterator& rhs) : node_(rhs.node_) {}
+    list_iterator(const list_iterator&) = default;
+    list_iterator& operator=(const list_iterator&) = default;
 
     // 重载操作符
     reference operator*() const { return node_->as_node()->value; }
@@ -171,23 +191,25 @@ struct list_const_iterator : public iterator<bidirectional_iterator_tag, T> {
 };
 
 // 模板类: list
-// 模板参数 T 代表数据类型
-template <class T>
-class list {
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型，节点与哨兵的分配器由它 rebind 得到
+template <class T, class Alloc = typename default_node_allocator<T>::type>
+class list : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<list_node<T>>> {
    public:
     // list嵌套类型定义
-    typedef MySTL::allocator<T> allocator_type;
-    typedef MySTL::allocator<T> data_allocator;
-    typedef MySTL::allocator<list_node_base<T>> base_allocator;
-    typedef MySTL::allocator<list_node<T>> node_allocator;
-
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<list_node_base<T>> base_allocator;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<list_node<T>> node_allocator;
+    typedef MySTL::allocator_traits<base_allocator> base_alloc_traits;
+    typedef MySTL::allocator_traits<node_allocator> node_alloc_traits;
+    typedef MySTL::alloc_holder<node_allocator> holder_type;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
 
     typedef list_iterator<T> iterator;
     typedef list_const_iterator<T> const_iterator;
@@ -197,7 +219,7 @@ class list {
     typedef typename node_traits<T>::base_ptr base_ptr;
     typedef typename node_traits<T>::node_ptr node_ptr;
 
-    allocator_type get_allocator() { return node_allocator(); }
+    allocator_type get_allocator() const { return allocator_type(this->get_alloc()); }
 
    private:
     base_ptr node_;   // 指向末尾节点
@@ -206,44 +228,63 @@ class list {
    public:
     // 构造、复制、移动、析构函数
     list() { fill_init(0, value_type()); }
-    explicit list(size_type n) { fill_init(n, value_type()); }
-    list(size_type n, const value_type& value) { fill_init(n, value); }
+    explicit list(const allocator_type& alloc) : holder_type(node_allocator(alloc)) { fill_init(0, value_type()); }
+    explicit list(size_type n, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) { fill_init(n, value_type()); }
+    list(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) { fill_init(n, value); }
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    list(Iter first, Iter last) { copy_init(first, last); }
-    list(std::initializer_list<T> ilist) { copy_init(ilist.begin(), ilist.end()); }
-    list(const list& rhs) { copy_init(rhs.begin(), rhs.end()); }
-    list(list&& rhs) noexcept : node_(rhs.node_), size_(rhs.size_) {
+    list(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) { copy_init(first, last); }
+    list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)) { copy_init(ilist.begin(), ilist.end()); }
+    list(const list& rhs)
+        : holder_type(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) { copy_init(rhs.begin(), rhs.end()); }
+    list(const list& rhs, const allocator_type& alloc)
+        : holder_type(node_allocator(alloc)) { copy_init(rhs.begin(), rhs.end()); }
+    list(list&& rhs) noexcept : holder_type(MySTL::move(rhs.get_alloc())), node_(rhs.node_), size_(rhs.size_) {
         rhs.node_ = nullptr;
         rhs.size_ = 0;
     }
 
     list& operator=(const list& rhs) {
         if (this != &rhs) {
+            if (node_alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+                // 原有的节点必须由原来的分配器释放
+                tidy();
+                MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+                fill_init(0, value_type());
+            }
             assign(rhs.begin(), rhs.end());
         }
         return *this;
     }
 
-    list& operator=(list&& rhs) noexcept {
+    list& operator=(list&& rhs) noexcept(node_alloc_traits::is_always_equal::value) {
+        if (node_alloc_traits::propagate_on_container_move_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            tidy();
+            MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+            fill_init(0, value_type());
+        }
         clear();
-        splice(end(), rhs);
+        if (this->get_alloc() == rhs.get_alloc()) {
+            splice(end(), rhs);
+        } else {
+            // 分配器不相等，不能直接接管对方的节点
+            for (auto& value : rhs)
+                emplace_back(MySTL::move(value));
+            rhs.clear();
+        }
         return *this;
     }
 
     list& operator=(std::initializer_list<T> ilist) {
-        list tmp(ilist.begin(), ilist.end());
+        list tmp(ilist.begin(), ilist.end(), get_allocator());
         swap(tmp);
         return *this;
     }
 
-    ~list() {
-        if (node_) {
-            clear();
-            base_allocator::deallocate(node_);
-            node_ = nullptr;
-            size_ = 0;
-        }
-    }
+    ~list() { tidy(); }
 
    public:
     // 迭代器相关操作
@@ -396,6 +437,7 @@ class list {
     void resize(size_type new_size, const value_type& value);
 
     void swap(list& rhs) noexcept {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
         MySTL::swap(node_, rhs.node_);
         MySTL::swap(size_, rhs.size_);
     }
@@ -419,9 +461,13 @@ class list {
     template <class Compare>
     void merge(list& x, Compare comp);
 
-    void sort() { list_sort(begin(), end(), size(), MySTL::less<T>()); }
+    void sort() { list_sort(MySTL::less<T>()); }
     template <class Compared>
-    void sort(Compared comp) { list_sort(begin(), end(), size(), comp); }
+    void sort(Compared comp) { list_sort(comp); }
+
+    void indirect_sort() { pointer_sort(MySTL::less<T>()); }
+    template <class Compared>
+    void indirect_sort(Compared comp) { pointer_sort(comp); }
 
     void reverse();
 
@@ -432,6 +478,7 @@ class list {
     template <class... Args>
     node_ptr create_node(Args&&... agrs);
     void destroy_node(node_ptr p);
+    void tidy();
 
     // initialize
     void fill_init(size_type n, const value_type& value);
@@ -456,16 +503,25 @@ class list {
     iterator copy_insert(const_iterator pos, size_type n, Iter first);
 
     // sort
+    struct node_chain {
+        base_ptr first;  // 第一个节点，链以 nullptr 结尾
+        base_ptr last;   // 最后一个节点
+    };
+    void relink_chain(base_ptr first) noexcept;
+    template <class Compared>
+    static void merge_chains(node_chain& a, node_chain b, Compared& comp);
     template <class Compared>
-    iterator list_sort(iterator first, iterator last, size_type n, Compared comp);
+    void list_sort(Compared comp);
+    template <class Compared>
+    void pointer_sort(Compared comp);
 };
 
 /*****************************************************************************************/
 
 // 删除 pos 处的元素
-template <class T>
-typename list<T>::iterator
-list<T>::erase(const_iterator pos) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::erase(const_iterator pos) {
     MYSTL_DEBUG(pos != cend());
     auto n = pos.node_;
     auto next = n->next;
@@ -476,9 +532,9 @@ list<T>::erase(const_iterator pos) {
 }
 
 // 删除 [first, last) 内的元素
-template <class T>
-typename list<T>::iterator
-list<T>::erase(const_iterator first, const_iterator last) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::erase(const_iterator first, const_iterator last) {
     if (first != last) {
         unlink_nodes(first.node_, last.node_->prev);
         while (first != last) {
@@ -492,8 +548,8 @@ list<T>::erase(const_iterator first, const_iterator last) {
 }
 
 // 清空 list
-template <class T>
-void list<T>::clear() {
+template <class T, class Alloc>
+void list<T, Alloc>::clear() {
     if (size_ != 0) {
         auto cur = node_->next;
         for (base_ptr next = cur->next; cur != node_; cur = next, next = cur->next) {
@@ -505,8 +561,8 @@ void list<T>::clear() {
 }
 
 // 重置容器大小
-template <class T>
-void list<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size, const value_type& value) {
     auto i = begin();
     size_type len = 0;
     while (i != end() && len < new_size) {
@@ -521,8 +577,8 @@ void list<T>::resize(size_type new_size, const value_type& value) {
 }
 
 // 将 list x 接合于 pos 之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x) {
     MYSTL_DEBUG(this != &x);
     if (!x.empty()) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "list<T>'s size too big");
@@ -539,8 +595,8 @@ void list<T>::splice(const_iterator pos, list& x) {
 }
 
 // 将 it 所指的节点接合于 pos 之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator it) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator it) {
     if (pos.node_ != it.node_ && pos.node_ != it.node_->next) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
 
@@ -555,8 +611,8 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator it) {
 }
 
 // 将 list x 的 [first, last) 内的节点接合于 pos 之前
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator first, const_iterator last) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator first, const_iterator last) {
     if (first != last && this != &x) {
         size_type n = MySTL::distance(first, last);
         THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
@@ -572,9 +628,9 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator first, const_it
 }
 
 // 将另一元操作 pred 为 true 的所有元素移除
-template <class T>
+template <class T, class Alloc>
 template <class UnaryPredicate>
-void list<T>::remove_if(UnaryPredicate pred) {
+void list<T, Alloc>::remove_if(UnaryPredicate pred) {
     auto f = begin();
     auto l = end();
     for (auto next = f; f != l; f = next) {
@@ -586,9 +642,9 @@ void list<T>::remove_if(UnaryPredicate pred) {
 }
 
 // 移除 list 中满足 pred 为 true 重复元素
-template <class T>
+template <class T, class Alloc>
 template <class BinaryPredicate>
-void list<T>::unique(BinaryPredicate pred) {
+void list<T, Alloc>::unique(BinaryPredicate pred) {
     auto i = begin();
     auto e = end();
     auto j = i;
@@ -605,9 +661,9 @@ void list<T>::unique(BinaryPredicate pred) {
 }
 
 // 与另一个 list 合并，按照 comp 为 true 的顺序
-template <class T>
+template <class T, class Alloc>
 template <class Compare>
-void list<T>::merge(list& x, Compare comp) {
+void list<T, Alloc>::merge(list& x, Compare comp) {
     if (this != &x) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "list<T>'s size too big");
 
@@ -648,8 +704,8 @@ void list<T>::merge(list& x, Compare comp) {
 }
 
 // 将 list 反转
-template <class T>
-void list<T>::reverse() {
+template <class T, class Alloc>
+void list<T, Alloc>::reverse() {
     if (size_ <= 1) {
         return;
     }
@@ -666,33 +722,46 @@ void list<T>::reverse() {
 // helper function
 
 // 创建结点
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename list<T>::node_ptr
-list<T>::create_node(Args&&... args) {
-    node_ptr p = node_allocator::allocate(1);
+typename list<T, Alloc>::node_ptr
+list<T, Alloc>::create_node(Args&&... args) {
+    node_ptr p = node_alloc_traits::allocate(this->get_alloc(), 1);
     try {
-        data_allocator::construct(MySTL::address_of(p->value), MySTL::forward<Args>(args)...);
+        node_alloc_traits::construct(this->get_alloc(), MySTL::address_of(p->value), MySTL::forward<Args>(args)...);
         p->prev = nullptr;
         p->next = nullptr;
     } catch (...) {
-        node_allocator::deallocate(p);
+        node_alloc_traits::deallocate(this->get_alloc(), p, 1);
         throw;
     }
     return p;
 }
 
 // 销毁结点
-template <class T>
-void list<T>::destroy_node(node_ptr p) {
-    data_allocator::destroy(MySTL::address_of(p->value));
-    node_allocator::deallocate(p);
+template <class T, class Alloc>
+void list<T, Alloc>::destroy_node(node_ptr p) {
+    node_alloc_traits::destroy(this->get_alloc(), MySTL::address_of(p->value));
+    node_alloc_traits::deallocate(this->get_alloc(), p, 1);
+}
+
+// 销毁所有节点并释放哨兵节点
+template <class T, class Alloc>
+void list<T, Alloc>::tidy() {
+    if (node_) {
+        clear();
+        base_allocator base_alloc(this->get_alloc());
+        base_alloc_traits::deallocate(base_alloc, node_, 1);
+        node_ = nullptr;
+        size_ = 0;
+    }
 }
 
 // 用 n 个元素初始化容器
-template <class T>
-void list<T>::fill_init(size_type n, const value_type& value) {
-    node_ = base_allocator::allocate(1);
+template <class T, class Alloc>
+void list<T, Alloc>::fill_init(size_type n, const value_type& value) {
+    base_allocator base_alloc(this->get_alloc());
+    node_ = base_alloc_traits::allocate(base_alloc, 1);
     node_->unlink();
     size_ = n;
     try {
@@ -702,17 +771,18 @@ void list<T>::fill_init(size_type n, const value_type& value) {
         }
     } catch (...) {
         clear();
-        base_allocator::deallocate(node_);
+        base_alloc_traits::deallocate(base_alloc, node_, 1);
         node_ = nullptr;
         throw;
     }
 }
 
 // 以 [first, last) 初始化容器
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_init(Iter first, Iter last) {
-    node_ = base_allocator::allocate(1);
+void list<T, Alloc>::copy_init(Iter first, Iter last) {
+    base_allocator base_alloc(this->get_alloc());
+    node_ = base_alloc_traits::allocate(base_alloc, 1);
     node_->unlink();
     size_type n = MySTL::distance(first, last);
     size_ = n;
@@ -723,16 +793,16 @@ void list<T>::copy_init(Iter first, Iter last) {
         }
     } catch (...) {
         clear();
-        base_allocator::deallocate(node_);
+        base_alloc_traits::deallocate(base_alloc, node_, 1);
         node_ = nullptr;
         throw;
     }
 }
 
 // 在 pos 处连接一个节点
-template <class T>
-typename list<T>::iterator
-list<T>::link_iter_node(const_iterator pos, base_ptr link_node) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::link_iter_node(const_iterator pos, base_ptr link_node) {
     if (pos == node_->next) {
         link_nodes_at_front(link_node, link_node);
     } else if (pos == node_) {
@@ -744,42 +814,32 @@ list<T>::link_iter_node(const_iterator pos, base_ptr link_node) {
 }
 
 // 在 pos 处连接 [first, last] 的结点
-template <class T>
-void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
-    pos->prev->next = first;
-    first->prev = pos->prev;
-    pos->prev = last;
-    last->next = pos;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
+    list_node_base<T>::link_before(pos, first, last);
 }
 
 // 在头部连接 [first, last] 结点
-template <class T>
-void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
-    first->prev = node_;
-    last->next = node_->next;
-    last->next->prev = last;
-    node_->next = first;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_front(base_ptr first, base_ptr last) {
+    list_node_base<T>::link_before(node_->next, first, last);
 }
 
 // 在尾部连接 [first, last] 结点
-template <class T>
-void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
-    last->next = node_;
-    first->prev = node_->prev;
-    first->prev->next = first;
-    node_->prev = last;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_back(base_ptr first, base_ptr last) {
+    list_node_base<T>::link_before(node_, first, last);
 }
 
 // 容器与 [first, last] 结点断开连接
-template <class T>
-void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
-    first->prev->next = last->next;
-    last->next->prev = first->prev;
+template <class T, class Alloc>
+void list<T, Alloc>::unlink_nodes(base_ptr first, base_ptr last) {
+    list_node_base<T>::unlink_range(first, last);
 }
 
 // 用 n 个元素为容器赋值
-template <class T>
-void list<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc>
+void list<T, Alloc>::fill_assign(size_type n, const value_type& value) {
     auto i = begin();
     auto e = end();
     for (; n > 0 && i != e; --n, ++i) {
@@ -793,9 +853,9 @@ void list<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 // 复制[f2, l2)为容器赋值
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_assign(Iter f2, Iter l2) {
+void list<T, Alloc>::copy_assign(Iter f2, Iter l2) {
     auto f1 = begin();
     auto l1 = end();
     for (; f1 != l1 && f2 != l2; ++f1, ++f2) {
@@ -809,9 +869,9 @@ void list<T>::copy_assign(Iter f2, Iter l2) {
 }
 
 // 在 pos 处插入 n 个元素
-template <class T>
-typename list<T>::iterator
-list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator
+list<T, Alloc>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
     iterator r(pos.node_);
     if (n != 0) {
         const auto add_size = n;
@@ -844,10 +904,10 @@ list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
 }
 
 // 在 pos 处插入 [first, last) 的元素
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-typename list<T>::iterator
-list<T>::copy_insert(const_iterator pos, size_type n, Iter first) {
+typename list<T, Alloc>::iterator
+list<T, Alloc>::copy_insert(const_iterator pos, size_type n, Iter first) {
     iterator r(pos.node_);
     if (n != 0) {
         const auto add_size = n;
@@ -878,74 +938,192 @@ list<T>::copy_insert(const_iterator pos, size_type n, Iter first) {
     return r;
 }
 
-// 对 list 进行归并排序，返回一个迭代器指向区间最小元素的位置
-template <class T>
+// relink_chain 函数
+// 以 first 开头、以 nullptr 结尾的单链就是全部节点，按 next 的顺序重新接到 node_ 上并补回 prev 指针
+template <class T, class Alloc>
+void list<T, Alloc>::relink_chain(base_ptr first) noexcept {
+    base_ptr prev = node_;
+    for (base_ptr cur = first; cur != nullptr; cur = cur->next) {
+        cur->prev = prev;
+        prev->next = cur;
+        prev = cur;
+    }
+    prev->next = node_;
+    node_->prev = prev;
+}
+
+// merge_chains 函数
+// 把两条以 nullptr 结尾的有序链 a、b 合并后放回 a，相等的元素中 a 的在前，排序因此是稳定的
+// 被取出的节点已在缓存中，顺带写好它的 prev，剩余的一段只需改动第一个节点，合并结果的 prev 除第一个节点外都有效
+// comp 抛出异常时，已合并的部分与 a、b 剩余的节点接成一条放回 a.first，节点不会丢失
+template <class T, class Alloc>
 template <class Compared>
-typename list<T>::iterator
-list<T>::list_sort(iterator f1, iterator l2, size_type n, Compared comp) {
-    if (n < 2)
-        return f1;
-
-    if (n == 2) {
-        if (comp(*--l2, *f1)) {
-            auto ln = l2.node_;
-            unlink_nodes(ln, ln);
-            link_nodes(f1.node_, ln, ln);
-            return l2;
+void list<T, Alloc>::merge_chains(node_chain& a, node_chain b, Compared& comp) {
+    if (b.first == nullptr)
+        return;
+    list_node_base<T> head;
+    base_ptr tail = &head;
+    base_ptr x = a.first;
+    base_ptr y = b.first;
+    try {
+        while (x != nullptr && y != nullptr) {
+            if (comp(y->as_node()->value, x->as_node()->value)) {
+                tail->next = y;
+                y->prev = tail;
+                tail = y;
+                y = y->next;
+            } else {
+                tail->next = x;
+                x->prev = tail;
+                tail = x;
+                x = x->next;
+            }
         }
-        return f1;
-    }
-
-    auto n2 = n / 2;
-    auto l1 = f1;
-    MySTL::advance(l1, n2);
-    auto result = f1 = list_sort(f1, l1, n2, comp);  // 前半段的最小位置
-    auto f2 = l1 = list_sort(l1, l2, n - n2, comp);  // 后半段的最小位置
-
-    // 把较小的一段区间移到前面
-    if (comp(*f2, *f1)) {
-        auto m = f2;
-        ++m;
-        for (; m != l2 && comp(*m, *f1); ++m);
-        auto f = f2.node_;
-        auto l = m.node_->prev;
-        result = f2;
-        l1 = f2 = m;
-        unlink_nodes(f, l);
-        m = f1;
-        ++m;
-        link_nodes(f1.node_, f, l);
-        f1 = m;
+    } catch (...) {
+        tail->next = x;
+        while (tail->next != nullptr)
+            tail = tail->next;
+        tail->next = y;
+        a.first = head.next;
+        throw;
+    }
+    if (x != nullptr) {
+        tail->next = x;
+        x->prev = tail;
     } else {
-        ++f1;
+        tail->next = y;
+        y->prev = tail;
+        a.last = b.last;
     }
+    a.first = head.next;
+}
 
-    // 合并两段有序区间
-    while (f1 != l1 && f2 != l2) {
-        if (comp(*f2, *f1)) {
-            auto m = f2;
-            ++m;
-            for (; m != l2 && comp(*m, *f1); ++m);
-            auto f = f2.node_;
-            auto l = m.node_->prev;
-            if (l1 == f2)
-                l1 = m;
-            f2 = m;
-            unlink_nodes(f, l);
-            m = f1;
-            ++m;
-            link_nodes(f1.node_, f, l);
-            f1 = m;
-        } else {
-            ++f1;
+// 对 list 进行自底向上的归并排序
+template <class T, class Alloc>
+template <class Compared>
+void list<T, Alloc>::list_sort(Compared comp) {
+    if (size_ < 2)
+        return;
+    // 断开成以 nullptr 结尾的单链
+    base_ptr rest = node_->next;
+    node_->prev->next = nullptr;
+    node_chain bins[64] = {};  // 64 个桶足以容纳 2^64 - 1 个节点
+    node_chain carry = {nullptr, nullptr};
+    try {
+        while (rest != nullptr) {
+            carry.first = carry.last = rest;
+            rest = rest->next;
+            carry.first->next = nullptr;
+            // 桶中的节点比 carry 更早出现，放在 merge_chains 的第一个参数
+            size_t i = 0;
+            for (; bins[i].first != nullptr; ++i) {
+                node_chain later = carry;
+                carry.first = nullptr;
+                merge_chains(bins[i], later, comp);
+                carry = bins[i];
+                bins[i].first = nullptr;
+            }
+            bins[i] = carry;
+            carry.first = nullptr;
+        }
+        node_chain result = {nullptr, nullptr};
+        for (size_t i = 0; i < 64; ++i) {
+            if (bins[i].first != nullptr) {
+                merge_chains(bins[i], result, comp);
+                result = bins[i];
+                bins[i].first = nullptr;
+            }
         }
+        node_->next = result.first;
+        result.first->prev = node_;
+        result.last->next = node_;
+        node_->prev = result.last;
+    } catch (...) {
+        // 把散落在各个桶与 carry、rest 中的节点接回 list，元素不变，顺序不定
+        base_ptr all = rest;
+        auto gather = [&all](base_ptr chain) {
+            if (chain == nullptr)
+                return;
+            base_ptr tail = chain;
+            while (tail->next != nullptr)
+                tail = tail->next;
+            tail->next = all;
+            all = chain;
+        };
+        gather(carry.first);
+        for (size_t i = 0; i < 64; ++i)
+            gather(bins[i].first);
+        relink_chain(all);
+        throw;
     }
-    return result;
+}
+
+// 把节点指针复制到临时缓冲区，在指针数组上做自底向上的稳定归并排序，再按新的顺序连接节点
+// 节点在 comp 抛出异常时还没有改动，list 保持原样
+template <class T, class Alloc>
+template <class Compared>
+void list<T, Alloc>::pointer_sort(Compared comp) {
+    if (size_ < 2)
+        return;
+    const ptrdiff_t n = static_cast<ptrdiff_t>(size_);
+    auto buf = MySTL::get_temporary_buffer<base_ptr>(n * 2);
+    if (buf.second < n * 2) {
+        if (buf.first != nullptr)
+            MySTL::release_temporary_buffer(buf.first);
+        list_sort(comp);
+        return;
+    }
+    base_ptr* from = buf.first;
+    base_ptr* to = buf.first + n;
+    base_ptr cur = node_->next;
+    for (ptrdiff_t i = 0; i < n; ++i, cur = cur->next)
+        from[i] = cur;
+    auto less = [&comp](base_ptr x, base_ptr y) { return comp(x->as_node()->value, y->as_node()->value); };
+    try {
+        // 先把每 16 个指针做插入排序，再逐轮两两归并
+        const ptrdiff_t run = 16;
+        for (ptrdiff_t f = 0; f < n; f += run) {
+            const ptrdiff_t l = MySTL::min(f + run, n);
+            for (ptrdiff_t i = f + 1; i < l; ++i) {
+                base_ptr x = from[i];
+                ptrdiff_t j = i;
+                for (; j > f && less(x, from[j - 1]); --j)
+                    from[j] = from[j - 1];
+                from[j] = x;
+            }
+        }
+        for (ptrdiff_t width = run; width < n; width *= 2) {
+            for (ptrdiff_t f = 0; f < n; f += width * 2) {
+                const ptrdiff_t m = MySTL::min(f + width, n);
+                const ptrdiff_t l = MySTL::min(f + width * 2, n);
+                ptrdiff_t i = f, j = m, k = f;
+                while (i < m && j < l)
+                    to[k++] = less(from[j], from[i]) ? from[j++] : from[i++];
+                while (i < m)
+                    to[k++] = from[i++];
+                while (j < l)
+                    to[k++] = from[j++];
+            }
+            MySTL::swap(from, to);
+        }
+    } catch (...) {
+        MySTL::release_temporary_buffer(buf.first);
+        throw;
+    }
+    base_ptr prev = node_;
+    for (ptrdiff_t i = 0; i < n; ++i) {
+        prev->next = from[i];
+        from[i]->prev = prev;
+        prev = from[i];
+    }
+    prev->next = node_;
+    node_->prev = prev;
+    MySTL::release_temporary_buffer(buf.first);
 }
 
 // 重载比较操作符
-template <class T>
-bool operator==(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     auto f1 = lhs.cbegin();
     auto f2 = rhs.cbegin();
     auto l1 = lhs.cend();
@@ -954,35 +1132,47 @@ bool operator==(const list<T>& lhs, const list<T>& rhs) {
     return f1 == l1 && f2 == l2;
 }
 
-template <class T>
-bool operator<(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return MySTL::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
 }
 
-template <class T>
-bool operator!=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class T>
-void swap(list<T>& lhs, list<T>& rhs) noexcept {
+template <class T, class Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
+// list 的哨兵节点分配在堆上，list 对象本身只保存指针与大小
+template <class T, class Alloc>
+struct is_trivially_relocatable<list<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class T>
+using list = MySTL::list<T, MySTL::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
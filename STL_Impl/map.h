@@ -18,8 +18,8 @@
 namespace MySTL {
 
 // 模板类 map，键值不允许重复
-// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less
-template <class Key, class T, class Compare = MySTL::less<Key>>
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less，参数四代表分配器类型
+template <class Key, class T, class Compare = MySTL::less<Key>, class Alloc = typename default_node_allocator<MySTL::pair<const Key, T>>::type>
 class map {
    public:
     // map的嵌套类型定义
@@ -30,7 +30,7 @@ class map {
 
     // 定义一个 functor，用来进行元素比较
     class value_compare : public binary_function<value_type, value_type, bool> {
-        friend class map<Key, T, Compare>;
+        friend class map<Key, T, Compare, Alloc>;
 
        private:
         Compare comp;
@@ -44,7 +44,7 @@ class map {
 
    private:
     // 以 MySTL::rb_tree 作为底层机制
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -65,10 +65,15 @@ class map {
    public:
     // 构造、复制、移动、赋值函数
     map() = default;
+    explicit map(const key_compare& comp, const allocator_type& alloc = allocator_type()) : tree_(comp, alloc) {}
+    explicit map(const allocator_type& alloc) : tree_(alloc) {}
     template <class InputIter>
-    map(InputIter first, InputIter last) : tree_() { tree_.insert_unique(first, last); }
-    map(std::initializer_list<value_type> ilist) : tree_() { tree_.insert_unique(ilist.begin(), ilist.end()); }
+    map(InputIter first, InputIter last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(first, last); }
+    map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(ilist.begin(), ilist.end()); }
     map(const map& rhs) : tree_(rhs.tree_) {}
+    map(const map& rhs, const allocator_type& alloc) : tree_(rhs.tree_, alloc) {}
     map(map&& rhs) noexcept : tree_(MySTL::move(rhs.tree_)) {}
 
     map& operator=(const map& rhs) {
@@ -192,46 +197,46 @@ class map {
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class Key, class T, class Compare>
-void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, class Alloc>
+void swap(map<Key, T, Compare, Alloc>& lhs, map<Key, T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 /*****************************************************************************************/
 // 模板类 multimap，键值允许重复
-// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less
-template <class Key, class T, class Compare = MySTL::less<Key>>
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 MySTL::less，参数四代表分配器类型
+template <class Key, class T, class Compare = MySTL::less<Key>, class Alloc = typename default_node_allocator<MySTL::pair<const Key, T>>::type>
 class multimap {
    public:
     // multimap 的型别定义
@@ -242,7 +247,7 @@ class multimap {
 
     // 定义一个 functor，用来进行元素比较
     class value_compare : public binary_function<value_type, value_type, bool> {
-        friend class multimap<Key, T, Compare>;
+        friend class multimap<Key, T, Compare, Alloc>;
 
        private:
         Compare comp;
@@ -256,7 +261,7 @@ class multimap {
 
    private:
     // 用 MySTL::rb_tree 作为底层机制
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -278,16 +283,23 @@ class multimap {
     // 构造、复制、移动函数
 
     multimap() = default;
+    explicit multimap(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit multimap(const allocator_type& alloc)
+        : tree_(alloc) {}
 
     template <class InputIterator>
-    multimap(InputIterator first, InputIterator last)
-        : tree_() { tree_.insert_multi(first, last); }
-    multimap(std::initializer_list<value_type> ilist)
-        : tree_() { tree_.insert_multi(ilist.begin(), ilist.end()); }
+    multimap(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(first, last); }
+    multimap(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(ilist.begin(), ilist.end()); }
 
     multimap(const multimap& rhs)
         : tree_(rhs.tree_) {
     }
+    multimap(const multimap& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {
+    }
     multimap(multimap&& rhs) noexcept
         : tree_(MySTL::move(rhs.tree_)) {
     }
@@ -399,41 +411,61 @@ class multimap {
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class Key, class T, class Compare>
-void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, class Alloc>
+void swap(multimap<Key, T, Compare, Alloc>& lhs, multimap<Key, T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// map / multimap 只包含一棵 rb_tree
+template <class Key, class T, class Compare, class Alloc>
+struct is_trivially_relocatable<map<Key, T, Compare, Alloc>>
+    : is_trivially_relocatable<rb_tree<MySTL::pair<const Key, T>, Compare, Alloc>> {};
+
+template <class Key, class T, class Compare, class Alloc>
+struct is_trivially_relocatable<multimap<Key, T, Compare, Alloc>>
+    : is_trivially_relocatable<rb_tree<MySTL::pair<const Key, T>, Compare, Alloc>> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class Key, class T, class Compare = MySTL::less<Key>>
+using map = MySTL::map<Key, T, Compare, MySTL::polymorphic_allocator<MySTL::pair<const Key, T>>>;
+
+template <class Key, class T, class Compare = MySTL::less<Key>>
+using multimap = MySTL::multimap<Key, T, Compare, MySTL::polymorphic_allocator<MySTL::pair<const Key, T>>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
@@ -2,7 +2,7 @@
 #define _MYSTL_MEMORY_H_
 
 // 这个头文件负责更高级的动态内存管理
-// 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr
+// 包含一些基本函数、空间配置器、未初始化的储存空间管理，一个模板类 auto_ptr，以及 smart_ptr.h 中的智能指针
 
 #include <climits>
 #include <cstddef>
@@ -11,6 +11,9 @@
 #include "algobase.h"
 #include "allocator.h"
 #include "construct.h"
+#include "memory_resource.h"
+#include "pool_allocator.h"
+#include "smart_ptr.h"
 #include "uninitialized.h"
 
 namespace MySTL {
@@ -27,7 +30,7 @@ pair<T*, ptrdiff_t> get_buffer_helper(ptrdiff_t len, T*) {
     if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
         len = INT_MAX / sizeof(T);
     while (len > 0) {
-        T* tmp = static_cast<T*>(malloc(static_cast<size_t>(len) * sizeof(T)));
+        T* tmp = static_cast<T*>(aligned_malloc(static_cast<size_t>(len) * sizeof(T), alignof(T)));
         if (tmp)
             return MySTL::pair<T*, ptrdiff_t>(tmp, len);
         len /= 2;  // 申请失败时减少 len 的大小
@@ -47,7 +50,7 @@ pair<T*, ptrdiff_t> get_temporary_buffer(ptrdiff_t len, T*) {
 
 template <class T>
 void release_temporary_buffer(T* ptr) {
-    free(ptr);
+    aligned_free(ptr, alignof(T));
 }
 
 // --------------------------------------------------------------------------------------
@@ -64,7 +67,7 @@ class temporary_buffer {
     temporary_buffer(ForwardIterator first, ForwardIterator last);
     ~temporary_buffer() {
         MySTL::destroy(buffer, buffer + len);
-        free(buffer);
+        aligned_free(buffer, alignof(T));
     }
 
    public:
@@ -88,14 +91,15 @@ class temporary_buffer {
 
 // 构造函数
 template <class ForwardIterator, class T>
-temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last) {
+temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last)
+    : original_len(0), len(0), buffer(nullptr) {
     try {
         len = MySTL::distance(first, last);
         allocate_buffer();
         if (len > 0)
             initializer_buffer(*first, std::is_trivially_default_constructible<T>());
     } catch (...) {
-        free(buffer);
+        aligned_free(buffer, alignof(T));
         buffer = nullptr;
         len = 0;
     }
@@ -108,7 +112,7 @@ void temporary_buffer<ForwardIterator, T>::allocate_buffer() {
     if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
         len = INT_MAX / sizeof(T);
     while (len > 0) {
-        buffer = static_cast<T*>(malloc(len * sizeof(T)));
+        buffer = static_cast<T*>(aligned_malloc(len * sizeof(T), alignof(T)));
         if (buffer) break;
         len /= 2;
     }
@@ -0,0 +1,505 @@
+#ifndef _MYSTL_MEMORY_RESOURCE_H_
+#define _MYSTL_MEMORY_RESOURCE_H_
+
+// 这个头文件包含多态内存资源 memory_resource 及其派生类，以及模板类 polymorphic_allocator
+// memory_resource                : 抽象基类，容器通过它的虚函数申请和释放内存
+// monotonic_buffer_resource     : 单调缓冲区，只移动指针分配，释放操作为空，release 时一次性归还
+// unsynchronized_pool_resource  : 按尺寸分级的内存池，不加锁，适合单线程使用
+// polymorphic_allocator         : 把 memory_resource 包装成容器可以使用的分配器
+
+// notes:
+//
+// 不同的 memory_resource 可以在运行期替换，而容器的类型保持不变，pmr 命名空间下的别名都使用 polymorphic_allocator
+// 资源的生命期必须长于使用它的容器，资源本身不可复制
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace MySTL {
+
+// monotonic_buffer_resource 没有给定初始大小时，第一次向上游申请的字节数
+#ifndef MONOTONIC_BUFFER_INIT_SIZE
+#define MONOTONIC_BUFFER_INIT_SIZE 1024
+#endif
+
+// unsynchronized_pool_resource 缺省的最大块大小与每个 chunk 的最大块数
+#ifndef POOL_RESOURCE_MAX_BLOCK
+#define POOL_RESOURCE_MAX_BLOCK 4096
+#endif
+
+#ifndef POOL_RESOURCE_MAX_BLOCKS_PER_CHUNK
+#define POOL_RESOURCE_MAX_BLOCKS_PER_CHUNK 1024
+#endif
+
+/*****************************************************************************************/
+// memory_resource
+// 公有接口转发到私有的虚函数，派生类只需要实现 do_allocate、do_deallocate、do_is_equal
+/*****************************************************************************************/
+class memory_resource {
+   public:
+    enum : size_t { max_align = alignof(std::max_align_t) };
+
+    virtual ~memory_resource() {}
+
+    void* allocate(size_t bytes, size_t align = max_align) { return do_allocate(bytes, align); }
+
+    void deallocate(void* p, size_t bytes, size_t align = max_align) { do_deallocate(p, bytes, align); }
+
+    bool is_equal(const memory_resource& other) const noexcept { return do_is_equal(other); }
+
+   private:
+    virtual void* do_allocate(size_t bytes, size_t align) = 0;
+    virtual void do_deallocate(void* p, size_t bytes, size_t align) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept {
+    return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+namespace resource_detail {
+
+// 把 n 向上取整到 align 的倍数，align 为 2 的幂
+constexpr size_t round_up(size_t n, size_t align) noexcept { return (n + align - 1) & ~(align - 1); }
+
+inline char* align_up(char* p, size_t align) noexcept {
+    return reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(p), align));
+}
+
+// 每个资源只需要一个实例，用函数内的静态对象保存
+class new_delete_resource_impl : public memory_resource {
+   private:
+    void* do_allocate(size_t bytes, size_t align) override { return aligned_allocate(bytes, align); }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override { aligned_deallocate(p, bytes, align); }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+class null_resource_impl : public memory_resource {
+   private:
+    void* do_allocate(size_t, size_t) override { throw std::bad_alloc(); }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+}  // namespace resource_detail
+
+// 使用 ::operator new / ::operator delete 的全局资源
+inline memory_resource* new_delete_resource() noexcept {
+    static resource_detail::new_delete_resource_impl resource;
+    return &resource;
+}
+
+// 任何分配请求都抛出 std::bad_alloc，可以作为上游资源，保证容器不越出给定的缓冲区
+inline memory_resource* null_memory_resource() noexcept {
+    static resource_detail::null_resource_impl resource;
+    return &resource;
+}
+
+namespace resource_detail {
+
+inline std::atomic<memory_resource*>& default_resource() noexcept {
+    static std::atomic<memory_resource*> resource(new_delete_resource());
+    return resource;
+}
+
+}  // namespace resource_detail
+
+// 缺省构造的 polymorphic_allocator 使用的资源，初始为 new_delete_resource()
+inline memory_resource* get_default_resource() noexcept {
+    return resource_detail::default_resource().load(std::memory_order_acquire);
+}
+
+// 设置缺省资源并返回原来的资源，传入空指针时恢复为 new_delete_resource()
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+    if (r == nullptr) r = new_delete_resource();
+    return resource_detail::default_resource().exchange(r, std::memory_order_acq_rel);
+}
+
+/*****************************************************************************************/
+// monotonic_buffer_resource
+// 在当前缓冲区中移动指针分配，空间不够时向上游申请一块更大的 chunk，大小按倍数增长
+// deallocate 什么也不做，所有内存在 release 或析构时一次性归还给上游
+/*****************************************************************************************/
+class monotonic_buffer_resource : public memory_resource {
+   private:
+    // 每块 chunk 的头部，把 chunk 串起来以便 release 时归还
+    struct chunk_header {
+        chunk_header* next;
+        size_t size;
+    };
+
+    enum { header_size = resource_detail::round_up(sizeof(chunk_header), alignof(std::max_align_t)) };
+
+   public:
+    monotonic_buffer_resource() : monotonic_buffer_resource(get_default_resource()) {}
+
+    explicit monotonic_buffer_resource(memory_resource* upstream)
+        : monotonic_buffer_resource(MONOTONIC_BUFFER_INIT_SIZE, upstream) {}
+
+    explicit monotonic_buffer_resource(size_t initial_size, memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), initial_buffer_(nullptr), initial_size_(0), current_(nullptr), remaining_(0), chunks_(nullptr) {
+        MYSTL_DEBUG(upstream != nullptr);
+        initial_next_ = next_size_ = initial_size < header_size + 1 ? header_size + 1 : initial_size;
+    }
+
+    // 先使用调用者提供的缓冲区，用完后再向上游申请
+    monotonic_buffer_resource(void* buffer, size_t size, memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), initial_buffer_(static_cast<char*>(buffer)), initial_size_(size), current_(static_cast<char*>(buffer)), remaining_(size), chunks_(nullptr) {
+        MYSTL_DEBUG(upstream != nullptr);
+        initial_next_ = next_size_ = size < MONOTONIC_BUFFER_INIT_SIZE ? MONOTONIC_BUFFER_INIT_SIZE : size * 2;
+    }
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+    ~monotonic_buffer_resource() override { release(); }
+
+   public:
+    // 归还所有向上游申请的 chunk，重新从初始缓冲区开始分配
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            chunk_header* next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->size, max_align);
+            chunks_ = next;
+        }
+        current_ = initial_buffer_;
+        remaining_ = initial_size_;
+        next_size_ = initial_next_;
+    }
+
+    memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+   private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (bytes == 0) bytes = 1;
+        char* p = current_ == nullptr ? nullptr : resource_detail::align_up(current_, align);
+        if (p == nullptr || static_cast<size_t>(p - current_) + bytes > remaining_) {
+            new_chunk(bytes, align);
+            p = resource_detail::align_up(current_, align);
+        }
+        remaining_ -= static_cast<size_t>(p - current_) + bytes;
+        current_ = p + bytes;
+        return p;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    // 新 chunk 至少要放得下本次请求以及对齐需要的空隙
+    void new_chunk(size_t bytes, size_t align) {
+        size_t need = header_size + bytes + (align > max_align ? align : 0);
+        THROW_LENGTH_ERROR_IF(need < bytes, "monotonic_buffer_resource<T>'s size too big");
+        size_t size = next_size_ < need ? need : next_size_;
+        char* mem = static_cast<char*>(upstream_->allocate(size, max_align));
+        chunk_header* header = reinterpret_cast<chunk_header*>(mem);
+        header->next = chunks_;
+        header->size = size;
+        chunks_ = header;
+        current_ = mem + header_size;
+        remaining_ = size - header_size;
+        next_size_ = size * 2 < size ? size : size * 2;
+    }
+
+   private:
+    memory_resource* upstream_;
+    char* initial_buffer_;  // 调用者提供的缓冲区，不归还
+    size_t initial_size_;
+    char* current_;     // 当前缓冲区中下一个可用的位置
+    size_t remaining_;  // 当前缓冲区剩余的字节数
+    size_t next_size_;  // 下一次向上游申请的字节数
+    size_t initial_next_;
+    chunk_header* chunks_;
+};
+
+/*****************************************************************************************/
+// pool_options
+// 为 0 的字段使用缺省值，超出实现上限的值会被截断
+/*****************************************************************************************/
+struct pool_options {
+    size_t max_blocks_per_chunk;
+    size_t largest_required_pool_block;
+
+    pool_options() noexcept : max_blocks_per_chunk(0), largest_required_pool_block(0) {}
+    pool_options(size_t blocks, size_t largest) noexcept : max_blocks_per_chunk(blocks), largest_required_pool_block(largest) {}
+};
+
+/*****************************************************************************************/
+// unsynchronized_pool_resource
+// 把请求按 2 的幂分级，每个等级维护一条自由链表，释放的块回到链表上供下次复用
+// 超过最大块大小或对齐要求超过 max_align 的请求直接交给上游，并记录下来以便 release 时归还
+/*****************************************************************************************/
+class unsynchronized_pool_resource : public memory_resource {
+   private:
+    struct free_block {
+        free_block* next;
+    };
+
+    struct chunk_header {
+        chunk_header* next;
+        size_t size;
+    };
+
+    // 直接向上游申请的大块，用双向链表串起来，释放时可以在常数时间内摘除
+    struct large_header {
+        large_header* prev;
+        large_header* next;
+        size_t size;
+        size_t align;
+    };
+
+    struct pool {
+        free_block* free_list;
+        chunk_header* chunks;
+        size_t next_blocks;  // 下一个 chunk 的块数，按倍数增长到 max_blocks_per_chunk
+    };
+
+    enum { min_block_shift = 3 };
+    enum { max_pool_count = 18 };  // 8 字节到 1 MB
+    enum { header_size = resource_detail::round_up(sizeof(chunk_header), alignof(std::max_align_t)) };
+
+   public:
+    unsynchronized_pool_resource() : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+    explicit unsynchronized_pool_resource(memory_resource* upstream) : unsynchronized_pool_resource(pool_options(), upstream) {}
+
+    explicit unsynchronized_pool_resource(const pool_options& opts) : unsynchronized_pool_resource(opts, get_default_resource()) {}
+
+    unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+        : upstream_(upstream), options_(opts), pool_count_(0), large_(nullptr) {
+        MYSTL_DEBUG(upstream != nullptr);
+        if (options_.max_blocks_per_chunk == 0 || options_.max_blocks_per_chunk > POOL_RESOURCE_MAX_BLOCKS_PER_CHUNK)
+            options_.max_blocks_per_chunk = POOL_RESOURCE_MAX_BLOCKS_PER_CHUNK;
+        if (options_.largest_required_pool_block == 0) options_.largest_required_pool_block = POOL_RESOURCE_MAX_BLOCK;
+        size_t largest = static_cast<size_t>(1) << min_block_shift;
+        pool_count_ = 1;
+        while (largest < options_.largest_required_pool_block && pool_count_ < max_pool_count) {
+            largest <<= 1;
+            ++pool_count_;
+        }
+        options_.largest_required_pool_block = largest;
+        for (size_t i = 0; i < max_pool_count; ++i) {
+            pools_[i].free_list = nullptr;
+            pools_[i].chunks = nullptr;
+            pools_[i].next_blocks = 16 < options_.max_blocks_per_chunk ? 16 : options_.max_blocks_per_chunk;
+        }
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override { release(); }
+
+   public:
+    // 把所有 chunk 和大块归还给上游，即使其中还有未释放的块
+    void release() noexcept {
+        for (size_t i = 0; i < pool_count_; ++i) {
+            pool& pl = pools_[i];
+            while (pl.chunks != nullptr) {
+                chunk_header* next = pl.chunks->next;
+                upstream_->deallocate(pl.chunks, pl.chunks->size, max_align);
+                pl.chunks = next;
+            }
+            pl.free_list = nullptr;
+        }
+        while (large_ != nullptr) {
+            large_header* next = large_->next;
+            upstream_->deallocate(large_, large_->size, large_->align);
+            large_ = next;
+        }
+    }
+
+    memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+    pool_options options() const noexcept { return options_; }
+
+   private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (bytes == 0) bytes = 1;
+        if (bytes > options_.largest_required_pool_block || align > max_align) return allocate_large(bytes, align);
+        // 块的大小是 2 的幂，块大小不小于对齐要求时，块的起始地址自然满足对齐
+        if (bytes < align) bytes = align;
+        pool& pl = pools_[pool_index(bytes)];
+        free_block* p = pl.free_list;
+        if (p == nullptr) p = refill(pl, block_size(pool_index(bytes)));
+        pl.free_list = p->next;
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (p == nullptr) return;
+        if (bytes == 0) bytes = 1;
+        if (bytes > options_.largest_required_pool_block || align > max_align) {
+            deallocate_large(p, bytes, align);
+            return;
+        }
+        if (bytes < align) bytes = align;
+        pool& pl = pools_[pool_index(bytes)];
+        free_block* b = static_cast<free_block*>(p);
+        b->next = pl.free_list;
+        pl.free_list = b;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    static size_t block_size(size_t index) noexcept { return static_cast<size_t>(1) << (index + min_block_shift); }
+
+    static size_t pool_index(size_t bytes) noexcept {
+        size_t index = 0;
+        while (block_size(index) < bytes) ++index;
+        return index;
+    }
+
+    // 申请一块 chunk，切成同样大小的块串到自由链表上
+    free_block* refill(pool& pl, size_t size) {
+        const size_t count = pl.next_blocks;
+        const size_t bytes = header_size + count * size;
+        char* mem = static_cast<char*>(upstream_->allocate(bytes, max_align));
+        chunk_header* header = reinterpret_cast<chunk_header*>(mem);
+        header->next = pl.chunks;
+        header->size = bytes;
+        pl.chunks = header;
+        if (pl.next_blocks < options_.max_blocks_per_chunk) {
+            pl.next_blocks *= 2;
+            if (pl.next_blocks > options_.max_blocks_per_chunk) pl.next_blocks = options_.max_blocks_per_chunk;
+        }
+
+        char* first = mem + header_size;
+        for (size_t i = 0; i + 1 < count; ++i) {
+            reinterpret_cast<free_block*>(first + i * size)->next = reinterpret_cast<free_block*>(first + (i + 1) * size);
+        }
+        reinterpret_cast<free_block*>(first + (count - 1) * size)->next = pl.free_list;
+        pl.free_list = reinterpret_cast<free_block*>(first);
+        return pl.free_list;
+    }
+
+    // 大块的头部放在返回地址之前，头部所占的空间按对齐要求取整
+    static size_t large_offset(size_t align) noexcept {
+        const size_t a = align > max_align ? align : static_cast<size_t>(max_align);
+        return resource_detail::round_up(sizeof(large_header), a);
+    }
+
+    void* allocate_large(size_t bytes, size_t align) {
+        const size_t offset = large_offset(align);
+        THROW_LENGTH_ERROR_IF(bytes + offset < bytes, "unsynchronized_pool_resource<T>'s size too big");
+        const size_t mem_align = align > max_align ? align : static_cast<size_t>(max_align);
+        char* mem = static_cast<char*>(upstream_->allocate(bytes + offset, mem_align));
+        large_header* header = reinterpret_cast<large_header*>(mem);
+        header->size = bytes + offset;
+        header->align = mem_align;
+        header->prev = nullptr;
+        header->next = large_;
+        if (large_ != nullptr) large_->prev = header;
+        large_ = header;
+        return mem + offset;
+    }
+
+    void deallocate_large(void* p, size_t, size_t align) {
+        char* mem = static_cast<char*>(p) - large_offset(align);
+        large_header* header = reinterpret_cast<large_header*>(mem);
+        if (header->prev != nullptr)
+            header->prev->next = header->next;
+        else
+            large_ = header->next;
+        if (header->next != nullptr) header->next->prev = header->prev;
+        upstream_->deallocate(mem, header->size, header->align);
+    }
+
+   private:
+    memory_resource* upstream_;
+    pool_options options_;
+    size_t pool_count_;
+    pool pools_[max_pool_count];
+    large_header* large_;
+};
+
+/*****************************************************************************************/
+// polymorphic_allocator
+// 保存一个 memory_resource 指针，所有的分配都转发给它
+// 不随容器的赋值、交换而传播，容器的拷贝构造使用缺省资源
+/*****************************************************************************************/
+template <class T>
+class polymorphic_allocator {
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef const T* const_pointer;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef polymorphic_allocator<U> other;
+    };
+
+   public:
+    polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+
+    polymorphic_allocator(memory_resource* r) noexcept : resource_(r) { MYSTL_DEBUG(r != nullptr); }
+
+    polymorphic_allocator(const polymorphic_allocator& rhs) noexcept : resource_(rhs.resource_) {}
+
+    template <class U>
+    polymorphic_allocator(const polymorphic_allocator<U>& rhs) noexcept : resource_(rhs.resource()) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+   public:
+    T* allocate(size_type n) {
+        if (n > static_cast<size_type>(-1) / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_type n) { resource_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args) {
+        MySTL::construct(p, MySTL::forward<Args>(args)...);
+    }
+
+    template <class U>
+    void destroy(U* p) {
+        MySTL::destroy(p);
+    }
+
+    polymorphic_allocator select_on_container_copy_construction() const { return polymorphic_allocator(); }
+
+    memory_resource* resource() const noexcept { return resource_; }
+
+   private:
+    memory_resource* resource_;
+};
+
+template <class T, class U>
+bool operator==(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept {
+    return *lhs.resource() == *rhs.resource();
+}
+
+template <class T, class U>
+bool operator!=(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// 只保存一个资源指针
+template <class T>
+struct is_trivially_relocatable<polymorphic_allocator<T>> : std::true_type {};
+
+}  // namespace MySTL
+#endif
@@ -0,0 +1,437 @@
+#ifndef _MYSTL_MMAP_VECTOR_H_
+#define _MYSTL_MMAP_VECTOR_H_
+
+// 这个头文件包含一个模板类 mmap_vector，元素保存在内存映射的文件中
+
+// notes:
+//
+// mmap_vector<T> 只接受可平凡复制的 T，元素直接以内存中的字节形式写入文件
+// 文件的第一页是文件头，记录元素大小与元素个数，元素从第二页开始连续存放
+// 打开已有的文件只做一次 mmap，不复制、不解析数据，元素在第一次访问时由内核按页读入
+// 扩容时先用 ftruncate 扩展文件，Linux 下再由 mremap 扩展映射，其余平台重新映射
+// 文件头中的元素个数在 flush 与 close 时写回，进程异常退出时，最后一次 flush 之后追加的元素不会被记录
+// 以 mmap_read_only 打开时文件以 MAP_PRIVATE 映射，元素访问不做检查，通过引用写入元素只修改本进程的私有副本，
+// 不会写回文件；改变大小或写回文件的操作（push_back、resize、reserve、clear 等）都会抛出 std::runtime_error
+//
+// 只在提供 mmap 的平台（__unix__ 或 __APPLE__）上可用，此时 MYSTL_HAS_FILE_MAP 为 1
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+#include "vector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYSTL_HAS_FILE_MAP 1
+#else
+#define MYSTL_HAS_FILE_MAP 0
+#endif
+
+#if MYSTL_HAS_FILE_MAP
+
+namespace MySTL {
+
+// 打开文件的方式
+enum mmap_mode {
+    mmap_read_only,   // 只读打开已有的文件
+    mmap_read_write,  // 读写打开，文件不存在时创建
+    mmap_truncate     // 读写打开，清空已有的内容
+};
+
+namespace mmap_detail {
+
+// 文件头，占据文件的第一页
+struct file_header {
+    uint64_t magic;
+    uint64_t elem_size;
+    uint64_t size;
+};
+
+constexpr uint64_t file_magic = 0x4345564c5453594dULL;  // 小端序下为 "MYSTLVEC"
+
+}  // namespace mmap_detail
+
+// 模板类: mmap_vector
+// 模板参数 T 代表数据类型，Growth 代表增长策略，缺省按两倍增长并把文件大小取整到页
+template <class T, class Growth = MySTL::page_vector_growth<2, 1>>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector requires a trivially copyable T");
+    static_assert(alignof(T) <= MYSTL_PAGE_SIZE, "mmap_vector can not align T beyond a page");
+
+   public:
+    // mmap_vector 的嵌套型别定义
+    typedef Growth growth_policy;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    enum : size_t { header_size = MYSTL_PAGE_SIZE };
+
+   private:
+    int fd_;            // 文件描述符，未打开时为 -1
+    char* map_;         // 映射的起始位置，即文件头
+    size_t map_bytes_;  // 映射的字节数，与文件大小相同
+    size_type size_;    // 元素个数
+    size_type cap_;     // 文件能容纳的元素个数
+    bool read_only_;
+
+   public:
+    // 构造、移动、析构函数
+    mmap_vector() noexcept : fd_(-1), map_(nullptr), map_bytes_(0), size_(0), cap_(0), read_only_(false) {}
+
+    explicit mmap_vector(const char* path, mmap_mode mode = mmap_read_write)
+        : fd_(-1), map_(nullptr), map_bytes_(0), size_(0), cap_(0), read_only_(false) {
+        open(path, mode);
+    }
+
+    mmap_vector(mmap_vector&& rhs) noexcept
+        : fd_(rhs.fd_), map_(rhs.map_), map_bytes_(rhs.map_bytes_), size_(rhs.size_), cap_(rhs.cap_), read_only_(rhs.read_only_) {
+        rhs.fd_ = -1;
+        rhs.map_ = nullptr;
+        rhs.map_bytes_ = 0;
+        rhs.size_ = 0;
+        rhs.cap_ = 0;
+    }
+
+    mmap_vector& operator=(mmap_vector&& rhs) noexcept {
+        mmap_vector tmp(MySTL::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    mmap_vector(const mmap_vector&) = delete;
+    mmap_vector& operator=(const mmap_vector&) = delete;
+
+    ~mmap_vector() { close(); }
+
+   public:
+    // 打开与关闭文件
+    void open(const char* path, mmap_mode mode = mmap_read_write);
+
+    // 写回文件头，把文件截到恰好容纳所有元素的大小，然后关闭
+    void close() noexcept;
+
+    // 写回文件头并等待所有修改落盘
+    void flush();
+
+    bool is_open() const noexcept { return map_ != nullptr; }
+    bool is_read_only() const noexcept { return read_only_; }
+
+    // 迭代器相关操作
+    iterator begin() noexcept { return data(); }
+    const_iterator begin() const noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator end() const noexcept { return data() + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return cap_; }
+    size_type max_size() const noexcept { return (static_cast<size_type>(-1) - header_size) / sizeof(T); }
+
+    void reserve(size_type n);
+    void shrink_to_fit();
+
+    // 访问元素相关操作
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size_);
+        return data()[n];
+    }
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return data()[n];
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size_), "mmap_vector<T>::at() subscript out of range");
+        return data()[n];
+    }
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size_), "mmap_vector<T>::at() subscript out of range");
+        return data()[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return data()[0];
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return data()[0];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return data()[size_ - 1];
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return data()[size_ - 1];
+    }
+
+    pointer data() noexcept { return map_ == nullptr ? nullptr : reinterpret_cast<pointer>(map_ + header_size); }
+    const_pointer data() const noexcept { return map_ == nullptr ? nullptr : reinterpret_cast<const_pointer>(map_ + header_size); }
+
+    // 修改容器相关操作
+    // 扩容可能移动映射，参数可能引用容器自身的元素，所以先构造好新元素再扩容
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        push_back(value_type(MySTL::forward<Args>(args)...));
+    }
+
+    void push_back(const value_type& value) {
+        if (size_ == cap_) {
+            const value_type tmp = value;
+            reserve(get_new_cap(1));
+            data()[size_++] = tmp;
+            return;
+        }
+        data()[size_++] = value;
+    }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        check_writable();
+        --size_;
+    }
+
+    // 在尾部追加 [first, last) 的元素
+    template <class Iter, typename std::enable_if<MySTL::is_forward_iterator<Iter>::value, int>::type = 0>
+    void append(Iter first, Iter last) {
+        const size_type n = static_cast<size_type>(MySTL::distance(first, last));
+        if (cap_ - size_ < n) reserve(get_new_cap(n));
+        MySTL::copy(first, last, data() + size_);
+        size_ += n;
+    }
+
+    void resize(size_type new_size) { return resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    // 新增的元素不写入任何值：文件新扩展出的部分总是 0，曾经用过的部分保留原来的字节
+    void resize_default_init(size_type new_size);
+
+    void clear() {
+        check_writable();
+        size_ = 0;
+    }
+
+    void swap(mmap_vector& rhs) noexcept {
+        MySTL::swap(fd_, rhs.fd_);
+        MySTL::swap(map_, rhs.map_);
+        MySTL::swap(map_bytes_, rhs.map_bytes_);
+        MySTL::swap(size_, rhs.size_);
+        MySTL::swap(cap_, rhs.cap_);
+        MySTL::swap(read_only_, rhs.read_only_);
+    }
+
+   private:
+    // helper functions
+    mmap_detail::file_header* header() noexcept { return reinterpret_cast<mmap_detail::file_header*>(map_); }
+
+    void check_writable() const {
+        THROW_RUNTIME_ERROR_IF(read_only_, "mmap_vector<T> is opened read only");
+    }
+
+    size_type get_new_cap(size_type add_size) const {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - add_size, "mmap_vector<T>'s size too big");
+        return MySTL::min(Growth::next_capacity(cap_, size_ + add_size, sizeof(T)), max_size());
+    }
+
+    void remap(size_type new_cap);
+    void release() noexcept;
+};
+
+/*****************************************************************************************/
+
+// 打开 path 指向的文件，之前打开的文件会先关闭
+// 文件不是由 mmap_vector<T> 写出的，或元素大小与 T 不同时抛出 std::runtime_error
+template <class T, class Growth>
+void mmap_vector<T, Growth>::open(const char* path, mmap_mode mode) {
+    close();
+    int flags = mode == mmap_read_only ? O_RDONLY : (O_RDWR | O_CREAT | (mode == mmap_truncate ? O_TRUNC : 0));
+#if defined(O_CLOEXEC)
+    flags |= O_CLOEXEC;  // 不让 exec 出的子进程继承文件描述符
+#endif
+    fd_ = ::open(path, flags, 0644);
+    THROW_RUNTIME_ERROR_IF(fd_ < 0, "mmap_vector<T> can not open the file");
+    read_only_ = mode == mmap_read_only;
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        release();
+        throw std::runtime_error("mmap_vector<T> can not stat the file");
+    }
+    size_t bytes = static_cast<size_t>(st.st_size);
+    const bool fresh = bytes == 0 && !read_only_;
+    if (fresh) {
+        if (::ftruncate(fd_, header_size) != 0) {
+            release();
+            throw std::runtime_error("mmap_vector<T> can not extend the file");
+        }
+        bytes = header_size;
+    }
+    if (bytes < header_size) {
+        release();
+        throw std::runtime_error("mmap_vector<T> file is too small");
+    }
+
+    // 只读打开时使用写时复制的私有映射，写入元素不会改动文件，也不会因为页面只读而出错
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, read_only_ ? MAP_PRIVATE : MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        release();
+        throw std::runtime_error("mmap_vector<T> can not map the file");
+    }
+    map_ = static_cast<char*>(p);
+    map_bytes_ = bytes;
+    cap_ = (bytes - header_size) / sizeof(T);
+
+    mmap_detail::file_header* h = header();
+    if (fresh) {
+        h->magic = mmap_detail::file_magic;
+        h->elem_size = sizeof(T);
+        h->size = 0;
+    }
+    if (h->magic != mmap_detail::file_magic || h->elem_size != sizeof(T) || h->size > cap_) {
+        release();
+        throw std::runtime_error("mmap_vector<T> file is not compatible");
+    }
+    size_ = static_cast<size_type>(h->size);
+    if (read_only_) cap_ = size_;
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::close() noexcept {
+    if (map_ == nullptr) return;
+    if (!read_only_) {
+        header()->size = size_;
+        const size_t bytes = header_size + size_ * sizeof(T);
+        if (bytes < map_bytes_) {
+            // 先解除映射，再截短文件
+            ::munmap(map_, map_bytes_);
+            map_ = nullptr;
+            (void)::ftruncate(fd_, static_cast<off_t>(bytes));
+        }
+    }
+    release();
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::flush() {
+    if (map_ == nullptr || read_only_) return;
+    header()->size = size_;
+    THROW_RUNTIME_ERROR_IF(::msync(map_, map_bytes_, MS_SYNC) != 0, "mmap_vector<T> can not sync the file");
+}
+
+// 预留空间，文件扩展到至少容纳 n 个元素
+template <class T, class Growth>
+void mmap_vector<T, Growth>::reserve(size_type n) {
+    if (n <= cap_) return;
+    THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in mmap_vector<T>::reserve(n)");
+    remap(n);
+}
+
+// 文件截到恰好容纳所有元素
+template <class T, class Growth>
+void mmap_vector<T, Growth>::shrink_to_fit() {
+    check_writable();
+    if (size_ < cap_) remap(size_);
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::resize(size_type new_size, const value_type& value) {
+    check_writable();
+    if (new_size > size_) {
+        reserve(new_size);
+        MySTL::uninitialized_fill_n(data() + size_, new_size - size_, value);
+    }
+    size_ = new_size;
+}
+
+template <class T, class Growth>
+void mmap_vector<T, Growth>::resize_default_init(size_type new_size) {
+    check_writable();
+    reserve(new_size);
+    size_ = new_size;
+}
+
+// 把文件与映射调整为恰好容纳 new_cap 个元素，扩展时先扩文件，收缩时先缩映射，映射不会越过文件末尾
+template <class T, class Growth>
+void mmap_vector<T, Growth>::remap(size_type new_cap) {
+    check_writable();
+    MYSTL_DEBUG(map_ != nullptr && new_cap >= size_);
+    const size_t new_bytes = header_size + new_cap * sizeof(T);
+    if (new_bytes > map_bytes_) {
+        THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0, "mmap_vector<T> can not extend the file");
+    }
+#if defined(__linux__)
+    void* p = ::mremap(map_, map_bytes_, new_bytes, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) {
+        if (new_bytes > map_bytes_) (void)::ftruncate(fd_, static_cast<off_t>(map_bytes_));
+        throw std::runtime_error("mmap_vector<T> can not remap the file");
+    }
+#else
+    void* p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        if (new_bytes > map_bytes_) (void)::ftruncate(fd_, static_cast<off_t>(map_bytes_));
+        throw std::runtime_error("mmap_vector<T> can not remap the file");
+    }
+    ::munmap(map_, map_bytes_);
+#endif
+    if (new_bytes < map_bytes_) (void)::ftruncate(fd_, static_cast<off_t>(new_bytes));
+    map_ = static_cast<char*>(p);
+    map_bytes_ = new_bytes;
+    cap_ = new_cap;
+}
+
+// 解除映射并关闭文件，不写回任何内容
+template <class T, class Growth>
+void mmap_vector<T, Growth>::release() noexcept {
+    if (map_ != nullptr) ::munmap(map_, map_bytes_);
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    map_ = nullptr;
+    map_bytes_ = 0;
+    size_ = 0;
+    cap_ = 0;
+    read_only_ = false;
+}
+
+/*****************************************************************************************/
+// 重载 MySTL 的 swap
+template <class T, class Growth>
+void swap(mmap_vector<T, Growth>& lhs, mmap_vector<T, Growth>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace MySTL
+
+#endif  // MYSTL_HAS_FILE_MAP
+#endif
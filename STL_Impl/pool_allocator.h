@@ -0,0 +1,408 @@
+#ifndef _MYSTL_POOL_ALLOCATOR_H_
+#define _MYSTL_POOL_ALLOCATOR_H_
+
+// 这个头文件包含一个分级内存池 node_pool，以及基于它的模板类 pool_allocator
+// list、rb_tree、hashtable 等节点容器默认使用 pool_allocator 分配节点
+
+// notes:
+//
+// node_pool 把不超过 NODE_POOL_MAX_BYTES 的请求按 NODE_POOL_ALIGN 向上取整，分到不同的尺寸等级，
+// 每个等级维护一条自由链表，链表为空时向系统申请一块 chunk，一次切出一批同样大小的块补充链表
+// 释放的块只回到对应等级的自由链表，chunk 在程序运行期间不归还给系统
+// 每个等级各有一把自旋锁，多线程下可以安全使用
+//
+// MYSTL_THREAD_CACHE 打开时，每个线程在中心链表前面还有一层线程本地缓存：
+// 分配和释放先访问本线程的链表，不加锁；本地链表为空时一次从中心链表取 THREAD_CACHE_BATCH 个块，
+// 本地链表超过 THREAD_CACHE_LIMIT 个块时一次归还 THREAD_CACHE_BATCH 个块
+// 在其他线程释放的块进入释放线程的本地缓存，随后经由中心链表回到所有线程手中
+// 线程退出时把本地缓存整个归还给中心链表，此后该线程上的分配与释放直接走中心链表
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace MySTL {
+
+// 定义 MYSTL_NODE_POOL 为 0 时，节点容器退回到 allocator，每个节点直接调用 ::operator new
+#ifndef MYSTL_NODE_POOL
+#define MYSTL_NODE_POOL 1
+#endif
+
+#ifndef NODE_POOL_ALIGN
+#define NODE_POOL_ALIGN 8
+#endif
+
+#ifndef NODE_POOL_MAX_BYTES
+#define NODE_POOL_MAX_BYTES 256
+#endif
+
+#ifndef NODE_POOL_CHUNK_SIZE
+#define NODE_POOL_CHUNK_SIZE 16384
+#endif
+
+// 定义 MYSTL_THREAD_CACHE 为 0 时，关闭线程本地缓存，每次分配与释放都要获取中心链表的锁
+#ifndef MYSTL_THREAD_CACHE
+#define MYSTL_THREAD_CACHE 1
+#endif
+
+#ifndef THREAD_CACHE_BATCH
+#define THREAD_CACHE_BATCH 32
+#endif
+
+#ifndef THREAD_CACHE_LIMIT
+#define THREAD_CACHE_LIMIT 128
+#endif
+
+/*****************************************************************************************/
+// node_pool
+// 分级内存池，只提供静态接口
+/*****************************************************************************************/
+class node_pool {
+   private:
+    // 空闲块复用自身的前几个字节作为链表指针
+    struct free_block {
+        free_block* next;
+    };
+
+    // 每个 chunk 的头部，把所有 chunk 串起来，保证它们始终可达
+    struct chunk_header {
+        chunk_header* next;
+    };
+
+    struct size_class {
+        free_block* free_list;
+        chunk_header* chunks;
+        std::atomic<bool> locked;
+    };
+
+    enum { class_count = NODE_POOL_MAX_BYTES / NODE_POOL_ALIGN };
+    enum { header_size = (sizeof(chunk_header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1) };
+
+#if MYSTL_THREAD_CACHE
+    static_assert(THREAD_CACHE_BATCH > 0 && THREAD_CACHE_BATCH <= THREAD_CACHE_LIMIT, "THREAD_CACHE_BATCH must be in (0, THREAD_CACHE_LIMIT]");
+
+    // 线程本地缓存，平凡析构，线程存储期下零初始化，访问时不需要额外的初始化检查
+    struct thread_cache {
+        free_block* lists[class_count];
+        unsigned counts[class_count];
+        bool registered;  // 是否已登记线程退出时的归还
+        bool dead;        // 本线程的缓存已经归还，之后直接使用中心链表
+    };
+
+    // 线程退出时析构，把本线程缓存的块全部归还给中心链表
+    struct cache_guard {
+        ~cache_guard() { flush_cache(); }
+    };
+#endif
+
+   public:
+    // 能否由内存池分配：大小不超过上限，且对齐要求不超过 chunk 起始地址的对齐
+    static constexpr bool is_pooled(size_t bytes, size_t align) noexcept {
+        return bytes != 0 && bytes <= NODE_POOL_MAX_BYTES && align <= alignof(std::max_align_t);
+    }
+
+    static void* allocate(size_t bytes) {
+#if MYSTL_THREAD_CACHE
+        thread_cache& tc = local_cache();
+        if (!tc.dead) {
+            const size_t idx = class_index(bytes);
+            free_block* p = tc.lists[idx];
+            if (p != nullptr) {
+                tc.lists[idx] = p->next;
+                --tc.counts[idx];
+                return p;
+            }
+            return fetch_batch(tc, idx, round_up(bytes));
+        }
+#endif
+        size_class& sc = classes()[class_index(bytes)];
+        lock(sc);
+        free_block* p = sc.free_list;
+        if (p != nullptr) {
+            sc.free_list = p->next;
+            unlock(sc);
+            return p;
+        }
+        try {
+            p = refill(sc, round_up(bytes));
+        } catch (...) {
+            unlock(sc);
+            throw;
+        }
+        unlock(sc);
+        return p;
+    }
+
+    static void deallocate(void* ptr, size_t bytes) noexcept {
+        free_block* p = static_cast<free_block*>(ptr);
+#if MYSTL_THREAD_CACHE
+        thread_cache& tc = local_cache();
+        if (!tc.dead) {
+            if (!tc.registered) register_cache(tc);
+            const size_t idx = class_index(bytes);
+            p->next = tc.lists[idx];
+            tc.lists[idx] = p;
+            if (++tc.counts[idx] > THREAD_CACHE_LIMIT) release_batch(tc, idx);
+            return;
+        }
+#endif
+        size_class& sc = classes()[class_index(bytes)];
+        lock(sc);
+        p->next = sc.free_list;
+        sc.free_list = p;
+        unlock(sc);
+    }
+
+   private:
+    // 所有尺寸等级，静态存储期下零初始化，不需要构造和析构
+    static size_class* classes() noexcept {
+        static size_class pool[class_count];
+        return pool;
+    }
+
+    static constexpr size_t round_up(size_t bytes) noexcept { return (bytes + NODE_POOL_ALIGN - 1) & ~(static_cast<size_t>(NODE_POOL_ALIGN) - 1); }
+
+    static constexpr size_t class_index(size_t bytes) noexcept { return (bytes + NODE_POOL_ALIGN - 1) / NODE_POOL_ALIGN - 1; }
+
+    static void lock(size_class& sc) noexcept {
+        while (sc.locked.exchange(true, std::memory_order_acquire)) {
+            while (sc.locked.load(std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    static void unlock(size_class& sc) noexcept { sc.locked.store(false, std::memory_order_release); }
+
+#if MYSTL_THREAD_CACHE
+    static thread_cache& local_cache() noexcept {
+        static thread_local thread_cache cache;
+        return cache;
+    }
+
+    // 第一次使用缓存时构造本线程的 cache_guard，使线程退出时能够归还缓存
+    static void register_cache(thread_cache& tc) noexcept {
+        static thread_local cache_guard guard;
+        (void)guard;
+        tc.registered = true;
+    }
+
+    // 本地链表为空：从中心链表取一批块，返回其中一个，其余的留在本地链表
+    static void* fetch_batch(thread_cache& tc, size_t idx, size_t block_size) {
+        if (!tc.registered) register_cache(tc);
+        size_class& sc = classes()[idx];
+        lock(sc);
+        free_block* first = sc.free_list;
+        if (first != nullptr) {
+            sc.free_list = first->next;
+        } else {
+            try {
+                first = refill(sc, block_size);
+            } catch (...) {
+                unlock(sc);
+                throw;
+            }
+        }
+        free_block* head = sc.free_list;
+        free_block* tail = nullptr;
+        unsigned n = 0;
+        for (free_block* cur = head; cur != nullptr && n + 1 < THREAD_CACHE_BATCH; cur = cur->next, ++n) tail = cur;
+        if (tail != nullptr) {
+            sc.free_list = tail->next;
+            tail->next = tc.lists[idx];
+            tc.lists[idx] = head;
+            tc.counts[idx] += n;
+        }
+        unlock(sc);
+        return first;
+    }
+
+    // 把 [head, tail] 这一段块接到中心链表的头部
+    static void splice_central(size_t idx, free_block* head, free_block* tail) noexcept {
+        size_class& sc = classes()[idx];
+        lock(sc);
+        tail->next = sc.free_list;
+        sc.free_list = head;
+        unlock(sc);
+    }
+
+    // 本地链表过长：把链表头部的一批块还给中心链表
+    static void release_batch(thread_cache& tc, size_t idx) noexcept {
+        free_block* head = tc.lists[idx];
+        free_block* tail = head;
+        for (unsigned i = 1; i < THREAD_CACHE_BATCH; ++i) tail = tail->next;
+        tc.lists[idx] = tail->next;
+        tc.counts[idx] -= THREAD_CACHE_BATCH;
+        splice_central(idx, head, tail);
+    }
+
+    static void flush_cache() noexcept {
+        thread_cache& tc = local_cache();
+        for (size_t idx = 0; idx < class_count; ++idx) {
+            free_block* head = tc.lists[idx];
+            if (head == nullptr) continue;
+            free_block* tail = head;
+            while (tail->next != nullptr) tail = tail->next;
+            splice_central(idx, head, tail);
+            tc.lists[idx] = nullptr;
+            tc.counts[idx] = 0;
+        }
+        tc.dead = true;
+    }
+#endif
+
+    // 申请一块 chunk，把第一个块返回，其余的块串到自由链表上
+    static free_block* refill(size_class& sc, size_t block_size) {
+        size_t count = (NODE_POOL_CHUNK_SIZE - header_size) / block_size;
+        if (count < 2) count = 2;
+        char* mem = static_cast<char*>(::operator new(header_size + count * block_size));
+        chunk_header* header = reinterpret_cast<chunk_header*>(mem);
+        header->next = sc.chunks;
+        sc.chunks = header;
+
+        char* first = mem + header_size;
+        for (size_t i = 1; i + 1 < count; ++i) {
+            reinterpret_cast<free_block*>(first + i * block_size)->next = reinterpret_cast<free_block*>(first + (i + 1) * block_size);
+        }
+        reinterpret_cast<free_block*>(first + (count - 1) * block_size)->next = sc.free_list;
+        sc.free_list = reinterpret_cast<free_block*>(first + block_size);
+        return reinterpret_cast<free_block*>(first);
+    }
+};
+
+/*****************************************************************************************/
+// pool_allocator
+// 接口与 allocator 相同，小对象从 node_pool 分配，其余的请求仍然交给 aligned_allocate
+// 释放时必须传入与分配时相同的个数，不带个数的版本对应 allocate()
+/*****************************************************************************************/
+template <class T>
+class pool_allocator {
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef const T* const_pointer;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef pool_allocator<U> other;
+    };
+
+   public:
+    pool_allocator() noexcept {}
+    pool_allocator(const pool_allocator&) noexcept {}
+    template <class U>
+    pool_allocator(const pool_allocator<U>&) noexcept {}
+
+   public:
+    static T* allocate();
+    static T* allocate(size_type n);
+
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+
+    template <class... Args>
+    static void construct(T* ptr, Args&&... args);
+
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+};
+
+template <class T>
+T* pool_allocator<T>::allocate() {
+    return allocate(1);
+}
+
+template <class T>
+T* pool_allocator<T>::allocate(size_type n) {
+    if (n == 0) return nullptr;
+    const size_t bytes = n * sizeof(T);
+    if (node_pool::is_pooled(bytes, alignof(T))) return static_cast<T*>(node_pool::allocate(bytes));
+    return static_cast<T*>(aligned_allocate(bytes, alignof(T)));
+}
+
+template <class T>
+void pool_allocator<T>::deallocate(T* ptr) {
+    deallocate(ptr, 1);
+}
+
+template <class T>
+void pool_allocator<T>::deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) return;
+    const size_t bytes = n * sizeof(T);
+    if (node_pool::is_pooled(bytes, alignof(T)))
+        node_pool::deallocate(ptr, bytes);
+    else
+        aligned_deallocate(ptr, bytes, alignof(T));
+}
+
+template <class T>
+void pool_allocator<T>::construct(T* ptr) {
+    MySTL::construct(ptr);
+}
+
+template <class T>
+void pool_allocator<T>::construct(T* ptr, const T& value) {
+    MySTL::construct(ptr, value);
+}
+
+template <class T>
+void pool_allocator<T>::construct(T* ptr, T&& value) {
+    MySTL::construct(ptr, MySTL::move(value));
+}
+
+template <class T>
+template <class... Args>
+void pool_allocator<T>::construct(T* ptr, Args&&... args) {
+    MySTL::construct(ptr, MySTL::forward<Args>(args)...);
+}
+
+template <class T>
+void pool_allocator<T>::destroy(T* ptr) {
+    MySTL::destroy(ptr);
+}
+
+template <class T>
+void pool_allocator<T>::destroy(T* first, T* last) {
+    MySTL::destroy(first, last);
+}
+
+// 内存池是全局的，任意两个 pool_allocator 都相等
+template <class T, class U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&) noexcept {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&) noexcept {
+    return false;
+}
+
+template <class T>
+struct is_trivially_relocatable<pool_allocator<T>> : std::true_type {};
+
+/*****************************************************************************************/
+// default_node_allocator
+// list、map、set、unordered_map 等节点容器默认的分配器，节点与哨兵由它 rebind 得到
+/*****************************************************************************************/
+template <class T>
+struct default_node_allocator {
+#if MYSTL_NODE_POOL
+    typedef MySTL::pool_allocator<T> type;
+#else
+    typedef MySTL::allocator<T> type;
+#endif
+};
+
+}  // namespace MySTL
+#endif
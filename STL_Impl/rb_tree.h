@@ -620,9 +620,9 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 }
 
 // 模板类 rb_tree
-// 参数一代表数据类型，参数二代表键值比较类型
-template <class T, class Compare>
-class rb_tree {
+// 参数一代表数据类型，参数二代表键值比较类型，参数三代表分配器类型
+template <class T, class Compare, class Alloc = typename default_node_allocator<T>::type>
+class rb_tree : private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<rb_tree_node<T>>> {
    public:
     // rb_tree 的嵌套型别定义
     typedef rb_tree_traits<T> tree_traits;
@@ -637,24 +637,26 @@ class rb_tree {
     typedef typename tree_traits::value_type value_type;
     typedef Compare key_compare;
 
-    typedef MySTL::allocator<T> allocator_type;
-    typedef MySTL::allocator<T> data_allocator;
-    typedef MySTL::allocator<base_type> base_allocator;
-    typedef MySTL::allocator<node_type> node_allocator;
+    typedef Alloc allocator_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<base_type> base_allocator;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<node_type> node_allocator;
+    typedef MySTL::allocator_traits<base_allocator> base_alloc_traits;
+    typedef MySTL::allocator_traits<node_allocator> node_alloc_traits;
+    typedef MySTL::alloc_holder<node_allocator> holder_type;
 
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
 
     typedef rb_tree_iterator<T> iterator;
     typedef rb_tree_const_iterator<T> const_iterator;
     typedef MySTL::reverse_iterator<iterator> reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() const { return node_allocator(); }
+    allocator_type get_allocator() const { return allocator_type(this->get_alloc()); }
     key_compare key_comp() const { return key_comp_; }
 
    private:
@@ -672,13 +674,17 @@ class rb_tree {
    public:
     // 构造、复制、析构函数
     rb_tree() { rb_tree_init(); }
+    explicit rb_tree(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : holder_type(node_allocator(alloc)), key_comp_(comp) { rb_tree_init(); }
+    explicit rb_tree(const allocator_type& alloc) : holder_type(node_allocator(alloc)) { rb_tree_init(); }
     rb_tree(const rb_tree& rhs);
+    rb_tree(const rb_tree& rhs, const allocator_type& alloc);
     rb_tree(rb_tree&& rhs) noexcept;
 
     rb_tree& operator=(const rb_tree& rhs);
     rb_tree& operator=(rb_tree&& rhs);
 
-    ~rb_tree() { clear(); }
+    ~rb_tree() { tidy(); }
 
    public:
     // 迭代器相关操作
@@ -731,10 +737,7 @@ class rb_tree {
 
     template <class InputIterator>
     void insert_multi(InputIterator first, InputIterator last) {
-        size_type n = MySTL::distance(first, last);
-        THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
-        for (; n > 0; --n, ++first)
-            insert_multi(end(), *first);
+        copy_insert_multi(first, last, iterator_category(first));
     }
 
     MySTL::pair<iterator, bool> insert_unique(const value_type& value);
@@ -751,10 +754,7 @@ class rb_tree {
 
     template <class InputIterator>
     void insert_unique(InputIterator first, InputIterator last) {
-        size_type n = MySTL::distance(first, last);
-        THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
-        for (; n > 0; --n, ++first)
-            insert_unique(end(), *first);
+        copy_insert_unique(first, last, iterator_category(first));
     }
 
     // erase
@@ -814,9 +814,11 @@ class rb_tree {
     node_ptr clone_node(base_ptr x);
     void destroy_node(node_ptr p);
 
-    // init / reset
+    // init / reset / tidy
     void rb_tree_init();
     void reset();
+    void tidy();
+    void copy_tree(const rb_tree& rhs);
 
     // get insert pos
     MySTL::pair<base_ptr, bool>
@@ -832,6 +834,25 @@ class rb_tree {
     iterator insert_multi_use_hint(iterator hint, key_type key, node_ptr node);
     iterator insert_unique_use_hint(iterator hint, key_type key, node_ptr node);
 
+    // insert range
+    template <class InputIter>
+    void copy_insert_multi(InputIter first, InputIter last, MySTL::input_iterator_tag);
+    template <class ForwardIter>
+    void copy_insert_multi(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag);
+    template <class InputIter>
+    void copy_insert_unique(InputIter first, InputIter last, MySTL::input_iterator_tag);
+    template <class ForwardIter>
+    void copy_insert_unique(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag);
+
+    // build from sorted range
+    template <class ForwardIter>
+    size_type sorted_distinct_count(ForwardIter first, ForwardIter last) const;
+    template <class ForwardIter>
+    void build_from_sorted(ForwardIter first, size_type n, bool unique);
+    template <class ForwardIter>
+    base_ptr build_subtree(ForwardIter& first, size_type n, size_type depth,
+                           size_type red_depth, bool unique, base_ptr& prev);
+
     // copy tree / erase tree
     base_ptr copy_from(base_ptr x, base_ptr p);
     void erase_since(base_ptr x);
@@ -839,67 +860,82 @@ class rb_tree {
 
 /*****************************************************************************************/
 // 复制构造函数
-template <class T, class Compare>
-rb_tree<T, Compare>::
-    rb_tree(const rb_tree& rhs) {
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
+    rb_tree(const rb_tree& rhs)
+    : holder_type(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())),
+      key_comp_(rhs.key_comp_) {
     rb_tree_init();
-    if (rhs.node_count_ != 0) {
-        root() = copy_from(rhs.root(), header_);
-        leftmost() = rb_tree_min(root());
-        rightmost() = rb_tree_max(root());
-    }
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
+    copy_tree(rhs);
+}
+
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
+    rb_tree(const rb_tree& rhs, const allocator_type& alloc)
+    : holder_type(node_allocator(alloc)),
+      key_comp_(rhs.key_comp_) {
+    rb_tree_init();
+    copy_tree(rhs);
 }
 
 // 移动构造函数
-template <class T, class Compare>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::
     rb_tree(rb_tree&& rhs) noexcept
-    : header_(MySTL::move(rhs.header_)),
+    : holder_type(MySTL::move(rhs.get_alloc())),
+      header_(MySTL::move(rhs.header_)),
       node_count_(rhs.node_count_),
       key_comp_(rhs.key_comp_) {
     rhs.reset();
 }
 
 // 复制赋值操作符
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>&
+rb_tree<T, Compare, Alloc>::
 operator=(const rb_tree& rhs) {
     if (this != &rhs) {
-        clear();
-
-        if (rhs.node_count_ != 0) {
-            root() = copy_from(rhs.root(), header_);
-            leftmost() = rb_tree_min(root());
-            rightmost() = rb_tree_max(root());
+        if (node_alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的节点必须由原来的分配器释放
+            tidy();
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+            rb_tree_init();
         }
-
-        node_count_ = rhs.node_count_;
+        clear();
+        copy_tree(rhs);
         key_comp_ = rhs.key_comp_;
     }
     return *this;
 }
 
 // 移动赋值操作符
-template <class T, class Compare>
-rb_tree<T, Compare>&
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>&
+rb_tree<T, Compare, Alloc>::
 operator=(rb_tree&& rhs) {
-    clear();
-    header_ = MySTL::move(rhs.header_);
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
-    rhs.reset();
+    if (node_alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+        tidy();
+        MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+        header_ = MySTL::move(rhs.header_);
+        node_count_ = rhs.node_count_;
+        key_comp_ = rhs.key_comp_;
+        rhs.reset();
+    } else {
+        // 分配器不相等，不能直接接管对方的节点
+        clear();
+        key_comp_ = rhs.key_comp_;
+        for (auto it = rhs.begin(); it != rhs.end(); ++it)
+            emplace_multi_use_hint(end(), MySTL::move(*it));
+        rhs.clear();
+    }
     return *this;
 }
 
 // 就地插入元素，键值允许重复
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     emplace_multi(Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
@@ -908,10 +944,10 @@ rb_tree<T, Compare>::
 }
 
 // 就地插入元素，键值不允许重复
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-MySTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::
+MySTL::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::
     emplace_unique(Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
@@ -924,10 +960,10 @@ rb_tree<T, Compare>::
 }
 
 // 就地插入元素，键值允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     emplace_multi_use_hint(iterator hint, Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
@@ -954,10 +990,10 @@ rb_tree<T, Compare>::
 }
 
 // 就地插入元素，键值不允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     emplace_unique_use_hint(iterator hint, Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(MySTL::forward<Args>(args)...);
@@ -992,9 +1028,9 @@ rb_tree<T, Compare>::
 }
 
 // 插入元素，节点键值允许重复
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     insert_multi(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     auto res = get_insert_multi_pos(value_traits::get_key(value));
@@ -1002,9 +1038,9 @@ rb_tree<T, Compare>::
 }
 
 // 插入新值，节点键值不允许重复，返回一个 pair，若插入成功，pair 的第二参数为 true，否则为 false
-template <class T, class Compare>
-MySTL::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+MySTL::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::
     insert_unique(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T, Comp>'s size too big");
     auto res = get_insert_unique_pos(value_traits::get_key(value));
@@ -1015,9 +1051,9 @@ rb_tree<T, Compare>::
 }
 
 // 删除 hint 位置的节点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     erase(iterator hint) {
     auto node = hint.node->get_node_ptr();
     iterator next(node);
@@ -1030,9 +1066,9 @@ rb_tree<T, Compare>::
 }
 
 // 删除键值等于 key 的元素，返回删除的个数
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
     erase_multi(const key_type& key) {
     auto p = equal_range_multi(key);
     size_type n = MySTL::distance(p.first, p.second);
@@ -1041,9 +1077,9 @@ rb_tree<T, Compare>::
 }
 
 // 删除键值等于 key 的元素，返回删除的个数
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
     erase_unique(const key_type& key) {
     auto it = find(key);
     if (it != end()) {
@@ -1054,8 +1090,8 @@ rb_tree<T, Compare>::
 }
 
 // 删除[first, last)区间内的元素
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
     erase(iterator first, iterator last) {
     if (first == begin() && last == end()) {
         clear();
@@ -1066,8 +1102,8 @@ void rb_tree<T, Compare>::
 }
 
 // 清空 rb tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
     clear() {
     if (node_count_ != 0) {
         erase_since(root());
@@ -1079,9 +1115,9 @@ void rb_tree<T, Compare>::
 }
 
 // 查找键值为 k 的节点，返回指向它的迭代器
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     find(const key_type& key) {
     auto y = header_;  // 最后一个不小于 key 的节点
     auto x = root();
@@ -1096,9 +1132,9 @@ rb_tree<T, Compare>::
     return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
     find(const key_type& key) const {
     auto y = header_;  // 最后一个不小于 key 的节点
     auto x = root();
@@ -1114,9 +1150,9 @@ rb_tree<T, Compare>::
 }
 
 // 键值不小于 key 的第一个位置
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     lower_bound(const key_type& key) {
     auto y = header_;
     auto x = root();
@@ -1130,9 +1166,9 @@ rb_tree<T, Compare>::
     return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
     lower_bound(const key_type& key) const {
     auto y = header_;
     auto x = root();
@@ -1147,9 +1183,9 @@ rb_tree<T, Compare>::
 }
 
 // 键值不小于 key 的最后一个位置
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     upper_bound(const key_type& key) {
     auto y = header_;
     auto x = root();
@@ -1163,9 +1199,9 @@ rb_tree<T, Compare>::
     return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::
     upper_bound(const key_type& key) const {
     auto y = header_;
     auto x = root();
@@ -1180,10 +1216,11 @@ rb_tree<T, Compare>::
 }
 
 // 交换 rb tree
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
     swap(rb_tree& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
         MySTL::swap(header_, rhs.header_);
         MySTL::swap(node_count_, rhs.node_count_);
         MySTL::swap(key_comp_, rhs.key_comp_);
@@ -1193,28 +1230,28 @@ void rb_tree<T, Compare>::
 /*****************************************************************************************/
 // helper function
 // 创建一个结点
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::
     create_node(Args&&... args) {
-    auto tmp = node_allocator::allocate(1);
+    auto tmp = node_alloc_traits::allocate(this->get_alloc(), 1);
     try {
-        data_allocator::construct(MySTL::address_of(tmp->value), MySTL::forward<Args>(args)...);
+        node_alloc_traits::construct(this->get_alloc(), MySTL::address_of(tmp->value), MySTL::forward<Args>(args)...);
         tmp->left = nullptr;
         tmp->right = nullptr;
         tmp->parent = nullptr;
     } catch (...) {
-        node_allocator::deallocate(tmp);
+        node_alloc_traits::deallocate(this->get_alloc(), tmp, 1);
         throw;
     }
     return tmp;
 }
 
 // 复制一个结点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::
     clone_node(base_ptr x) {
     node_ptr tmp = create_node(x->get_node_ptr()->value);
     tmp->color = x->color;
@@ -1224,18 +1261,19 @@ rb_tree<T, Compare>::
 }
 
 // 销毁一个结点
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
     destroy_node(node_ptr p) {
-    data_allocator::destroy(&p->value);
-    node_allocator::deallocate(p);
+    node_alloc_traits::destroy(this->get_alloc(), &p->value);
+    node_alloc_traits::deallocate(this->get_alloc(), p, 1);
 }
 
 // 初始化容器
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
     rb_tree_init() {
-    header_ = base_allocator::allocate(1);
+    base_allocator base_alloc(this->get_alloc());
+    header_ = base_alloc_traits::allocate(base_alloc, 1);
     header_->color = rb_tree_red;  // header_ 节点颜色为红，与 root 区分
     root() = nullptr;
     leftmost() = header_;
@@ -1244,16 +1282,40 @@ void rb_tree<T, Compare>::
 }
 
 // reset 函数
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset() {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::reset() {
     header_ = nullptr;
     node_count_ = 0;
 }
 
+// tidy 函数
+// 销毁所有节点并释放 header_
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::tidy() {
+    if (header_) {
+        clear();
+        base_allocator base_alloc(this->get_alloc());
+        base_alloc_traits::deallocate(base_alloc, header_, 1);
+        header_ = nullptr;
+    }
+}
+
+// copy_tree 函数
+// 复制 rhs 的所有节点，调用前容器必须为空
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::copy_tree(const rb_tree& rhs) {
+    if (rhs.node_count_ != 0) {
+        root() = copy_from(rhs.root(), header_);
+        leftmost() = rb_tree_min(root());
+        rightmost() = rb_tree_max(root());
+    }
+    node_count_ = rhs.node_count_;
+}
+
 // get_insert_multi_pos 函数
-template <class T, class Compare>
-MySTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
+template <class T, class Compare, class Alloc>
+MySTL::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>
+rb_tree<T, Compare, Alloc>::get_insert_multi_pos(const key_type& key) {
     auto x = root();
     auto y = header_;
     bool add_to_left = true;
@@ -1266,9 +1328,9 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
 }
 
 // get_insert_unique_pos 函数
-template <class T, class Compare>
-MySTL::pair<MySTL::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {  // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
+template <class T, class Compare, class Alloc>
+MySTL::pair<MySTL::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc>::get_insert_unique_pos(const key_type& key) {  // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
     // 第二个值为一个 bool，表示是否插入成功
     auto x = root();
     auto y = header_;
@@ -1295,9 +1357,9 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {  // 返回一
 
 // insert_value_at 函数
 // x 为插入点的父节点， value 为要插入的值，add_to_left 表示是否在左边插入
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     insert_value_at(base_ptr x, const value_type& value, bool add_to_left) {
     node_ptr node = create_node(value);
     node->parent = x;
@@ -1322,9 +1384,9 @@ rb_tree<T, Compare>::
 
 // 在 x 节点处插入新的节点
 // x 为插入点的父节点， node 为要插入的节点，add_to_left 表示是否在左边插入
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     insert_node_at(base_ptr x, node_ptr node, bool add_to_left) {
     node->parent = x;
     auto base_node = node->get_base_ptr();
@@ -1347,9 +1409,9 @@ rb_tree<T, Compare>::
 }
 
 // 插入元素，键值允许重复，使用 hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
     // 在 hint 附近寻找可插入的位置
     auto np = hint.node;
@@ -1369,9 +1431,9 @@ rb_tree<T, Compare>::
 }
 
 // 插入元素，键值不允许重复，使用 hint
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::
     insert_unique_use_hint(iterator hint, key_type key, node_ptr node) {
     // 在 hint 附近寻找可插入的位置
     auto np = hint.node;
@@ -1396,9 +1458,9 @@ rb_tree<T, Compare>::
 
 // copy_from 函数
 // 递归复制一颗树，节点从 x 开始，p 为 x 的父节点
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr
-rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::copy_from(base_ptr x, base_ptr p) {
     auto top = clone_node(x);
     top->parent = p;
     try {
@@ -1422,10 +1484,143 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
     return top;
 }
 
+// copy_insert_multi 函数
+// 输入迭代器只能遍历一次，逐个插入
+template <class T, class Compare, class Alloc>
+template <class InputIter>
+void rb_tree<T, Compare, Alloc>::
+    copy_insert_multi(InputIter first, InputIter last, MySTL::input_iterator_tag) {
+    for (; first != last; ++first)
+        insert_multi(end(), *first);
+}
+
+// 空树插入已排序的区间时自底向上建树，否则逐个插入
+template <class T, class Compare, class Alloc>
+template <class ForwardIter>
+void rb_tree<T, Compare, Alloc>::
+    copy_insert_multi(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag) {
+    size_type n = MySTL::distance(first, last);
+    THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+    if (node_count_ == 0 && n != 0 && sorted_distinct_count(first, last) != 0) {
+        build_from_sorted(first, n, false);
+        return;
+    }
+    for (; n > 0; --n, ++first)
+        insert_multi(end(), *first);
+}
+
+// copy_insert_unique 函数
+template <class T, class Compare, class Alloc>
+template <class InputIter>
+void rb_tree<T, Compare, Alloc>::
+    copy_insert_unique(InputIter first, InputIter last, MySTL::input_iterator_tag) {
+    for (; first != last; ++first)
+        insert_unique(end(), *first);
+}
+
+// 键值相同的元素只保留第一个，与逐个插入的结果一致
+template <class T, class Compare, class Alloc>
+template <class ForwardIter>
+void rb_tree<T, Compare, Alloc>::
+    copy_insert_unique(ForwardIter first, ForwardIter last, MySTL::forward_iterator_tag) {
+    size_type n = MySTL::distance(first, last);
+    THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "rb_tree<T, Comp>'s size too big");
+    if (node_count_ == 0 && n != 0) {
+        const size_type distinct = sorted_distinct_count(first, last);
+        if (distinct != 0) {
+            build_from_sorted(first, distinct, true);
+            return;
+        }
+    }
+    for (; n > 0; --n, ++first)
+        insert_unique(end(), *first);
+}
+
+// sorted_distinct_count 函数
+// 若非空区间 [first, last) 按键值非降序排列，返回其中不同键值的个数，否则返回 0
+template <class T, class Compare, class Alloc>
+template <class ForwardIter>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::
+    sorted_distinct_count(ForwardIter first, ForwardIter last) const {
+    size_type distinct = 1;
+    auto prev = first;
+    for (++first; first != last; prev = first, ++first) {
+        if (key_comp_(value_traits::get_key(*first), value_traits::get_key(*prev)))
+            return 0;
+        if (key_comp_(value_traits::get_key(*prev), value_traits::get_key(*first)))
+            ++distinct;
+    }
+    return distinct;
+}
+
+// build_from_sorted 函数
+// 由已排序的区间建立一棵平衡树，每个节点只创建一次，不做任何旋转，调用前容器必须为空
+// 除最后一层未满时该层的节点为红色外，其余节点均为黑色，因此每条路径上的黑色节点数相同
+template <class T, class Compare, class Alloc>
+template <class ForwardIter>
+void rb_tree<T, Compare, Alloc>::
+    build_from_sorted(ForwardIter first, size_type n, bool unique) {
+    size_type red_depth = 0;  // 最后一层（可能未满）的深度
+    for (size_type m = n; m > 1; m /= 2)
+        ++red_depth;
+    if (n + 1 == (static_cast<size_type>(1) << (red_depth + 1)))
+        ++red_depth;  // 满二叉树没有红色节点
+    base_ptr prev = nullptr;
+    root() = build_subtree(first, n, 0, red_depth, unique, prev);
+    root()->parent = header_;
+    leftmost() = rb_tree_min(root());
+    rightmost() = rb_tree_max(root());
+    node_count_ = n;
+}
+
+// build_subtree 函数
+// 按中序取用 first 之后的 n 个元素建立子树，depth 为子树根节点的深度，prev 为上一个建立的节点
+// unique 为 true 时跳过与 prev 键值相同的元素
+template <class T, class Compare, class Alloc>
+template <class ForwardIter>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::
+    build_subtree(ForwardIter& first, size_type n, size_type depth,
+                  size_type red_depth, bool unique, base_ptr& prev) {
+    if (n == 0)
+        return nullptr;
+    const size_type left_n = (n - 1) / 2;
+    base_ptr left = build_subtree(first, left_n, depth + 1, red_depth, unique, prev);
+    if (unique && prev != nullptr) {
+        while (!key_comp_(value_traits::get_key(prev->get_node_ptr()->value),
+                          value_traits::get_key(*first)))
+            ++first;
+    }
+    node_ptr np = nullptr;
+    try {
+        np = create_node(*first);
+    } catch (...) {
+        erase_since(left);
+        throw;
+    }
+    ++first;
+    base_ptr x = np->get_base_ptr();
+    x->color = depth == red_depth ? rb_tree_red : rb_tree_black;
+    x->left = left;
+    if (left != nullptr)
+        left->parent = x;
+    prev = x;
+    try {
+        x->right = build_subtree(first, n - 1 - left_n, depth + 1, red_depth, unique, prev);
+    } catch (...) {
+        erase_since(x);
+        throw;
+    }
+    if (x->right != nullptr)
+        x->right->parent = x;
+    return x;
+}
+
 // erase_since 函数
 // 从 x 节点开始删除该节点及其子树
-template <class T, class Compare>
-void rb_tree<T, Compare>::
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::
     erase_since(base_ptr x) {
     while (x != nullptr) {
         erase_since(x->right);
@@ -1436,41 +1631,46 @@ void rb_tree<T, Compare>::
 }
 
 // 重载比较操作符
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator==(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator<(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator!=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator>(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator<=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator>=(const rb_tree<T, Compare, Alloc>& lhs, const rb_tree<T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept {
+template <class T, class Compare, class Alloc>
+void swap(rb_tree<T, Compare, Alloc>& lhs, rb_tree<T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// rb_tree 的 header_ 分配在堆上，比较函数与分配器都可以平凡重定位时 rb_tree 也可以
+template <class T, class Compare, class Alloc>
+struct is_trivially_relocatable<rb_tree<T, Compare, Alloc>>
+    : std::integral_constant<bool, is_trivially_relocatable<Compare>::value && is_trivially_relocatable<Alloc>::value> {};
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -18,8 +18,8 @@
 namespace MySTL {
 
 // 模板类 set，键值不允许重复
-// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 MySTL::less
-template <class Key, class Compare = MySTL::less<Key>>
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 MySTL::less，参数三代表分配器类型
+template <class Key, class Compare = MySTL::less<Key>, class Alloc = typename default_node_allocator<Key>::type>
 class set {
    public:
     typedef Key key_type;
@@ -29,7 +29,7 @@ class set {
 
    private:
     // 以 MySTL::rb_tree 作为底层机制
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -50,16 +50,23 @@ class set {
    public:
     // 构造、复制、移动函数
     set() = default;
+    explicit set(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit set(const allocator_type& alloc)
+        : tree_(alloc) {}
 
     template <class InputIterator>
-    set(InputIterator first, InputIterator last)
-        : tree_() { tree_.insert_unique(first, last); }
-    set(std::initializer_list<value_type> ilist)
-        : tree_() { tree_.insert_unique(ilist.begin(), ilist.end()); }
+    set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(first, last); }
+    set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_unique(ilist.begin(), ilist.end()); }
 
     set(const set& rhs)
         : tree_(rhs.tree_) {
     }
+    set(const set& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {
+    }
     set(set&& rhs) noexcept
         : tree_(MySTL::move(rhs.tree_)) {
     }
@@ -170,46 +177,46 @@ class set {
 };
 
 // 重载比较操作符
-template <class Key, class Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class Key, class Compare>
-void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept {
+template <class Key, class Compare, class Alloc>
+void swap(set<Key, Compare, Alloc>& lhs, set<Key, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 /*****************************************************************************************/
 // 模板类 multiset，键值允许重复
-// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 MySTL::less
-template <class Key, class Compare = MySTL::less<Key>>
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 MySTL::less，参数三代表分配器类型
+template <class Key, class Compare = MySTL::less<Key>, class Alloc = typename default_node_allocator<Key>::type>
 class multiset {
    public:
     typedef Key key_type;
@@ -219,7 +226,7 @@ class multiset {
 
    private:
     // 以 MySTL::rb_tree 作为底层机制
-    typedef MySTL::rb_tree<value_type, key_compare> base_type;
+    typedef MySTL::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;  // 以 rb_tree 表现 multiset
 
    public:
@@ -240,16 +247,23 @@ class multiset {
    public:
     // 构造、复制、移动函数
     multiset() = default;
+    explicit multiset(const key_compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit multiset(const allocator_type& alloc)
+        : tree_(alloc) {}
 
     template <class InputIterator>
-    multiset(InputIterator first, InputIterator last)
-        : tree_() { tree_.insert_multi(first, last); }
-    multiset(std::initializer_list<value_type> ilist)
-        : tree_() { tree_.insert_multi(ilist.begin(), ilist.end()); }
+    multiset(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(first, last); }
+    multiset(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) { tree_.insert_multi(ilist.begin(), ilist.end()); }
 
     multiset(const multiset& rhs)
         : tree_(rhs.tree_) {
     }
+    multiset(const multiset& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {
+    }
     multiset(multiset&& rhs) noexcept
         : tree_(MySTL::move(rhs.tree_)) {
     }
@@ -360,41 +374,59 @@ class multiset {
 };
 
 // 重载比较操作符
-template <class Key, class Compare>
-bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator==(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator!=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class Key, class Compare>
-void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept {
+template <class Key, class Compare, class Alloc>
+void swap(multiset<Key, Compare, Alloc>& lhs, multiset<Key, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// set / multiset 只包含一棵 rb_tree
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<set<Key, Compare, Alloc>> : is_trivially_relocatable<rb_tree<Key, Compare, Alloc>> {};
+
+template <class Key, class Compare, class Alloc>
+struct is_trivially_relocatable<multiset<Key, Compare, Alloc>> : is_trivially_relocatable<rb_tree<Key, Compare, Alloc>> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class Key, class Compare = MySTL::less<Key>>
+using set = MySTL::set<Key, Compare, MySTL::polymorphic_allocator<Key>>;
+
+template <class Key, class Compare = MySTL::less<Key>>
+using multiset = MySTL::multiset<Key, Compare, MySTL::polymorphic_allocator<Key>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -0,0 +1,762 @@
+#ifndef _MYSTL_SMALL_VECTOR_H_
+#define _MYSTL_SMALL_VECTOR_H_
+
+// 这个头文件包含一个模板类 small_vector，接口与 vector 相同，前 N 个元素保存在对象内部
+
+// notes:
+//
+// small_vector<T, N> 在对象内部预留 N 个元素的空间，元素个数不超过 N 时不申请堆内存，
+// 超过 N 时才像 vector 一样向分配器申请缓冲区，此后按 1.5 倍增长；shrink_to_fit 在元素足够少时搬回内部空间
+// 元素可能位于对象内部，移动构造、移动赋值与 swap 在这种情况下要逐个移动元素，迭代器随之失效
+// 同样的原因，small_vector 本身不是可平凡重定位的类型
+//
+// 异常保证：
+// 与 vector 相同，emplace_back、push_back 与需要扩容的 emplace、insert 满足强异常保证，
+// 其余修改操作满足基本异常保证
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace MySTL {
+
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif  // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif  // min
+
+// 模板类: small_vector
+// 模板参数 T 代表数据类型，N 代表内部空间能容纳的元素个数，Alloc 代表溢出到堆上时使用的分配器
+template <class T, size_t N, class Alloc = MySTL::allocator<T>>
+class small_vector : private alloc_holder<Alloc> {
+    static_assert(N > 0, "small_vector<T, N> requires N > 0");
+
+   public:
+    // small_vector 的嵌套型别定义
+    typedef Alloc allocator_type;
+    typedef MySTL::allocator_traits<Alloc> alloc_traits;
+    typedef MySTL::alloc_holder<Alloc> holder_type;
+    typedef typename MySTL::is_trivially_relocatable<T>::type relocate_tag;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef MySTL::reverse_iterator<iterator> reverse_iterator;
+    typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static constexpr size_type inline_capacity = N;
+
+    allocator_type get_allocator() const { return this->get_alloc(); }
+
+   private:
+    iterator begin_;  // 表示目前使用空间的头部
+    iterator end_;    // 表示目前使用空间的尾部
+    iterator cap_;    // 表示目前储存空间的尾部
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buf_;  // 内部空间
+
+   public:
+    // 构造、复制、移动、析构函数
+    small_vector() noexcept { init_inline(); }
+
+    explicit small_vector(const allocator_type& alloc) noexcept : holder_type(alloc) { init_inline(); }
+
+    explicit small_vector(size_type n, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_inline();
+        fill_insert(end_, n, value_type());
+    }
+
+    small_vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_inline();
+        fill_insert(end_, n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    small_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_inline();
+        range_insert(end_, first, last, iterator_category(first));
+    }
+
+    small_vector(const small_vector& rhs)
+        : holder_type(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        init_inline();
+        range_insert(end_, rhs.begin_, rhs.end_, MySTL::forward_iterator_tag{});
+    }
+
+    small_vector(const small_vector& rhs, const allocator_type& alloc)
+        : holder_type(alloc) {
+        init_inline();
+        range_insert(end_, rhs.begin_, rhs.end_, MySTL::forward_iterator_tag{});
+    }
+
+    small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : holder_type(MySTL::move(rhs.get_alloc())) {
+        init_inline();
+        take(rhs);
+    }
+
+    small_vector(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
+        init_inline();
+        range_insert(end_, list.begin(), list.end(), MySTL::forward_iterator_tag{});
+    }
+
+    small_vector& operator=(const small_vector& rhs);
+    small_vector& operator=(small_vector&& rhs);
+
+    small_vector& operator=(std::initializer_list<value_type> list) {
+        assign(list.begin(), list.end());
+        return *this;
+    }
+
+    ~small_vector() {
+        alloc_traits::destroy(this->get_alloc(), begin_, end_);
+        release_heap();
+    }
+
+   public:
+    // 迭代器相关操作
+    iterator begin() noexcept { return begin_; }
+    const_iterator begin() const noexcept { return begin_; }
+
+    iterator end() noexcept { return end_; }
+    const_iterator end() const noexcept { return end_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_iterator crbegin() const noexcept { return rbegin(); }
+    const_iterator crend() const noexcept { return rend(); }
+
+    // 容量相关操作
+    bool empty() const noexcept { return begin_ == end_; }
+    size_type size() const noexcept { return static_cast<size_type>(end_ - begin_); }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+    size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+
+    // 元素是否仍保存在对象内部
+    bool is_inline() const noexcept { return begin_ == inline_data(); }
+
+    void reserve(size_type n);
+    void shrink_to_fit();
+
+    // 访问元素操作
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T, N>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T, N>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    pointer data() noexcept { return begin_; }
+    const_pointer data() const noexcept { return begin_; }
+
+    // 修改容器相关操作
+    // assign
+    void assign(size_type n, const value_type& value);
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        MYSTL_DEBUG(!(last < first));
+        copy_assign(first, last, iterator_category(first));
+    }
+
+    void assign(std::initializer_list<value_type> list) {
+        copy_assign(list.begin(), list.end(), MySTL::forward_iterator_tag{});
+    }
+
+    // emplace / emplace_back
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    template <class... Args>
+    void emplace_back(Args&&... args);
+
+    // push_back / pop_back
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(MySTL::move(value)); }
+
+    void pop_back();
+
+    // insert
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, MySTL::move(value)); }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return fill_insert(const_cast<iterator>(pos), n, value);
+    }
+
+    template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
+        return range_insert(const_cast<iterator>(pos), first, last, iterator_category(first));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
+        return insert(pos, list.begin(), list.end());
+    }
+
+    // erase / clear
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear() { erase(begin(), end()); }
+
+    // resize / reverse
+    void resize(size_type new_size) { return resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value);
+
+    void reverse() { MySTL::reverse(begin(), end()); }
+
+    // swap
+    void swap(small_vector& rhs);
+
+   private:
+    // helper functions
+
+    // 内部空间
+    pointer inline_data() noexcept { return reinterpret_cast<pointer>(&buf_); }
+    const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(&buf_); }
+
+    // initialize / destroy
+    void init_inline() noexcept;
+    void release_heap() noexcept;
+    void take(small_vector& rhs);
+
+    // calculate the growth size
+    size_type get_new_cap(size_type add_size);
+
+    // assign
+    template <class Iter>
+    void copy_assign(Iter first, Iter last, input_iterator_tag);
+
+    template <class Iter>
+    void copy_assign(Iter first, Iter last, forward_iterator_tag);
+
+    // insert
+    iterator fill_insert(iterator pos, size_type n, const value_type& value);
+
+    template <class Iter>
+    iterator range_insert(iterator pos, Iter first, Iter last, input_iterator_tag);
+
+    template <class Iter>
+    iterator range_insert(iterator pos, Iter first, Iter last, forward_iterator_tag);
+
+    // relocate
+    void relocate_to(iterator new_begin, size_type new_cap, iterator pos, size_type n);
+};
+
+template <class T, size_t N, class Alloc>
+constexpr typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::inline_capacity;
+
+/*****************************************************************************************/
+
+// 复制赋值操作符
+template <class T, size_t N, class Alloc>
+small_vector<T, N, Alloc>& small_vector<T, N, Alloc>::operator=(const small_vector& rhs) {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的堆空间必须由原来的分配器释放
+            clear();
+            release_heap();
+            init_inline();
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        }
+        copy_assign(rhs.begin_, rhs.end_, MySTL::forward_iterator_tag{});
+    }
+    return *this;
+}
+
+// 移动赋值操作符
+template <class T, size_t N, class Alloc>
+small_vector<T, N, Alloc>& small_vector<T, N, Alloc>::operator=(small_vector&& rhs) {
+    if (this != &rhs) {
+        clear();
+        if (alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+            release_heap();
+            init_inline();
+            MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+            take(rhs);
+        } else {
+            // 分配器不相等，不能直接接管对方的空间，只能逐个移动元素
+            reserve(rhs.size());
+            for (auto& value : rhs)
+                emplace_back(MySTL::move(value));
+            rhs.clear();
+        }
+    }
+    return *this;
+}
+
+// 预留空间大小，当原容量小于要求大小时，才会把元素搬到新申请的堆空间
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::reserve(size_type n) {
+    if (capacity() < n) {
+        THROW_LENGTH_ERROR_IF(n > max_size(),
+                              "n can not larger than max_size() in small_vector<T, N>::reserve(n)");
+        auto tmp = alloc_traits::allocate(this->get_alloc(), n);
+        try {
+            relocate_to(tmp, n, end_, 0);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), tmp, n);
+            throw;
+        }
+    }
+}
+
+// 放弃多余的容量，元素个数不超过 N 时搬回内部空间
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::shrink_to_fit() {
+    if (is_inline() || end_ == cap_) return;
+    if (size() <= N) {
+        relocate_to(inline_data(), N, end_, 0);
+        return;
+    }
+    const size_type len = size();
+    auto tmp = alloc_traits::allocate(this->get_alloc(), len);
+    try {
+        relocate_to(tmp, len, end_, 0);
+    } catch (...) {
+        alloc_traits::deallocate(this->get_alloc(), tmp, len);
+        throw;
+    }
+}
+
+// 在 pos 位置就地构造元素
+template <class T, size_t N, class Alloc>
+template <class... Args>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::emplace(const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    iterator xpos = const_cast<iterator>(pos);
+    const size_type n = xpos - begin_;
+
+    if (end_ != cap_ && xpos == end_) {
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
+        ++end_;
+    } else if (end_ != cap_ && relocate_tag::value) {
+        // 先在临时空间构造新元素，args 可能引用容器中的元素，再把 [xpos, end_) 整体后移一格
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T* tmp = reinterpret_cast<T*>(&buf);
+        alloc_traits::construct(this->get_alloc(), tmp, MySTL::forward<Args>(args)...);
+        MySTL::uninitialized_relocate(xpos, end_, xpos + 1);
+        MySTL::uninitialized_relocate(tmp, tmp + 1, xpos);
+        ++end_;
+    } else if (end_ != cap_) {
+        value_type tmp(MySTL::forward<Args>(args)...);
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), MySTL::move(*(end_ - 1)));
+        ++end_;
+        MySTL::move_backward(xpos, end_ - 2, end_ - 1);
+        *xpos = MySTL::move(tmp);
+    } else {
+        // 先在新空间构造新元素，再搬运原有元素，构造失败时容器保持不变
+        const auto new_cap = get_new_cap(1);
+        auto new_begin = alloc_traits::allocate(this->get_alloc(), new_cap);
+        try {
+            alloc_traits::construct(this->get_alloc(), new_begin + n, MySTL::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_cap);
+            throw;
+        }
+        try {
+            relocate_to(new_begin, new_cap, xpos, 1);
+        } catch (...) {
+            alloc_traits::destroy(this->get_alloc(), new_begin + n);
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_cap);
+            throw;
+        }
+    }
+    return begin_ + n;
+}
+
+// 在尾部就地构造元素
+template <class T, size_t N, class Alloc>
+template <class... Args>
+void small_vector<T, N, Alloc>::emplace_back(Args&&... args) {
+    if (end_ < cap_) {
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
+        ++end_;
+    } else {
+        emplace(end_, MySTL::forward<Args>(args)...);
+    }
+}
+
+// 弹出尾部元素
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    alloc_traits::destroy(this->get_alloc(), end_ - 1);
+    --end_;
+}
+
+// 删除 pos 位置上的元素
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator small_vector<T, N, Alloc>::erase(const_iterator pos) {
+    MYSTL_DEBUG(pos >= begin() && pos < end());
+    return erase(pos, pos + 1);
+}
+
+// 删除[first, last)上的元素
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::erase(const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+    iterator r = begin_ + (first - begin());
+    if (relocate_tag::value) {
+        alloc_traits::destroy(this->get_alloc(), r, r + (last - first));
+        MySTL::uninitialized_relocate(r + (last - first), end_, r);
+    } else {
+        alloc_traits::destroy(this->get_alloc(), MySTL::move(r + (last - first), end_, r), end_);
+    }
+    end_ = end_ - (last - first);
+    return r;
+}
+
+// 重置容器大小
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::resize(size_type new_size, const value_type& value) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        fill_insert(end_, new_size - size(), value);
+    }
+}
+
+// 与另一个 small_vector 交换，两者都在堆上时只交换指针，否则逐个移动元素
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::swap(small_vector& rhs) {
+    if (this == &rhs) return;
+    if (!is_inline() && !rhs.is_inline()) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
+        MySTL::swap(begin_, rhs.begin_);
+        MySTL::swap(end_, rhs.end_);
+        MySTL::swap(cap_, rhs.cap_);
+        return;
+    }
+    small_vector tmp(MySTL::move(rhs));
+    rhs = MySTL::move(*this);
+    *this = MySTL::move(tmp);
+}
+
+/*****************************************************************************************/
+// helper function
+
+// init_inline 函数，使用内部空间
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::init_inline() noexcept {
+    begin_ = inline_data();
+    end_ = begin_;
+    cap_ = begin_ + N;
+}
+
+// release_heap 函数，元素已经析构或搬走，只释放堆空间
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::release_heap() noexcept {
+    if (!is_inline())
+        alloc_traits::deallocate(this->get_alloc(), begin_, cap_ - begin_);
+}
+
+// take 函数，当前容器为空且使用内部空间，接管 rhs 的元素，rhs 随后为空
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::take(small_vector& rhs) {
+    if (!rhs.is_inline()) {
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.init_inline();
+        return;
+    }
+    end_ = MySTL::uninitialized_relocate(rhs.begin_, rhs.end_, begin_);
+    rhs.end_ = rhs.begin_;
+}
+
+// get_new_cap 函数
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::get_new_cap(size_type add_size) {
+    const auto old_size = capacity();
+    THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size, "small_vector<T, N>'s size is too big!");
+    if (old_size > max_size() - old_size / 2) return old_size + add_size;
+    return MySTL::max(old_size + old_size / 2, size() + add_size);
+}
+
+// copy_assign 函数
+template <class T, size_t N, class Alloc>
+template <class Iter>
+void small_vector<T, N, Alloc>::copy_assign(Iter first, Iter last, input_iterator_tag) {
+    auto cur = begin_;
+    for (; first != last && cur != end_; ++first, ++cur) {
+        *cur = *first;
+    }
+    if (first == last) {
+        erase(cur, end_);
+    } else {
+        range_insert(end_, first, last, input_iterator_tag{});
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class Iter>
+void small_vector<T, N, Alloc>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
+    const size_type len = MySTL::distance(first, last);
+    if (size() >= len) {
+        auto new_end = MySTL::copy(first, last, begin_);
+        alloc_traits::destroy(this->get_alloc(), new_end, end_);
+        end_ = new_end;
+    } else {
+        auto mid = first;
+        MySTL::advance(mid, size());
+        MySTL::copy(first, mid, begin_);
+        range_insert(end_, mid, last, forward_iterator_tag{});
+    }
+}
+
+// assign 函数
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::assign(size_type n, const value_type& value) {
+    if (n > size()) {
+        MySTL::fill(begin(), end(), value);
+        fill_insert(end_, n - size(), value);
+    } else {
+        erase(MySTL::fill_n(begin_, n, value), end_);
+    }
+}
+
+// fill_insert 函数
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::fill_insert(iterator pos, size_type n, const value_type& value) {
+    const size_type xpos = pos - begin_;
+    if (n == 0) return pos;
+    const value_type value_copy = value;
+
+    if (static_cast<size_type>(cap_ - end_) >= n) {
+        // 如果备用空间大于等于增加的空间
+        const size_type after_elems = end_ - pos;
+        auto old_end = end_;
+        if (relocate_tag::value) {
+            MySTL::uninitialized_relocate(pos, end_, pos + n);
+            try {
+                MySTL::uninitialized_fill_n(pos, n, value_copy);
+            } catch (...) {
+                MySTL::uninitialized_relocate(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
+            MySTL::uninitialized_move(end_ - n, end_, end_);
+            end_ += n;
+            MySTL::move_backward(pos, old_end - n, old_end);
+            MySTL::fill_n(pos, n, value_copy);
+        } else {
+            end_ = MySTL::uninitialized_fill_n(end_, n - after_elems, value_copy);
+            end_ = MySTL::uninitialized_move(pos, old_end, end_);
+            MySTL::fill_n(pos, after_elems, value_copy);
+        }
+    } else {
+        // 如果备用空间不足，先在新空间填充新元素，再搬运原有元素
+        const auto new_cap = get_new_cap(n);
+        auto new_begin = alloc_traits::allocate(this->get_alloc(), new_cap);
+        try {
+            MySTL::uninitialized_fill_n(new_begin + xpos, n, value_copy);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_cap);
+            throw;
+        }
+        try {
+            relocate_to(new_begin, new_cap, pos, n);
+        } catch (...) {
+            alloc_traits::destroy(this->get_alloc(), new_begin + xpos, new_begin + xpos + n);
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_cap);
+            throw;
+        }
+    }
+    return begin_ + xpos;
+}
+
+// range_insert 函数，输入迭代器只能逐个插入
+template <class T, size_t N, class Alloc>
+template <class Iter>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::range_insert(iterator pos, Iter first, Iter last, input_iterator_tag) {
+    const size_type xpos = pos - begin_;
+    for (size_type i = xpos; first != last; ++first, ++i)
+        emplace(begin_ + i, *first);
+    return begin_ + xpos;
+}
+
+template <class T, size_t N, class Alloc>
+template <class Iter>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::range_insert(iterator pos, Iter first, Iter last, forward_iterator_tag) {
+    const size_type xpos = pos - begin_;
+    if (first == last) return pos;
+    const size_type n = MySTL::distance(first, last);
+
+    if (static_cast<size_type>(cap_ - end_) >= n) {
+        // 如果备用空间大小足够
+        const size_type after_elems = end_ - pos;
+        auto old_end = end_;
+        if (relocate_tag::value) {
+            MySTL::uninitialized_relocate(pos, end_, pos + n);
+            try {
+                MySTL::uninitialized_copy(first, last, pos);
+            } catch (...) {
+                MySTL::uninitialized_relocate(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
+            end_ = MySTL::uninitialized_move(end_ - n, end_, end_);
+            MySTL::move_backward(pos, old_end - n, old_end);
+            MySTL::copy(first, last, pos);
+        } else {
+            auto mid = first;
+            MySTL::advance(mid, after_elems);
+            end_ = MySTL::uninitialized_copy(mid, last, end_);
+            end_ = MySTL::uninitialized_move(pos, old_end, end_);
+            MySTL::copy(first, mid, pos);
+        }
+    } else {
+        // 备用空间不足
+        const auto new_cap = get_new_cap(n);
+        auto new_begin = alloc_traits::allocate(this->get_alloc(), new_cap);
+        try {
+            MySTL::uninitialized_copy(first, last, new_begin + xpos);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_cap);
+            throw;
+        }
+        try {
+            relocate_to(new_begin, new_cap, pos, n);
+        } catch (...) {
+            alloc_traits::destroy(this->get_alloc(), new_begin + xpos, new_begin + xpos + n);
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_cap);
+            throw;
+        }
+    }
+    return begin_ + xpos;
+}
+
+// relocate_to 函数
+// 把原有元素搬到 new_begin 开始的空间，在 pos 对应的位置留出 n 个由调用者构造好的元素，随后释放旧的堆空间
+// new_begin 可以是内部空间，此时当前元素一定位于堆上；搬运失败时原有元素保持不变
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::relocate_to(iterator new_begin, size_type new_cap, iterator pos, size_type n) {
+    const size_type before = pos - begin_;
+    const size_type old_size = size();
+    if (relocate_tag::value) {
+        MySTL::uninitialized_relocate(begin_, pos, new_begin);
+        MySTL::uninitialized_relocate(pos, end_, new_begin + before + n);
+    } else {
+        auto mid = MySTL::uninitialized_move(begin_, pos, new_begin);
+        try {
+            MySTL::uninitialized_move(pos, end_, mid + n);
+        } catch (...) {
+            alloc_traits::destroy(this->get_alloc(), new_begin, mid);
+            throw;
+        }
+        alloc_traits::destroy(this->get_alloc(), begin_, end_);
+    }
+    release_heap();
+    begin_ = new_begin;
+    end_ = new_begin + old_size + n;
+    cap_ = new_begin + new_cap;
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+template <class T, size_t N, class Alloc>
+bool operator==(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator!=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, size_t N, class Alloc>
+void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace MySTL
+#endif
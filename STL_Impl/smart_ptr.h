@@ -0,0 +1,900 @@
+#ifndef _MYSTL_SMART_PTR_H_
+#define _MYSTL_SMART_PTR_H_
+
+// 这个头文件包含智能指针 unique_ptr、shared_ptr、weak_ptr，以及 make_unique、make_shared、allocate_shared
+// unique_ptr               : 独占所有权，只能移动，删除器为空类时大小与一个指针相同，支持数组
+// shared_ptr               : 共享所有权，引用计数是原子变量，不同线程可以同时复制、销毁指向同一对象的 shared_ptr
+// weak_ptr                 : 不延长对象生命期的观察者，通过 lock 取得 shared_ptr
+// enable_shared_from_this  : 让对象在成员函数中取得管理自己的 shared_ptr
+
+// notes:
+//
+// 控制块保存强引用计数 use_count 与弱引用计数 weak_count，所有强引用合起来持有一个弱引用，
+// use_count 归零时销毁对象，weak_count 归零时释放控制块
+// make_shared / allocate_shared 把对象就地构造在控制块里，只分配一次内存，
+// 代价是对象销毁之后，只要还有 weak_ptr，整块内存就不会释放
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "functional.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace MySTL {
+
+/*****************************************************************************************/
+// default_delete
+// unique_ptr 缺省的删除器，数组版本使用 delete[]
+/*****************************************************************************************/
+template <class T>
+struct default_delete {
+    constexpr default_delete() noexcept = default;
+
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    default_delete(const default_delete<U>&) noexcept {}
+
+    void operator()(T* ptr) const {
+        static_assert(sizeof(T) > 0, "default_delete: can not delete an incomplete type");
+        delete ptr;
+    }
+};
+
+template <class T>
+struct default_delete<T[]> {
+    constexpr default_delete() noexcept = default;
+
+    void operator()(T* ptr) const {
+        static_assert(sizeof(T) > 0, "default_delete: can not delete an incomplete type");
+        delete[] ptr;
+    }
+};
+
+/*****************************************************************************************/
+// unique_ptr
+// 删除器提供嵌套类型 pointer 时使用它作为指针类型，否则使用 T*
+/*****************************************************************************************/
+template <class T, class D, class = void>
+struct unique_ptr_pointer {
+    typedef T* type;
+};
+
+template <class T, class D>
+struct unique_ptr_pointer<T, D, typename alloc_void<typename std::remove_reference<D>::type::pointer>::type> {
+    typedef typename std::remove_reference<D>::type::pointer type;
+};
+
+// 保存指针与删除器，删除器为空类时借助空基类优化，不增加 unique_ptr 的大小
+template <class Pointer, class D, bool = std::is_empty<D>::value && !__is_final(D)>
+class unique_ptr_holder : private D {
+   public:
+    unique_ptr_holder() : D(), ptr_() {}
+    template <class E>
+    unique_ptr_holder(Pointer p, E&& d) : D(MySTL::forward<E>(d)), ptr_(p) {}
+
+    Pointer& ptr() noexcept { return ptr_; }
+    const Pointer& ptr() const noexcept { return ptr_; }
+    D& deleter() noexcept { return *this; }
+    const D& deleter() const noexcept { return *this; }
+
+   private:
+    Pointer ptr_;
+};
+
+template <class Pointer, class D>
+class unique_ptr_holder<Pointer, D, false> {
+   public:
+    unique_ptr_holder() : ptr_(), deleter_() {}
+    template <class E>
+    unique_ptr_holder(Pointer p, E&& d) : ptr_(p), deleter_(MySTL::forward<E>(d)) {}
+
+    Pointer& ptr() noexcept { return ptr_; }
+    const Pointer& ptr() const noexcept { return ptr_; }
+    D& deleter() noexcept { return deleter_; }
+    const D& deleter() const noexcept { return deleter_; }
+
+   private:
+    Pointer ptr_;
+    D deleter_;
+};
+
+// 模板类 : unique_ptr
+// 模板参数 T 代表所管理的对象类型，D 代表删除器类型
+template <class T, class D = default_delete<T>>
+class unique_ptr {
+   public:
+    typedef typename unique_ptr_pointer<T, D>::type pointer;
+    typedef T element_type;
+    typedef D deleter_type;
+
+   private:
+    unique_ptr_holder<pointer, D> holder_;
+
+   public:
+    // 构造、移动、析构函数
+    unique_ptr() noexcept : holder_() {}
+    unique_ptr(std::nullptr_t) noexcept : holder_() {}
+    explicit unique_ptr(pointer p) noexcept : holder_(p, D()) {}
+    unique_ptr(pointer p, const D& d) noexcept : holder_(p, d) {}
+    unique_ptr(pointer p, typename std::remove_reference<D>::type&& d) noexcept : holder_(p, MySTL::move(d)) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept : holder_(rhs.release(), MySTL::forward<D>(rhs.get_deleter())) {}
+
+    template <class U, class E,
+              class = typename std::enable_if<
+                  !std::is_array<U>::value &&
+                  std::is_convertible<typename unique_ptr<U, E>::pointer, pointer>::value &&
+                  (std::is_reference<D>::value ? std::is_same<E, D>::value : std::is_convertible<E, D>::value)>::type>
+    unique_ptr(unique_ptr<U, E>&& rhs) noexcept : holder_(rhs.release(), MySTL::forward<E>(rhs.get_deleter())) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    ~unique_ptr() {
+        if (get() != pointer()) get_deleter()(get());
+    }
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MySTL::forward<D>(rhs.get_deleter());
+        return *this;
+    }
+
+    template <class U, class E,
+              class = typename std::enable_if<
+                  !std::is_array<U>::value &&
+                  std::is_convertible<typename unique_ptr<U, E>::pointer, pointer>::value &&
+                  std::is_assignable<D&, E&&>::value>::type>
+    unique_ptr& operator=(unique_ptr<U, E>&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MySTL::forward<E>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+   public:
+    // 访问对象
+    typename std::add_lvalue_reference<T>::type operator*() const { return *get(); }
+    pointer operator->() const noexcept { return get(); }
+
+    pointer get() const noexcept { return holder_.ptr(); }
+    D& get_deleter() noexcept { return holder_.deleter(); }
+    const D& get_deleter() const noexcept { return holder_.deleter(); }
+
+    explicit operator bool() const noexcept { return get() != pointer(); }
+
+    // 放弃所有权，返回原来的指针
+    pointer release() noexcept {
+        pointer p = get();
+        holder_.ptr() = pointer();
+        return p;
+    }
+
+    // 接管 p，再删除原来的对象
+    void reset(pointer p = pointer()) noexcept {
+        pointer old = get();
+        holder_.ptr() = p;
+        if (old != pointer()) get_deleter()(old);
+    }
+
+    void swap(unique_ptr& rhs) noexcept {
+        MySTL::swap(holder_.ptr(), rhs.holder_.ptr());
+        MySTL::swap(get_deleter(), rhs.get_deleter());
+    }
+};
+
+// 数组版本，不提供 operator* 与 operator->，以 operator[] 访问元素
+template <class T, class D>
+class unique_ptr<T[], D> {
+   public:
+    typedef typename unique_ptr_pointer<T, D>::type pointer;
+    typedef T element_type;
+    typedef D deleter_type;
+
+   private:
+    unique_ptr_holder<pointer, D> holder_;
+
+   public:
+    unique_ptr() noexcept : holder_() {}
+    unique_ptr(std::nullptr_t) noexcept : holder_() {}
+    explicit unique_ptr(pointer p) noexcept : holder_(p, D()) {}
+    unique_ptr(pointer p, const D& d) noexcept : holder_(p, d) {}
+    unique_ptr(pointer p, typename std::remove_reference<D>::type&& d) noexcept : holder_(p, MySTL::move(d)) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept : holder_(rhs.release(), MySTL::forward<D>(rhs.get_deleter())) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    ~unique_ptr() {
+        if (get() != pointer()) get_deleter()(get());
+    }
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MySTL::forward<D>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+   public:
+    T& operator[](size_t n) const { return get()[n]; }
+
+    pointer get() const noexcept { return holder_.ptr(); }
+    D& get_deleter() noexcept { return holder_.deleter(); }
+    const D& get_deleter() const noexcept { return holder_.deleter(); }
+
+    explicit operator bool() const noexcept { return get() != pointer(); }
+
+    pointer release() noexcept {
+        pointer p = get();
+        holder_.ptr() = pointer();
+        return p;
+    }
+
+    void reset(pointer p = pointer()) noexcept {
+        pointer old = get();
+        holder_.ptr() = p;
+        if (old != pointer()) get_deleter()(old);
+    }
+
+    void reset(std::nullptr_t) noexcept { reset(pointer()); }
+
+    // 通过基类指针 delete[] 派生类数组是未定义行为，禁止用其他类型的指针重置
+    template <class U>
+    void reset(U*) = delete;
+
+    void swap(unique_ptr& rhs) noexcept {
+        MySTL::swap(holder_.ptr(), rhs.holder_.ptr());
+        MySTL::swap(get_deleter(), rhs.get_deleter());
+    }
+};
+
+// make_unique
+// 非数组版本用 args 构造对象，数组版本值初始化 n 个元素
+template <class T, class... Args>
+typename std::enable_if<!std::is_array<T>::value, unique_ptr<T>>::type
+make_unique(Args&&... args) {
+    return unique_ptr<T>(new T(MySTL::forward<Args>(args)...));
+}
+
+template <class T>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, unique_ptr<T>>::type
+make_unique(size_t n) {
+    typedef typename std::remove_extent<T>::type U;
+    return unique_ptr<T>(new U[n]());
+}
+
+// 重载比较操作符
+template <class T1, class D1, class T2, class D2>
+bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() == rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() != rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator<(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() < rhs.get();
+}
+
+template <class T, class D>
+bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <class T, class D>
+bool operator==(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept {
+    return !rhs;
+}
+
+template <class T, class D>
+bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <class T, class D>
+bool operator!=(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept {
+    return static_cast<bool>(rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T, class D>
+void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// unique_ptr 只包含一个指针与删除器，删除器可以按字节搬运时整体也可以
+template <class T, class D>
+struct is_trivially_relocatable<unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+/*****************************************************************************************/
+// 控制块
+// sp_counted_base     : 引用计数与销毁接口
+// sp_counted_deleter  : 由 shared_ptr(p, d, a) 创建，保存指针与删除器，对象在别处
+// sp_counted_inplace  : 由 allocate_shared 创建，对象就地构造在控制块中
+/*****************************************************************************************/
+class bad_weak_ptr : public std::exception {
+   public:
+    const char* what() const noexcept override { return "MySTL::bad_weak_ptr"; }
+};
+
+class sp_counted_base {
+   public:
+    sp_counted_base() noexcept : counts_(one_use | one_weak) {}
+    virtual ~sp_counted_base() {}
+
+    sp_counted_base(const sp_counted_base&) = delete;
+    sp_counted_base& operator=(const sp_counted_base&) = delete;
+
+    // use_count 归零时销毁所管理的对象
+    virtual void dispose() noexcept = 0;
+
+    // weak_count 归零时释放控制块自身
+    virtual void destroy() noexcept = 0;
+
+    // 增加引用计数只需要原子性，不需要与其他内存操作排序
+    void add_ref() noexcept { counts_.fetch_add(one_use, std::memory_order_relaxed); }
+
+    // 引用计数不为零时才加一，供 weak_ptr::lock 使用
+    bool add_ref_nonzero() noexcept {
+        count_type n = counts_.load(std::memory_order_relaxed);
+        while ((n & use_mask) != 0) {
+            if (counts_.compare_exchange_weak(n, n + one_use, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    // 减少引用计数需要 acq_rel，保证其他线程对对象的修改在销毁之前可见
+    // 两个计数都是 1 时，没有其他 shared_ptr 或 weak_ptr 能再访问控制块，一次读取就可以直接销毁
+    void release() noexcept {
+        if (counts_.load(std::memory_order_acquire) == (one_use | one_weak)) {
+            dispose();
+            destroy();
+            return;
+        }
+        if ((counts_.fetch_sub(one_use, std::memory_order_acq_rel) & use_mask) == one_use) {
+            dispose();
+            weak_release();
+        }
+    }
+
+    void weak_add_ref() noexcept { counts_.fetch_add(one_weak, std::memory_order_relaxed); }
+
+    void weak_release() noexcept {
+        if ((counts_.fetch_sub(one_weak, std::memory_order_acq_rel) >> weak_shift) == 1) destroy();
+    }
+
+    long use_count() const noexcept { return static_cast<long>(counts_.load(std::memory_order_relaxed) & use_mask); }
+
+   private:
+    // 低 32 位是 use_count，高 32 位是 weak_count，放在同一个原子变量中，可以一次读出两个计数
+    typedef unsigned long long count_type;
+    static constexpr unsigned weak_shift = 32;
+    static constexpr count_type one_use = 1;
+    static constexpr count_type one_weak = one_use << weak_shift;
+    static constexpr count_type use_mask = one_weak - 1;
+
+    std::atomic<count_type> counts_;
+};
+
+template <class P, class D, class Alloc>
+class sp_counted_deleter : public sp_counted_base,
+                           private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<sp_counted_deleter<P, D, Alloc>>> {
+   public:
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<sp_counted_deleter> alloc_type;
+    typedef allocator_traits<alloc_type> alloc_traits;
+    typedef alloc_holder<alloc_type> holder_type;
+
+   public:
+    sp_counted_deleter(P p, const D& d, const Alloc& a) : holder_type(alloc_type(a)), ptr_(p), deleter_(d) {}
+
+    // 分配并构造控制块，失败时抛出异常，p 的所有权仍在调用者手中
+    static sp_counted_deleter* create(P p, const D& d, const Alloc& a) {
+        alloc_type ba(a);
+        sp_counted_deleter* block = alloc_traits::allocate(ba, 1);
+        try {
+            ::new (static_cast<void*>(block)) sp_counted_deleter(p, d, a);
+        } catch (...) {
+            alloc_traits::deallocate(ba, block, 1);
+            throw;
+        }
+        return block;
+    }
+
+    void dispose() noexcept override { deleter_(ptr_); }
+
+    void destroy() noexcept override {
+        alloc_type a(this->get_alloc());
+        this->~sp_counted_deleter();
+        alloc_traits::deallocate(a, this, 1);
+    }
+
+   private:
+    P ptr_;
+    D deleter_;
+};
+
+template <class T, class Alloc>
+class sp_counted_inplace : public sp_counted_base,
+                           private alloc_holder<typename allocator_traits<Alloc>::template rebind_alloc<sp_counted_inplace<T, Alloc>>> {
+   public:
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<sp_counted_inplace> alloc_type;
+    typedef allocator_traits<alloc_type> alloc_traits;
+    typedef alloc_holder<alloc_type> holder_type;
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<typename std::remove_cv<T>::type> value_alloc_type;
+
+   public:
+    template <class... Args>
+    explicit sp_counted_inplace(const Alloc& a, Args&&... args) : holder_type(alloc_type(a)) {
+        value_alloc_type va(a);
+        allocator_traits<value_alloc_type>::construct(va, get(), MySTL::forward<Args>(args)...);
+    }
+
+    typename std::remove_cv<T>::type* get() noexcept {
+        return reinterpret_cast<typename std::remove_cv<T>::type*>(&storage_);
+    }
+
+    void dispose() noexcept override {
+        value_alloc_type va(this->get_alloc());
+        allocator_traits<value_alloc_type>::destroy(va, get());
+    }
+
+    void destroy() noexcept override {
+        alloc_type a(this->get_alloc());
+        this->~sp_counted_inplace();
+        alloc_traits::deallocate(a, this, 1);
+    }
+
+   private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+};
+
+/*****************************************************************************************/
+// shared_ptr / weak_ptr / enable_shared_from_this
+/*****************************************************************************************/
+template <class T>
+class shared_ptr;
+
+template <class T>
+class weak_ptr;
+
+template <class T>
+class enable_shared_from_this;
+
+// make_shared 使用的构造函数标签
+struct sp_inplace_tag {};
+
+// 模板类 : shared_ptr
+// 模板参数 T 代表所管理的对象类型
+template <class T>
+class shared_ptr {
+    template <class U>
+    friend class shared_ptr;
+    template <class U>
+    friend class weak_ptr;
+
+   public:
+    typedef T element_type;
+    typedef weak_ptr<T> weak_type;
+
+   private:
+    T* ptr_;                 // get() 返回的指针，别名构造时可以与控制块管理的对象不同
+    sp_counted_base* ctrl_;  // 控制块，为空时不拥有任何对象
+
+   public:
+    // 构造、复制、移动、析构函数
+    shared_ptr() noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+    shared_ptr(std::nullptr_t) noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+
+    template <class Y, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    explicit shared_ptr(Y* p) : ptr_(p), ctrl_(nullptr) {
+        ctrl_ = acquire(p, default_delete<Y>(), MySTL::allocator<Y>());
+        enable_weak_this(p);
+    }
+
+    template <class Y, class D, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr(Y* p, D d) : ptr_(p), ctrl_(nullptr) {
+        ctrl_ = acquire(p, d, MySTL::allocator<Y>());
+        enable_weak_this(p);
+    }
+
+    template <class Y, class D, class Alloc, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr(Y* p, D d, Alloc a) : ptr_(p), ctrl_(nullptr) {
+        ctrl_ = acquire(p, d, a);
+        enable_weak_this(p);
+    }
+
+    template <class D>
+    shared_ptr(std::nullptr_t, D d) : ptr_(nullptr), ctrl_(nullptr) {
+        ctrl_ = acquire(static_cast<T*>(nullptr), d, MySTL::allocator<T>());
+    }
+
+    // 别名构造：与 r 共享所有权，get() 却返回 p，常用于指向 r 所管理对象的成员
+    template <class Y>
+    shared_ptr(const shared_ptr<Y>& r, T* p) noexcept : ptr_(p), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) ctrl_->add_ref();
+    }
+
+    shared_ptr(const shared_ptr& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        if (ctrl_ != nullptr) ctrl_->add_ref();
+    }
+
+    template <class Y, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr(const shared_ptr<Y>& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        if (ctrl_ != nullptr) ctrl_->add_ref();
+    }
+
+    shared_ptr(shared_ptr&& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        rhs.ptr_ = nullptr;
+        rhs.ctrl_ = nullptr;
+    }
+
+    template <class Y, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    shared_ptr(shared_ptr<Y>&& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        rhs.ptr_ = nullptr;
+        rhs.ctrl_ = nullptr;
+    }
+
+    // 对象已经销毁时抛出 bad_weak_ptr
+    template <class Y, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    explicit shared_ptr(const weak_ptr<Y>& r) : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (ctrl_ == nullptr || !ctrl_->add_ref_nonzero()) throw bad_weak_ptr();
+    }
+
+    // 从 unique_ptr 接管所有权，分配控制块失败时 r 保持不变
+    template <class Y, class D, class = typename std::enable_if<std::is_convertible<typename unique_ptr<Y, D>::pointer, T*>::value>::type>
+    shared_ptr(unique_ptr<Y, D>&& r) : ptr_(r.get()), ctrl_(nullptr) {
+        if (ptr_ != nullptr) {
+            typedef typename std::remove_reference<D>::type deleter_type;
+            typedef typename unique_ptr<Y, D>::pointer pointer;
+            ctrl_ = sp_counted_deleter<pointer, deleter_type, MySTL::allocator<Y>>::create(r.get(), r.get_deleter(), MySTL::allocator<Y>());
+            enable_weak_this(r.release());
+        }
+    }
+
+    ~shared_ptr() {
+        if (ctrl_ != nullptr) ctrl_->release();
+    }
+
+    shared_ptr& operator=(const shared_ptr& rhs) noexcept {
+        shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    shared_ptr& operator=(const shared_ptr<Y>& rhs) noexcept {
+        shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    shared_ptr& operator=(shared_ptr&& rhs) noexcept {
+        shared_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    shared_ptr& operator=(shared_ptr<Y>&& rhs) noexcept {
+        shared_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class Y, class D>
+    shared_ptr& operator=(unique_ptr<Y, D>&& rhs) {
+        shared_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+   public:
+    // 修改容器相关操作
+    void reset() noexcept { shared_ptr().swap(*this); }
+
+    template <class Y>
+    void reset(Y* p) { shared_ptr(p).swap(*this); }
+
+    template <class Y, class D>
+    void reset(Y* p, D d) { shared_ptr(p, d).swap(*this); }
+
+    template <class Y, class D, class Alloc>
+    void reset(Y* p, D d, Alloc a) { shared_ptr(p, d, a).swap(*this); }
+
+    void swap(shared_ptr& rhs) noexcept {
+        MySTL::swap(ptr_, rhs.ptr_);
+        MySTL::swap(ctrl_, rhs.ctrl_);
+    }
+
+   public:
+    // 访问对象
+    T* get() const noexcept { return ptr_; }
+    typename std::add_lvalue_reference<T>::type operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+
+    long use_count() const noexcept { return ctrl_ == nullptr ? 0 : ctrl_->use_count(); }
+    bool unique() const noexcept { return use_count() == 1; }
+
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    // 按控制块的地址排序，共享所有权的两个 shared_ptr 等价
+    template <class Y>
+    bool owner_before(const shared_ptr<Y>& rhs) const noexcept { return ctrl_ < rhs.ctrl_; }
+
+    template <class Y>
+    bool owner_before(const weak_ptr<Y>& rhs) const noexcept { return ctrl_ < rhs.ctrl_; }
+
+   private:
+    template <class U, class Alloc, class... Args>
+    friend shared_ptr<U> allocate_shared(const Alloc& a, Args&&... args);
+
+    // 接管 allocate_shared 构造好的控制块
+    shared_ptr(sp_inplace_tag, T* p, sp_counted_base* ctrl) noexcept : ptr_(p), ctrl_(ctrl) {
+        enable_weak_this(p);
+    }
+
+    // 为 p 创建控制块，失败时用 d 删除 p 后重新抛出
+    template <class Y, class D, class Alloc>
+    static sp_counted_base* acquire(Y* p, D d, const Alloc& a) {
+        try {
+            return sp_counted_deleter<Y*, D, Alloc>::create(p, d, a);
+        } catch (...) {
+            d(p);
+            throw;
+        }
+    }
+
+    // 对象派生自 enable_shared_from_this 时，让它记住管理自己的控制块
+    template <class Y>
+    void enable_weak_this(Y* p) noexcept { enable_weak_this_aux(p, p); }
+
+    template <class U, class Y>
+    void enable_weak_this_aux(const enable_shared_from_this<U>* base, Y* p) noexcept {
+        if (base != nullptr && base->weak_this_.expired())
+            base->weak_this_ = shared_ptr<U>(*this, const_cast<U*>(static_cast<const U*>(p)));
+    }
+
+    void enable_weak_this_aux(...) noexcept {}
+};
+
+// 模板类 : weak_ptr
+// 只增加弱引用计数，对象销毁后 lock 返回空的 shared_ptr
+template <class T>
+class weak_ptr {
+    template <class U>
+    friend class shared_ptr;
+    template <class U>
+    friend class weak_ptr;
+
+   public:
+    typedef T element_type;
+
+   private:
+    T* ptr_;
+    sp_counted_base* ctrl_;
+
+   public:
+    // 构造、复制、移动、析构函数
+    weak_ptr() noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+
+    weak_ptr(const weak_ptr& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        if (ctrl_ != nullptr) ctrl_->weak_add_ref();
+    }
+
+    // 对象可能已经销毁，通过虚基类转换指针需要访问对象，所以先 lock 再取指针
+    template <class Y, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    weak_ptr(const weak_ptr<Y>& rhs) noexcept : ptr_(rhs.lock().get()), ctrl_(rhs.ctrl_) {
+        if (ctrl_ != nullptr) ctrl_->weak_add_ref();
+    }
+
+    template <class Y, class = typename std::enable_if<std::is_convertible<Y*, T*>::value>::type>
+    weak_ptr(const shared_ptr<Y>& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        if (ctrl_ != nullptr) ctrl_->weak_add_ref();
+    }
+
+    weak_ptr(weak_ptr&& rhs) noexcept : ptr_(rhs.ptr_), ctrl_(rhs.ctrl_) {
+        rhs.ptr_ = nullptr;
+        rhs.ctrl_ = nullptr;
+    }
+
+    ~weak_ptr() {
+        if (ctrl_ != nullptr) ctrl_->weak_release();
+    }
+
+    weak_ptr& operator=(const weak_ptr& rhs) noexcept {
+        weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    weak_ptr& operator=(const weak_ptr<Y>& rhs) noexcept {
+        weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    weak_ptr& operator=(const shared_ptr<Y>& rhs) noexcept {
+        weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    weak_ptr& operator=(weak_ptr&& rhs) noexcept {
+        weak_ptr(MySTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+   public:
+    void reset() noexcept { weak_ptr().swap(*this); }
+
+    void swap(weak_ptr& rhs) noexcept {
+        MySTL::swap(ptr_, rhs.ptr_);
+        MySTL::swap(ctrl_, rhs.ctrl_);
+    }
+
+    long use_count() const noexcept { return ctrl_ == nullptr ? 0 : ctrl_->use_count(); }
+    bool expired() const noexcept { return use_count() == 0; }
+
+    // 对象还存在时返回共享它的 shared_ptr，否则返回空的 shared_ptr
+    shared_ptr<T> lock() const noexcept {
+        shared_ptr<T> r;
+        if (ctrl_ != nullptr && ctrl_->add_ref_nonzero()) {
+            r.ptr_ = ptr_;
+            r.ctrl_ = ctrl_;
+        }
+        return r;
+    }
+
+    template <class Y>
+    bool owner_before(const shared_ptr<Y>& rhs) const noexcept { return ctrl_ < rhs.ctrl_; }
+
+    template <class Y>
+    bool owner_before(const weak_ptr<Y>& rhs) const noexcept { return ctrl_ < rhs.ctrl_; }
+};
+
+// 模板类 : enable_shared_from_this
+// 派生类对象由 shared_ptr 管理后，shared_from_this 返回共享它的 shared_ptr，否则抛出 bad_weak_ptr
+template <class T>
+class enable_shared_from_this {
+    template <class U>
+    friend class shared_ptr;
+
+   protected:
+    enable_shared_from_this() noexcept {}
+    enable_shared_from_this(const enable_shared_from_this&) noexcept {}
+    enable_shared_from_this& operator=(const enable_shared_from_this&) noexcept { return *this; }
+    ~enable_shared_from_this() {}
+
+   public:
+    shared_ptr<T> shared_from_this() { return shared_ptr<T>(weak_this_); }
+    shared_ptr<const T> shared_from_this() const { return shared_ptr<const T>(weak_this_); }
+
+    weak_ptr<T> weak_from_this() noexcept { return weak_this_; }
+    weak_ptr<const T> weak_from_this() const noexcept { return weak_this_; }
+
+   private:
+    mutable weak_ptr<T> weak_this_;
+};
+
+// allocate_shared / make_shared
+// 对象与控制块在同一次分配中，用 a 的 rebind 分配内存、构造对象
+template <class T, class Alloc, class... Args>
+shared_ptr<T> allocate_shared(const Alloc& a, Args&&... args) {
+    static_assert(!std::is_array<T>::value, "allocate_shared: array types are not supported");
+    typedef sp_counted_inplace<T, Alloc> block_type;
+    typedef typename block_type::alloc_type block_alloc;
+    block_alloc ba(a);
+    block_type* block = allocator_traits<block_alloc>::allocate(ba, 1);
+    try {
+        ::new (static_cast<void*>(block)) block_type(a, MySTL::forward<Args>(args)...);
+    } catch (...) {
+        allocator_traits<block_alloc>::deallocate(ba, block, 1);
+        throw;
+    }
+    return shared_ptr<T>(sp_inplace_tag(), block->get(), block);
+}
+
+template <class T, class... Args>
+shared_ptr<T> make_shared(Args&&... args) {
+    return MySTL::allocate_shared<T>(MySTL::allocator<typename std::remove_cv<T>::type>(), MySTL::forward<Args>(args)...);
+}
+
+// 指针转换，结果与 r 共享所有权
+template <class T, class U>
+shared_ptr<T> static_pointer_cast(const shared_ptr<U>& r) noexcept {
+    return shared_ptr<T>(r, static_cast<T*>(r.get()));
+}
+
+template <class T, class U>
+shared_ptr<T> const_pointer_cast(const shared_ptr<U>& r) noexcept {
+    return shared_ptr<T>(r, const_cast<T*>(r.get()));
+}
+
+template <class T, class U>
+shared_ptr<T> dynamic_pointer_cast(const shared_ptr<U>& r) noexcept {
+    T* p = dynamic_cast<T*>(r.get());
+    return p != nullptr ? shared_ptr<T>(r, p) : shared_ptr<T>();
+}
+
+// 重载比较操作符
+template <class T, class U>
+bool operator==(const shared_ptr<T>& lhs, const shared_ptr<U>& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <class T, class U>
+bool operator!=(const shared_ptr<T>& lhs, const shared_ptr<U>& rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+template <class T, class U>
+bool operator<(const shared_ptr<T>& lhs, const shared_ptr<U>& rhs) noexcept {
+    return lhs.get() < rhs.get();
+}
+
+template <class T>
+bool operator==(const shared_ptr<T>& lhs, std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <class T>
+bool operator==(std::nullptr_t, const shared_ptr<T>& rhs) noexcept {
+    return !rhs;
+}
+
+template <class T>
+bool operator!=(const shared_ptr<T>& lhs, std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <class T>
+bool operator!=(std::nullptr_t, const shared_ptr<T>& rhs) noexcept {
+    return static_cast<bool>(rhs);
+}
+
+// 重载 MySTL 的 swap
+template <class T>
+void swap(shared_ptr<T>& lhs, shared_ptr<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class T>
+void swap(weak_ptr<T>& lhs, weak_ptr<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// shared_ptr、weak_ptr 只包含两个指针，搬运时引用计数不变
+template <class T>
+struct is_trivially_relocatable<shared_ptr<T>> : std::true_type {};
+
+template <class T>
+struct is_trivially_relocatable<weak_ptr<T>> : std::true_type {};
+
+// 哈希函数对象，与所保存的指针的哈希值相同
+template <class T, class D>
+struct hash<unique_ptr<T, D>> {
+    size_t operator()(const unique_ptr<T, D>& p) const noexcept {
+        return hash<typename unique_ptr<T, D>::pointer>()(p.get());
+    }
+};
+
+template <class T>
+struct hash<shared_ptr<T>> {
+    size_t operator()(const shared_ptr<T>& p) const noexcept { return hash<T*>()(p.get()); }
+};
+
+}  // namespace MySTL
+#endif
@@ -36,5 +36,21 @@ struct is_pair : MySTL::m_false_type {};
 template <class T1, class T2>
 struct is_pair<MySTL::pair<T1, T2>> : MySTL::m_true_type {};
 
+// is_trivially_relocatable
+// 把对象按字节复制到新地址、并且不再对旧对象调用析构函数，效果与移动构造后析构旧对象相同的类型
+// 可平凡复制的类型都满足，其余类型可以通过特化为 std::true_type 主动声明，MySTL 的容器已经给出了特化
+// 容器搬运这类元素时直接使用 memcpy / memmove，省去逐个移动构造与析构
+
+template <class T>
+struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+template <class T1, class T2>
+struct is_trivially_relocatable<MySTL::pair<T1, T2>>
+    : std::integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
+// map 的 value_type 为 pair<const Key, T>，const 不影响按字节搬移
+template <class T>
+struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> {};
+
 }  // namespace MySTL
 #endif
@@ -2,6 +2,9 @@
 #define _MYSTL_UNINITIALIZED_H_
 
 // 这个头文件用于对未初始化空间构造元素
+// 连续存放、可平凡复制的元素整段 memcpy，标量的字节模式填充用 memset
+
+#include <cstring>
 
 #include "algobase.h"
 #include "construct.h"
@@ -9,9 +12,50 @@
 #include "type_traits.h"
 #include "util.h"
 namespace MySTL {
+/*****************************************************************************************/
+// 按字节构造的辅助工具
+// 源与目标都是连续迭代器、值类型相同且可平凡复制时，复制与移动直接 memcpy
+// 填充标量类型时，若值的每个字节都相同（例如 0、-1、nullptr），直接 memset
+/*****************************************************************************************/
+template <class InputIter, class ForwardIter>
+struct uninit_memcpy_able : std::integral_constant<bool,
+                                is_contiguous_iterator<InputIter>::value &&
+                                is_contiguous_iterator<ForwardIter>::value &&
+                                std::is_same<typename std::remove_cv<typename iterator_traits<InputIter>::value_type>::type,
+                                             typename std::remove_cv<typename iterator_traits<ForwardIter>::value_type>::type>::value &&
+                                std::is_trivially_copyable<typename iterator_traits<ForwardIter>::value_type>::value> {};
+
+template <class ForwardIter>
+struct uninit_memset_able : std::integral_constant<bool,
+                                is_contiguous_iterator<ForwardIter>::value &&
+                                std::is_scalar<typename iterator_traits<ForwardIter>::value_type>::value &&
+                                !std::is_volatile<typename iterator_traits<ForwardIter>::value_type>::value> {};
+
+// 把从 first 开始的 n 个元素按字节复制到 result，两段内存不能重叠
+template <class InputIter, class ForwardIter>
+ForwardIter uninit_memcpy(InputIter first, size_t n, ForwardIter result) noexcept {
+    if (n != 0) {
+        std::memcpy(static_cast<void*>(&*result), static_cast<const void*>(&*first),
+                    n * sizeof(typename iterator_traits<ForwardIter>::value_type));
+    }
+    return result + n;
+}
+
+// value 的每个字节都相同时返回 true，并把这个字节写入 byte
+template <class T>
+bool is_byte_pattern(const T& value, unsigned char& byte) noexcept {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(&value);
+    byte = p[0];
+    for (size_t i = 1; i < sizeof(T); ++i) {
+        if (p[i] != byte) return false;
+    }
+    return true;
+}
+
 /*****************************************************************************************/
 // uninitialized_copy
 // 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
+// 构造过程中抛出异常时，析构已构造的元素后重新抛出
 /*****************************************************************************************/
 template <class InputIter, class ForwardIter>
 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::true_type) {
@@ -26,19 +70,83 @@ ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter r
             MySTL::construct(&*cur, *first);
         }
     } catch (...) {
-        for (; result != cur; --cur) {
-            MySTL::destroy(&*cur);
-        }
+        MySTL::destroy(result, cur);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+ForwardIter uninit_copy_aux(InputIter first, InputIter last, ForwardIter result, std::true_type) {
+    return MySTL::uninit_memcpy(first, static_cast<size_t>(last - first), result);
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninit_copy_aux(InputIter first, InputIter last, ForwardIter result, std::false_type) {
     return MySTL::unchecked_uninit_copy(first, last, result,
                                         std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+    return MySTL::uninit_copy_aux(first, last, result, uninit_memcpy_able<InputIter, ForwardIter>{});
+}
+
+// 目标是 deque 的迭代器时逐个缓冲区复制，源为随机访问迭代器时每段交给指针版本，可平凡复制的元素整段 memcpy
+template <class InputIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+uninit_copy_to_segments(InputIter first, InputIter last, deque_iterator<T, T&, T*, BufSiz> result, MySTL::input_iterator_tag) {
+    return MySTL::unchecked_uninit_copy(first, last, result, std::false_type());
+}
+
+template <class RandomIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz>
+uninit_copy_to_segments(RandomIter first, RandomIter last, deque_iterator<T, T&, T*, BufSiz> result, MySTL::random_access_iterator_tag) {
+    auto cur = result;
+    try {
+        cur = MySTL::deque_segments_n(result, last - first, [&](T* b, T* e) {
+            MySTL::uninitialized_copy(first, first + (e - b), b);
+            first += e - b;
+            cur += e - b;
+        });
+    } catch (...) {
+        MySTL::destroy(result, cur);
+        throw;
+    }
+    return cur;
+}
+
+template <class InputIter, class T, size_t BufSiz>
+deque_iterator<T, T&, T*, BufSiz> uninitialized_copy(InputIter first, InputIter last, deque_iterator<T, T&, T*, BufSiz> result) {
+    return MySTL::uninit_copy_to_segments(first, last, result, iterator_category(first));
+}
+
+// 源是 deque 的迭代器时逐个缓冲区复制，某一段抛出异常时析构之前各段已构造的元素
+template <class T, class Ref, class Ptr, size_t BufSiz, class ForwardIter>
+ForwardIter uninitialized_copy(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, ForwardIter result) {
+    auto cur = result;
+    try {
+        MySTL::deque_segments(first, last, [&cur](T* b, T* e) { cur = MySTL::uninitialized_copy(b, e, cur); });
+    } catch (...) {
+        MySTL::destroy(result, cur);
+        throw;
+    }
+    return cur;
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz, class U, size_t BufSiz2>
+deque_iterator<U, U&, U*, BufSiz2>
+uninitialized_copy(deque_iterator<T, Ref, Ptr, BufSiz> first, deque_iterator<T, Ref, Ptr, BufSiz> last, deque_iterator<U, U&, U*, BufSiz2> result) {
+    auto cur = result;
+    try {
+        MySTL::deque_segments(first, last, [&cur](T* b, T* e) { cur = MySTL::uninitialized_copy(b, e, cur); });
+    } catch (...) {
+        MySTL::destroy(result, cur);
+        throw;
+    }
+    return cur;
+}
+
 /*****************************************************************************************/
 // uninitialized_copy_n
 // 把 [first, first + n) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
@@ -52,50 +160,30 @@ template <class InputIter, class Size, class ForwardIter>
 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
-        for (; n > 0; ++first, ++cur) {
+        for (; n > 0; --n, ++first, ++cur) {
             MySTL::construct(&*cur, *first);
         }
     } catch (...) {
-        for (; result != cur; --cur) {
-            MySTL::destroy(&*cur);
-        }
+        MySTL::destroy(result, cur);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
-    return MySTL::unchecked_uninit_copy_n(first, n, result,
-                                          std::is_trivially_copy_assignable<typename iterator_traits<InputIter>::value_type>{});
-}
-
-/*****************************************************************************************/
-// uninitialized_fill
-// 在 [first, last) 区间内填充元素值
-/*****************************************************************************************/
-template <class ForwardIter, class T>
-void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
-    MySTL::fill(first, last, value);
+ForwardIter uninit_copy_n_aux(InputIter first, Size n, ForwardIter result, std::true_type) {
+    return n > 0 ? MySTL::uninit_memcpy(first, static_cast<size_t>(n), result) : result;
 }
 
-template <class ForwardIter, class T>
-void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type) {
-    auto cur = first;
-    try {
-        for (; cur != last; ++cur) {
-            MySTL::construct(&*cur, value);
-        }
-    } catch (...) {
-        for (; first != cur; --cur) {
-            MySTL::destroy(&*first);
-        }
-    }
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter uninit_copy_n_aux(InputIter first, Size n, ForwardIter result, std::false_type) {
+    return MySTL::unchecked_uninit_copy_n(first, n, result,
+                                          std::is_trivially_copy_assignable<typename iterator_traits<InputIter>::value_type>{});
 }
 
-template <class ForwardIter, class T>
-void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
-    MySTL::unchecked_uninit_fill(first, last, value,
-                                 std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
+    return MySTL::uninit_copy_n_aux(first, n, result, uninit_memcpy_able<InputIter, ForwardIter>{});
 }
 
 /*****************************************************************************************/
@@ -115,18 +203,73 @@ ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, s
             MySTL::construct(&*cur, value);
         }
     } catch (...) {
-        for (; first != cur; ++first)
-            MySTL::destroy(&*first);
+        MySTL::destroy(first, cur);
+        throw;
     }
     return cur;
 }
 
 template <class ForwardIter, class Size, class T>
-ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+ForwardIter uninit_fill_n_aux(ForwardIter first, Size n, const T& value, std::true_type) {
+    typedef typename std::remove_cv<typename iterator_traits<ForwardIter>::value_type>::type value_type;
+    const value_type v = value;
+    unsigned char byte;
+    if (n > 0 && MySTL::is_byte_pattern(v, byte)) {
+        std::memset(static_cast<void*>(&*first), byte, static_cast<size_t>(n) * sizeof(value_type));
+        return first + n;
+    }
+    return MySTL::fill_n(first, n, v);
+}
+
+template <class ForwardIter, class Size, class T>
+ForwardIter uninit_fill_n_aux(ForwardIter first, Size n, const T& value, std::false_type) {
     return MySTL::unchecked_uninit_fill_n(first, n, value,
                                           std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
+template <class ForwardIter, class Size, class T>
+ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+    return MySTL::uninit_fill_n_aux(first, n, value, uninit_memset_able<ForwardIter>{});
+}
+
+/*****************************************************************************************/
+// uninitialized_fill
+// 在 [first, last) 区间内填充元素值
+/*****************************************************************************************/
+template <class ForwardIter, class T>
+void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
+    MySTL::fill(first, last, value);
+}
+
+template <class ForwardIter, class T>
+void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type) {
+    auto cur = first;
+    try {
+        for (; cur != last; ++cur) {
+            MySTL::construct(&*cur, value);
+        }
+    } catch (...) {
+        MySTL::destroy(first, cur);
+        throw;
+    }
+}
+
+template <class ForwardIter, class T>
+void uninit_fill_aux(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
+    MySTL::uninit_fill_n_aux(first, last - first, value, std::true_type{});
+}
+
+template <class ForwardIter, class T>
+void uninit_fill_aux(ForwardIter first, ForwardIter last, const T& value, std::false_type) {
+    MySTL::unchecked_uninit_fill(first, last, value,
+                                 std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+template <class ForwardIter, class T>
+void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+    MySTL::uninit_fill_aux(first, last, value, uninit_memset_able<ForwardIter>{});
+}
+
 /*****************************************************************************************/
 // uninitialized_move
 // 把[first, last)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
@@ -145,16 +288,27 @@ ForwardIter unchecked_uninit_move(InputIter first, InputIter last, ForwardIter r
         }
     } catch (...) {
         MySTL::destroy(result, cur);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
+ForwardIter uninit_move_aux(InputIter first, InputIter last, ForwardIter result, std::true_type) {
+    return MySTL::uninit_memcpy(first, static_cast<size_t>(last - first), result);
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninit_move_aux(InputIter first, InputIter last, ForwardIter result, std::false_type) {
     return MySTL::unchecked_uninit_move(first, last, result,
                                         std::is_trivially_move_assignable<typename iterator_traits<InputIter>::value_type>{});
 }
 
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
+    return MySTL::uninit_move_aux(first, last, result, uninit_memcpy_able<InputIter, ForwardIter>{});
+}
+
 /*****************************************************************************************/
 // uninitialized_move_n
 // 把[first, first + n)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
@@ -181,10 +335,99 @@ ForwardIter unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result,
 }
 
 template <class InputIter, class Size, class ForwardIter>
-ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
+ForwardIter uninit_move_n_aux(InputIter first, Size n, ForwardIter result, std::true_type) {
+    return n > 0 ? MySTL::uninit_memcpy(first, static_cast<size_t>(n), result) : result;
+}
+
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter uninit_move_n_aux(InputIter first, Size n, ForwardIter result, std::false_type) {
     return MySTL::unchecked_uninit_move_n(first, n, result,
                                           std::is_trivially_move_assignable<typename iterator_traits<InputIter>::value_type>{});
 }
 
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
+    return MySTL::uninit_move_n_aux(first, n, result, uninit_memcpy_able<InputIter, ForwardIter>{});
+}
+
+/*****************************************************************************************/
+// uninitialized_move_if_noexcept
+// 元素的移动构造不抛出异常（或元素不能复制）时移动，否则复制，用于重新分配空间时保持强异常保证
+/*****************************************************************************************/
+template <class InputIter, class ForwardIter>
+ForwardIter uninit_move_if_noexcept_aux(InputIter first, InputIter last, ForwardIter result, std::true_type) {
+    return MySTL::uninitialized_move(first, last, result);
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninit_move_if_noexcept_aux(InputIter first, InputIter last, ForwardIter result, std::false_type) {
+    return MySTL::uninitialized_copy(first, last, result);
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_move_if_noexcept(InputIter first, InputIter last, ForwardIter result) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return MySTL::uninit_move_if_noexcept_aux(first, last, result,
+                                              std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value ||
+                                                                               !std::is_copy_constructible<value_type>::value>{});
+}
+
+/*****************************************************************************************/
+// uninitialized_default_construct_n
+// 在以 first 为起始处的 n 个未初始化空间上默认初始化对象，返回构造结束的位置
+// 平凡类型的默认初始化不写入任何值，整段空间保持原样，适合随后由 read() 等直接填充的缓冲区
+/*****************************************************************************************/
+template <class ForwardIter, class Size>
+ForwardIter unchecked_uninit_default_n(ForwardIter first, Size n, std::true_type) {
+    MySTL::advance(first, n);
+    return first;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter unchecked_uninit_default_n(ForwardIter first, Size n, std::false_type) {
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    auto cur = first;
+    try {
+        for (; n > 0; --n, ++cur) {
+            ::new (static_cast<void*>(&*cur)) value_type;
+        }
+    } catch (...) {
+        MySTL::destroy(first, cur);
+        throw;
+    }
+    return cur;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter uninitialized_default_construct_n(ForwardIter first, Size n) {
+    return MySTL::unchecked_uninit_default_n(first, n,
+                                             std::is_trivially_default_constructible<typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+/*****************************************************************************************/
+// uninitialized_relocate
+// 把 [first, last) 上的对象搬到以 result 为起始处的未初始化空间，源区间随后视为未初始化，返回搬运结束的位置
+// 可平凡重定位的类型按字节复制，源区间与目标区间允许重叠；其余类型逐个移动构造再析构源对象，两个区间不能重叠
+/*****************************************************************************************/
+template <class T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::true_type) noexcept {
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0)
+        std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(T));
+    return result + n;
+}
+
+template <class T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::false_type) {
+    T* cur = MySTL::uninitialized_move(first, last, result);
+    MySTL::destroy(first, last);
+    return cur;
+}
+
+template <class T>
+T* uninitialized_relocate(T* first, T* last, T* result) {
+    return MySTL::unchecked_uninit_relocate(first, last, result, is_trivially_relocatable<T>{});
+}
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -19,11 +19,13 @@ namespace MySTL {
 // 模板类 unordered_map，键值不允许重复
 // 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 MySTL::hash
 // 参数四代表键值比较方式，缺省使用 MySTL::equal_to
-template <class Key, class T, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+// 参数五代表空间配置器类型，缺省使用 default_node_allocator 选出的分配器
+template <class Key, class T, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>,
+          class Alloc = typename default_node_allocator<MySTL::pair<const Key, T>>::type>
 class unordered_map {
    private:
     // 使用 hashtable 作为底层机制
-    typedef hashtable<MySTL::pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<MySTL::pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -55,15 +57,17 @@ class unordered_map {
 
     explicit unordered_map(size_type bucket_count,
                            const Hash& hash = Hash(),
-                           const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal) {}
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class Iter>
     unordered_map(Iter first, Iter last,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal) {
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal, alloc) {
         for (; first != last; ++first)
             ht_.insert_unique_noresize(*first);
     }
@@ -71,14 +75,19 @@ class unordered_map {
     unordered_map(std::initializer_list<value_type> ilist,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal) {
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_unique_noresize(*first);
     }
 
     unordered_map(const unordered_map& rhs) : ht_(rhs.ht_) {}
     unordered_map(unordered_map&& rhs) noexcept : ht_(MySTL::move(rhs.ht_)) {}
+
+    // 指定分配器的构造函数
+    explicit unordered_map(const allocator_type& alloc) : ht_(100, Hash(), KeyEqual(), alloc) {}
+    unordered_map(const unordered_map& rhs, const allocator_type& alloc) : ht_(rhs.ht_, alloc) {}
     unordered_map& operator=(const unordered_map& rhs) {
         ht_ = rhs.ht_;
         return *this;
@@ -212,22 +221,22 @@ class unordered_map {
 };
 
 // 重载比较操作符
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
 // 重载 MySTL 的 swap
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
-          unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
@@ -236,11 +245,13 @@ void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
 // 模板类 unordered_multimap，键值允许重复
 // 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 MySTL::hash
 // 参数四代表键值比较方式，缺省使用 MySTL::equal_to
-template <class Key, class T, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+// 参数五代表空间配置器类型，缺省使用 default_node_allocator 选出的分配器
+template <class Key, class T, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>,
+          class Alloc = typename default_node_allocator<MySTL::pair<const Key, T>>::type>
 class unordered_multimap {
    private:
     // 使用 hashtable 作为底层机制
-    typedef hashtable<pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -275,16 +286,18 @@ class unordered_multimap {
 
     explicit unordered_multimap(size_type bucket_count,
                                 const Hash& hash = Hash(),
-                                const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal) {
+                                const KeyEqual& equal = KeyEqual(),
+                                const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {
     }
 
     template <class InputIterator>
     unordered_multimap(InputIterator first, InputIterator last,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal) {
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal, alloc) {
         for (; first != last; ++first)
             ht_.insert_multi_noresize(*first);
     }
@@ -292,8 +305,9 @@ class unordered_multimap {
     unordered_multimap(std::initializer_list<value_type> ilist,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal) {
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_multi_noresize(*first);
     }
@@ -305,6 +319,10 @@ class unordered_multimap {
         : ht_(MySTL::move(rhs.ht_)) {
     }
 
+    // 指定分配器的构造函数
+    explicit unordered_multimap(const allocator_type& alloc) : ht_(100, Hash(), KeyEqual(), alloc) {}
+    unordered_multimap(const unordered_multimap& rhs, const allocator_type& alloc) : ht_(rhs.ht_, alloc) {}
+
     unordered_multimap& operator=(const unordered_multimap& rhs) {
         ht_ = rhs.ht_;
         return *this;
@@ -421,24 +439,44 @@ class unordered_multimap {
 };
 
 // 重载比较操作符
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
 // 重载 MySTL 的 swap
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-          unordered_multimap<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
+// unordered_map / unordered_multimap 只包含一个 hashtable
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+    : is_trivially_relocatable<hashtable<MySTL::pair<const Key, T>, Hash, KeyEqual, Alloc>> {};
+
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<unordered_multimap<Key, T, Hash, KeyEqual, Alloc>>
+    : is_trivially_relocatable<hashtable<MySTL::pair<const Key, T>, Hash, KeyEqual, Alloc>> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class Key, class T, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+using unordered_map = MySTL::unordered_map<Key, T, Hash, KeyEqual, MySTL::polymorphic_allocator<MySTL::pair<const Key, T>>>;
+
+template <class Key, class T, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+using unordered_multimap = MySTL::unordered_multimap<Key, T, Hash, KeyEqual, MySTL::polymorphic_allocator<MySTL::pair<const Key, T>>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -19,11 +19,13 @@ namespace MySTL {
 // 模板类 unordered_set，键值不允许重复
 // 参数一代表键值类型，参数二代表哈希函数，缺省使用 MySTL::hash，
 // 参数三代表键值比较方式，缺省使用 MySTL::equal_to
-template <class Key, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+// 参数四代表空间配置器类型，缺省使用 default_node_allocator 选出的分配器
+template <class Key, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>,
+          class Alloc = typename default_node_allocator<Key>::type>
 class unordered_set {
    private:
     // 使用 hashtable 作为底层机制
-    typedef hashtable<Key, Hash, KeyEqual> base_type;
+    typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -54,14 +56,16 @@ class unordered_set {
 
     explicit unordered_set(size_type bucket_count,
                            const Hash& hash = Hash(),
-                           const KeyEqual equal = KeyEqual()) : ht_(bucket_count, hash, equal) {}
+                           const KeyEqual equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type()) : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class Iter>
     unordered_set(Iter first, Iter last,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal) {
+                  const KeyEqual equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal, alloc) {
         for (; first != last; ++first)
             ht_.insert_unique_noresize(*first);
     }
@@ -69,8 +73,9 @@ class unordered_set {
     unordered_set(std::initializer_list<value_type> ilist,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal) {
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_unique_noresize(*first);
     }
@@ -78,6 +83,10 @@ class unordered_set {
     unordered_set(const unordered_set& rhs) : ht_(rhs.ht_) {}
     unordered_set(unordered_set&& rhs) noexcept : ht_(MySTL::move(rhs.ht_)) {}
 
+    // 指定分配器的构造函数
+    explicit unordered_set(const allocator_type& alloc) : ht_(100, Hash(), KeyEqual(), alloc) {}
+    unordered_set(const unordered_set& rhs, const allocator_type& alloc) : ht_(rhs.ht_, alloc) {}
+
     unordered_set& operator=(const unordered_set& rhs) {
         ht_ = rhs.ht_;
         return *this;
@@ -191,21 +200,21 @@ class unordered_set {
 
 // 重载比较操作符
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator==(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs) {
+bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator!=(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs) {
+bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
 // 重载 MySTL 的 swap
 template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
-          unordered_set<Key, Hash, KeyEqual>& rhs) {
+void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+          unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
@@ -214,11 +223,13 @@ void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
 // 模板类 unordered_multiset，键值允许重复
 // 参数一代表键值类型，参数二代表哈希函数，缺省使用 MySTL::hash，
 // 参数三代表键值比较方式，缺省使用 MySTL::equal_to
-template <class Key, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+// 参数四代表空间配置器类型，缺省使用 default_node_allocator 选出的分配器
+template <class Key, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>,
+          class Alloc = typename default_node_allocator<Key>::type>
 class unordered_multiset {
    private:
     // 使用 hashtable 作为底层机制
-    typedef hashtable<Key, Hash, KeyEqual> base_type;
+    typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -250,15 +261,17 @@ class unordered_multiset {
 
     explicit unordered_multiset(size_type bucket_count,
                                 const Hash& hash = Hash(),
-                                const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal) {}
+                                const KeyEqual& equal = KeyEqual(),
+                                const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class InputIterator>
     unordered_multiset(InputIterator first, InputIterator last,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal) {
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(MySTL::distance(first, last))), hash, equal, alloc) {
         for (; first != last; ++first)
             ht_.insert_multi_noresize(*first);
     }
@@ -266,8 +279,9 @@ class unordered_multiset {
     unordered_multiset(std::initializer_list<value_type> ilist,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
-        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal) {
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
+        : ht_(MySTL::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_multi_noresize(*first);
     }
@@ -275,6 +289,10 @@ class unordered_multiset {
     unordered_multiset(const unordered_multiset& rhs) : ht_(rhs.ht_) {}
     unordered_multiset(unordered_multiset&& rhs) noexcept : ht_(MySTL::move(rhs.ht_)) {}
 
+    // 指定分配器的构造函数
+    explicit unordered_multiset(const allocator_type& alloc) : ht_(100, Hash(), KeyEqual(), alloc) {}
+    unordered_multiset(const unordered_multiset& rhs, const allocator_type& alloc) : ht_(rhs.ht_, alloc) {}
+
     unordered_multiset& operator=(const unordered_multiset& rhs) {
         ht_ = rhs.ht_;
         return *this;
@@ -380,23 +398,41 @@ class unordered_multiset {
 
 // 重载比较操作符
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator==(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs) {
+bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator!=(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs) {
+bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
 // 重载 MySTL 的 swap
 template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_multiset<Key, Hash, KeyEqual>& lhs,
-          unordered_multiset<Key, Hash, KeyEqual>& rhs) {
+void swap(unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+          unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
+// unordered_set / unordered_multiset 只包含一个 hashtable
+template <class Key, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<unordered_set<Key, Hash, KeyEqual, Alloc>> : is_trivially_relocatable<hashtable<Key, Hash, KeyEqual, Alloc>> {};
+
+template <class Key, class Hash, class KeyEqual, class Alloc>
+struct is_trivially_relocatable<unordered_multiset<Key, Hash, KeyEqual, Alloc>> : is_trivially_relocatable<hashtable<Key, Hash, KeyEqual, Alloc>> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class Key, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+using unordered_set = MySTL::unordered_set<Key, Hash, KeyEqual, MySTL::polymorphic_allocator<Key>>;
+
+template <class Key, class Hash = MySTL::hash<Key>, class KeyEqual = MySTL::equal_to<Key>>
+using unordered_multiset = MySTL::unordered_multiset<Key, Hash, KeyEqual, MySTL::polymorphic_allocator<Key>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 // notes:
 // 异常保证：
-// MySTL::vector<T> 满足基本异常保证，部分函数无异常保证，并对以下函数做强异常安全保证：
+// MySTL::vector<T, Alloc, Growth> 满足基本异常保证，部分函数无异常保证，并对以下函数做强异常安全保证：
 //   * emplace
 //   * emplace_back
 //   * push_back
@@ -13,6 +13,14 @@
 //   * reserve
 //   * resize
 //   * insert
+//
+// 元素类型满足 is_trivially_relocatable 时，扩容、insert、erase 用 memcpy / memmove 整体搬运元素，
+// 新元素总是先构造好再搬运旧元素，构造失败时容器保持不变
+// 若分配器还提供了 reallocate（如 MySTL::allocator），扩容与 shrink_to_fit 直接交给它，
+// 大块内存由 mremap 原地扩展，不复制数据，峰值内存接近实际元素占用的大小
+//
+// 容量的增长由模板参数 Growth 决定，缺省为 1.5 倍、至少 16 个元素；
+// 指定个数或区间的构造函数只申请恰好容纳这些元素的空间，reserve 与 shrink_to_fit 同样不多申请
 
 #include <initializer_list>
 
@@ -33,29 +41,80 @@ namespace MySTL {
 #undef min
 #endif  // min
 
-template <class T>
-class vector {
+/*****************************************************************************************/
+// vector 的增长策略
+// min_capacity 为默认构造与第一次扩容时至少申请的元素个数，为 0 时默认构造不申请内存
+// next_capacity(old_cap, required, elem_size) 在容量不足以容纳 required 个元素时给出新的容量，
+// elem_size 为元素大小，结果超过 max_size() 时由 vector 截断
+/*****************************************************************************************/
+
+// 按 Num / Den 倍增长
+template <size_t Num, size_t Den, size_t Min = 0>
+struct vector_growth {
+    static_assert(Den > 0 && Num > Den, "vector_growth requires Num / Den > 1");
+
+    static constexpr size_t min_capacity = Min;
+
+    static size_t next_capacity(size_t old_cap, size_t required, size_t elem_size) noexcept {
+        const size_t limit = static_cast<size_t>(-1) / elem_size;
+        const size_t grown = old_cap > limit / Num * Den ? limit : old_cap / Den * Num + old_cap % Den * Num / Den;
+        return MySTL::max(MySTL::max(grown, required), static_cast<size_t>(Min));
+    }
+};
+
+template <size_t Num, size_t Den, size_t Min>
+constexpr size_t vector_growth<Num, Den, Min>::min_capacity;
+
+// 缺省策略，1.5 倍增长，至少 16 个元素
+typedef vector_growth<3, 2, 16> default_vector_growth;
+
+// 不足一页时按 Num / Den 倍增长，之后把缓冲区的字节数向上取整到 PageSize 的倍数，
+// 适合大缓冲区：增长较慢，浪费不超过一页，按页映射的块也能由 mremap 直接扩展
+template <size_t Num = 5, size_t Den = 4, size_t PageSize = MYSTL_PAGE_SIZE>
+struct page_vector_growth {
+    static constexpr size_t min_capacity = 0;
+
+    static size_t next_capacity(size_t old_cap, size_t required, size_t elem_size) noexcept {
+        const size_t cap = vector_growth<Num, Den>::next_capacity(old_cap, required, elem_size);
+        if (cap > (static_cast<size_t>(-1) - PageSize) / elem_size) return cap;
+        const size_t bytes = cap * elem_size;
+        if (bytes < PageSize) return cap;
+        return (bytes + PageSize - 1) / PageSize * PageSize / elem_size;
+    }
+};
+
+template <size_t Num, size_t Den, size_t PageSize>
+constexpr size_t page_vector_growth<Num, Den, PageSize>::min_capacity;
+
+// 模板类: vector
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型，缺省使用 MySTL::allocator，Growth 代表增长策略
+template <class T, class Alloc = MySTL::allocator<T>, class Growth = MySTL::default_vector_growth>
+class vector : private alloc_holder<Alloc> {
     static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in MySTL");
 
    public:
     // vector类型的嵌套定义
-    typedef MySTL::allocator<T> allocator_type;
-    typedef MySTL::allocator<T> data_allocator;
-
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef MySTL::allocator_traits<Alloc> alloc_traits;
+    typedef MySTL::alloc_holder<Alloc> holder_type;
+    typedef typename MySTL::is_trivially_relocatable<T>::type relocate_tag;
+    typedef typename MySTL::alloc_has_reallocate<Alloc>::type reallocate_tag;
+    typedef Growth growth_policy;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
 
     typedef value_type* iterator;
     typedef const value_type* const_iterator;
     typedef MySTL::reverse_iterator<iterator> reverse_iterator;
     typedef MySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() { return data_allocator(); }
+    allocator_type get_allocator() const { return this->get_alloc(); }
 
    private:
     iterator begin_;  // 表示目前使用空间的头部
@@ -66,35 +125,48 @@ class vector {
     // 构造、复制、移动、析构函数
     vector() noexcept { try_init(); }
 
-    explicit vector(size_type n) { fill_init(n, value_type()); }
+    explicit vector(const allocator_type& alloc) noexcept : holder_type(alloc) { try_init(); }
 
-    vector(size_type n, const value_type& value) { fill_init(n, value); }
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { fill_init(n, value_type()); }
+
+    vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) { fill_init(n, value); }
 
     template <class Iter, typename std::enable_if<MySTL::is_input_iterator<Iter>::value, int>::type = 0>
-    vector(Iter first, Iter last) {
+    vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
         MYSTL_DEBUG(!(last < first));
         range_init(first, last);
     }
 
-    vector(const vector& rhs) {
+    vector(const vector& rhs)
+        : holder_type(alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        range_init(rhs.begin_, rhs.end_);
+    }
+
+    vector(const vector& rhs, const allocator_type& alloc)
+        : holder_type(alloc) {
         range_init(rhs.begin_, rhs.end_);
     }
 
-    vector(vector&& rhs) noexcept : begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
+    vector(vector&& rhs) noexcept
+        : holder_type(MySTL::move(rhs.get_alloc())), begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
         rhs.begin_ = nullptr;
         rhs.end_ = nullptr;
         rhs.cap_ = nullptr;
     }
 
-    vector(std::initializer_list<value_type> list) {
+    vector(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+        : holder_type(alloc) {
         range_init(list.begin(), list.end());
     }
 
     vector& operator=(const vector& rhs);
-    vector& operator=(vector&& rhs) noexcept;
+    vector& operator=(vector&& rhs) noexcept(alloc_traits::is_always_equal::value);
 
     vector& operator=(std::initializer_list<value_type> list) {
-        vector tmp(list.begin(), list.end());
+        vector tmp(list.begin(), list.end(), get_allocator());
         swap(tmp);
         return *this;
     }
@@ -205,7 +277,7 @@ class vector {
 
     // insert
     iterator insert(const_iterator pos, const value_type& value);
-    iterator insert(const_iterator pos, value_type&& value) { emplace(pos, MySTL::move(value)); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, MySTL::move(value)); }
 
     iterator insert(const_iterator pos, size_type n, const value_type& value) {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
@@ -228,6 +300,11 @@ class vector {
     void resize(size_type new_size) { return resize(new_size, value_type()); }
     void resize(size_type new_size, const value_type& value);
 
+    // resize_default_init / append_uninitialized
+    // 新增的元素只做默认初始化，对 int、char 这类平凡类型不写入任何值，由调用者随后填充
+    void resize_default_init(size_type new_size);
+    pointer append_uninitialized(size_type n);
+
     void reverse() { MySTL::reverse(begin(), end()); }
 
     // swap
@@ -270,72 +347,94 @@ class vector {
 
     // shrink_to_fit
     void reinsert(size_type size);
+
+    // relocate
+    void relocate_to(iterator new_begin, size_type new_cap, iterator pos, size_type n);
+    void reallocate_buffer(size_type new_cap);
 };
 
 /*****************************************************************************************/
 
 // 复制赋值操作符
-template <class T>
-vector<T>& vector<T>::operator=(const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(const vector<T, Alloc, Growth>& rhs) {
     if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value && this->get_alloc() != rhs.get_alloc()) {
+            // 原有的空间必须由原来的分配器释放
+            destroy_and_recover(begin_, end_, cap_ - begin_);
+            begin_ = end_ = cap_ = nullptr;
+            MySTL::alloc_copy_assign(this->get_alloc(), rhs.get_alloc());
+        }
         const auto len = rhs.size();
         if (len > capacity()) {
-            vector tmp(rhs.begin(), rhs.end());
+            vector tmp(rhs.begin(), rhs.end(), get_allocator());
             swap(tmp);
         } else if (size() >= len) {
             auto i = MySTL::copy(rhs.begin(), rhs.end(), begin());
-            data_allocator::destroy(i, end_);
+            alloc_traits::destroy(this->get_alloc(), i, end_);
             end_ = begin_ + len;
         } else {
             MySTL::copy(rhs.begin(), rhs.begin() + size(), begin_);
             MySTL::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
-            cap_ = end_ = begin_ + len;
+            end_ = begin_ + len;
         }
     }
     return *this;
 }
 
 // 移动赋值操作符
-template <class T>
-vector<T>& vector<T>::operator=(vector<T>&& rhs) noexcept {
-    destroy_and_recover(begin_, end_, cap_ - begin_);
-    begin_ = rhs.begin_;
-    end_ = rhs.end_;
-    cap_ = rhs.cap_;
-    rhs.begin_ = nullptr;
-    rhs.end_ = nullptr;
-    rhs.cap_ = nullptr;
-
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(vector<T, Alloc, Growth>&& rhs) noexcept(alloc_traits::is_always_equal::value) {
+    if (alloc_traits::propagate_on_container_move_assignment::value || this->get_alloc() == rhs.get_alloc()) {
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        MySTL::alloc_move_assign(this->get_alloc(), rhs.get_alloc());
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.begin_ = nullptr;
+        rhs.end_ = nullptr;
+        rhs.cap_ = nullptr;
+    } else {
+        // 分配器不相等，不能直接接管对方的空间，只能逐个移动元素
+        clear();
+        reserve(rhs.size());
+        for (auto& value : rhs)
+            emplace_back(MySTL::move(value));
+        rhs.clear();
+    }
     return *this;
 }
 
 // 预留空间大小，当原容量小于要求大小时，才会重新分配
-template <class T>
-void vector<T>::reserve(size_type n) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reserve(size_type n) {
     if (capacity() < n) {
         THROW_LENGTH_ERROR_IF(n > max_size(),
                               "n can not larger than max_size() in vector<T>::reserve(n)");
-        const auto old_size = size();
-        auto tmp = data_allocator::allocate(n);
-        MySTL::uninitialized_move(begin_, end_, tmp);
-        data_allocator::deallocate(begin_, cap_ - begin_);
-
-        begin_ = tmp;
-        end_ = begin_ + old_size;
-        cap_ = begin_ + n;
+        if (relocate_tag::value && reallocate_tag::value) {
+            reallocate_buffer(n);
+            return;
+        }
+        auto tmp = alloc_traits::allocate(this->get_alloc(), n);
+        try {
+            relocate_to(tmp, n, end_, 0);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), tmp, n);
+            throw;
+        }
     }
 }
 
 // 放弃多余的容量
-template <class T>
-void vector<T>::shrink_to_fit() {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::shrink_to_fit() {
     if (end_ < cap_) reinsert(size());
 }
 
 // 在 pos 位置就地构造元素，避免额外的复制或移动开销
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-typename vector<T>::iterator vector<T>::emplace(const_iterator pos, Args&&... args) {
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::emplace(const_iterator pos, Args&&... args) {
     MYSTL_DEBUG(pos >= begin() && pos <= end());
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = xpos - begin_;
@@ -343,12 +442,22 @@ typename vector<T>::iterator vector<T>::emplace(const_iterator pos, Args&&... ar
     if (end_ != cap_ && xpos == end_) {
         MySTL::construct(MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
         ++end_;
+    } else if (end_ != cap_ && relocate_tag::value) {
+        // 先在临时空间构造新元素，args 可能引用容器中的元素，再把 [xpos, end_) 整体后移一格
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T* tmp = reinterpret_cast<T*>(&buf);
+        alloc_traits::construct(this->get_alloc(), tmp, MySTL::forward<Args>(args)...);
+        MySTL::uninitialized_relocate(xpos, end_, xpos + 1);
+        MySTL::uninitialized_relocate(tmp, tmp + 1, xpos);
+        ++end_;
     } else if (end_ != cap_) {
+        // 先构造新值，args 可能引用容器中的元素；元素向后移动而不是复制，只能移动的类型也可以使用
+        value_type tmp(MySTL::forward<Args>(args)...);
         auto new_end = end_;
-        data_allocator::construct(MySTL::address_of(*end_), *(end_ - 1));
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), MySTL::move(*(end_ - 1)));
         ++new_end;
-        MySTL::copy_backward(xpos, end_ - 1, end_);
-        *xpos = value_type(MySTL::forward<Args>(args)...);
+        MySTL::move_backward(xpos, end_ - 1, end_);
+        *xpos = MySTL::move(tmp);
         end_ = new_end;
     } else {
         reallocate_emplace(xpos, MySTL::forward<Args>(args)...);
@@ -357,11 +466,11 @@ typename vector<T>::iterator vector<T>::emplace(const_iterator pos, Args&&... ar
 }
 
 // 在尾部就地构造元素，避免额外的复制或移动开销
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-void vector<T>::emplace_back(Args&&... args) {
+void vector<T, Alloc, Growth>::emplace_back(Args&&... args) {
     if (end_ < cap_) {
-        data_allocator::construct(MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), MySTL::forward<Args>(args)...);
         ++end_;
     } else {
         reallocate_emplace(end_, MySTL::forward<Args>(args)...);
@@ -369,10 +478,10 @@ void vector<T>::emplace_back(Args&&... args) {
 }
 
 // 在尾部插入元素
-template <class T>
-void vector<T>::push_back(const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::push_back(const value_type& value) {
     if (end_ != cap_) {
-        data_allocator::construct(MySTL::address_of(*end_), value);
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), value);
         ++end_;
     } else {
         reallocate_insert(end_, value);
@@ -380,26 +489,28 @@ void vector<T>::push_back(const value_type& value) {
 }
 
 // 弹出尾部元素
-template <class T>
-void vector<T>::pop_back() {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::pop_back() {
     MYSTL_DEBUG(!empty());
-    data_allocator::destroy(end_ - 1);
+    alloc_traits::destroy(this->get_alloc(), end_ - 1);
     --end_;
 }
 
 // 在 pos 处插入元素
-template <class T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, const value_type& value) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, const value_type& value) {
     MYSTL_DEBUG(pos >= begin() && pos <= end());
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = pos - begin_;
 
     if (end_ != cap_ && xpos == end_) {
-        data_allocator::construct(MySTL::address_of(*end_), value);
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), value);
         ++end_;
+    } else if (end_ != cap_ && relocate_tag::value) {
+        return emplace(pos, value);
     } else if (end_ != cap_) {
         auto new_end = end_;
-        data_allocator::construct(MySTL::address_of(*end_), *(end_ - 1));
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*end_), *(end_ - 1));
         ++new_end;
         auto value_copy = value;  // 避免元素因以下复制操作而被改变
         MySTL::copy_backward(xpos, end_ - 1, end_);
@@ -413,31 +524,41 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos, const value_t
 }
 
 // 删除 pos 位置上的元素
-template <class T>
-typename vector<T>::iterator vector<T>::erase(const_iterator pos) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(const_iterator pos) {
     MYSTL_DEBUG(pos >= begin() && pos < end());
     iterator xpos = begin_ + (pos - begin());
-    MySTL::move(xpos + 1, end_, xpos);
-    data_allocator::destroy(end_ - 1);
+    if (relocate_tag::value) {
+        alloc_traits::destroy(this->get_alloc(), xpos);
+        MySTL::uninitialized_relocate(xpos + 1, end_, xpos);
+    } else {
+        MySTL::move(xpos + 1, end_, xpos);
+        alloc_traits::destroy(this->get_alloc(), end_ - 1);
+    }
     --end_;
     return xpos;
 }
 
 // 删除[first, last)上的元素
-template <class T>
-typename vector<T>::iterator vector<T>::erase(const_iterator first, const_iterator last) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) {
     MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
     const auto n = first - begin();
 
     iterator r = begin_ + (first - begin());
-    data_allocator::destroy(MySTL::move(r + (last - first), end_, r), end_);
+    if (relocate_tag::value) {
+        alloc_traits::destroy(this->get_alloc(), r, r + (last - first));
+        MySTL::uninitialized_relocate(r + (last - first), end_, r);
+    } else {
+        alloc_traits::destroy(this->get_alloc(), MySTL::move(r + (last - first), end_, r), end_);
+    }
     end_ = end_ - (last - first);
     return begin_ + n;
 }
 
 // 重置容器大小
-template <class T>
-void vector<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize(size_type new_size, const value_type& value) {
     if (new_size < size()) {
         erase(begin() + new_size, end());
     } else {
@@ -445,10 +566,30 @@ void vector<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
+// 重置容器大小，新增的元素默认初始化
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_default_init(size_type new_size) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        append_uninitialized(new_size - size());
+    }
+}
+
+// 在尾部追加 n 个默认初始化的元素，返回指向第一个新元素的指针
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::pointer vector<T, Alloc, Growth>::append_uninitialized(size_type n) {
+    if (static_cast<size_type>(cap_ - end_) < n)
+        reserve(get_new_cap(n));
+    end_ = MySTL::uninitialized_default_construct_n(end_, n);
+    return end_ - n;
+}
+
 // 与另一个 vector 交换
-template <class T>
-void vector<T>::swap(vector<T>& rhs) noexcept {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::swap(vector<T, Alloc, Growth>& rhs) noexcept {
     if (this != &rhs) {
+        MySTL::alloc_swap(this->get_alloc(), rhs.get_alloc());
         MySTL::swap(begin_, rhs.begin_);
         MySTL::swap(end_, rhs.end_);
         MySTL::swap(cap_, rhs.cap_);
@@ -458,13 +599,13 @@ void vector<T>::swap(vector<T>& rhs) noexcept {
 /*****************************************************************************************/
 // helper function
 
-// try_init 函数，若分配失败则忽略，不抛出异常
-template <class T>
-void vector<T>::try_init() noexcept {
+// try_init 函数，按增长策略预先申请 min_capacity 个元素的空间，若分配失败则忽略，不抛出异常
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::try_init() noexcept {
     try {
-        begin_ = data_allocator::allocate(16);
+        begin_ = Growth::min_capacity == 0 ? nullptr : alloc_traits::allocate(this->get_alloc(), Growth::min_capacity);
         end_ = begin_;
-        cap_ = begin_ + 16;
+        cap_ = begin_ == nullptr ? nullptr : begin_ + Growth::min_capacity;
     } catch (...) {
         begin_ = nullptr;
         end_ = nullptr;
@@ -473,10 +614,10 @@ void vector<T>::try_init() noexcept {
 }
 
 // init_space 函数
-template <class T>
-void vector<T>::init_space(size_type size, size_type cap) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::init_space(size_type size, size_type cap) {
     try {
-        begin_ = data_allocator::allocate(cap);
+        begin_ = alloc_traits::allocate(this->get_alloc(), cap);
         end_ = begin_ + size;
         cap_ = begin_ + cap;
     } catch (...) {
@@ -487,52 +628,44 @@ void vector<T>::init_space(size_type size, size_type cap) {
     }
 }
 
-// fill_init 函数
-template <class T>
-void vector<T>::fill_init(size_type n, const value_type& value) {
-    const size_type init_size = MySTL::max(static_cast<size_type>(16), n);
-    init_space(n, init_size);
+// fill_init 函数，只申请恰好容纳 n 个元素的空间
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::fill_init(size_type n, const value_type& value) {
+    init_space(n, n);
     MySTL::uninitialized_fill_n(begin_, n, value);
 }
 
 // range_init 函数
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::range_init(Iter first, Iter last) {
+void vector<T, Alloc, Growth>::range_init(Iter first, Iter last) {
     const size_type len = MySTL::distance(first, last);
-    const size_type init_size = MySTL::max(len, static_cast<size_type>(16));
-    init_space(len, init_size);
+    init_space(len, len);
     MySTL::uninitialized_copy(first, last, begin_);
 }
 
 // destroy_and_recover 函数
-template <class T>
-void vector<T>::destroy_and_recover(iterator first, iterator last, size_type n) {
-    data_allocator::destroy(first, last);
-    data_allocator::deallocate(first, n);
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::destroy_and_recover(iterator first, iterator last, size_type n) {
+    alloc_traits::destroy(this->get_alloc(), first, last);
+    if (first != nullptr)
+        alloc_traits::deallocate(this->get_alloc(), first, n);
 }
 
-// get_new_cap 函数
-template <class T>
-typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size) {
-    const auto old_size = capacity();
-    THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size, "vector<T>'s size is too big!");
-
-    if (old_size > max_size() - old_size / 2) {
-        return old_size + add_size > max_size() - 16 ? old_size + add_size : old_size + add_size + 16;
-    }
-
-    const size_type new_size = old_size == 0
-                                   ? MySTL::max(add_size, static_cast<size_type>(16))
-                                   : MySTL::max(old_size + old_size / 2, old_size + add_size);
-    return new_size;
+// get_new_cap 函数，由增长策略给出容纳 size() + add_size 个元素的新容量
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::get_new_cap(size_type add_size) {
+    THROW_LENGTH_ERROR_IF(size() > max_size() - add_size, "vector<T>'s size is too big!");
+    const size_type required = size() + add_size;
+    const size_type new_size = Growth::next_capacity(capacity(), required, sizeof(T));
+    return MySTL::min(MySTL::max(new_size, required), max_size());
 }
 
 // fill_assign 函数
-template <class T>
-void vector<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::fill_assign(size_type n, const value_type& value) {
     if (n > capacity()) {
-        vector tmp(n, value);
+        vector tmp(n, value, get_allocator());
         swap(tmp);
     } else if (n > size()) {
         MySTL::fill(begin(), end(), value);
@@ -543,9 +676,9 @@ void vector<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 // copy_assign 函数
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::copy_assign(Iter first, Iter last, input_iterator_tag) {
+void vector<T, Alloc, Growth>::copy_assign(Iter first, Iter last, input_iterator_tag) {
     auto cur = begin_;
     for (; first != last && cur != end_; ++first, ++cur) {
         *cur = *first;
@@ -557,17 +690,17 @@ void vector<T>::copy_assign(Iter first, Iter last, input_iterator_tag) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
+void vector<T, Alloc, Growth>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
     const size_type len = MySTL::distance(first, last);
 
     if (len > capacity()) {
-        vector tmp(first, last);
+        vector tmp(first, last, get_allocator());
         swap(tmp);
     } else if (size() >= len) {
         auto new_end = MySTL::copy(first, last, begin_);
-        data_allocator::destroy(new_end, end_);
+        alloc_traits::destroy(this->get_alloc(), new_end, end_);
         end_ = new_end;
     } else {
         auto mid = first;
@@ -579,20 +712,50 @@ void vector<T>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
 }
 
 // 重新分配空间并在 pos 处就地构造元素
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-void vector<T>::reallocate_emplace(iterator pos, Args&&... args) {
+void vector<T, Alloc, Growth>::reallocate_emplace(iterator pos, Args&&... args) {
     const auto new_size = get_new_cap(1);
-    auto new_begin = data_allocator::allocate(new_size);
+    if (relocate_tag::value && reallocate_tag::value) {
+        // args 可能引用容器中的元素，扩容后原来的地址会失效，所以先在临时空间构造新元素
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T* tmp = reinterpret_cast<T*>(&buf);
+        alloc_traits::construct(this->get_alloc(), tmp, MySTL::forward<Args>(args)...);
+        const size_type xpos = pos - begin_;
+        try {
+            reallocate_buffer(new_size);
+        } catch (...) {
+            alloc_traits::destroy(this->get_alloc(), tmp);
+            throw;
+        }
+        pos = begin_ + xpos;
+        MySTL::uninitialized_relocate(pos, end_, pos + 1);
+        MySTL::uninitialized_relocate(tmp, tmp + 1, pos);
+        ++end_;
+        return;
+    }
+    auto new_begin = alloc_traits::allocate(this->get_alloc(), new_size);
     auto new_end = new_begin;
 
+    if (relocate_tag::value) {
+        // 先构造新元素，再按字节搬运原有元素
+        try {
+            alloc_traits::construct(this->get_alloc(), new_begin + (pos - begin_), MySTL::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_size);
+            throw;
+        }
+        relocate_to(new_begin, new_size, pos, 1);
+        return;
+    }
+
     try {
         new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(MySTL::address_of(*new_end), MySTL::forward<Args>(args)...);
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*new_end), MySTL::forward<Args>(args)...);
         ++new_end;
         new_end = MySTL::uninitialized_move(pos, end_, new_end);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        alloc_traits::deallocate(this->get_alloc(), new_begin, new_size);
         throw;
     }
     destroy_and_recover(begin_, end_, cap_ - begin_);
@@ -602,20 +765,48 @@ void vector<T>::reallocate_emplace(iterator pos, Args&&... args) {
 }
 
 // 重新分配空间并在 pos 处插入元素
-template <class T>
-void vector<T>::reallocate_insert(iterator pos, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reallocate_insert(iterator pos, const value_type& value) {
     const auto new_size = get_new_cap(1);
-    auto new_begin = data_allocator::allocate(new_size);
+    if (relocate_tag::value && reallocate_tag::value) {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T* tmp = reinterpret_cast<T*>(&buf);
+        alloc_traits::construct(this->get_alloc(), tmp, value);
+        const size_type xpos = pos - begin_;
+        try {
+            reallocate_buffer(new_size);
+        } catch (...) {
+            alloc_traits::destroy(this->get_alloc(), tmp);
+            throw;
+        }
+        pos = begin_ + xpos;
+        MySTL::uninitialized_relocate(pos, end_, pos + 1);
+        MySTL::uninitialized_relocate(tmp, tmp + 1, pos);
+        ++end_;
+        return;
+    }
+    auto new_begin = alloc_traits::allocate(this->get_alloc(), new_size);
     auto new_end = new_begin;
     const value_type& value_copy = value;
 
+    if (relocate_tag::value) {
+        try {
+            alloc_traits::construct(this->get_alloc(), new_begin + (pos - begin_), value_copy);
+        } catch (...) {
+            alloc_traits::deallocate(this->get_alloc(), new_begin, new_size);
+            throw;
+        }
+        relocate_to(new_begin, new_size, pos, 1);
+        return;
+    }
+
     try {
         new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(MySTL::address_of(*new_end), value_copy);
+        alloc_traits::construct(this->get_alloc(), MySTL::address_of(*new_end), value_copy);
         ++new_end;
         MySTL::uninitialized_move(pos, end_, new_end);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        alloc_traits::deallocate(this->get_alloc(), new_begin, new_size);
         throw;
     }
     destroy_and_recover(begin_, end_, cap_ - begin_);
@@ -625,8 +816,8 @@ void vector<T>::reallocate_insert(iterator pos, const value_type& value) {
 }
 
 // fill_insert 函数
-template <class T>
-typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::fill_insert(iterator pos, size_type n, const value_type& value) {
     if (n == 0) return pos;
     const size_type xpos = pos - begin_;
     const value_type value_copy = value;
@@ -635,7 +826,17 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n, c
         // 如果备用空间大于等于增加的空间
         const size_type after_elems = end_ - pos;
         auto old_end = end_;
-        if (after_elems > n) {
+        if (relocate_tag::value) {
+            // 把 [pos, end_) 整体后移 n 格，填充失败时再搬回原处
+            MySTL::uninitialized_relocate(pos, end_, pos + n);
+            try {
+                MySTL::uninitialized_fill_n(pos, n, value_copy);
+            } catch (...) {
+                MySTL::uninitialized_relocate(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
             MySTL::uninitialized_copy(end_ - n, end_, end_);
             end_ += n;
             MySTL::move_backward(pos, old_end - n, old_end);
@@ -648,8 +849,18 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n, c
     } else {
         // 如果备用空间不足
         const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator::allocate(new_size);
+        auto new_begin = alloc_traits::allocate(this->get_alloc(), new_size);
         auto new_end = new_begin;
+        if (relocate_tag::value) {
+            try {
+                MySTL::uninitialized_fill_n(new_begin + xpos, n, value_copy);
+            } catch (...) {
+                alloc_traits::deallocate(this->get_alloc(), new_begin, new_size);
+                throw;
+            }
+            relocate_to(new_begin, new_size, pos, n);
+            return begin_ + xpos;
+        }
         try {
             new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
             new_end = MySTL::uninitialized_fill_n(new_end, n, value);
@@ -658,7 +869,7 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n, c
             destroy_and_recover(new_begin, new_end, new_size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        alloc_traits::deallocate(this->get_alloc(), begin_, cap_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = new_begin + new_size;
@@ -667,9 +878,9 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n, c
 }
 
 // copy_insert 函数
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::copy_inset(iterator pos, Iter first, Iter last) {
+void vector<T, Alloc, Growth>::copy_inset(iterator pos, Iter first, Iter last) {
     if (first == last) return;
 
     const auto n = MySTL::distance(first, last);
@@ -677,7 +888,16 @@ void vector<T>::copy_inset(iterator pos, Iter first, Iter last) {
         // 如果备用空间大小足够
         const auto after_elems = end_ - pos;
         auto old_end = end_;
-        if (after_elems > n) {
+        if (relocate_tag::value) {
+            MySTL::uninitialized_relocate(pos, end_, pos + n);
+            try {
+                MySTL::uninitialized_copy(first, last, pos);
+            } catch (...) {
+                MySTL::uninitialized_relocate(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
             end_ = MySTL::uninitialized_copy(end_ - n, end_, end_);
             MySTL::move_backward(pos, old_end - n, old_end);
             MySTL::uninitialized_copy(first, last, pos);
@@ -691,9 +911,20 @@ void vector<T>::copy_inset(iterator pos, Iter first, Iter last) {
     } else {
         // 备用空间不足
         const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator::allocate(new_size);
+        auto new_begin = alloc_traits::allocate(this->get_alloc(), new_size);
         auto new_end = new_begin;
 
+        if (relocate_tag::value) {
+            try {
+                MySTL::uninitialized_copy(first, last, new_begin + (pos - begin_));
+            } catch (...) {
+                alloc_traits::deallocate(this->get_alloc(), new_begin, new_size);
+                throw;
+            }
+            relocate_to(new_begin, new_size, pos, n);
+            return;
+        }
+
         try {
             new_end = MySTL::uninitialized_move(begin_, pos, new_begin);
             new_end = MySTL::uninitialized_copy(first, last, new_end);
@@ -702,7 +933,7 @@ void vector<T>::copy_inset(iterator pos, Iter first, Iter last) {
             destroy_and_recover(new_begin, new_end, new_size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        alloc_traits::deallocate(this->get_alloc(), begin_, cap_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
@@ -710,58 +941,98 @@ void vector<T>::copy_inset(iterator pos, Iter first, Iter last) {
 }
 
 // reinsert 函数
-template <class T>
-void vector<T>::reinsert(size_type size) {
-    auto new_begin = data_allocator::allocate(size);
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reinsert(size_type size) {
+    if (relocate_tag::value && reallocate_tag::value) {
+        reallocate_buffer(size);
+        return;
+    }
+    auto new_begin = alloc_traits::allocate(this->get_alloc(), size);
     try {
-        MySTL::uninitialized_move(begin_, end_, new_begin);
+        relocate_to(new_begin, size, end_, 0);
     } catch (...) {
-        data_allocator::deallocate(new_begin, size);
+        alloc_traits::deallocate(this->get_alloc(), new_begin, size);
         throw;
     }
+}
 
-    data_allocator::deallocate(begin_, cap_ - begin_);
+// relocate_to 函数
+// 把原有元素搬到 new_begin 开始的新空间，在 pos 对应的位置留出 n 个由调用者构造好的元素，随后释放旧空间
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::relocate_to(iterator new_begin, size_type new_cap, iterator pos, size_type n) {
+    const size_type before = pos - begin_;
+    const size_type old_size = size();
+    MySTL::uninitialized_relocate(begin_, pos, new_begin);
+    MySTL::uninitialized_relocate(pos, end_, new_begin + before + n);
+    if (begin_ != nullptr)
+        alloc_traits::deallocate(this->get_alloc(), begin_, cap_ - begin_);
     begin_ = new_begin;
-    end_ = begin_ + size;
-    cap_ = begin_ + size;
+    end_ = new_begin + old_size + n;
+    cap_ = new_begin + new_cap;
+}
+
+// reallocate_buffer 函数
+// 由分配器把缓冲区换成 new_cap 个元素的大小，元素按字节保留，失败时容器保持不变
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reallocate_buffer(size_type new_cap) {
+    const size_type old_size = size();
+    begin_ = alloc_traits::reallocate(this->get_alloc(), begin_, cap_ - begin_, new_cap);
+    end_ = begin_ + old_size;
+    cap_ = begin_ + new_cap;
 }
 
 /*****************************************************************************************/
 // 重载比较操作符
-template <class T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs) {
-    return lhs.size == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+template <class T, class Alloc, class Growth>
+bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
+    return lhs.size() == rhs.size() && MySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return MySTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载 MySTL 的 swap
-template <class T>
-void swap(vector<T>& lhs, vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs) {
     lhs.swap(rhs);
 }
+// data() 起始于 Align 边界的 vector，缺省对齐到缓存行，按页对齐时使用 aligned_vector<T, MYSTL_PAGE_SIZE>
+template <class T, size_t Align = MYSTL_CACHE_LINE_SIZE>
+using aligned_vector = MySTL::vector<T, MySTL::aligned_allocator<T, Align>>;
+
+// vector 只保存指向缓冲区的指针，分配器可以平凡重定位时 vector 也可以
+template <class T, class Alloc, class Growth>
+struct is_trivially_relocatable<vector<T, Alloc, Growth>> : is_trivially_relocatable<Alloc> {};
+
+// pmr 版本，使用 polymorphic_allocator，内存来自运行期指定的 memory_resource
+namespace pmr {
+
+template <class T>
+using vector = MySTL::vector<T, MySTL::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace MySTL
 #endif
\ No newline at end of file
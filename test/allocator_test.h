@@ -0,0 +1,362 @@
+﻿#ifndef MYTINYSTL_ALLOCATOR_TEST_H_
+#define MYTINYSTL_ALLOCATOR_TEST_H_
+
+// allocator test : 测试 pool_allocator 与 aligned_allocator 的接口、容器的 Allocator 模板参数，以及节点容器在反复插入、删除下的分配性能
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/deque.h"
+#include "../STL_Impl/list.h"
+#include "../STL_Impl/map.h"
+#include "../STL_Impl/memory.h"
+#include "../STL_Impl/unordered_map.h"
+#include "../STL_Impl/vector.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace allocator_test {
+
+// 有状态的分配器，把分配出去的字节数记在外部计数器上，用来检查容器是否经由传入的分配器申请内存
+template <class T>
+class counting_allocator {
+   public:
+    typedef T value_type;
+
+    explicit counting_allocator(size_t* bytes) noexcept : bytes_(bytes) {}
+    template <class U>
+    counting_allocator(const counting_allocator<U>& rhs) noexcept : bytes_(rhs.bytes_) {}
+
+    T* allocate(size_t n) {
+        *bytes_ += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        *bytes_ -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    size_t* bytes_;
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept {
+    return lhs.bytes_ == rhs.bytes_;
+}
+
+template <class T, class U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept {
+    return lhs.bytes_ != rhs.bytes_;
+}
+
+// 扩展对齐的类型，模拟 SIMD 向量
+struct alignas(64) simd_block {
+    float lane[16];
+};
+
+// 先插入 count 个元素再逐个删除，重复两轮，第二轮会复用第一轮释放的节点
+#define NODE_CHURN_DO_TEST(con, insert, erase, count)                                       \
+    do {                                                                                    \
+        srand((int)time(0));                                                                \
+        clock_t start, end;                                                                 \
+        con c;                                                                              \
+        char buf[10];                                                                       \
+        start = clock();                                                                    \
+        for (int round = 0; round < 2; ++round) {                                           \
+            for (size_t i = 0; i < count; ++i) insert;                                      \
+            for (size_t i = 0; i < count; ++i) erase;                                       \
+        }                                                                                   \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// 直接用分配器申请 count 个节点再全部释放，重复两轮
+#define NODE_ALLOC_DO_TEST(alloc, node, count)                                              \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        node** p = new node*[count];                                                        \
+        char buf[10];                                                                       \
+        start = clock();                                                                    \
+        for (int round = 0; round < 2; ++round) {                                           \
+            for (size_t i = 0; i < count; ++i) p[i] = alloc<node>::allocate(1);             \
+            for (size_t i = 0; i < count; ++i) alloc<node>::deallocate(p[i], 1);            \
+        }                                                                                   \
+        end = clock();                                                                      \
+        delete[] p;                                                                         \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// 每一轮构造一个容器，执行 fill 使缓冲区增长若干次，随后析构，缓冲区的申请与释放都带有大小
+#define BUFFER_CHURN_DO_TEST(con, fill, count)                                              \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < count; ++i) {                                                \
+            con c;                                                                          \
+            fill;                                                                           \
+        }                                                                                   \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define BUFFER_CHURN_TEST(std_con, my_con, fill, len1, len2, len3) \
+    TEST_LEN(len1, len2, len3, WIDE);                              \
+    std::cout << "|         std         |";                        \
+    BUFFER_CHURN_DO_TEST(std_con, fill, len1);                     \
+    BUFFER_CHURN_DO_TEST(std_con, fill, len2);                     \
+    BUFFER_CHURN_DO_TEST(std_con, fill, len3);                     \
+    std::cout << "\n|        MySTL        |";                      \
+    BUFFER_CHURN_DO_TEST(my_con, fill, len1);                      \
+    BUFFER_CHURN_DO_TEST(my_con, fill, len2);                      \
+    BUFFER_CHURN_DO_TEST(my_con, fill, len3);
+
+// my_con 使用缺省的 pool_allocator，plain_con 通过 Allocator 参数换成 MySTL::allocator
+#define NODE_CHURN_TEST(std_con, my_con, plain_con, insert, erase, len1, len2, len3) \
+    TEST_LEN(len1, len2, len3, WIDE);                                               \
+    std::cout << "|         std         |";                                         \
+    NODE_CHURN_DO_TEST(std_con, insert, erase, len1);                               \
+    NODE_CHURN_DO_TEST(std_con, insert, erase, len2);                               \
+    NODE_CHURN_DO_TEST(std_con, insert, erase, len3);                               \
+    std::cout << "\n|        MySTL        |";                                       \
+    NODE_CHURN_DO_TEST(my_con, insert, erase, len1);                                \
+    NODE_CHURN_DO_TEST(my_con, insert, erase, len2);                                \
+    NODE_CHURN_DO_TEST(my_con, insert, erase, len3);                                \
+    std::cout << "\n|  MySTL (allocator)  |";                                       \
+    NODE_CHURN_DO_TEST(plain_con, insert, erase, len1);                             \
+    NODE_CHURN_DO_TEST(plain_con, insert, erase, len2);                             \
+    NODE_CHURN_DO_TEST(plain_con, insert, erase, len3);
+
+// 每个线程各自持有一个 map 和一个 list，反复插入 count 个元素后清空，计时以所有线程结束为准
+template <class Map, class List>
+void thread_churn(size_t count) {
+    Map m;
+    List l;
+    for (int round = 0; round < 4; ++round) {
+        for (size_t i = 0; i < count; ++i) {
+            m.emplace(static_cast<int>(i), static_cast<int>(i));
+            l.push_back(static_cast<int>(i));
+        }
+        m.clear();
+        l.clear();
+    }
+}
+
+#define THREAD_CHURN_DO_TEST(map, list, threads, len)                                                         \
+    do {                                                                                                      \
+        char buf[10];                                                                                         \
+        std::vector<std::thread> workers;                                                                     \
+        auto start = std::chrono::steady_clock::now();                                                        \
+        for (size_t k = 0; k < threads; ++k) workers.emplace_back(thread_churn<map, list>, len);              \
+        for (size_t k = 0; k < threads; ++k) workers[k].join();                                               \
+        auto end = std::chrono::steady_clock::now();                                                          \
+        int n = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                                             \
+        std::string t = buf;                                                                                  \
+        t += "ms    |";                                                                                       \
+        std::cout << std::setw(WIDE) << t;                                                                    \
+    } while (0)
+
+// 表头是线程数，每个线程的工作量相同，理想的扩展下三列耗时相等
+#define THREAD_CHURN_TEST(std_map, std_list, my_map, my_list, plain_map, plain_list, len, t1, t2, t3) \
+    TEST_LEN(t1, t2, t3, WIDE);                                                                       \
+    std::cout << "|         std         |";                                                           \
+    THREAD_CHURN_DO_TEST(std_map, std_list, t1, len);                                                 \
+    THREAD_CHURN_DO_TEST(std_map, std_list, t2, len);                                                 \
+    THREAD_CHURN_DO_TEST(std_map, std_list, t3, len);                                                 \
+    std::cout << "\n|        MySTL        |";                                                         \
+    THREAD_CHURN_DO_TEST(my_map, my_list, t1, len);                                                   \
+    THREAD_CHURN_DO_TEST(my_map, my_list, t2, len);                                                   \
+    THREAD_CHURN_DO_TEST(my_map, my_list, t3, len);                                                   \
+    std::cout << "\n|  MySTL (allocator)  |";                                                         \
+    THREAD_CHURN_DO_TEST(plain_map, plain_list, t1, len);                                             \
+    THREAD_CHURN_DO_TEST(plain_map, plain_list, t2, len);                                             \
+    THREAD_CHURN_DO_TEST(plain_map, plain_list, t3, len);
+
+#define NODE_ALLOC_TEST(node, len1, len2, len3)            \
+    TEST_LEN(len1, len2, len3, WIDE);                      \
+    std::cout << "|      allocator      |";                \
+    NODE_ALLOC_DO_TEST(MySTL::allocator, node, len1);      \
+    NODE_ALLOC_DO_TEST(MySTL::allocator, node, len2);      \
+    NODE_ALLOC_DO_TEST(MySTL::allocator, node, len3);      \
+    std::cout << "\n|   pool_allocator    |";              \
+    NODE_ALLOC_DO_TEST(MySTL::pool_allocator, node, len1); \
+    NODE_ALLOC_DO_TEST(MySTL::pool_allocator, node, len2); \
+    NODE_ALLOC_DO_TEST(MySTL::pool_allocator, node, len3);
+
+void allocator_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------------- Run container test : allocator ---------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    typedef MySTL::rb_tree_node<MySTL::pair<const int, int>> node_type;
+    node_type* p1 = MySTL::pool_allocator<node_type>::allocate(1);
+    node_type* p2 = MySTL::pool_allocator<node_type>::allocate(1);
+    FUN_VALUE((p1 != p2));
+    FUN_VALUE(reinterpret_cast<uintptr_t>(p1) % alignof(node_type));
+    MySTL::pool_allocator<node_type>::deallocate(p1, 1);
+    node_type* p3 = MySTL::pool_allocator<node_type>::allocate(1);
+    FUN_VALUE((p1 == p3));
+    MySTL::pool_allocator<node_type>::deallocate(p2, 1);
+    MySTL::pool_allocator<node_type>::deallocate(p3, 1);
+    int* big = MySTL::pool_allocator<int>::allocate(1024);
+    FUN_VALUE(MySTL::node_pool::is_pooled(1024 * sizeof(int), alignof(int)));
+    MySTL::pool_allocator<int>::deallocate(big, 1024);
+
+    // 在一个线程上分配、另一个线程上释放，释放的节点经由中心链表回到分配线程
+    {
+        MySTL::vector<node_type*> nodes;
+        for (int i = 0; i < 1000; ++i) nodes.push_back(MySTL::pool_allocator<node_type>::allocate(1));
+        std::thread releaser([&nodes]() {
+            for (size_t i = 0; i < nodes.size(); ++i) MySTL::pool_allocator<node_type>::deallocate(nodes[i], 1);
+        });
+        releaser.join();
+        std::thread worker([]() {
+            MySTL::map<int, int> m;
+            for (int i = 0; i < 1000; ++i) m.emplace(i, i);
+        });
+        worker.join();
+        MySTL::list<int> l(1000, 1);
+        FUN_VALUE(l.size());
+    }
+
+    // 空的分配器不占用容器的空间
+    FUN_VALUE(sizeof(MySTL::vector<int>));
+    FUN_VALUE(sizeof(MySTL::list<int>));
+    FUN_VALUE(sizeof(MySTL::map<int, int>));
+
+    // 所有内存都应经由传入的分配器申请，容器析构后计数归零
+    size_t bytes = 0;
+    {
+        counting_allocator<int> alloc(&bytes);
+        MySTL::vector<int, counting_allocator<int>> v(alloc);
+        MySTL::deque<int, counting_allocator<int>> d(alloc);
+        MySTL::list<int, counting_allocator<int>> l(alloc);
+        MySTL::map<int, int, MySTL::less<int>, counting_allocator<MySTL::pair<const int, int>>> m(alloc);
+        MySTL::unordered_map<int, int, MySTL::hash<int>, MySTL::equal_to<int>, counting_allocator<MySTL::pair<const int, int>>> um(alloc);
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+            d.push_front(i);
+            l.push_back(i);
+            m.emplace(i, i);
+            um.emplace(i, i);
+        }
+        FUN_VALUE((bytes > 1000 * 5 * sizeof(int)));
+        MySTL::vector<int, counting_allocator<int>> v2(v);
+        MySTL::list<int, counting_allocator<int>> l2(MySTL::move(l));
+        FUN_VALUE((v2.get_allocator() == alloc));
+        FUN_VALUE(l2.size());
+    }
+    FUN_VALUE(bytes);
+
+    // 扩展对齐的类型放进容器后仍然满足 alignof，aligned_vector 的 data() 对齐到缓存行或内存页
+    {
+        MySTL::vector<simd_block> v(10);
+        MySTL::deque<simd_block> d(100);
+        MySTL::list<simd_block> l(3);
+        FUN_VALUE(reinterpret_cast<uintptr_t>(v.data()) % alignof(simd_block));
+        FUN_VALUE(reinterpret_cast<uintptr_t>(&d[99]) % alignof(simd_block));
+        FUN_VALUE(reinterpret_cast<uintptr_t>(&l.back()) % alignof(simd_block));
+        MySTL::aligned_vector<char> cv(3, 'a');
+        MySTL::aligned_vector<int, MYSTL_PAGE_SIZE> pv;
+        pv.push_back(1);
+        FUN_VALUE(reinterpret_cast<uintptr_t>(cv.data()) % MYSTL_CACHE_LINE_SIZE);
+        FUN_VALUE(reinterpret_cast<uintptr_t>(pv.data()) % MYSTL_PAGE_SIZE);
+    }
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    typedef std::list<int> std_list;
+    typedef MySTL::list<int> my_list;
+    typedef MySTL::list<int, MySTL::allocator<int>> plain_list;
+    typedef std::map<int, int> std_map;
+    typedef MySTL::map<int, int> my_map;
+    typedef MySTL::map<int, int, MySTL::less<int>, MySTL::allocator<MySTL::pair<const int, int>>> plain_map;
+    typedef std::unordered_map<int, int> std_umap;
+    typedef MySTL::unordered_map<int, int> my_umap;
+    typedef MySTL::unordered_map<int, int, MySTL::hash<int>, MySTL::equal_to<int>, MySTL::allocator<MySTL::pair<const int, int>>> plain_umap;
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     node alloc      |";
+#if LARGER_TEST_DATA_ON
+    NODE_ALLOC_TEST(node_type, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    NODE_ALLOC_TEST(node_type, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     list churn      |";
+#if LARGER_TEST_DATA_ON
+    NODE_CHURN_TEST(std_list, my_list, plain_list, c.push_back(static_cast<int>(i)), c.pop_front(), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    NODE_CHURN_TEST(std_list, my_list, plain_list, c.push_back(static_cast<int>(i)), c.pop_front(), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|      map churn      |";
+#if LARGER_TEST_DATA_ON
+    NODE_CHURN_TEST(std_map, my_map, plain_map, c.emplace(static_cast<int>(i), rand()), c.erase(static_cast<int>(i)), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    NODE_CHURN_TEST(std_map, my_map, plain_map, c.emplace(static_cast<int>(i), rand()), c.erase(static_cast<int>(i)), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| unordered_map churn |";
+#if LARGER_TEST_DATA_ON
+    NODE_CHURN_TEST(std_umap, my_umap, plain_umap, c.emplace(static_cast<int>(i), rand()), c.erase(static_cast<int>(i)), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    NODE_CHURN_TEST(std_umap, my_umap, plain_umap, c.emplace(static_cast<int>(i), rand()), c.erase(static_cast<int>(i)), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    vector churn     |";
+#if LARGER_TEST_DATA_ON
+    BUFFER_CHURN_TEST(std::vector<int>, MySTL::vector<int>, for (int k = 0; k < 100; ++k) c.push_back(k), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    BUFFER_CHURN_TEST(std::vector<int>, MySTL::vector<int>, for (int k = 0; k < 100; ++k) c.push_back(k), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    string churn     |";
+#if LARGER_TEST_DATA_ON
+    BUFFER_CHURN_TEST(std::string, MySTL::string, for (int k = 0; k < 100; ++k) c.push_back('a'), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    BUFFER_CHURN_TEST(std::string, MySTL::string, for (int k = 0; k < 100; ++k) c.push_back('a'), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  map+list threads   |";
+#if LARGER_TEST_DATA_ON
+    THREAD_CHURN_TEST(std_map, std_list, my_map, my_list, plain_map, plain_list, LEN1, 1, 4, 16);
+#else
+    THREAD_CHURN_TEST(std_map, std_list, my_map, my_list, plain_map, plain_list, LEN1, 1, 2, 4);
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : allocator ----------------]" << std::endl;
+}
+
+}  // namespace allocator_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_ALLOCATOR_TEST_H_
@@ -0,0 +1,160 @@
+﻿#ifndef MYTINYSTL_BIT_VECTOR_TEST_H_
+#define MYTINYSTL_BIT_VECTOR_TEST_H_
+
+// bit_vector test : 测试 bit_vector 的接口，以及 count、find、fill 按字处理的性能
+
+#include <algorithm>
+#include <vector>
+
+#include "../STL_Impl/algo.h"
+#include "../STL_Impl/bit_vector.h"
+#include "../STL_Impl/vector.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace bit_vector_test {
+
+// 构造 len 个元素、只有最后一个为 true 的容器，把 body 执行 rounds 次，alg 为算法所在的命名空间
+#define BIT_DO_TEST(con, ns, rounds, body, len)                                             \
+    do {                                                                                    \
+        namespace alg = ns;                                                                 \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        volatile size_t sink = 0;                                                           \
+        const size_t n = len;                                                               \
+        con c(n, false);                                                                    \
+        c[n - 1] = true;                                                                    \
+        start = clock();                                                                    \
+        for (int r = 0; r < rounds; ++r) {                                                  \
+            body;                                                                           \
+        }                                                                                   \
+        end = clock();                                                                      \
+        (void)sink;                                                                         \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define BIT_TEST(rounds, body, len1, len2, len3)                          \
+    TEST_LEN(len1, len2, len3, WIDE);                                     \
+    std::cout << "|   std vector<bool>  |";                               \
+    BIT_DO_TEST(std::vector<bool>, std, rounds, body, len1);              \
+    BIT_DO_TEST(std::vector<bool>, std, rounds, body, len2);              \
+    BIT_DO_TEST(std::vector<bool>, std, rounds, body, len3);              \
+    std::cout << "\n| MySTL vector<char>  |";                             \
+    BIT_DO_TEST(MySTL::vector<char>, MySTL, rounds, body, len1);          \
+    BIT_DO_TEST(MySTL::vector<char>, MySTL, rounds, body, len2);          \
+    BIT_DO_TEST(MySTL::vector<char>, MySTL, rounds, body, len3);          \
+    std::cout << "\n|     bit_vector      |";                             \
+    BIT_DO_TEST(MySTL::bit_vector<>, MySTL, rounds, body, len1);          \
+    BIT_DO_TEST(MySTL::bit_vector<>, MySTL, rounds, body, len2);          \
+    BIT_DO_TEST(MySTL::bit_vector<>, MySTL, rounds, body, len3);
+
+void bit_vector_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[--------------- Run container test : bit_vector ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    bool a[] = {true, false, true, true, false};
+    MySTL::bit_vector<> v1;
+    MySTL::bit_vector<> v2(10);
+    MySTL::bit_vector<> v3(70, true);
+    MySTL::bit_vector<> v4(a, a + 5);
+    MySTL::bit_vector<> v5(v2);
+    MySTL::bit_vector<> v6(std::move(v2));
+    MySTL::bit_vector<> v7{true, true, false, true};
+    MySTL::bit_vector<> v8, v9, v10;
+    v8 = v3;
+    v9 = std::move(v3);
+    v10 = {false, true, true};
+
+    FUN_AFTER(v1, v1.assign(3, true));
+    FUN_AFTER(v1, v1.assign(a, a + 5));
+    FUN_AFTER(v1, v1.push_back(true));
+    FUN_AFTER(v1, v1.insert(v1.begin(), false));
+    FUN_AFTER(v1, v1.insert(v1.begin() + 3, 2, true));
+    FUN_AFTER(v1, v1.insert(v1.end(), a, a + 5));
+    FUN_AFTER(v1, v1.pop_back());
+    FUN_AFTER(v1, v1.erase(v1.begin()));
+    FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+    FUN_AFTER(v1, v1[0] = false);
+    FUN_AFTER(v1, v1[1].flip());
+    FUN_AFTER(v1, MySTL::swap(v1[0], v1[2]));
+    FUN_AFTER(v1, v1.flip());
+    FUN_VALUE(*v1.begin());
+    FUN_VALUE(*(v1.end() - 1));
+    FUN_VALUE(*v1.rbegin());
+    FUN_VALUE(v1.front());
+    FUN_VALUE(v1.back());
+    FUN_VALUE(v1.at(1));
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v1.capacity());
+    FUN_VALUE(v1.count());
+    FUN_VALUE(v1.find_first());
+    FUN_VALUE(v1.find_next(v1.find_first()));
+    FUN_VALUE(MySTL::count(v1.begin(), v1.end(), false));
+    FUN_VALUE(MySTL::find(v1.begin(), v1.end(), false) - v1.begin());
+    FUN_AFTER(v1, v1.resize(12, true));
+    FUN_AFTER(v1, v1.resize(4));
+    FUN_AFTER(v1, MySTL::fill(v1.begin() + 1, v1.end(), false));
+    FUN_AFTER(v1, v1.swap(v7));
+    FUN_AFTER(v1, v1.clear());
+    FUN_VALUE(v1.size());
+
+    // 跨越字边界的按字操作
+    FUN_VALUE(v8.count());
+    FUN_AFTER(v8, MySTL::fill(v8.begin() + 3, v8.begin() + 67, false));
+    FUN_VALUE(v8.count());
+    FUN_VALUE(MySTL::count(v8.begin() + 1, v8.end() - 1, true));
+    FUN_VALUE(MySTL::find(v8.begin() + 3, v8.end(), true) - v8.begin());
+    FUN_VALUE(v8.find_next(2));
+    FUN_AFTER(v8, v8.resize(200));
+    FUN_VALUE(v8.find_next(69));
+    FUN_AFTER(v8, v8.shrink_to_fit());
+    FUN_VALUE(v8.capacity());
+    FUN_VALUE((v5 == v6));
+    FUN_VALUE((v9 == v8));
+    FUN_VALUE((v10 < v7));
+
+    // pmr 版本的空间来自传入的资源
+    MySTL::monotonic_buffer_resource arena;
+    MySTL::pmr::bit_vector v11(&arena);
+    FUN_AFTER(v11, v11.assign(a, a + 5));
+    FUN_AFTER(v11, v11.resize(100, true));
+    FUN_VALUE((v11.get_allocator().resource() == &arena));
+    FUN_VALUE(v11.count());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|      push_back      |";
+    BIT_TEST(1, decltype(c) d; for (size_t k = 0; k < n; ++k) d.push_back((k & 1) != 0); sink = d.size(),
+             SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     count x 10      |";
+    BIT_TEST(10, sink = sink + alg::count(c.begin(), c.end(), true),
+             SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|      find x 10      |";
+    BIT_TEST(10, sink = sink + static_cast<size_t>(alg::find(c.begin(), c.end(), true) - c.begin()),
+             SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|      fill x 10      |";
+    BIT_TEST(10, alg::fill(c.begin(), c.end(), (r & 1) != 0),
+             SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : bit_vector ---------------]\n";
+}
+
+}  // namespace bit_vector_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_BIT_VECTOR_TEST_H_
@@ -0,0 +1,273 @@
+﻿#ifndef MYTINYSTL_BTREE_TEST_H_
+#define MYTINYSTL_BTREE_TEST_H_
+
+// btree test : 测试 btree_map, btree_multimap, btree_set, btree_multiset 的接口，
+//              以及与 map 对比 insert、find、顺序遍历的性能与每个元素占用的内存
+
+#include <map>
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/btree_map.h"
+#include "../STL_Impl/btree_set.h"
+#include "../STL_Impl/map.h"
+#include "../STL_Impl/vector.h"
+#include "map_test.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace btree_test {
+
+// 当前仍在使用的字节数
+inline size_t& live_bytes() {
+    static size_t bytes = 0;
+    return bytes;
+}
+
+// 记录容器申请的字节数的分配器，不计入 malloc 自身的开销
+template <class T>
+class byte_counting_allocator {
+   public:
+    typedef T value_type;
+
+    byte_counting_allocator() noexcept {}
+    template <class U>
+    byte_counting_allocator(const byte_counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        live_bytes() += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        live_bytes() -= n * sizeof(T);
+        ::operator delete(p);
+    }
+};
+
+template <class T, class U>
+bool operator==(const byte_counting_allocator<T>&, const byte_counting_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const byte_counting_allocator<T>&, const byte_counting_allocator<U>&) noexcept { return false; }
+
+#define BTREE_TEST(key, fill, op, len1, len2, len3)             \
+    TEST_LEN(len1, len2, len3, WIDE);                           \
+    std::cout << "|     MySTL::map      |";                     \
+    RANDOM_PAIR_DO_TEST(MySTL::map, key, fill, op, len1);       \
+    RANDOM_PAIR_DO_TEST(MySTL::map, key, fill, op, len2);       \
+    RANDOM_PAIR_DO_TEST(MySTL::map, key, fill, op, len3);       \
+    std::cout << "\n|  MySTL::btree_map   |";                   \
+    RANDOM_PAIR_DO_TEST(MySTL::btree_map, key, fill, op, len1); \
+    RANDOM_PAIR_DO_TEST(MySTL::btree_map, key, fill, op, len2); \
+    RANDOM_PAIR_DO_TEST(MySTL::btree_map, key, fill, op, len3);
+
+#define BTREE_INSERT(m)                \
+    for (size_t i = 0; i < n; ++i)     \
+        m.emplace(in[i].first, in[i].second)
+
+#define BTREE_FIND(m)                                  \
+    size_t hit = 0;                                    \
+    for (size_t i = 0; i < n; ++i)                     \
+        hit += m.find(in[i].first) != m.end() ? 1 : 0; \
+    sink = hit
+
+#define BTREE_ITERATE(m)               \
+    size_t sum = 0;                    \
+    for (auto& x : m)                  \
+        sum += x.second;               \
+    sink = sum
+
+// 随机插入 len 个元素后，容器申请的字节数除以元素个数
+#define BTREE_BYTES_DO_TEST(con, key, len)                                                      \
+    do {                                                                                        \
+        srand((int)time(0));                                                                    \
+        char buf[16];                                                                           \
+        const size_t before = live_bytes();                                                     \
+        {                                                                                       \
+            con<key, int, MySTL::less<key>, byte_counting_allocator<MySTL::pair<const key, int>>> m; \
+            for (size_t i = 0; i < static_cast<size_t>(len); ++i)                               \
+                m.emplace(random_key<key>(), static_cast<int>(i));                              \
+            std::snprintf(buf, sizeof(buf), "%.1f",                                             \
+                          static_cast<double>(live_bytes() - before) / m.size());               \
+        }                                                                                       \
+        std::string t = buf;                                                                    \
+        t += "      |";                                                                         \
+        std::cout << std::setw(WIDE) << t;                                                      \
+    } while (0)
+
+#define BTREE_BYTES_TEST(con, len)                   \
+    BTREE_BYTES_DO_TEST(con, int, len);              \
+    BTREE_BYTES_DO_TEST(con, MySTL::string, len);
+
+void btree_map_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : btree_map ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    MySTL::vector<MySTL::pair<int, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(MySTL::pair<int, int>(i, i));
+    MySTL::btree_map<int, int> m1;
+    MySTL::btree_map<int, int, MySTL::greater<int>> m2;
+    MySTL::btree_map<int, int> m3(v.begin(), v.end());
+    MySTL::btree_map<int, int> m4(v.begin(), v.end());
+    MySTL::btree_map<int, int> m5(m3);
+    MySTL::btree_map<int, int> m6(std::move(m3));
+    MySTL::btree_map<int, int> m7;
+    m7 = m4;
+    MySTL::btree_map<int, int> m8;
+    m8 = std::move(m4);
+    MySTL::btree_map<int, int> m9{{1, 1}, {3, 2}, {2, 3}};
+    MySTL::btree_map<int, int> m10;
+    m10 = {{1, 1}, {3, 2}, {2, 3}};
+
+    for (int i = 5; i > 0; --i) {
+        MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    MAP_FUN_AFTER(m1, m1.erase(0));
+    MAP_FUN_AFTER(m1, m1.erase(1));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.end()));
+    for (int i = 0; i < 5; ++i) {
+        MAP_FUN_AFTER(m1, m1.insert(MySTL::make_pair(i, i)));
+    }
+    MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    MAP_FUN_AFTER(m1, m1.insert(m1.end(), MySTL::make_pair(5, 5)));
+    FUN_VALUE(m1.count(1));
+    MAP_VALUE(*m1.find(3));
+    MAP_VALUE(*m1.lower_bound(3));
+    MAP_VALUE(*m1.upper_bound(2));
+    auto first = *m1.equal_range(2).first;
+    auto second = *m1.equal_range(2).second;
+    std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+              << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+    MAP_VALUE(*m1.erase(m1.find(2)));
+    MAP_FUN_AFTER(m1, m1.erase(1));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(4)));
+    MAP_FUN_AFTER(m1, m1.clear());
+    MAP_FUN_AFTER(m1, m1.swap(m9));
+    MAP_VALUE(*m1.begin());
+    MAP_VALUE(*m1.rbegin());
+    FUN_VALUE(m1[1]);
+    MAP_FUN_AFTER(m1, m1[1] = 3);
+    FUN_VALUE(m1.at(1));
+    std::cout << std::boolalpha;
+    FUN_VALUE((m1 == m10));
+    FUN_VALUE((m6 == m8));
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+    MySTL::btree_map<int, int> big;
+    for (int i = 0; i < 10000; ++i)
+        big.emplace((i * 7919) % 10000, i);
+    for (int i = 0; i < 10000; i += 2)
+        big.erase(i);
+    std::cout << std::boolalpha;
+    FUN_VALUE(big.size());
+    FUN_VALUE((big.begin()->first == 1 && big.rbegin()->first == 9999));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    volatile size_t sink = 0;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     insert <int>    |";
+    BTREE_TEST(int, (void)0, BTREE_INSERT(m), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|      find <int>     |";
+    BTREE_TEST(int, BTREE_INSERT(m), BTREE_FIND(m), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    iterate <int>    |";
+    BTREE_TEST(int, BTREE_INSERT(m), BTREE_ITERATE(m), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   insert <string>   |";
+    BTREE_TEST(MySTL::string, (void)0, BTREE_INSERT(m), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    find <string>    |";
+    BTREE_TEST(MySTL::string, BTREE_INSERT(m), BTREE_FIND(m), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   iterate <string>  |";
+    BTREE_TEST(MySTL::string, BTREE_INSERT(m), BTREE_ITERATE(m), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   bytes / element   |     int     |    string   |             |" << std::endl;
+    std::cout << "|     MySTL::map      |";
+    BTREE_BYTES_TEST(MySTL::map, SCALE_S(LEN2));
+    std::cout << std::setw(WIDE) << "|" << std::endl;
+    std::cout << "|  MySTL::btree_map   |";
+    BTREE_BYTES_TEST(MySTL::btree_map, SCALE_S(LEN2));
+    std::cout << std::setw(WIDE) << "|" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : btree_map ----------------]" << std::endl;
+}
+
+void btree_multimap_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : btree_multimap -------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    MySTL::btree_multimap<int, int> m1;
+    MySTL::btree_multimap<int, int> m2{{1, 1}, {3, 2}, {2, 3}, {3, 3}};
+    for (int i = 5; i > 0; --i) {
+        MAP_FUN_AFTER(m1, m1.emplace(i % 3, i));
+    }
+    MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+    MAP_FUN_AFTER(m1, m1.insert(m1.end(), MySTL::make_pair(2, 6)));
+    FUN_VALUE(m1.count(2));
+    MAP_VALUE(*m1.find(1));
+    MAP_VALUE(*m1.upper_bound(1));
+    MAP_FUN_AFTER(m1, m1.erase(2));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    MAP_FUN_AFTER(m1, m1.swap(m2));
+    FUN_VALUE(m1.size());
+    PASSED;
+    std::cout << "[------------- End container test : btree_multimap -------------]" << std::endl;
+}
+
+void btree_set_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : btree_set ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = {5, 4, 3, 2, 1};
+    MySTL::btree_set<int> s1;
+    MySTL::btree_set<int, MySTL::greater<int>> s2(a, a + 5);
+    MySTL::btree_set<int> s3(a, a + 5);
+    MySTL::btree_set<int> s4(s3);
+    MySTL::btree_multiset<int> s5{1, 2, 2, 3, 3, 3};
+
+    for (int i = 5; i > 0; --i) {
+        FUN_AFTER(s1, s1.emplace(i));
+    }
+    FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.erase(1));
+    FUN_AFTER(s1, s1.insert(a, a + 5));
+    FUN_VALUE(s1.count(5));
+    FUN_VALUE(*s1.find(3));
+    FUN_VALUE(*s1.lower_bound(3));
+    FUN_VALUE(*s1.upper_bound(3));
+    FUN_VALUE(*s1.erase(s1.find(3)));
+    FUN_AFTER(s2, s2.erase(s2.begin(), s2.find(2)));
+    FUN_VALUE(s5.count(3));
+    FUN_AFTER(s5, s5.erase(3));
+    FUN_AFTER(s5, s5.insert(2));
+    FUN_AFTER(s1, s1.swap(s4));
+    std::cout << std::boolalpha;
+    FUN_VALUE((s1 == s3));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(s1.size());
+    PASSED;
+    std::cout << "[--------------- End container test : btree_set ----------------]" << std::endl;
+}
+
+}  // namespace btree_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_BTREE_TEST_H_
@@ -0,0 +1,220 @@
+﻿#ifndef MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+#define MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+
+// circular_buffer test : 测试 circular_buffer 的接口，以及它与 deque 作为 queue 底层容器时的性能
+
+#include <deque>
+#include <queue>
+#include <stdexcept>
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/circular_buffer.h"
+#include "../STL_Impl/queue.h"
+#include "../STL_Impl/stack.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace circular_buffer_test {
+
+typedef MySTL::queue<int, MySTL::circular_buffer<int>> ring_queue;
+
+// 执行 setup 后，把 body 重复 len 次，body 中可以使用队列 q 与下标 i
+#define RING_QUEUE_DO_TEST(con, setup, body, len)                                           \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        volatile int sink = 0;                                                              \
+        const size_t n = len;                                                               \
+        con q;                                                                              \
+        setup;                                                                              \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < n; ++i) {                                                    \
+            body;                                                                           \
+        }                                                                                   \
+        end = clock();                                                                      \
+        (void)sink;                                                                         \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define RING_QUEUE_TEST(setup, body, len1, len2, len3)             \
+    TEST_LEN(len1, len2, len3, WIDE);                              \
+    std::cout << "|     std::queue      |";                        \
+    RING_QUEUE_DO_TEST(std::queue<int>, setup, body, len1);        \
+    RING_QUEUE_DO_TEST(std::queue<int>, setup, body, len2);        \
+    RING_QUEUE_DO_TEST(std::queue<int>, setup, body, len3);        \
+    std::cout << "\n|    queue<deque>     |";                     \
+    RING_QUEUE_DO_TEST(MySTL::queue<int>, setup, body, len1);      \
+    RING_QUEUE_DO_TEST(MySTL::queue<int>, setup, body, len2);      \
+    RING_QUEUE_DO_TEST(MySTL::queue<int>, setup, body, len3);      \
+    std::cout << "\n| queue<circular_buf> |";                     \
+    RING_QUEUE_DO_TEST(ring_queue, setup, body, len1);             \
+    RING_QUEUE_DO_TEST(ring_queue, setup, body, len2);             \
+    RING_QUEUE_DO_TEST(ring_queue, setup, body, len3);
+
+// 复制与移动构造都可能抛出异常的元素，ctors_left 为 0 时抛出异常，移动后原对象的值置为 -1
+struct throwing_copy {
+    static int ctors_left;
+    int value;
+    throwing_copy(int v) : value(v) {}
+    throwing_copy(const throwing_copy& rhs) : value(rhs.value) { count(); }
+    throwing_copy(throwing_copy&& rhs) : value(rhs.value) {
+        count();
+        rhs.value = -1;
+    }
+    throwing_copy& operator=(const throwing_copy& rhs) {
+        value = rhs.value;
+        return *this;
+    }
+    static void count() {
+        if (ctors_left == 0) throw std::runtime_error("throwing_copy");
+        --ctors_left;
+    }
+};
+int throwing_copy::ctors_left = -1;
+
+// 扩容时搬移到一半抛出异常，原有元素不变
+void strong_guarantee_test() {
+    MySTL::circular_buffer<throwing_copy> c;
+    c.reserve(4);
+    for (int i = 0; i < 4; ++i)
+        c.emplace_back(i);
+    throwing_copy::ctors_left = 2;
+    bool thrown = false;
+    try {
+        c.emplace_back(4);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    throwing_copy::ctors_left = -1;
+    int sum = 0;
+    for (auto& x : c)
+        sum += x.value;
+    FUN_VALUE(thrown);
+    FUN_VALUE(c.size());
+    FUN_VALUE(sum);
+}
+
+void circular_buffer_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run container test : circular_buffer -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    MySTL::circular_buffer<int> c1;
+    MySTL::circular_buffer<int> c2(5);
+    MySTL::circular_buffer<int> c3(5, 1);
+    MySTL::circular_buffer<int> c4(a, a + 5);
+    MySTL::circular_buffer<int> c5(c2);
+    MySTL::circular_buffer<int> c6(std::move(c2));
+    MySTL::circular_buffer<int> c7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::circular_buffer<int> c8, c9, c10;
+    c8 = c3;
+    c9 = std::move(c3);
+    c10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    FUN_AFTER(c1, c1.assign(5, 1));
+    FUN_AFTER(c1, c1.assign(a, a + 5));
+    FUN_AFTER(c1, c1.emplace_front(0));
+    FUN_AFTER(c1, c1.emplace_back(6));
+    FUN_AFTER(c1, c1.push_front(-1));
+    FUN_AFTER(c1, c1.push_back(7));
+    FUN_AFTER(c1, c1.pop_front());
+    FUN_AFTER(c1, c1.pop_back());
+    FUN_AFTER(c1, c1.swap(c4));
+    FUN_VALUE(*c1.begin());
+    FUN_VALUE(*(c1.end() - 1));
+    FUN_VALUE(*c1.rbegin());
+    FUN_VALUE(c1.front());
+    FUN_VALUE(c1.back());
+    FUN_VALUE(c1.at(1));
+    FUN_VALUE(c1[2]);
+    FUN_VALUE(c1.size());
+    FUN_VALUE(c1.capacity());
+    FUN_AFTER(c1, c1.resize(20, 9));
+    FUN_VALUE(c1.capacity());
+    FUN_AFTER(c1, c1.resize(3));
+    FUN_AFTER(c1, c1.shrink_to_fit());
+    FUN_VALUE(c1.capacity());
+    FUN_AFTER(c1, c1.clear());
+    FUN_VALUE(c1.empty());
+    FUN_VALUE((c5 == c6));
+    FUN_VALUE((c9 < c10));
+
+    // 固定容量：满时插入覆盖另一端或抛出异常，容量向上取到 2 的幂
+    MySTL::circular_buffer<int> ring(4, MySTL::circular_overwrite);
+    FUN_AFTER(ring, for (int i = 0; i < 10; ++i) ring.push_back(i));
+    FUN_AFTER(ring, ring.push_front(-1));
+    FUN_VALUE(ring.full());
+    MySTL::circular_buffer<int> fixed(3, MySTL::circular_fixed);
+    FUN_VALUE(fixed.capacity());
+    FUN_AFTER(fixed, for (int i = 0; i < 4; ++i) fixed.push_back(i));
+    try {
+        fixed.push_back(4);
+    } catch (std::length_error&) {
+        FUN_VALUE(fixed.size());
+    }
+
+    // 头部绕到尾部之后，元素分成两段，两段空闲区间依次接在尾部之后
+    MySTL::circular_buffer<char> bytes(8, MySTL::circular_fixed);
+    for (char ch = 'a'; ch < 'g'; ++ch)
+        bytes.push_back(ch);
+    bytes.consume_front(4);
+    for (char ch = 'g'; ch < 'k'; ++ch)
+        bytes.push_back(ch);
+    auto spans = bytes.as_spans();
+    FUN_VALUE(std::string(spans.first.begin(), spans.first.end()));
+    FUN_VALUE(std::string(spans.second.begin(), spans.second.end()));
+    auto room = bytes.free_spans();
+    FUN_VALUE(room.first.size);
+    room.first.data[0] = 'k';
+    room.first.data[1] = 'l';
+    FUN_AFTER(bytes, bytes.commit_back(2));
+
+    // 作为 queue 与 stack 的底层容器，参数引用容器自身的元素时扩容也要正确
+    ring_queue q;
+    MySTL::stack<int, MySTL::circular_buffer<int>> s;
+    for (int i = 0; i < 40; ++i) {
+        q.push(i);
+        s.push(i);
+    }
+    q.pop();
+    s.pop();
+    FUN_VALUE(q.front());
+    FUN_VALUE(q.back());
+    FUN_VALUE(s.top());
+    MySTL::circular_buffer<MySTL::string> cs;
+    cs.emplace_back(3, 'a');
+    for (int i = 0; i < 20; ++i)
+        cs.push_back(cs.front());
+    FUN_AFTER(cs, cs.push_front(cs.back()));
+    FUN_VALUE(cs.size());
+    strong_guarantee_test();
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|        push         |";
+    RING_QUEUE_TEST((void)0,
+                    q.push(static_cast<int>(i)),
+                    SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  push+pop depth 1k  |";
+    RING_QUEUE_TEST(for (int k = 0; k < 1024; ++k) q.push(k),
+                    q.push(static_cast<int>(i)); sink = sink + q.front(); q.pop(),
+                    SCALE_LL(LEN1), SCALE_LL(LEN2), SCALE_LL(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------ End container test : circular_buffer -------------]\n";
+}
+
+}  // namespace circular_buffer_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
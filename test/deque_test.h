@@ -1,17 +1,178 @@
 ﻿#ifndef MYTINYSTL_DEQUE_TEST_H_
 #define MYTINYSTL_DEQUE_TEST_H_
 
-// deque test : 测试 deque 的接口和 push_front/push_back 的性能
+// deque test : 测试 deque 的接口和 push_front/push_back 的性能，不同缓冲区大小下队列与随机访问的性能，
+//              copy、fill、find、insert 按缓冲区分段处理的性能，以及队列负载下申请内存的次数
 
+#include <algorithm>
 #include <deque>
+#include <string>
+#include <vector>
 
+#include "../STL_Impl/algo.h"
+#include "../STL_Impl/astring.h"
 #include "../STL_Impl/deque.h"
+#include "../STL_Impl/queue.h"
+#include "../STL_Impl/vector.h"
 #include "test.h"
 
 namespace MySTL {
 namespace test {
 namespace deque_test {
 
+// 缓冲区分别容纳 64 个与 16384 个 int，缺省为 1024 个
+typedef MySTL::deque<int, MySTL::allocator<int>, 64> deque_64;
+typedef MySTL::deque<int, MySTL::allocator<int>, 16384> deque_16k;
+
+// 记录 allocate 调用次数的分配器，用来统计队列负载下申请内存的次数
+inline size_t& allocation_count() {
+    static size_t count = 0;
+    return count;
+}
+
+template <class T>
+class counting_allocator {
+   public:
+    typedef T value_type;
+
+    counting_allocator() noexcept {}
+    template <class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++allocation_count();
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept { ::operator delete(p); }
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&) noexcept { return false; }
+
+typedef std::deque<int, counting_allocator<int>> std_churn_deque;
+typedef MySTL::deque<int, counting_allocator<int>> churn_deque;
+typedef MySTL::queue<int, churn_deque> churn_queue;
+
+// 队列中先放入 len 个元素，预热后统计 100 万次 push_back + pop_front 申请内存的次数
+#define DEQUE_CHURN_DO_TEST(con, push, pop, len)                                            \
+    do {                                                                                    \
+        char buf[16];                                                                       \
+        con q;                                                                              \
+        for (size_t k = 0; k < static_cast<size_t>(len); ++k)                               \
+            q.push(static_cast<int>(k));                                                    \
+        for (int k = 0; k < 100000; ++k) {                                                  \
+            q.push(k);                                                                      \
+            q.pop();                                                                        \
+        }                                                                                   \
+        const size_t before = allocation_count();                                           \
+        for (int k = 0; k < 1000000; ++k) {                                                 \
+            q.push(k);                                                                      \
+            q.pop();                                                                        \
+        }                                                                                   \
+        std::snprintf(buf, sizeof(buf), "%zu", allocation_count() - before);                \
+        std::string t = buf;                                                                \
+        t += "      |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define DEQUE_CHURN_TEST(len1, len2, len3)                            \
+    TEST_LEN(len1, len2, len3, WIDE);                                 \
+    std::cout << "|     std::deque      |";                           \
+    DEQUE_CHURN_DO_TEST(std_churn_deque, push_back, pop_front, len1); \
+    DEQUE_CHURN_DO_TEST(std_churn_deque, push_back, pop_front, len2); \
+    DEQUE_CHURN_DO_TEST(std_churn_deque, push_back, pop_front, len3); \
+    std::cout << "\n|    MySTL::deque     |";                         \
+    DEQUE_CHURN_DO_TEST(churn_deque, push_back, pop_front, len1);     \
+    DEQUE_CHURN_DO_TEST(churn_deque, push_back, pop_front, len2);     \
+    DEQUE_CHURN_DO_TEST(churn_deque, push_back, pop_front, len3);     \
+    std::cout << "\n|    MySTL::queue     |";                         \
+    DEQUE_CHURN_DO_TEST(churn_queue, push, pop, len1);                \
+    DEQUE_CHURN_DO_TEST(churn_queue, push, pop, len2);                \
+    DEQUE_CHURN_DO_TEST(churn_queue, push, pop, len3);
+
+// 执行 setup 后，把 body 重复 len 次，body 中可以使用容器 d、下标 i 与元素个数 n
+#define DEQUE_BLOCK_DO_TEST(con, setup, body, len)                                          \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        volatile size_t sink = 0;                                                           \
+        const size_t n = len;                                                               \
+        con d;                                                                              \
+        setup;                                                                              \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < n; ++i) {                                                    \
+            body;                                                                           \
+        }                                                                                   \
+        end = clock();                                                                      \
+        (void)sink;                                                                         \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define DEQUE_BLOCK_TEST(setup, body, len1, len2, len3)            \
+    TEST_LEN(len1, len2, len3, WIDE);                              \
+    std::cout << "|         std         |";                        \
+    DEQUE_BLOCK_DO_TEST(std::deque<int>, setup, body, len1);       \
+    DEQUE_BLOCK_DO_TEST(std::deque<int>, setup, body, len2);       \
+    DEQUE_BLOCK_DO_TEST(std::deque<int>, setup, body, len3);       \
+    std::cout << "\n|    MySTL default    |";                     \
+    DEQUE_BLOCK_DO_TEST(MySTL::deque<int>, setup, body, len1);     \
+    DEQUE_BLOCK_DO_TEST(MySTL::deque<int>, setup, body, len2);     \
+    DEQUE_BLOCK_DO_TEST(MySTL::deque<int>, setup, body, len3);     \
+    std::cout << "\n|   MySTL 64 / blk    |";                     \
+    DEQUE_BLOCK_DO_TEST(deque_64, setup, body, len1);              \
+    DEQUE_BLOCK_DO_TEST(deque_64, setup, body, len2);              \
+    DEQUE_BLOCK_DO_TEST(deque_64, setup, body, len3);              \
+    std::cout << "\n|  MySTL 16384 / blk  |";                     \
+    DEQUE_BLOCK_DO_TEST(deque_16k, setup, body, len1);             \
+    DEQUE_BLOCK_DO_TEST(deque_16k, setup, body, len2);             \
+    DEQUE_BLOCK_DO_TEST(deque_16k, setup, body, len3);
+
+// 在 len 个元素的 deque d 与 vector v 上把 body 执行 10 次
+#define DEQUE_SEG_DO_TEST(con, vec, body, len)                                              \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        volatile size_t sink = 0;                                                           \
+        const size_t n = len;                                                               \
+        con d(n, 1);                                                                        \
+        vec v(n, 2);                                                                        \
+        start = clock();                                                                    \
+        for (int r = 0; r < 10; ++r) {                                                      \
+            body;                                                                           \
+        }                                                                                   \
+        end = clock();                                                                      \
+        (void)sink;                                                                         \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// per-element 一行调用逐个 ++ 的通用版本，segmented 一行调用按缓冲区分段的重载
+#define DEQUE_SEG_TEST(std_body, elem_body, seg_body, len1, len2, len3)                 \
+    TEST_LEN(len1, len2, len3, WIDE);                                                   \
+    std::cout << "|         std         |";                                             \
+    DEQUE_SEG_DO_TEST(std::deque<int>, std::vector<int>, std_body, len1);               \
+    DEQUE_SEG_DO_TEST(std::deque<int>, std::vector<int>, std_body, len2);               \
+    DEQUE_SEG_DO_TEST(std::deque<int>, std::vector<int>, std_body, len3);               \
+    std::cout << "\n|     per-element     |";                                          \
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, elem_body, len1);          \
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, elem_body, len2);          \
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, elem_body, len3);          \
+    std::cout << "\n|      segmented      |";                                          \
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, seg_body, len1);           \
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, seg_body, len2);           \
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, seg_body, len3);
+
 void deque_test() {
     std::cout << "[===============================================================]" << std::endl;
     std::cout << "[----------------- Run container test : deque ------------------]" << std::endl;
@@ -66,6 +227,47 @@ void deque_test() {
     std::cout << std::noboolalpha;
     FUN_VALUE(d1.size());
     FUN_VALUE(d1.max_size());
+
+    // 可平凡重定位的元素在 insert、erase 时跨缓冲区逐段搬运，与 std::deque 的结果对照
+    {
+        MySTL::deque<MySTL::string> ds;
+        std::deque<std::string> dr;
+        for (int i = 0; i < 1000; ++i) {
+            const char ch = static_cast<char>('a' + i % 26);
+            ds.emplace_back(static_cast<size_t>(i % 7 + 1), ch);
+            dr.emplace_back(static_cast<size_t>(i % 7 + 1), ch);
+        }
+        for (int i = 0; i < 200; ++i) {
+            const size_t pos = static_cast<size_t>(i * 37) % ds.size();
+            ds.insert(ds.begin() + pos, ds[ds.size() - 1 - pos]);
+            dr.insert(dr.begin() + pos, dr[dr.size() - 1 - pos]);
+            ds.erase(ds.begin() + (pos * 3) % ds.size());
+            dr.erase(dr.begin() + (pos * 3) % dr.size());
+        }
+        ds.erase(ds.begin() + 100, ds.begin() + 400);
+        dr.erase(dr.begin() + 100, dr.begin() + 400);
+        ds.erase(ds.end() - 400, ds.end() - 50);
+        dr.erase(dr.end() - 400, dr.end() - 50);
+        bool same = ds.size() == dr.size();
+        for (size_t i = 0; same && i < ds.size(); ++i)
+            same = std::string(ds[i].c_str()) == dr[i];
+        std::cout << std::boolalpha;
+        FUN_VALUE(same);
+        std::cout << std::noboolalpha;
+        FUN_VALUE(ds.size());
+    }
+
+    // 每个缓冲区只有 3 个元素，迭代器的运算频繁跨越缓冲区
+    {
+        MySTL::deque<int, MySTL::allocator<int>, 3> db(a, a + 5);
+        FUN_VALUE(db.buffer_size);
+        FUN_AFTER(db, db.insert(db.begin() + 2, 4, 0));
+        FUN_AFTER(db, db.push_front(9));
+        FUN_AFTER(db, db.erase(db.begin() + 1, db.end() - 2));
+        FUN_VALUE(*(db.begin() + 2));
+        FUN_VALUE(db.end() - db.begin());
+        FUN_VALUE(*(db.end() - 3));
+    }
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -84,6 +286,57 @@ void deque_test() {
 #else
     CON_TEST_P1(deque<int>, push_back, rand(), SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    // 队列中始终保持 1024 个元素，每轮从尾部推入一个、从头部弹出一个
+    std::cout << "| push_back+pop_front |";
+    DEQUE_BLOCK_TEST(for (int k = 0; k < 1024; ++k) d.push_back(k),
+                     d.push_back(static_cast<int>(i)); sink = sink + d.front(); d.pop_front(),
+                     SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    random access    |";
+    DEQUE_BLOCK_TEST(for (size_t k = 0; k < n; ++k) d.push_back(static_cast<int>(k)),
+                     sink = sink + d[i * 2654435761u % n],
+                     SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| allocs / 1M push+pop|";
+    DEQUE_CHURN_TEST(16, 4096, 1048576);
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  copy to vector x10 |";
+    DEQUE_SEG_TEST(std::copy(d.begin(), d.end(), v.begin()),
+                   MySTL::unchecked_copy_cat(d.begin(), d.end(), v.begin(), MySTL::random_access_iterator_tag()),
+                   MySTL::copy(d.begin(), d.end(), v.begin()),
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|      fill x10       |";
+    DEQUE_SEG_TEST(std::fill(d.begin(), d.end(), r),
+                   MySTL::fill_n(d.begin(), d.end() - d.begin(), r),
+                   MySTL::fill(d.begin(), d.end(), r),
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|      find x10       |";
+    DEQUE_SEG_TEST(sink = sink + (std::find(d.begin(), d.end(), r + 2) - d.begin()),
+                   sink = sink + (MySTL::find_if(d.begin(), d.end(), [r](int x) { return x == r + 2; }) - d.begin()),
+                   sink = sink + (MySTL::find(d.begin(), d.end(), r + 2) - d.begin()),
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    // insert 没有保留逐个复制的版本，只与 std::deque 对照，每次在中间插入 n / 10 个元素
+    std::cout << "| insert range x10    |";
+    TEST_LEN(SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3), WIDE);
+    std::cout << "|         std         |";
+    DEQUE_SEG_DO_TEST(std::deque<int>, std::vector<int>, d.insert(d.begin() + n / 3, v.begin(), v.begin() + n / 10), SCALE_M(LEN1));
+    DEQUE_SEG_DO_TEST(std::deque<int>, std::vector<int>, d.insert(d.begin() + n / 3, v.begin(), v.begin() + n / 10), SCALE_M(LEN2));
+    DEQUE_SEG_DO_TEST(std::deque<int>, std::vector<int>, d.insert(d.begin() + n / 3, v.begin(), v.begin() + n / 10), SCALE_M(LEN3));
+    std::cout << "\n|        MySTL        |";
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, d.insert(d.begin() + n / 3, v.begin(), v.begin() + n / 10), SCALE_M(LEN1));
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, d.insert(d.begin() + n / 3, v.begin(), v.begin() + n / 10), SCALE_M(LEN2));
+    DEQUE_SEG_DO_TEST(MySTL::deque<int>, MySTL::vector<int>, d.insert(d.begin() + n / 3, v.begin(), v.begin() + n / 10), SCALE_M(LEN3));
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
     PASSED;
@@ -0,0 +1,307 @@
+﻿#ifndef MYTINYSTL_FLAT_MAP_TEST_H_
+#define MYTINYSTL_FLAT_MAP_TEST_H_
+
+// flat_map test : 测试 flat_map, flat_multimap, flat_split_map, flat_set, flat_multiset 的接口，
+//                 以及与 map 对比批量构建、find、顺序遍历的性能
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/flat_map.h"
+#include "../STL_Impl/flat_set.h"
+#include "../STL_Impl/map.h"
+#include "../STL_Impl/vector.h"
+#include "map_test.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace flat_map_test {
+
+#define FLAT_TEST(key, fill, op, len1, len2, len3)                   \
+    TEST_LEN(len1, len2, len3, WIDE);                                \
+    std::cout << "|     MySTL::map      |";                          \
+    RANDOM_PAIR_DO_TEST(MySTL::map, key, fill, op, len1);            \
+    RANDOM_PAIR_DO_TEST(MySTL::map, key, fill, op, len2);            \
+    RANDOM_PAIR_DO_TEST(MySTL::map, key, fill, op, len3);            \
+    std::cout << "\n|   MySTL::flat_map   |";                        \
+    RANDOM_PAIR_DO_TEST(MySTL::flat_map, key, fill, op, len1);       \
+    RANDOM_PAIR_DO_TEST(MySTL::flat_map, key, fill, op, len2);       \
+    RANDOM_PAIR_DO_TEST(MySTL::flat_map, key, fill, op, len3);       \
+    std::cout << "\n|MySTL::flat_split_map|";                        \
+    RANDOM_PAIR_DO_TEST(MySTL::flat_split_map, key, fill, op, len1); \
+    RANDOM_PAIR_DO_TEST(MySTL::flat_split_map, key, fill, op, len2); \
+    RANDOM_PAIR_DO_TEST(MySTL::flat_split_map, key, fill, op, len3);
+
+#define FLAT_BUILD(m) \
+    m.insert(in.begin(), in.end())
+
+#define FLAT_FIND(m)                                   \
+    size_t hit = 0;                                    \
+    for (size_t i = 0; i < n; ++i)                     \
+        hit += m.find(in[i].first) != m.end() ? 1 : 0; \
+    sink = hit
+
+#define FLAT_ITERATE(m)                \
+    size_t sum = 0;                    \
+    for (auto x : m)                   \
+        sum += x.second;               \
+    sink = sum
+
+// 容器 c 与逐个插入得到的 ref 的元素及其次序是否相同
+template <class Con, class Ref>
+bool same_elements(const Con& c, const Ref& ref) {
+    if (c.size() != ref.size())
+        return false;
+    auto it = ref.begin();
+    for (auto x : c) {
+        if (x.first != it->first || x.second != it->second)
+            return false;
+        ++it;
+    }
+    return true;
+}
+
+// 每个键值在区间中出现两次、次序打乱的键值对
+inline MySTL::vector<MySTL::pair<int, int>> duplicate_input() {
+    MySTL::vector<MySTL::pair<int, int>> in;
+    for (int i = 0; i < 200; ++i)
+        in.push_back(MySTL::make_pair((i * 37) % 100, i));
+    return in;
+}
+
+void flat_map_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : flat_map -----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    MySTL::vector<MySTL::pair<int, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(MySTL::pair<int, int>(i, i));
+    MySTL::flat_map<int, int> m1;
+    MySTL::flat_map<int, int, MySTL::greater<int>> m2;
+    MySTL::flat_map<int, int> m3(v.begin(), v.end());
+    MySTL::flat_map<int, int> m4(v.begin(), v.end());
+    MySTL::flat_map<int, int> m5(m3);
+    MySTL::flat_map<int, int> m6(std::move(m3));
+    MySTL::flat_map<int, int> m7;
+    m7 = m4;
+    MySTL::flat_map<int, int> m8;
+    m8 = std::move(m4);
+    MySTL::flat_map<int, int> m9{{1, 1}, {3, 2}, {2, 3}};
+    MySTL::flat_map<int, int> m10;
+    m10 = {{1, 1}, {3, 2}, {2, 3}};
+
+    for (int i = 5; i > 0; --i) {
+        MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    MAP_FUN_AFTER(m1, m1.erase(0));
+    MAP_FUN_AFTER(m1, m1.erase(1));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.end()));
+    for (int i = 0; i < 5; ++i) {
+        MAP_FUN_AFTER(m1, m1.insert(MySTL::make_pair(i, i)));
+    }
+    MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    MAP_FUN_AFTER(m1, m1.insert(m1.end(), MySTL::make_pair(5, 5)));
+    MAP_FUN_AFTER(m2, m2.insert(v.begin(), v.end()));
+    FUN_VALUE(m1.count(1));
+    MAP_VALUE(*m1.find(3));
+    MAP_VALUE(*m1.lower_bound(3));
+    MAP_VALUE(*m1.upper_bound(2));
+    auto first = *m1.equal_range(2).first;
+    auto second = *m1.equal_range(2).second;
+    std::cout << " m1.equal_range(2) : from <" << first.first << ", " << first.second
+              << "> to <" << second.first << ", " << second.second << ">" << std::endl;
+    MAP_VALUE(*m1.erase(m1.find(2)));
+    MAP_FUN_AFTER(m1, m1.erase(1));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin(), m1.find(4)));
+    MAP_FUN_AFTER(m1, m1.clear());
+    MAP_FUN_AFTER(m1, m1.swap(m9));
+    MAP_VALUE(*m1.begin());
+    MAP_VALUE(*m1.rbegin());
+    FUN_VALUE(m1[1]);
+    MAP_FUN_AFTER(m1, m1[1] = 3);
+    FUN_VALUE(m1.at(1));
+    std::cout << std::boolalpha;
+    FUN_VALUE((m1 == m10));
+    FUN_VALUE((m6 == m8));
+    FUN_VALUE(m1.empty());
+    std::cout << std::noboolalpha;
+    FUN_VALUE(m1.size());
+    MAP_FUN_AFTER(m1, m1.reserve(100));
+    FUN_VALUE(m1.capacity());
+    MAP_FUN_AFTER(m1, m1.shrink_to_fit());
+    FUN_VALUE(m1.capacity());
+    MySTL::vector<MySTL::pair<int, int>> in;
+    for (int i = 0; i < 10000; ++i)
+        in.push_back(MySTL::make_pair((i * 7919) % 5000, i));
+    MySTL::flat_map<int, int> big;
+    big.insert(in.begin(), in.end());
+    std::cout << std::boolalpha;
+    FUN_VALUE(big.size());
+    FUN_VALUE((big.begin()->first == 0 && big.rbegin()->first == 4999));
+    // 区间中键值重复时与逐个插入一样保留第一个
+    auto dup = duplicate_input();
+    MySTL::flat_map<int, int> m11{{10, -1}, {150, -1}};
+    MySTL::map<int, int> ref{{10, -1}, {150, -1}};
+    m11.insert(dup.begin(), dup.end());
+    ref.insert(dup.begin(), dup.end());
+    FUN_VALUE(m11.at(1));
+    FUN_VALUE((same_elements(m11, ref)));
+    FUN_VALUE((same_elements(big, MySTL::map<int, int>(in.begin(), in.end()))));
+    // 迭代器只能读取键值
+    FUN_VALUE((std::is_const<std::remove_reference<decltype(m11.begin()->first)>::type>::value));
+    FUN_VALUE((std::is_const<std::remove_reference<decltype((*m11.begin()).first)>::type>::value));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    volatile size_t sink = 0;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  bulk insert <int>  |";
+    FLAT_TEST(int, (void)0, FLAT_BUILD(m), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|      find <int>     |";
+    FLAT_TEST(int, FLAT_BUILD(m), FLAT_FIND(m), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    iterate <int>    |";
+    FLAT_TEST(int, FLAT_BUILD(m), FLAT_ITERATE(m), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| bulk insert <string>|";
+    FLAT_TEST(MySTL::string, (void)0, FLAT_BUILD(m), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    find <string>    |";
+    FLAT_TEST(MySTL::string, FLAT_BUILD(m), FLAT_FIND(m), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   iterate <string>  |";
+    FLAT_TEST(MySTL::string, FLAT_BUILD(m), FLAT_ITERATE(m), SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : flat_map -----------------]" << std::endl;
+}
+
+void flat_multimap_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : flat_multimap --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    MySTL::flat_multimap<int, int> m1;
+    MySTL::flat_multimap<int, int> m2{{1, 1}, {3, 2}, {2, 3}, {3, 3}};
+    for (int i = 5; i > 0; --i) {
+        MAP_FUN_AFTER(m1, m1.emplace(i % 3, i));
+    }
+    MAP_FUN_AFTER(m1, m1.emplace_hint(m1.begin(), 0, 0));
+    MAP_FUN_AFTER(m1, m1.insert(m1.end(), MySTL::make_pair(2, 6)));
+    FUN_VALUE(m1.count(2));
+    MAP_VALUE(*m1.find(1));
+    MAP_VALUE(*m1.upper_bound(1));
+    MAP_FUN_AFTER(m1, m1.erase(2));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    MAP_FUN_AFTER(m1, m1.insert(m2.begin(), m2.end()));
+    MAP_FUN_AFTER(m1, m1.swap(m2));
+    FUN_VALUE(m1.size());
+    // 区间中键值相同的元素与逐个插入一样保持原有次序
+    auto dup = duplicate_input();
+    MySTL::flat_multimap<int, int> m3{{10, -1}, {150, -1}};
+    MySTL::multimap<int, int> ref{{10, -1}, {150, -1}};
+    m3.insert(dup.begin(), dup.end());
+    ref.insert(dup.begin(), dup.end());
+    std::cout << std::boolalpha;
+    FUN_VALUE((same_elements(m3, ref)));
+    std::cout << std::noboolalpha;
+    PASSED;
+    std::cout << "[------------- End container test : flat_multimap --------------]" << std::endl;
+}
+
+void flat_split_map_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------ Run container test : flat_split_map --------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    MySTL::vector<MySTL::pair<int, int>> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(MySTL::pair<int, int>(4 - i, i));
+    MySTL::flat_split_map<int, int> m1;
+    MySTL::flat_split_map<int, int> m2(v.begin(), v.end());
+    MySTL::flat_split_map<int, int> m3{{1, 1}, {3, 2}, {2, 3}};
+    for (int i = 5; i > 0; --i) {
+        MAP_FUN_AFTER(m1, m1.emplace(i, i));
+    }
+    MAP_FUN_AFTER(m1, m1.insert(MySTL::make_pair(0, 0)));
+    MAP_FUN_AFTER(m1, m1.insert(v.begin(), v.end()));
+    MAP_FUN_AFTER(m1, m1.erase(m1.begin()));
+    MAP_FUN_AFTER(m1, m1.erase(3));
+    FUN_VALUE(m1.count(2));
+    MAP_VALUE(*m1.find(2));
+    MAP_VALUE(*m1.lower_bound(3));
+    MAP_VALUE(*m1.upper_bound(4));
+    FUN_VALUE(m1.keys().size());
+    FUN_VALUE(m1.values().size());
+    FUN_VALUE(m1[4]);
+    MAP_FUN_AFTER(m1, m1[4] = 7);
+    MAP_FUN_AFTER(m1, m1[6] = 6);
+    FUN_VALUE(m1.at(6));
+    MAP_FUN_AFTER(m1, m1.swap(m2));
+    std::cout << std::boolalpha;
+    FUN_VALUE((m3 == m2));
+    FUN_VALUE((m3 < m1));
+    std::cout << std::noboolalpha;
+    MAP_FUN_AFTER(m1, m1.clear());
+    FUN_VALUE(m1.size());
+    // 区间中键值重复时与逐个插入一样保留第一个
+    auto dup = duplicate_input();
+    MySTL::flat_split_map<int, int> m4{{10, -1}, {150, -1}};
+    MySTL::map<int, int> ref{{10, -1}, {150, -1}};
+    m4.insert(dup.begin(), dup.end());
+    ref.insert(dup.begin(), dup.end());
+    std::cout << std::boolalpha;
+    FUN_VALUE((same_elements(m4, ref)));
+    std::cout << std::noboolalpha;
+    PASSED;
+    std::cout << "[------------ End container test : flat_split_map --------------]" << std::endl;
+}
+
+void flat_set_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[---------------- Run container test : flat_set ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    int a[] = {5, 4, 3, 2, 1, 3, 5};
+    MySTL::flat_set<int> s1;
+    MySTL::flat_set<int, MySTL::greater<int>> s2(a, a + 7);
+    MySTL::flat_set<int> s3(a, a + 7);
+    MySTL::flat_set<int> s4(s3);
+    MySTL::flat_multiset<int> s5{1, 2, 2, 3, 3, 3};
+
+    for (int i = 5; i > 0; --i) {
+        FUN_AFTER(s1, s1.emplace(i));
+    }
+    FUN_AFTER(s1, s1.emplace_hint(s1.begin(), 0));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.erase(1));
+    FUN_AFTER(s1, s1.insert(a, a + 7));
+    FUN_VALUE(s1.count(5));
+    FUN_VALUE(*s1.find(3));
+    FUN_VALUE(*s1.lower_bound(3));
+    FUN_VALUE(*s1.upper_bound(3));
+    FUN_VALUE(*s1.erase(s1.find(3)));
+    FUN_AFTER(s2, s2.erase(s2.begin(), s2.find(2)));
+    FUN_VALUE(s5.count(3));
+    FUN_AFTER(s5, s5.erase(3));
+    FUN_AFTER(s5, s5.insert(a, a + 7));
+    FUN_AFTER(s1, s1.swap(s4));
+    std::cout << std::boolalpha;
+    FUN_VALUE((s1 == s3));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(s1.size());
+    PASSED;
+    std::cout << "[---------------- End container test : flat_set ----------------]" << std::endl;
+}
+
+}  // namespace flat_map_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_FLAT_MAP_TEST_H_
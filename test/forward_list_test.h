@@ -0,0 +1,157 @@
+﻿#ifndef MYTINYSTL_FORWARD_LIST_TEST_H_
+#define MYTINYSTL_FORWARD_LIST_TEST_H_
+
+// forward_list test : 测试 forward_list 的接口，每个元素占用的内存，以及与 list 对比 push_front、sort 的性能
+
+#include <forward_list>
+#include <list>
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/forward_list.h"
+#include "../STL_Impl/list.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace forward_list_test {
+
+// 一个辅助测试函数
+bool is_odd(int x) { return x & 1; }
+
+// 节点在 node_pool 中实际占用的字节数
+template <class Node>
+size_t pool_bytes() {
+    return (sizeof(Node) + NODE_POOL_ALIGN - 1) / NODE_POOL_ALIGN * NODE_POOL_ALIGN;
+}
+
+#define NODE_BYTES_COUT(node)                                                                    \
+    do {                                                                                         \
+        std::cout << std::setw(WIDE - 7) << pool_bytes<MySTL::node<int>>() << "      |";          \
+        std::cout << std::setw(WIDE - 7) << pool_bytes<MySTL::node<double>>() << "      |";       \
+        std::cout << std::setw(WIDE - 7) << pool_bytes<MySTL::node<MySTL::string>>() << "      |"; \
+    } while (0)
+
+// 先执行 len 次 fill 准备数据，再对 op 计时，fill 与 op 中可以使用容器 l 与个数 n
+#define FORWARD_LIST_DO_TEST(con, fill, op, len)                                            \
+    do {                                                                                    \
+        srand((int)time(0));                                                                \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        const size_t n = len;                                                               \
+        con l;                                                                              \
+        for (size_t i = 0; i < n; ++i) {                                                    \
+            fill;                                                                           \
+        }                                                                                   \
+        start = clock();                                                                    \
+        op;                                                                                 \
+        end = clock();                                                                      \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define FORWARD_LIST_TEST(fill, op, len1, len2, len3)                       \
+    TEST_LEN(len1, len2, len3, WIDE);                                       \
+    std::cout << "|  std::forward_list  |";                                 \
+    FORWARD_LIST_DO_TEST(std::forward_list<int>, fill, op, len1);           \
+    FORWARD_LIST_DO_TEST(std::forward_list<int>, fill, op, len2);           \
+    FORWARD_LIST_DO_TEST(std::forward_list<int>, fill, op, len3);           \
+    std::cout << "\n|     MySTL::list     |";                               \
+    FORWARD_LIST_DO_TEST(MySTL::list<int>, fill, op, len1);                 \
+    FORWARD_LIST_DO_TEST(MySTL::list<int>, fill, op, len2);                 \
+    FORWARD_LIST_DO_TEST(MySTL::list<int>, fill, op, len3);                 \
+    std::cout << "\n| MySTL::forward_list |";                               \
+    FORWARD_LIST_DO_TEST(MySTL::forward_list<int>, fill, op, len1);         \
+    FORWARD_LIST_DO_TEST(MySTL::forward_list<int>, fill, op, len2);         \
+    FORWARD_LIST_DO_TEST(MySTL::forward_list<int>, fill, op, len3);
+
+void forward_list_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : forward_list --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    MySTL::forward_list<int> l1;
+    MySTL::forward_list<int> l2(5);
+    MySTL::forward_list<int> l3(5, 1);
+    MySTL::forward_list<int> l4(a, a + 5);
+    MySTL::forward_list<int> l5(l2);
+    MySTL::forward_list<int> l6(std::move(l2));
+    MySTL::forward_list<int> l7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::forward_list<int> l8;
+    l8 = l3;
+    MySTL::forward_list<int> l9;
+    l9 = std::move(l3);
+    MySTL::forward_list<int> l10;
+    l10 = {1, 2, 2, 3, 5, 6, 7, 8, 9};
+
+    FUN_AFTER(l1, l1.assign(8, 8));
+    FUN_AFTER(l1, l1.assign(a, a + 5));
+    FUN_AFTER(l1, l1.assign({1, 2, 3, 4, 5, 6}));
+    FUN_AFTER(l1, l1.insert_after(l1.before_begin(), 0));
+    FUN_AFTER(l1, l1.insert_after(l1.begin(), 2, 7));
+    FUN_AFTER(l1, l1.insert_after(l1.before_begin(), a, a + 5));
+    FUN_AFTER(l1, l1.push_front(1));
+    FUN_AFTER(l1, l1.emplace_after(l1.begin(), 1));
+    FUN_AFTER(l1, l1.emplace_front(0));
+    FUN_AFTER(l1, l1.pop_front());
+    FUN_AFTER(l1, l1.erase_after(l1.begin()));
+    FUN_AFTER(l1, l1.erase_after(l1.begin(), l1.end()));
+    FUN_AFTER(l1, l1.resize(10));
+    FUN_AFTER(l1, l1.resize(5, 1));
+    FUN_AFTER(l1, l1.resize(8, 2));
+    FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l4));
+    FUN_AFTER(l1, l1.splice_after(l1.begin(), l5, l5.before_begin()));
+    FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l6, l6.before_begin(), ++++l6.begin()));
+    FUN_AFTER(l1, l1.remove(0));
+    FUN_AFTER(l1, l1.remove_if(is_odd));
+    FUN_AFTER(l1, l1.assign({9, 5, 3, 3, 7, 1, 3, 2, 2, 0, 10}));
+    FUN_AFTER(l1, l1.sort());
+    FUN_AFTER(l1, l1.unique());
+    FUN_AFTER(l1, l1.unique([&](int a, int b) { return b == a + 1; }));
+    FUN_AFTER(l1, l1.merge(l7));
+    FUN_AFTER(l1, l1.sort(MySTL::greater<int>()));
+    FUN_AFTER(l1, l1.merge(l8, MySTL::greater<int>()));
+    FUN_AFTER(l1, l1.reverse());
+    FUN_AFTER(l1, l1.clear());
+    FUN_AFTER(l1, l1.swap(l9));
+    FUN_VALUE(*l1.begin());
+    FUN_VALUE(l1.front());
+    std::cout << std::boolalpha;
+    FUN_VALUE(l1.empty());
+    FUN_VALUE((l1 == l10));
+    FUN_VALUE((l1 < l10));
+    std::cout << std::noboolalpha;
+    FUN_VALUE(l1.max_size());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|   bytes / element   |      int    |    double   |    string   |\n";
+    std::cout << "|        list         |";
+    NODE_BYTES_COUT(list_node);
+    std::cout << "\n|    forward_list     |";
+    NODE_BYTES_COUT(forward_list_node);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|      push_front     |";
+    FORWARD_LIST_TEST((void)0,
+                      for (size_t i = 0; i < n; ++i) l.push_front(static_cast<int>(i)),
+                      SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|         sort        |";
+    FORWARD_LIST_TEST(l.push_front(rand()), l.sort(),
+                      SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : forward_list --------------]\n";
+}
+
+}  // namespace forward_list_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_FORWARD_LIST_TEST_H_
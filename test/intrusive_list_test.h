@@ -0,0 +1,140 @@
+﻿#ifndef MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+#define MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+
+// intrusive_list test : 测试 intrusive_list 的接口，以及 LRU 式移到表头操作与 list<T*> 的性能对比
+
+#include <list>
+#include <vector>
+
+#include "../STL_Impl/intrusive_list.h"
+#include "../STL_Impl/list.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace intrusive_list_test {
+
+struct lru_tag {};
+
+// 同时挂在两条链表上的元素
+struct hooked_int : public MySTL::list_hook<>, public MySTL::list_hook<lru_tag> {
+    int value;
+    hooked_int(int v = 0) : value(v) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const hooked_int& x) {
+    return os << x.value;
+}
+
+bool is_odd(const hooked_int& x) { return x.value & 1; }
+
+// LRU 缓存中的元素，pos / std_pos 记录它在 list<T*> 中的位置
+struct lru_entry : public MySTL::list_hook<> {
+    int key;
+    MySTL::list<lru_entry*>::iterator pos;
+    std::list<lru_entry*>::iterator std_pos;
+};
+
+// 把 len 个元素按 link 依次放入链表 l，再随机选取 len 次元素 e 执行 touch，只对 touch 计时
+#define LRU_DO_TEST(con, link, touch, len)                                                  \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        volatile int sink = 0;                                                              \
+        const size_t n = len;                                                               \
+        std::vector<lru_entry> pool(n);                                                     \
+        con l;                                                                              \
+        for (size_t i = 0; i < n; ++i) {                                                    \
+            lru_entry& e = pool[i];                                                         \
+            e.key = static_cast<int>(i);                                                    \
+            link;                                                                           \
+        }                                                                                   \
+        unsigned long long r = 1;                                                           \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < n; ++i) {                                                    \
+            r = r * 6364136223846793005ULL + 1442695040888963407ULL;                        \
+            lru_entry& e = pool[static_cast<size_t>(r >> 33) % n];                          \
+            touch;                                                                          \
+        }                                                                                   \
+        end = clock();                                                                      \
+        (void)sink;                                                                         \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define LRU_STD_LINK e.std_pos = l.insert(l.end(), &e)
+#define LRU_STD_TOUCH l.splice(l.begin(), l, e.std_pos); sink = sink + l.front()->key
+#define LRU_LIST_LINK e.pos = l.insert(l.end(), &e)
+#define LRU_LIST_TOUCH l.splice(l.begin(), l, e.pos); sink = sink + l.front()->key
+#define LRU_INTRUSIVE_LINK l.push_back(e)
+#define LRU_INTRUSIVE_TOUCH l.splice(l.begin(), l, l.iterator_to(e)); sink = sink + l.front().key
+
+#define LRU_TEST(len1, len2, len3)                                                                 \
+    TEST_LEN(len1, len2, len3, WIDE);                                                              \
+    std::cout << "|   std::list<T*>     |";                                                        \
+    LRU_DO_TEST(std::list<lru_entry*>, LRU_STD_LINK, LRU_STD_TOUCH, len1);                         \
+    LRU_DO_TEST(std::list<lru_entry*>, LRU_STD_LINK, LRU_STD_TOUCH, len2);                         \
+    LRU_DO_TEST(std::list<lru_entry*>, LRU_STD_LINK, LRU_STD_TOUCH, len3);                         \
+    std::cout << "\n|  MySTL::list<T*>    |";                                                      \
+    LRU_DO_TEST(MySTL::list<lru_entry*>, LRU_LIST_LINK, LRU_LIST_TOUCH, len1);                     \
+    LRU_DO_TEST(MySTL::list<lru_entry*>, LRU_LIST_LINK, LRU_LIST_TOUCH, len2);                     \
+    LRU_DO_TEST(MySTL::list<lru_entry*>, LRU_LIST_LINK, LRU_LIST_TOUCH, len3);                     \
+    std::cout << "\n|   intrusive_list    |";                                                      \
+    LRU_DO_TEST(MySTL::intrusive_list<lru_entry>, LRU_INTRUSIVE_LINK, LRU_INTRUSIVE_TOUCH, len1);  \
+    LRU_DO_TEST(MySTL::intrusive_list<lru_entry>, LRU_INTRUSIVE_LINK, LRU_INTRUSIVE_TOUCH, len2);  \
+    LRU_DO_TEST(MySTL::intrusive_list<lru_entry>, LRU_INTRUSIVE_LINK, LRU_INTRUSIVE_TOUCH, len3);
+
+void intrusive_list_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : intrusive_list -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    hooked_int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    typedef MySTL::intrusive_list<hooked_int> int_list;
+    typedef MySTL::intrusive_list<hooked_int, MySTL::list_hook<lru_tag>> lru_list;
+    int_list l1;
+    int_list l2(a, a + 5);
+    lru_list l3(a, a + 9);
+
+    FUN_AFTER(l1, l1.push_back(a[5]));
+    FUN_AFTER(l1, l1.push_front(a[6]));
+    FUN_AFTER(l1, l1.insert(l1.begin(), a[7]));
+    FUN_AFTER(l1, l1.splice(l1.end(), l2, l2.iterator_to(a[2])));
+    FUN_AFTER(l1, l1.splice(l1.begin(), l2));
+    FUN_AFTER(l1, l1.splice(l1.begin(), l1, l1.iterator_to(a[5])));
+    FUN_AFTER(l1, l1.erase(a[3]));
+    FUN_AFTER(l1, l1.pop_front());
+    FUN_AFTER(l1, l1.pop_back());
+    FUN_AFTER(l1, l1.reverse());
+    FUN_AFTER(l1, l1.remove_if(is_odd));
+    FUN_AFTER(l1, l1.swap(l2));
+    FUN_AFTER(l3, l3.splice(l3.begin(), l3, l3.iterator_to(a[8])));
+    FUN_AFTER(l3, l3.erase(l3.begin(), l3.iterator_to(a[4])));
+    FUN_VALUE(l2.size());
+    FUN_VALUE(l3.size());
+    FUN_VALUE(l2.front());
+    FUN_VALUE(l3.back());
+    FUN_VALUE(a[0].MySTL::list_hook<>::is_linked());
+    FUN_VALUE(a[0].MySTL::list_hook<lru_tag>::is_linked());
+    FUN_AFTER(l2, l2.clear());
+    FUN_VALUE(l2.empty());
+    FUN_VALUE(a[1].MySTL::list_hook<>::is_linked());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|    move to front    |";
+    LRU_TEST(SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : intrusive_list -------------]\n";
+}
+
+}  // namespace intrusive_list_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_INTRUSIVE_LIST_TEST_H_
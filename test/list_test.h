@@ -69,6 +69,8 @@ void list_test() {
     FUN_AFTER(l1, l1.unique([&](int a, int b) { return b == a + 1; }));
     FUN_AFTER(l1, l1.merge(l7));
     FUN_AFTER(l1, l1.sort(MySTL::greater<int>()));
+    FUN_AFTER(l1, l1.indirect_sort());
+    FUN_AFTER(l1, l1.indirect_sort(MySTL::greater<int>()));
     FUN_AFTER(l1, l1.merge(l8, MySTL::greater<int>()));
     FUN_AFTER(l1, l1.reverse());
     FUN_AFTER(l1, l1.clear());
@@ -1,7 +1,7 @@
 ﻿#ifndef MYTINYSTL_MAP_TEST_H_
 #define MYTINYSTL_MAP_TEST_H_
 
-// map test : 测试 map, multimap 的接口与它们 insert 的性能
+// map test : 测试 map, multimap 的接口与它们 insert、由已排序区间构造的性能
 
 #include <map>
 
@@ -42,6 +42,34 @@ namespace map_test {
         std::cout << " " << str << " : <" << it.first << "," << it.second << ">\n"; \
     } while (0)
 
+// 由区间构造的容器与逐个插入得到的容器是否相同，包括键值相同的元素的次序
+template <class Con>
+bool same_as_one_by_one(const MySTL::vector<PAIR>& v) {
+    Con built(v.begin(), v.end());
+    Con ref;
+    for (auto& x : v)
+        ref.insert(x);
+    return built == ref;
+}
+
+// 由已排序的区间构造：键值不重复、键值重复、已排序的前缀之后跟着乱序的部分
+template <class Con>
+void sorted_range_test() {
+    MySTL::vector<PAIR> unique_keys, equal_keys, unsorted_tail;
+    for (int i = 0; i < 100; ++i) {
+        unique_keys.push_back(PAIR(i, i));
+        equal_keys.push_back(PAIR(i / 3, i));
+    }
+    unsorted_tail = equal_keys;
+    for (int i = 0; i < 20; ++i)
+        unsorted_tail.push_back(PAIR(i * 7 % 20, 100 + i));
+    std::cout << std::boolalpha;
+    FUN_VALUE(same_as_one_by_one<Con>(unique_keys));
+    FUN_VALUE(same_as_one_by_one<Con>(equal_keys));
+    FUN_VALUE(same_as_one_by_one<Con>(unsorted_tail));
+    std::cout << std::noboolalpha;
+}
+
 void map_test() {
     std::cout << "[===============================================================]" << std::endl;
     std::cout << "[------------------ Run container test : map -------------------]" << std::endl;
@@ -99,6 +127,7 @@ void map_test() {
     std::cout << std::noboolalpha;
     FUN_VALUE(m1.size());
     FUN_VALUE(m1.max_size());
+    sorted_range_test<MySTL::map<int, int>>();
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -108,6 +137,14 @@ void map_test() {
     MAP_EMPLACE_TEST(map, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
 #else
     MAP_EMPLACE_TEST(map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    sorted insert    |";
+#if LARGER_TEST_DATA_ON
+    MAP_SORTED_INSERT_TEST(map, SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    MAP_SORTED_INSERT_TEST(map, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -172,6 +209,7 @@ void multimap_test() {
     std::cout << std::noboolalpha;
     FUN_VALUE(m1.size());
     FUN_VALUE(m1.max_size());
+    sorted_range_test<MySTL::multimap<int, int>>();
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -181,6 +219,14 @@ void multimap_test() {
     MAP_EMPLACE_TEST(multimap, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
 #else
     MAP_EMPLACE_TEST(multimap, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|    sorted insert    |";
+#if LARGER_TEST_DATA_ON
+    MAP_SORTED_INSERT_TEST(multimap, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    MAP_SORTED_INSERT_TEST(multimap, SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
 #endif
     std::cout << std::endl;
     std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
@@ -0,0 +1,212 @@
+﻿#ifndef MYTINYSTL_MEMORY_RESOURCE_TEST_H_
+#define MYTINYSTL_MEMORY_RESOURCE_TEST_H_
+
+// memory_resource test : 测试 memory_resource、polymorphic_allocator 的接口，以及 pmr 容器在内存资源上反复构建、丢弃的性能
+
+#include <map>
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/map.h"
+#include "../STL_Impl/memory.h"
+#include "../STL_Impl/unordered_map.h"
+#include "../STL_Impl/vector.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace memory_resource_test {
+
+// 每一轮构建的 map 的元素个数
+#define ARENA_MAP_SIZE 10000
+
+// 每一轮用 decl 声明一个容器 c，插入 ARENA_MAP_SIZE 个元素后整个丢弃，重复 count 轮
+#define ARENA_MAP_DO_TEST(decl, count)                                                      \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        start = clock();                                                                    \
+        for (size_t round = 0; round < count; ++round) {                                    \
+            decl;                                                                           \
+            for (int i = 0; i < ARENA_MAP_SIZE; ++i)                                        \
+                c.emplace(i * 7919 % ARENA_MAP_SIZE, i);                                    \
+        }                                                                                   \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define ARENA_MAP_TEST(decl, len1, len2, len3) \
+    ARENA_MAP_DO_TEST(decl, len1);             \
+    ARENA_MAP_DO_TEST(decl, len2);             \
+    ARENA_MAP_DO_TEST(decl, len3);
+
+void memory_resource_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[------------- Run container test : memory_resource ------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    // monotonic_buffer_resource 先用完给定的缓冲区，再向上游申请，释放不回收空间
+    alignas(std::max_align_t) char buffer[256];
+    {
+        MySTL::monotonic_buffer_resource arena(buffer, sizeof(buffer), MySTL::null_memory_resource());
+        char* p1 = static_cast<char*>(arena.allocate(1, 1));
+        char* p2 = static_cast<char*>(arena.allocate(8, 8));
+        FUN_VALUE((p1 == buffer));
+        FUN_VALUE(reinterpret_cast<uintptr_t>(p2) % 8);
+        arena.deallocate(p2, 8, 8);
+        FUN_VALUE((arena.allocate(8, 8) != p2));
+        bool thrown = false;
+        try {
+            arena.allocate(sizeof(buffer));
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        FUN_VALUE(thrown);
+        arena.release();
+        FUN_VALUE((arena.allocate(1, 1) == buffer));
+    }
+    {
+        MySTL::monotonic_buffer_resource arena(64);
+        void* p = arena.allocate(1000, 64);
+        FUN_VALUE(reinterpret_cast<uintptr_t>(p) % 64);
+    }
+
+    // unsynchronized_pool_resource 复用释放的块，超大的请求直接交给上游
+    {
+        MySTL::unsynchronized_pool_resource pool(MySTL::pool_options(0, 512));
+        FUN_VALUE(pool.options().largest_required_pool_block);
+        void* p1 = pool.allocate(24);
+        void* p2 = pool.allocate(24);
+        FUN_VALUE((p1 != p2));
+        pool.deallocate(p1, 24);
+        FUN_VALUE((pool.allocate(24) == p1));
+        void* big = pool.allocate(4096, 128);
+        FUN_VALUE(reinterpret_cast<uintptr_t>(big) % 128);
+        pool.deallocate(big, 4096, 128);
+        pool.allocate(100000);
+        pool.release();
+    }
+
+    // pmr 容器的内存都来自传入的资源，资源不同的容器之间拷贝、移动都按元素进行
+    {
+        MySTL::monotonic_buffer_resource arena;
+        MySTL::pmr::vector<int> v(&arena);
+        MySTL::pmr::map<int, int> m(&arena);
+        MySTL::pmr::unordered_map<int, int> um(&arena);
+        MySTL::pmr::string s(&arena);
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+            m.emplace(i, i);
+            um.emplace(i, i);
+            s.push_back(static_cast<char>('a' + i % 26));
+        }
+        FUN_VALUE((v.get_allocator().resource() == &arena));
+        FUN_VALUE((m.get_allocator().resource() == &arena));
+        FUN_VALUE((um.get_allocator().resource() == &arena));
+        FUN_VALUE(s.substr(0, 26));
+        MySTL::pmr::vector<int> v2(v);
+        FUN_VALUE((v2.get_allocator().resource() == MySTL::get_default_resource()));
+        MySTL::unsynchronized_pool_resource pool;
+        MySTL::pmr::map<int, int> m2(&pool);
+        m2 = MySTL::move(m);
+        FUN_VALUE((m2.get_allocator().resource() == &pool));
+        FUN_VALUE(m2.size());
+
+        // 移动构造直接接管节点与桶，不向缺省资源申请空间
+        alignas(std::max_align_t) char probe_buffer[1024];
+        MySTL::monotonic_buffer_resource probe(probe_buffer, sizeof(probe_buffer), MySTL::null_memory_resource());
+        MySTL::memory_resource* old = MySTL::set_default_resource(&probe);
+        MySTL::pmr::unordered_map<int, int> um2(MySTL::move(um));
+        MySTL::set_default_resource(old);
+        FUN_VALUE((probe.allocate(1, 1) == probe_buffer));
+        FUN_VALUE((um2.get_allocator().resource() == &arena));
+        FUN_VALUE(um2.size());
+
+        // 资源不同的移动赋值逐个复制元素，空间不足时抛出异常，而不是终止程序
+        MySTL::pmr::unordered_map<int, int> um3(&pool);
+        um3 = MySTL::move(um2);
+        FUN_VALUE((um3.get_allocator().resource() == &pool));
+        FUN_VALUE(um3.size());
+        alignas(std::max_align_t) char small_buffer[1024];
+        MySTL::monotonic_buffer_resource small(small_buffer, sizeof(small_buffer), MySTL::null_memory_resource());
+        MySTL::pmr::unordered_map<int, int> um4(&small);
+        bool thrown = false;
+        try {
+            um4 = MySTL::move(um3);
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        FUN_VALUE(thrown);
+        FUN_VALUE(um4.size());
+    }
+
+    // 缺省资源可以在运行期替换
+    {
+        MySTL::monotonic_buffer_resource arena;
+        MySTL::memory_resource* old = MySTL::set_default_resource(&arena);
+        FUN_VALUE((old == MySTL::new_delete_resource()));
+        MySTL::pmr::vector<int> v;
+        FUN_VALUE((v.get_allocator().resource() == &arena));
+        MySTL::set_default_resource(old);
+        FUN_VALUE((MySTL::get_default_resource() == MySTL::new_delete_resource()));
+    }
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    typedef std::map<int, int> std_map;
+    typedef MySTL::map<int, int> my_map;
+    typedef MySTL::pmr::map<int, int> pmr_map;
+    // 单调资源先使用一块可以重复利用的缓冲区，每轮结束时随资源一起整体丢弃
+    const size_t arena_size = ARENA_MAP_SIZE * 64;
+    char* arena_buffer = new char[arena_size];
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|  10k map per round  |";
+#if LARGER_TEST_DATA_ON
+    TEST_LEN(SCALE_M(LEN1) / 1000, SCALE_M(LEN2) / 1000, SCALE_M(LEN3) / 1000, WIDE);
+#else
+    TEST_LEN(SCALE_S(LEN1) / 1000, SCALE_S(LEN2) / 1000, SCALE_S(LEN3) / 1000, WIDE);
+#endif
+    std::cout << "|         std         |";
+#if LARGER_TEST_DATA_ON
+    ARENA_MAP_TEST(std_map c, SCALE_M(LEN1) / 1000, SCALE_M(LEN2) / 1000, SCALE_M(LEN3) / 1000);
+#else
+    ARENA_MAP_TEST(std_map c, SCALE_S(LEN1) / 1000, SCALE_S(LEN2) / 1000, SCALE_S(LEN3) / 1000);
+#endif
+    std::cout << "\n|        MySTL        |";
+#if LARGER_TEST_DATA_ON
+    ARENA_MAP_TEST(my_map c, SCALE_M(LEN1) / 1000, SCALE_M(LEN2) / 1000, SCALE_M(LEN3) / 1000);
+#else
+    ARENA_MAP_TEST(my_map c, SCALE_S(LEN1) / 1000, SCALE_S(LEN2) / 1000, SCALE_S(LEN3) / 1000);
+#endif
+    std::cout << "\n| pmr new_delete      |";
+#if LARGER_TEST_DATA_ON
+    ARENA_MAP_TEST(pmr_map c, SCALE_M(LEN1) / 1000, SCALE_M(LEN2) / 1000, SCALE_M(LEN3) / 1000);
+#else
+    ARENA_MAP_TEST(pmr_map c, SCALE_S(LEN1) / 1000, SCALE_S(LEN2) / 1000, SCALE_S(LEN3) / 1000);
+#endif
+    std::cout << "\n| pmr monotonic       |";
+#if LARGER_TEST_DATA_ON
+    ARENA_MAP_TEST(MySTL::monotonic_buffer_resource r(arena_buffer, arena_size); pmr_map c(&r), SCALE_M(LEN1) / 1000, SCALE_M(LEN2) / 1000, SCALE_M(LEN3) / 1000);
+#else
+    ARENA_MAP_TEST(MySTL::monotonic_buffer_resource r(arena_buffer, arena_size); pmr_map c(&r), SCALE_S(LEN1) / 1000, SCALE_S(LEN2) / 1000, SCALE_S(LEN3) / 1000);
+#endif
+    std::cout << "\n| pmr unsync pool     |";
+#if LARGER_TEST_DATA_ON
+    ARENA_MAP_TEST(MySTL::unsynchronized_pool_resource r; pmr_map c(&r), SCALE_M(LEN1) / 1000, SCALE_M(LEN2) / 1000, SCALE_M(LEN3) / 1000);
+#else
+    ARENA_MAP_TEST(MySTL::unsynchronized_pool_resource r; pmr_map c(&r), SCALE_S(LEN1) / 1000, SCALE_S(LEN2) / 1000, SCALE_S(LEN3) / 1000);
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    delete[] arena_buffer;
+    PASSED;
+#endif
+    std::cout << "[------------ End container test : memory_resource -------------]" << std::endl;
+}
+
+}  // namespace memory_resource_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_MEMORY_RESOURCE_TEST_H_
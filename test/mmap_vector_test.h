@@ -0,0 +1,204 @@
+﻿#ifndef MYTINYSTL_MMAP_VECTOR_TEST_H_
+#define MYTINYSTL_MMAP_VECTOR_TEST_H_
+
+// mmap_vector test : 测试 mmap_vector 的接口，以及打开映射文件与从文件重建 vector 的耗时
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+#include "../STL_Impl/mmap_vector.h"
+#include "../STL_Impl/vector.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace mmap_vector_test {
+
+#if MYSTL_HAS_FILE_MAP
+
+const char* const raw_file = "mystl_mmap_test.raw";  // 按字节写出的数组，重建时读入后逐个 push_back
+const char* const map_file = "mystl_mmap_test.map";  // 同样的数组，由 mmap_vector 写出
+
+// 写出 len 个元素的两份文件
+void prepare_files(size_t len) {
+    MySTL::mmap_vector<uint64_t> v(map_file, MySTL::mmap_truncate);
+    v.resize_default_init(len);
+    for (size_t i = 0; i < len; ++i)
+        v[i] = i * 2654435761u;
+    v.flush();
+    std::FILE* f = std::fopen(raw_file, "wb");
+    if (f != nullptr) {
+        std::fwrite(v.data(), sizeof(uint64_t), len, f);
+        std::fclose(f);
+    }
+}
+
+// 写回并丢弃文件在页缓存中的内容，之后的第一次访问要从磁盘读入
+void drop_cache(const char* path) {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return;
+    (void)::fsync(fd);
+#if defined(POSIX_FADV_DONTNEED)
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    ::close(fd);
+}
+
+// 读入整个文件，逐个 push_back 到 vector 后求和
+uint64_t rebuild_sum() {
+    MySTL::vector<uint64_t> v;
+    uint64_t buf[8192];
+    std::FILE* f = std::fopen(raw_file, "rb");
+    if (f == nullptr) return 0;
+    size_t got;
+    while ((got = std::fread(buf, sizeof(uint64_t), 8192, f)) != 0) {
+        for (size_t i = 0; i < got; ++i)
+            v.push_back(buf[i]);
+    }
+    std::fclose(f);
+    uint64_t sum = 0;
+    for (auto x : v)
+        sum += x;
+    return sum;
+}
+
+// 只读打开映射文件后求和
+uint64_t mapped_sum() {
+    MySTL::mmap_vector<uint64_t> v(map_file, MySTL::mmap_read_only);
+    uint64_t sum = 0;
+    for (auto x : v)
+        sum += x;
+    return sum;
+}
+
+// 每格都重新写出文件，cold 为 true 时先丢弃页缓存，计时包括打开与读遍所有元素
+#define MMAP_OPEN_DO_TEST(fun, cold, len)                                                                     \
+    do {                                                                                                      \
+        char buf[10];                                                                                         \
+        prepare_files(len);                                                                                   \
+        if (cold) {                                                                                           \
+            drop_cache(raw_file);                                                                             \
+            drop_cache(map_file);                                                                             \
+        }                                                                                                     \
+        auto start = std::chrono::steady_clock::now();                                                        \
+        volatile uint64_t sink = fun();                                                                       \
+        auto end = std::chrono::steady_clock::now();                                                          \
+        (void)sink;                                                                                           \
+        int n = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                                             \
+        std::string t = buf;                                                                                  \
+        t += "ms    |";                                                                                       \
+        std::cout << std::setw(WIDE) << t;                                                                    \
+    } while (0)
+
+#define MMAP_OPEN_TEST(len1, len2, len3)                \
+    TEST_LEN(len1, len2, len3, WIDE);                   \
+    std::cout << "|  rebuild from file  |";             \
+    MMAP_OPEN_DO_TEST(rebuild_sum, false, len1);        \
+    MMAP_OPEN_DO_TEST(rebuild_sum, false, len2);        \
+    MMAP_OPEN_DO_TEST(rebuild_sum, false, len3);        \
+    std::cout << "\n|  mmap_vector cold   |";           \
+    MMAP_OPEN_DO_TEST(mapped_sum, true, len1);          \
+    MMAP_OPEN_DO_TEST(mapped_sum, true, len2);          \
+    MMAP_OPEN_DO_TEST(mapped_sum, true, len3);          \
+    std::cout << "\n|  mmap_vector warm   |";           \
+    MMAP_OPEN_DO_TEST(mapped_sum, false, len1);         \
+    MMAP_OPEN_DO_TEST(mapped_sum, false, len2);         \
+    MMAP_OPEN_DO_TEST(mapped_sum, false, len3);
+
+#endif  // MYSTL_HAS_FILE_MAP
+
+void mmap_vector_test() {
+#if MYSTL_HAS_FILE_MAP
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : mmap_vector ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    const char* path = "mystl_mmap_api.map";
+    int a[] = {1, 2, 3, 4, 5};
+    {
+        MySTL::mmap_vector<int> v1(path, MySTL::mmap_truncate);
+        FUN_VALUE(v1.is_open());
+        FUN_VALUE(v1.size());
+        FUN_AFTER(v1, v1.push_back(6));
+        FUN_AFTER(v1, v1.emplace_back(7));
+        FUN_AFTER(v1, v1.append(a, a + 5));
+        FUN_AFTER(v1, v1.push_back(v1[0]));
+        FUN_AFTER(v1, v1.pop_back());
+        FUN_AFTER(v1, v1.resize(10, 9));
+        FUN_AFTER(v1, v1.resize(9));
+        FUN_VALUE(*v1.begin());
+        FUN_VALUE(*(v1.end() - 1));
+        FUN_VALUE(*v1.rbegin());
+        FUN_VALUE(v1.front());
+        FUN_VALUE(v1.back());
+        FUN_VALUE(v1.at(2));
+        FUN_VALUE(v1.capacity());
+        FUN_AFTER(v1, v1.reserve(5000));
+        FUN_VALUE(v1.capacity());
+        FUN_AFTER(v1, v1.shrink_to_fit());
+        FUN_VALUE(v1.capacity());
+        MySTL::mmap_vector<int> v2(MySTL::move(v1));
+        FUN_VALUE(v1.is_open());
+        FUN_VALUE(v2.size());
+    }
+    {
+        // 重新打开时直接映射，内容与关闭前相同
+        MySTL::mmap_vector<int> v3(path);
+        COUT(v3);
+        FUN_AFTER(v3, v3.push_back(10));
+        FUN_AFTER(v3, v3.flush());
+    }
+    {
+        MySTL::mmap_vector<int> v4(path, MySTL::mmap_read_only);
+        COUT(v4);
+        FUN_VALUE(v4[0]);
+        FUN_VALUE(v4.is_read_only());
+        bool thrown = false;
+        try {
+            v4.push_back(1);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        FUN_VALUE(thrown);
+        thrown = false;
+        try {
+            v4.clear();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        FUN_VALUE(thrown);
+        // 私有映射，写入元素只修改本进程的副本
+        FUN_AFTER(v4, v4[0] = 100);
+        MySTL::mmap_vector<int> v6(path, MySTL::mmap_read_only);
+        FUN_VALUE(v6[0]);
+        thrown = false;
+        try {
+            MySTL::mmap_vector<int64_t> v5(path, MySTL::mmap_read_only);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        FUN_VALUE(thrown);
+    }
+    std::remove(path);
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|   open + sum u64    |";
+    MMAP_OPEN_TEST(SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::remove(raw_file);
+    std::remove(map_file);
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : mmap_vector ---------------]\n";
+#endif  // MYSTL_HAS_FILE_MAP
+}
+
+}  // namespace mmap_vector_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_MMAP_VECTOR_TEST_H_
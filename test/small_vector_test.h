@@ -0,0 +1,139 @@
+﻿#ifndef MYTINYSTL_SMALL_VECTOR_TEST_H_
+#define MYTINYSTL_SMALL_VECTOR_TEST_H_
+
+// small_vector test : 测试 small_vector 的接口，以及大量短小 vector 的构造与析构性能
+
+#include <vector>
+
+#include "../STL_Impl/astring.h"
+#include "../STL_Impl/small_vector.h"
+#include "../STL_Impl/vector.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace small_vector_test {
+
+// 构造 count 个容器，每个插入 elems 个元素后析构
+#define SHORT_VECTOR_DO_TEST(con, elems, count)                                              \
+    do {                                                                                     \
+        clock_t start, end;                                                                  \
+        char buf[10];                                                                        \
+        volatile int sink = 0;                                                               \
+        start = clock();                                                                     \
+        for (size_t i = 0; i < count; ++i) {                                                 \
+            con c;                                                                           \
+            for (int k = 0; k < elems; ++k)                                                  \
+                c.push_back(k);                                                              \
+            sink = sink + c[i % elems];                                                      \
+        }                                                                                    \
+        end = clock();                                                                       \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                           \
+        std::string t = buf;                                                                 \
+        t += "ms    |";                                                                      \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define SHORT_VECTOR_TEST(small_con, elems, len1, len2, len3) \
+    TEST_LEN(len1, len2, len3, WIDE);                         \
+    std::cout << "|         std         |";                   \
+    SHORT_VECTOR_DO_TEST(std::vector<int>, elems, len1);      \
+    SHORT_VECTOR_DO_TEST(std::vector<int>, elems, len2);      \
+    SHORT_VECTOR_DO_TEST(std::vector<int>, elems, len3);      \
+    std::cout << "\n|        MySTL        |";                 \
+    SHORT_VECTOR_DO_TEST(MySTL::vector<int>, elems, len1);    \
+    SHORT_VECTOR_DO_TEST(MySTL::vector<int>, elems, len2);    \
+    SHORT_VECTOR_DO_TEST(MySTL::vector<int>, elems, len3);    \
+    std::cout << "\n|    small_vector     |";                 \
+    SHORT_VECTOR_DO_TEST(small_con, elems, len1);             \
+    SHORT_VECTOR_DO_TEST(small_con, elems, len2);             \
+    SHORT_VECTOR_DO_TEST(small_con, elems, len3);
+
+void small_vector_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : small_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    MySTL::small_vector<int, 4> v1;
+    MySTL::small_vector<int, 4> v2(10);
+    MySTL::small_vector<int, 4> v3(3, 1);
+    MySTL::small_vector<int, 4> v4(a, a + 5);
+    MySTL::small_vector<int, 4> v5(v2);
+    MySTL::small_vector<int, 4> v6(std::move(v2));
+    MySTL::small_vector<int, 4> v7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MySTL::small_vector<int, 4> v8, v9, v10;
+    v8 = v3;
+    v9 = std::move(v3);
+    v10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    FUN_AFTER(v1, v1.assign(3, 8));
+    FUN_VALUE(v1.is_inline());
+    FUN_AFTER(v1, v1.assign(a, a + 5));
+    FUN_VALUE(v1.is_inline());
+    FUN_AFTER(v1, v1.emplace(v1.begin(), 0));
+    FUN_AFTER(v1, v1.emplace_back(6));
+    FUN_AFTER(v1, v1.push_back(6));
+    FUN_AFTER(v1, v1.insert(v1.end(), 7));
+    FUN_AFTER(v1, v1.insert(v1.begin() + 3, 2, 3));
+    FUN_AFTER(v1, v1.insert(v1.begin(), a, a + 5));
+    FUN_AFTER(v1, v1.pop_back());
+    FUN_AFTER(v1, v1.erase(v1.begin()));
+    FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 2));
+    FUN_AFTER(v1, v1.reverse());
+    FUN_AFTER(v1, v1.swap(v8));
+    FUN_VALUE(*v1.begin());
+    FUN_VALUE(*(v1.end() - 1));
+    FUN_VALUE(*v1.rbegin());
+    FUN_VALUE(v1.front());
+    FUN_VALUE(v1.back());
+    FUN_VALUE(v1.at(1));
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v1.capacity());
+    FUN_AFTER(v8, v8.resize(3));
+    FUN_VALUE(v8.capacity());
+    FUN_AFTER(v8, v8.shrink_to_fit());
+    FUN_VALUE(v8.is_inline());
+    FUN_VALUE(v8.capacity());
+    FUN_AFTER(v8, v8.reserve(20));
+    FUN_VALUE(v8.capacity());
+    FUN_AFTER(v8, v8.clear());
+    FUN_VALUE(v8.size());
+    FUN_VALUE((v5 == v6));
+    FUN_VALUE((v9 < v10));
+
+    // 元素在内部空间与堆之间搬运，参数引用容器自身的元素时也要正确
+    MySTL::small_vector<MySTL::string, 2> vs;
+    vs.emplace_back(3, 'a');
+    vs.emplace_back(3, 'b');
+    FUN_AFTER(vs, vs.push_back(vs[0]));
+    FUN_AFTER(vs, vs.insert(vs.begin(), 2, vs.back()));
+    FUN_AFTER(vs, vs.erase(vs.begin() + 1, vs.end() - 1));
+    FUN_AFTER(vs, vs.shrink_to_fit());
+    FUN_VALUE(vs.is_inline());
+    MySTL::small_vector<MySTL::string, 2> vs2(MySTL::move(vs));
+    FUN_AFTER(vs2, vs2.swap(vs));
+    FUN_VALUE(vs.size());
+    FUN_VALUE(vs2.size());
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    typedef MySTL::small_vector<int, 8> small_vec;
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|   6 ints x count    |";
+    SHORT_VECTOR_TEST(small_vec, 6, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  12 ints x count    |";
+    SHORT_VECTOR_TEST(small_vec, 12, SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : small_vector --------------]\n";
+}
+
+}  // namespace small_vector_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_SMALL_VECTOR_TEST_H_
@@ -0,0 +1,211 @@
+﻿#ifndef MYTINYSTL_SMART_PTR_TEST_H_
+#define MYTINYSTL_SMART_PTR_TEST_H_
+
+// smart_ptr test : 测试 unique_ptr、shared_ptr、weak_ptr 的接口，以及 make_shared、引用计数、移动 unique_ptr 的性能
+
+#include <memory>
+#include <vector>
+
+#include "../STL_Impl/memory.h"
+#include "../STL_Impl/unordered_set.h"
+#include "../STL_Impl/vector.h"
+#include "test.h"
+
+namespace MySTL {
+namespace test {
+namespace smart_ptr_test {
+
+struct widget : public MySTL::enable_shared_from_this<widget> {
+    int value;
+    explicit widget(int v) : value(v) {}
+};
+
+struct base {
+    virtual ~base() {}
+};
+
+struct derived : public base {
+    int value = 7;
+};
+
+// 统计删除次数的删除器，用来检查对象是否恰好被删除一次
+struct counting_delete {
+    int* count;
+    void operator()(int* p) const {
+        ++*count;
+        delete p;
+    }
+};
+
+// 先执行 setup，再执行 count 次 body
+#define SMART_PTR_DO_TEST(setup, body, count)                                               \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        volatile long sink = 0;                                                             \
+        setup;                                                                              \
+        start = clock();                                                                    \
+        for (size_t i = 0; i < count; ++i) {                                                \
+            body;                                                                           \
+        }                                                                                   \
+        end = clock();                                                                      \
+        (void)sink;                                                                         \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+#define SMART_PTR_TEST(std_setup, std_body, my_setup, my_body, len1, len2, len3) \
+    TEST_LEN(len1, len2, len3, WIDE);                                             \
+    std::cout << "|         std         |";                                       \
+    SMART_PTR_DO_TEST(std_setup, std_body, len1);                                 \
+    SMART_PTR_DO_TEST(std_setup, std_body, len2);                                 \
+    SMART_PTR_DO_TEST(std_setup, std_body, len3);                                 \
+    std::cout << "\n|        MySTL        |";                                     \
+    SMART_PTR_DO_TEST(my_setup, my_body, len1);                                   \
+    SMART_PTR_DO_TEST(my_setup, my_body, len2);                                   \
+    SMART_PTR_DO_TEST(my_setup, my_body, len3);
+
+void smart_ptr_test() {
+    std::cout << "[===============================================================]" << std::endl;
+    std::cout << "[--------------- Run container test : smart_ptr ----------------]" << std::endl;
+    std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+    std::cout << std::boolalpha;
+    // unique_ptr 的删除器为空类时只占一个指针
+    FUN_VALUE((sizeof(MySTL::unique_ptr<int>) == sizeof(int*)));
+    FUN_VALUE((sizeof(MySTL::unique_ptr<int[]>) == sizeof(int*)));
+    MySTL::unique_ptr<int> u1 = MySTL::make_unique<int>(5);
+    MySTL::unique_ptr<int> u2(MySTL::move(u1));
+    FUN_VALUE((u1 == nullptr));
+    FUN_VALUE(*u2);
+    u1.reset(new int(3));
+    u1.swap(u2);
+    FUN_VALUE(*u1);
+    FUN_VALUE(*u2);
+    MySTL::unique_ptr<int[]> ua = MySTL::make_unique<int[]>(4);
+    ua[2] = 9;
+    FUN_VALUE(ua[0] + ua[2]);
+    MySTL::unique_ptr<base> ub(new derived);
+    FUN_VALUE(static_cast<derived*>(ub.get())->value);
+    int deleted = 0;
+    {
+        MySTL::unique_ptr<int, counting_delete> ud(new int(1), counting_delete{&deleted});
+        MySTL::shared_ptr<int> sd(new int(2), counting_delete{&deleted});
+        MySTL::shared_ptr<int> sd2 = sd;
+    }
+    FUN_VALUE(deleted);
+
+    // vector 按字节搬运 unique_ptr
+    MySTL::vector<MySTL::unique_ptr<int>> vu;
+    for (int i = 0; i < 5; ++i)
+        vu.push_back(MySTL::make_unique<int>(i));
+    vu.insert(vu.begin() + 1, MySTL::make_unique<int>(10));
+    vu.erase(vu.begin() + 3);
+    std::cout << " vu :";
+    for (auto& p : vu)
+        std::cout << " " << *p;
+    std::cout << "\n";
+
+    // shared_ptr 与 weak_ptr
+    MySTL::shared_ptr<int> s1 = MySTL::make_shared<int>(42);
+    MySTL::weak_ptr<int> w1 = s1;
+    FUN_VALUE(s1.use_count());
+    {
+        MySTL::shared_ptr<int> s2 = s1;
+        FUN_VALUE(s1.use_count());
+        FUN_VALUE(*w1.lock());
+    }
+    FUN_VALUE(s1.use_count());
+    s1.reset();
+    FUN_VALUE(w1.expired());
+    FUN_VALUE((w1.lock() == nullptr));
+    bool thrown = false;
+    try {
+        MySTL::shared_ptr<int> s3(w1);
+    } catch (const MySTL::bad_weak_ptr&) {
+        thrown = true;
+    }
+    FUN_VALUE(thrown);
+
+    MySTL::shared_ptr<widget> sw = MySTL::make_shared<widget>(8);
+    MySTL::shared_ptr<widget> sw2 = sw->shared_from_this();
+    FUN_VALUE(sw.use_count());
+    FUN_VALUE((sw2 == sw));
+    MySTL::shared_ptr<int> alias(sw, &sw->value);
+    FUN_VALUE(*alias);
+    FUN_VALUE(sw.use_count());
+
+    MySTL::shared_ptr<base> sb = MySTL::make_shared<derived>();
+    MySTL::shared_ptr<derived> sdv = MySTL::dynamic_pointer_cast<derived>(sb);
+    FUN_VALUE(sdv->value);
+    MySTL::shared_ptr<int> su(MySTL::make_unique<int>(6));
+    FUN_VALUE(*su);
+
+    MySTL::unordered_set<MySTL::shared_ptr<int>> hs;
+    hs.insert(su);
+    hs.insert(su);
+    FUN_VALUE(hs.size());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|     make_shared     |";
+#if LARGER_TEST_DATA_ON
+    SMART_PTR_TEST(, std::shared_ptr<int> p = std::make_shared<int>(static_cast<int>(i)); sink = sink + *p,
+                   , MySTL::shared_ptr<int> p = MySTL::make_shared<int>(static_cast<int>(i)); sink = sink + *p,
+                   SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    SMART_PTR_TEST(, std::shared_ptr<int> p = std::make_shared<int>(static_cast<int>(i)); sink = sink + *p,
+                   , MySTL::shared_ptr<int> p = MySTL::make_shared<int>(static_cast<int>(i)); sink = sink + *p,
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   shared_ptr copy   |";
+#if LARGER_TEST_DATA_ON
+    SMART_PTR_TEST(std::shared_ptr<int> sp = std::make_shared<int>(1), std::shared_ptr<int> p(sp); sink = sink + *p,
+                   MySTL::shared_ptr<int> sp = MySTL::make_shared<int>(1), MySTL::shared_ptr<int> p(sp); sink = sink + *p,
+                   SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    SMART_PTR_TEST(std::shared_ptr<int> sp = std::make_shared<int>(1), std::shared_ptr<int> p(sp); sink = sink + *p,
+                   MySTL::shared_ptr<int> sp = MySTL::make_shared<int>(1), MySTL::shared_ptr<int> p(sp); sink = sink + *p,
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "|   weak_ptr lock     |";
+#if LARGER_TEST_DATA_ON
+    SMART_PTR_TEST(std::shared_ptr<int> sp = std::make_shared<int>(1); std::weak_ptr<int> wp = sp, sink = sink + *wp.lock(),
+                   MySTL::shared_ptr<int> sp = MySTL::make_shared<int>(1); MySTL::weak_ptr<int> wp = sp, sink = sink + *wp.lock(),
+                   SCALE_L(LEN1), SCALE_L(LEN2), SCALE_L(LEN3));
+#else
+    SMART_PTR_TEST(std::shared_ptr<int> sp = std::make_shared<int>(1); std::weak_ptr<int> wp = sp, sink = sink + *wp.lock(),
+                   MySTL::shared_ptr<int> sp = MySTL::make_shared<int>(1); MySTL::weak_ptr<int> wp = sp, sink = sink + *wp.lock(),
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    std::cout << "| vector<unique_ptr>  |";
+#if LARGER_TEST_DATA_ON
+    SMART_PTR_TEST(std::vector<std::unique_ptr<int>> v, v.push_back(std::unique_ptr<int>(new int(static_cast<int>(i)))),
+                   MySTL::vector<MySTL::unique_ptr<int>> v, v.push_back(MySTL::unique_ptr<int>(new int(static_cast<int>(i)))),
+                   SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    SMART_PTR_TEST(std::vector<std::unique_ptr<int>> v, v.push_back(std::unique_ptr<int>(new int(static_cast<int>(i)))),
+                   MySTL::vector<MySTL::unique_ptr<int>> v, v.push_back(MySTL::unique_ptr<int>(new int(static_cast<int>(i)))),
+                   SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << std::endl;
+    std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+    PASSED;
+#endif
+    std::cout << "[--------------- End container test : smart_ptr ----------------]" << std::endl;
+}
+
+}  // namespace smart_ptr_test
+}  // namespace test
+}  // namespace MySTL
+#endif  // !MYTINYSTL_SMART_PTR_TEST_H_
@@ -77,6 +77,9 @@ void string_test() {
     FUN_VALUE(str.size());
     STR_FUN_AFTER(str, str.resize(20, 'x'));
     FUN_VALUE(str.size());
+    STR_FUN_AFTER(str, std::memcpy(str.append_uninitialized(3), "abc", 3));
+    STR_FUN_AFTER(str, str.resize_default_init(22));
+    FUN_VALUE(str.size());
     STR_FUN_AFTER(str, str.clear());
 
     STR_FUN_AFTER(str, str = "string");
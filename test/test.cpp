@@ -9,12 +9,23 @@
 #endif  // check memory leaks
 
 #include "algorithm_performance_test.h"
+#include "allocator_test.h"
 #include "algorithm_test.h"
+#include "bit_vector_test.h"
+#include "btree_test.h"
+#include "flat_map_test.h"
+#include "circular_buffer_test.h"
 #include "deque_test.h"
+#include "forward_list_test.h"
+#include "intrusive_list_test.h"
 #include "list_test.h"
 #include "map_test.h"
+#include "memory_resource_test.h"
+#include "mmap_vector_test.h"
 #include "queue_test.h"
 #include "set_test.h"
+#include "small_vector_test.h"
+#include "smart_ptr_test.h"
 #include "stack_test.h"
 #include "string_test.h"
 #include "unordered_map_test.h"
@@ -29,8 +40,14 @@ int main() {
     RUN_ALL_TESTS();
     algorithm_performance_test::algorithm_performance_test();
     vector_test::vector_test();
+    small_vector_test::small_vector_test();
+    bit_vector_test::bit_vector_test();
+    mmap_vector_test::mmap_vector_test();
     list_test::list_test();
+    intrusive_list_test::intrusive_list_test();
+    forward_list_test::forward_list_test();
     deque_test::deque_test();
+    circular_buffer_test::circular_buffer_test();
     queue_test::queue_test();
     queue_test::priority_test();
     stack_test::stack_test();
@@ -38,11 +55,21 @@ int main() {
     map_test::multimap_test();
     set_test::set_test();
     set_test::multiset_test();
+    btree_test::btree_map_test();
+    btree_test::btree_multimap_test();
+    btree_test::btree_set_test();
+    flat_map_test::flat_map_test();
+    flat_map_test::flat_multimap_test();
+    flat_map_test::flat_split_map_test();
+    flat_map_test::flat_set_test();
     unordered_map_test::unordered_map_test();
     unordered_map_test::unordered_multimap_test();
     unordered_set_test::unordered_set_test();
     unordered_set_test::unordered_multiset_test();
     string_test::string_test();
+    allocator_test::allocator_test();
+    memory_resource_test::memory_resource_test();
+    smart_ptr_test::smart_ptr_test();
 
 #if defined(_MSC_VER) && defined(_DEBUG)
     _CrtDumpMemoryLeaks();
@@ -592,6 +592,17 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide) {
 #define TEST_LEN(len1, len2, len3, wide) \
     test_len(len1, len2, len3, wide)
 
+// 由随机数生成键值，缺省由随机数的十进制表示构造，用于字符串类型
+template <class Key>
+Key random_key() {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%d", rand());
+    return Key(buf);
+}
+
+template <>
+inline int random_key<int>() { return rand(); }
+
 // 常用测试性能的宏
 #define FUN_TEST_FORMAT1(mode, fun, arg, count)                                             \
     do {                                                                                    \
@@ -627,7 +638,7 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide) {
         std::cout << std::setw(WIDE) << t;                                                  \
     } while (0)
 
-#define LIST_SORT_DO_TEST(mode, count)                                                      \
+#define LIST_SORT_DO_TEST(mode, sort, count)                                                \
     do {                                                                                    \
         srand((int)time(0));                                                                \
         clock_t start, end;                                                                 \
@@ -662,6 +673,48 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide) {
         std::cout << std::setw(WIDE) << t;                                                  \
     } while (0)
 
+// 由已排序的 count 个键值对构造 map，每个键值出现两次
+#define MAP_SORTED_INSERT_DO_TEST(mode, con, count)                                        \
+    do {                                                                                    \
+        clock_t start, end;                                                                 \
+        std::vector<mode::pair<int, int>> v;                                                \
+        v.reserve(count);                                                                   \
+        for (size_t i = 0; i < count; ++i)                                                  \
+            v.push_back(mode::make_pair(static_cast<int>(i / 2), static_cast<int>(i)));     \
+        char buf[10];                                                                       \
+        start = clock();                                                                    \
+        mode::con<int, int> c(v.data(), v.data() + v.size());                               \
+        end = clock();                                                                      \
+        int n = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                                           \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
+// 先准备 len 个随机键值对 in，执行 fill 后对 op 计时，fill 与 op 中可以使用容器 m、键值对 in 与个数 n
+#define RANDOM_PAIR_DO_TEST(con, key, fill, op, len)                                        \
+    do {                                                                                    \
+        srand((int)time(0));                                                                \
+        clock_t start, end;                                                                 \
+        char buf[10];                                                                       \
+        const size_t n = len;                                                               \
+        MySTL::vector<MySTL::pair<key, int>> in;                                            \
+        in.reserve(n);                                                                      \
+        for (size_t i = 0; i < n; ++i)                                                      \
+            in.push_back(MySTL::make_pair(random_key<key>(), static_cast<int>(i)));         \
+        con<key, int> m;                                                                    \
+        fill;                                                                               \
+        start = clock();                                                                    \
+        op;                                                                                 \
+        end = clock();                                                                      \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                          \
+        std::string t = buf;                                                                \
+        t += "ms    |";                                                                     \
+        std::cout << std::setw(WIDE) << t;                                                  \
+    } while (0)
+
 // 重构重复代码
 #define CON_TEST_P1(con, fun, arg, len1, len2, len3) \
     TEST_LEN(len1, len2, len3, WIDE);                \
@@ -696,16 +749,31 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide) {
     MAP_EMPLACE_DO_TEST(MySTL, con, len2);      \
     MAP_EMPLACE_DO_TEST(MySTL, con, len3);
 
-#define LIST_SORT_TEST(len1, len2, len3)      \
-    TEST_LEN(len1, len2, len3, WIDE);         \
-    std::cout << "|         std         |";   \
-    LIST_SORT_DO_TEST(std, len1);             \
-    LIST_SORT_DO_TEST(std, len2);             \
-    LIST_SORT_DO_TEST(std, len3);             \
-    std::cout << "\n|        MySTL        |"; \
-    LIST_SORT_DO_TEST(MySTL, len1);           \
-    LIST_SORT_DO_TEST(MySTL, len2);           \
-    LIST_SORT_DO_TEST(MySTL, len3);
+#define MAP_SORTED_INSERT_TEST(con, len1, len2, len3) \
+    TEST_LEN(len1, len2, len3, WIDE);                  \
+    std::cout << "|         std         |";            \
+    MAP_SORTED_INSERT_DO_TEST(std, con, len1);         \
+    MAP_SORTED_INSERT_DO_TEST(std, con, len2);         \
+    MAP_SORTED_INSERT_DO_TEST(std, con, len3);         \
+    std::cout << "\n|        MySTL        |";          \
+    MAP_SORTED_INSERT_DO_TEST(MySTL, con, len1);       \
+    MAP_SORTED_INSERT_DO_TEST(MySTL, con, len2);       \
+    MAP_SORTED_INSERT_DO_TEST(MySTL, con, len3);
+
+#define LIST_SORT_TEST(len1, len2, len3)             \
+    TEST_LEN(len1, len2, len3, WIDE);                \
+    std::cout << "|         std         |";          \
+    LIST_SORT_DO_TEST(std, sort, len1);              \
+    LIST_SORT_DO_TEST(std, sort, len2);              \
+    LIST_SORT_DO_TEST(std, sort, len3);              \
+    std::cout << "\n|        MySTL        |";        \
+    LIST_SORT_DO_TEST(MySTL, sort, len1);            \
+    LIST_SORT_DO_TEST(MySTL, sort, len2);            \
+    LIST_SORT_DO_TEST(MySTL, sort, len3);            \
+    std::cout << "\n|   MySTL indirect    |";        \
+    LIST_SORT_DO_TEST(MySTL, indirect_sort, len1);   \
+    LIST_SORT_DO_TEST(MySTL, indirect_sort, len2);   \
+    LIST_SORT_DO_TEST(MySTL, indirect_sort, len3);
 
 // 简单测试的宏定义
 #define TEST(testcase_name) \
@@ -1,10 +1,19 @@
 ﻿#ifndef MYTINYSTL_VECTOR_TEST_H_
 #define MYTINYSTL_VECTOR_TEST_H_
 
-// vector test : 测试 vector 的接口与 push_back 的性能
+// vector test : 测试 vector 的接口，以及 push_back、构造、元素按字节搬运、从文件填充缓冲区的性能，扩容时的峰值内存和不同增长策略浪费的容量
 
+#include <cstdio>
+#include <string>
 #include <vector>
 
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "../STL_Impl/astring.h"
 #include "../STL_Impl/vector.h"
 #include "test.h"
 
@@ -12,6 +21,208 @@ namespace MySTL {
 namespace test {
 namespace vector_test {
 
+// 重复构造 100 次 count 个元素的 vector，args 中用 n 表示元素个数
+#define VECTOR_CTOR_DO_TEST(con, args, count)                                                \
+    do {                                                                                     \
+        clock_t start, end;                                                                  \
+        char buf[10];                                                                        \
+        const size_t n = count;                                                              \
+        volatile int sink = 0;                                                               \
+        start = clock();                                                                     \
+        for (size_t r = 0; r < 100; ++r) {                                                   \
+            con c args;                                                                      \
+            sink = sink + c[r % n];                                                          \
+        }                                                                                    \
+        end = clock();                                                                       \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        std::snprintf(buf, sizeof(buf), "%d", ms);                                           \
+        std::string t = buf;                                                                 \
+        t += "ms    |";                                                                      \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define VECTOR_CTOR_TEST(args, len1, len2, len3)         \
+    TEST_LEN(len1, len2, len3, WIDE);                    \
+    std::cout << "|         std         |";              \
+    VECTOR_CTOR_DO_TEST(std::vector<int>, args, len1);   \
+    VECTOR_CTOR_DO_TEST(std::vector<int>, args, len2);   \
+    VECTOR_CTOR_DO_TEST(std::vector<int>, args, len3);   \
+    std::cout << "\n|        MySTL        |";            \
+    VECTOR_CTOR_DO_TEST(MySTL::vector<int>, args, len1); \
+    VECTOR_CTOR_DO_TEST(MySTL::vector<int>, args, len2); \
+    VECTOR_CTOR_DO_TEST(MySTL::vector<int>, args, len3);
+
+typedef MySTL::vector<int, MySTL::allocator<int>, MySTL::vector_growth<5, 4>> vector_125;
+typedef MySTL::vector<int, MySTL::allocator<int>, MySTL::page_vector_growth<>> vector_page;
+
+// 几种填充方式，返回多申请的容量占元素个数的百分比
+inline double waste_percent(size_t cap, size_t size) {
+    return size == 0 ? 0.0 : 100.0 * static_cast<double>(cap - size) / static_cast<double>(size);
+}
+
+// 逐个 push_back count 个元素
+template <class Vec>
+double waste_push_back(size_t count) {
+    Vec v;
+    for (size_t i = 0; i < count; ++i)
+        v.push_back(static_cast<int>(i));
+    return waste_percent(v.capacity(), v.size());
+}
+
+// 先构造 count 个元素，再追加一个，触发一次扩容
+template <class Vec>
+double waste_append_one(size_t count) {
+    Vec v(count, 0);
+    v.push_back(1);
+    return waste_percent(v.capacity(), v.size());
+}
+
+// count / 3 个只有 3 个元素的短小 vector
+template <class Vec>
+double waste_tiny(size_t count) {
+    size_t cap = 0, size = 0;
+    for (size_t i = 0; i < count / 3; ++i) {
+        Vec v;
+        for (int k = 0; k < 3; ++k)
+            v.push_back(k);
+        cap += v.capacity();
+        size += v.size();
+    }
+    return waste_percent(cap, size);
+}
+
+#define WASTE_DO_TEST(con, pattern, count)                              \
+    do {                                                                \
+        char buf[32];                                                   \
+        std::snprintf(buf, sizeof(buf), "%.1f%%", pattern<con>(count)); \
+        std::string t = buf;                                            \
+        t += "    |";                                                   \
+        std::cout << std::setw(WIDE) << t;                              \
+    } while (0)
+
+#define WASTE_TEST(pattern, len1, len2, len3)         \
+    TEST_LEN(len1, len2, len3, WIDE);                 \
+    std::cout << "|         std         |";           \
+    WASTE_DO_TEST(std::vector<int>, pattern, len1);   \
+    WASTE_DO_TEST(std::vector<int>, pattern, len2);   \
+    WASTE_DO_TEST(std::vector<int>, pattern, len3);   \
+    std::cout << "\n|     MySTL 1.5x      |";         \
+    WASTE_DO_TEST(MySTL::vector<int>, pattern, len1); \
+    WASTE_DO_TEST(MySTL::vector<int>, pattern, len2); \
+    WASTE_DO_TEST(MySTL::vector<int>, pattern, len3); \
+    std::cout << "\n|     MySTL 1.25x     |";         \
+    WASTE_DO_TEST(vector_125, pattern, len1);         \
+    WASTE_DO_TEST(vector_125, pattern, len2);         \
+    WASTE_DO_TEST(vector_125, pattern, len3);         \
+    std::cout << "\n|     MySTL page      |";         \
+    WASTE_DO_TEST(vector_page, pattern, len1);        \
+    WASTE_DO_TEST(vector_page, pattern, len2);        \
+    WASTE_DO_TEST(vector_page, pattern, len3);
+
+// 把 count 个字节的文件读进新构造的缓冲区，resize 为扩大缓冲区的成员函数
+#define FILE_READ_DO_TEST(con, resize, file, count)                                          \
+    do {                                                                                     \
+        clock_t start, end;                                                                  \
+        char buf[32];                                                                        \
+        size_t got = 0;                                                                      \
+        start = clock();                                                                     \
+        {                                                                                    \
+            con c;                                                                           \
+            c.resize(count);                                                                 \
+            std::rewind(file);                                                               \
+            got = std::fread(&c[0], 1, count, file);                                         \
+        }                                                                                    \
+        end = clock();                                                                       \
+        int ms = static_cast<int>(static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000); \
+        if (got == count)                                                                    \
+            std::snprintf(buf, sizeof(buf), "%dms", ms);                                     \
+        else                                                                                 \
+            std::snprintf(buf, sizeof(buf), "failed");                                       \
+        std::string t = buf;                                                                 \
+        t += "    |";                                                                        \
+        std::cout << std::setw(WIDE) << t;                                                   \
+    } while (0)
+
+#define FILE_READ_TEST(file, len1, len2, len3)                              \
+    TEST_LEN(len1, len2, len3, WIDE);                                       \
+    std::cout << "|         std         |";                                 \
+    FILE_READ_DO_TEST(std::vector<char>, resize, file, len1);               \
+    FILE_READ_DO_TEST(std::vector<char>, resize, file, len2);               \
+    FILE_READ_DO_TEST(std::vector<char>, resize, file, len3);               \
+    std::cout << "\n|        MySTL        |";                               \
+    FILE_READ_DO_TEST(MySTL::vector<char>, resize, file, len1);             \
+    FILE_READ_DO_TEST(MySTL::vector<char>, resize, file, len2);             \
+    FILE_READ_DO_TEST(MySTL::vector<char>, resize, file, len3);             \
+    std::cout << "\n| resize_default_init |";                               \
+    FILE_READ_DO_TEST(MySTL::vector<char>, resize_default_init, file, len1); \
+    FILE_READ_DO_TEST(MySTL::vector<char>, resize_default_init, file, len2); \
+    FILE_READ_DO_TEST(MySTL::vector<char>, resize_default_init, file, len3); \
+    std::cout << "\n| string default_init |";                               \
+    FILE_READ_DO_TEST(MySTL::string, resize_default_init, file, len1);      \
+    FILE_READ_DO_TEST(MySTL::string, resize_default_init, file, len2);      \
+    FILE_READ_DO_TEST(MySTL::string, resize_default_init, file, len3);
+
+// 写出 count 个字节的临时文件，程序结束时自动删除
+inline std::FILE* make_temp_file(size_t count) {
+    std::FILE* file = std::tmpfile();
+    if (file == nullptr) return nullptr;
+    std::vector<char> block(1 << 20, 'm');
+    for (size_t done = 0; done < count; done += block.size())
+        std::fwrite(block.data(), 1, MySTL::min(block.size(), count - done), file);
+    std::fflush(file);
+    return file;
+}
+
+#if defined(__linux__)
+template <class Vec>
+void push_back_ints(size_t count) {
+    Vec v;
+    for (size_t i = 0; i < count; ++i)
+        v.push_back(static_cast<int>(i));
+}
+
+// 在子进程中执行 fun(count)，由 wait4 取得子进程的峰值常驻内存（KB），失败时返回 -1
+// 子进程的峰值从 fork 时父进程的常驻内存开始算，用 count 为 0 的结果作为基准扣除
+inline long child_peak_rss(void (*fun)(size_t), size_t count) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        fun(count);
+        _exit(0);
+    }
+    struct rusage usage;
+    int status = 0;
+    if (pid < 0 || wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+    return usage.ru_maxrss;
+}
+
+#define PEAK_RSS_DO_TEST(con, count)                                        \
+    do {                                                                    \
+        char buf[32];                                                       \
+        long base = child_peak_rss(&push_back_ints<con>, 0);                \
+        long peak = child_peak_rss(&push_back_ints<con>, count);            \
+        if (base < 0 || peak < 0)                                           \
+            std::snprintf(buf, sizeof(buf), "failed");                      \
+        else                                                                \
+            std::snprintf(buf, sizeof(buf), "%ldMB", (peak - base) / 1024); \
+        std::string t = buf;                                                \
+        t += "    |";                                                       \
+        std::cout << std::setw(WIDE) << t;                                  \
+    } while (0)
+
+#define PEAK_RSS_TEST(len1, len2, len3)         \
+    TEST_LEN(len1, len2, len3, WIDE);           \
+    std::cout << "|         std         |";     \
+    PEAK_RSS_DO_TEST(std::vector<int>, len1);   \
+    PEAK_RSS_DO_TEST(std::vector<int>, len2);   \
+    PEAK_RSS_DO_TEST(std::vector<int>, len3);   \
+    std::cout << "\n|        MySTL        |";   \
+    PEAK_RSS_DO_TEST(MySTL::vector<int>, len1); \
+    PEAK_RSS_DO_TEST(MySTL::vector<int>, len2); \
+    PEAK_RSS_DO_TEST(MySTL::vector<int>, len3);
+#endif
+
 void vector_test() {
     std::cout << "[===============================================================]\n";
     std::cout << "[----------------- Run container test : vector -----------------]\n";
@@ -86,6 +297,49 @@ void vector_test() {
     FUN_AFTER(v1, v1.shrink_to_fit());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
+
+    // 可平凡重定位的元素在扩容、insert、erase 时按字节搬运，参数引用容器自身的元素时也要正确
+    std::cout << std::boolalpha;
+    FUN_VALUE(MySTL::is_trivially_relocatable<MySTL::string>::value);
+    FUN_VALUE(MySTL::is_trivially_relocatable<MySTL::vector<MySTL::string>>::value);
+    std::cout << std::noboolalpha;
+    MySTL::vector<MySTL::string> vs;
+    for (int i = 0; i < 5; ++i)
+        vs.emplace_back(static_cast<size_t>(i + 1), static_cast<char>('a' + i));
+    FUN_AFTER(vs, vs.insert(vs.begin() + 1, vs.back()));
+    FUN_AFTER(vs, vs.emplace(vs.begin(), MySTL::move(vs[3])));
+    FUN_AFTER(vs, vs.insert(vs.begin() + 2, 2, vs[0]));
+    FUN_AFTER(vs, vs.erase(vs.begin() + 1));
+    FUN_AFTER(vs, vs.erase(vs.begin(), vs.begin() + 3));
+    FUN_AFTER(vs, vs.shrink_to_fit());
+    FUN_AFTER(vs, vs.emplace_back(vs[0]));
+    MySTL::vector<int> vf(4, -1);
+    FUN_AFTER(vf, vf.insert(vf.begin() + 2, 3, 0x01010101));
+    FUN_AFTER(vf, vf.insert(vf.end(), 2, 7));
+    FUN_AFTER(vf, vf.resize(12, 0));
+
+    // 指定个数的构造只申请恰好的容量，扩容由增长策略决定
+    MySTL::vector<int> ve(3, 1);
+    FUN_VALUE(ve.capacity());
+    FUN_AFTER(ve, ve.push_back(2));
+    FUN_VALUE(ve.capacity());
+    vector_125 vg;
+    FUN_VALUE(vg.capacity());
+    for (int i = 0; i < 100; ++i)
+        vg.push_back(i);
+    FUN_VALUE(vg.capacity());
+    vector_page vp(1000, 0);
+    vp.push_back(1);
+    FUN_VALUE(vp.capacity());
+    FUN_VALUE(vp.capacity() * sizeof(int) % MYSTL_PAGE_SIZE);
+
+    // resize_default_init 与 append_uninitialized 不初始化新增的平凡元素，由调用者随后填充
+    MySTL::vector<int> vd(4, 7);
+    FUN_AFTER(vd, vd.resize_default_init(2));
+    FUN_AFTER(vd, MySTL::fill_n(vd.append_uninitialized(3), 3, 5));
+    MySTL::vector<MySTL::string> vsd(1, "a");
+    FUN_AFTER(vsd, vsd.resize_default_init(3));
+    FUN_VALUE(vsd[2].size());
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]\n";
@@ -98,6 +352,66 @@ void vector_test() {
 #endif
     std::cout << "\n";
     std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     range ctor      |";
+    {
+        std::vector<int> src(LEN3);
+        for (size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<int>(i);
+        const int* p = src.data();
+        VECTOR_CTOR_TEST((p, p + n), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    }
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|    vector(n, 0)     |";
+    VECTOR_CTOR_TEST((n, 0), SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  push_back string   |";
+#if LARGER_TEST_DATA_ON
+    CON_TEST_P1(vector<MySTL::string>, push_back, "relocate", SCALE_M(LEN1), SCALE_M(LEN2), SCALE_M(LEN3));
+#else
+    CON_TEST_P1(vector<MySTL::string>, push_back, "relocate", SCALE_S(LEN1), SCALE_S(LEN2), SCALE_S(LEN3));
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    // 构造缓冲区后立即由 fread 整体填充，resize 的清零是多余的一遍写入
+    std::cout << "|  read file (bytes)  |";
+#if LARGER_TEST_DATA_ON
+    const size_t file_size = static_cast<size_t>(1) << 30;
+#else
+    const size_t file_size = static_cast<size_t>(1) << 28;
+#endif
+    std::FILE* file = make_temp_file(file_size);
+    if (file != nullptr) {
+        FILE_READ_TEST(file, file_size / 16, file_size / 4, file_size);
+        std::fclose(file);
+    }
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    // 多申请的容量占元素个数的百分比
+    std::cout << "|  push_back waste    |";
+    WASTE_TEST(waste_push_back, LEN1, LEN2, LEN3);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  append one waste   |";
+    WASTE_TEST(waste_append_one, LEN1, LEN2, LEN3);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "| 3-element vectors   |";
+    WASTE_TEST(waste_tiny, LEN1, LEN2, LEN3);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+#if defined(__linux__)
+    // 峰值常驻内存，MySTL::vector<int> 的大块缓冲区由 mremap 扩容，不需要同时持有新旧两块内存
+    std::cout << "|  push_back peak RSS |";
+#if LARGER_TEST_DATA_ON
+    PEAK_RSS_TEST(LEN3 * 25, LEN3 * 50, LEN3 * 100);
+#else
+    PEAK_RSS_TEST(SCALE_L(LEN3), SCALE_LL(LEN3), SCALE_LLL(LEN3));
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+#endif
     PASSED;
 #endif
     std::cout << "[----------------- End container test : vector -----------------]\n";